@@ -2,6 +2,7 @@ mod auction;
 pub mod loan_token;
 mod masternode;
 pub mod oracle;
+pub mod payload;
 pub mod poolswap;
 pub mod transaction;
 pub mod tx_result;
@@ -15,10 +16,12 @@ use std::{
 };
 
 use ain_dftx::{deserialize, is_skipped_tx, DfTx, Stack};
+use bitcoin::consensus::Decodable;
 use defichain_rpc::json::blockchain::{Block, Transaction, Vin, VinStandard, Vout};
 use helper::check_if_evm_tx;
 use loan_token::{index_active_price, invalidate_active_price};
 use log::trace;
+use payload::{decode_block, NodeVec};
 pub use poolswap::PoolSwapAggregatedInterval;
 use poolswap::{index_pool_swap_aggregated, invalidate_pool_swap_aggregated};
 
@@ -744,3 +747,119 @@ pub fn invalidate_block(services: &Arc<Services>, block: Block<Transaction>) ->
 
     Ok(())
 }
+
+/// Indexes a batch of blocks in order, as written by OceanIndexBlocks in src/ocean.cpp:
+/// a CompactSize count followed by one length-prefixed block payload per block.
+/// Every payload is decoded before the first block is indexed. When a block fails to
+/// index, it and the blocks of the batch before it are invalidated again in reverse order.
+/// Each block is still written on its own, so this rollback is best effort: a crash or a
+/// failing invalidation can leave part of the batch indexed.
+pub fn index_blocks(services: &Arc<Services>, batch: &[u8]) -> Result<()> {
+    let start = Instant::now();
+    let payloads = NodeVec::<Vec<u8>>::consensus_decode(&mut &batch[..])?.0;
+    let blocks = payloads
+        .iter()
+        .map(|payload| decode_block(payload))
+        .collect::<Result<Vec<_>>>()?;
+
+    index_in_order(
+        blocks,
+        |block| index_block(services, block),
+        |failed| rollback_blocks(services, &payloads[..=failed]),
+    )?;
+
+    log_elapsed(start, format!("Indexed batch of {} blocks", payloads.len()));
+    Ok(())
+}
+
+/// Indexes items in order and stops at the first failure. `rollback` gets the position of
+/// the failed item, to undo it and the items before it. The indexing error is returned
+/// even when the rollback fails as well.
+fn index_in_order<T>(
+    items: Vec<T>,
+    mut index: impl FnMut(T) -> Result<()>,
+    rollback: impl FnOnce(usize) -> Result<()>,
+) -> Result<()> {
+    for (i, item) in items.into_iter().enumerate() {
+        if let Err(e) = index(item) {
+            if let Err(rollback_err) = rollback(i) {
+                log::error!(
+                    "Failed to roll back ocean blocks of the batch up to {i}: {rollback_err}"
+                );
+            }
+            return Err(e);
+        }
+    }
+    Ok(())
+}
+
+/// Invalidates the blocks newest first. Keeps going past a failing block and returns the
+/// first error.
+fn rollback_blocks(services: &Arc<Services>, payloads: &[Vec<u8>]) -> Result<()> {
+    let mut result = Ok(());
+    for payload in payloads.iter().rev() {
+        let invalidated = decode_block(payload).and_then(|block| invalidate_block(services, block));
+        if let Err(e) = invalidated {
+            if result.is_ok() {
+                result = Err(e);
+            }
+        }
+    }
+    result
+}
+
+#[cfg(test)]
+mod tests {
+    use std::cell::RefCell;
+
+    use super::index_in_order;
+    use crate::{error::Error, Result};
+
+    fn index_items(
+        items: Vec<u32>,
+        fail_at: Option<u32>,
+        rollback_result: Result<()>,
+    ) -> (Result<()>, Vec<u32>, Option<usize>) {
+        let indexed = RefCell::new(Vec::new());
+        let mut rolled_back = None;
+        let result = index_in_order(
+            items,
+            |item| {
+                indexed.borrow_mut().push(item);
+                if Some(item) == fail_at {
+                    return Err(Error::from("index failed"));
+                }
+                Ok(())
+            },
+            |failed| {
+                rolled_back = Some(failed);
+                rollback_result
+            },
+        );
+        (result, indexed.into_inner(), rolled_back)
+    }
+
+    #[test]
+    fn should_index_all_in_order() {
+        let (result, indexed, rolled_back) = index_items(vec![1, 2, 3], None, Ok(()));
+        assert!(result.is_ok());
+        assert_eq!(indexed, vec![1, 2, 3]);
+        assert_eq!(rolled_back, None);
+    }
+
+    #[test]
+    fn should_stop_and_roll_back_up_to_failed_item() {
+        let (result, indexed, rolled_back) = index_items(vec![1, 2, 3, 4], Some(3), Ok(()));
+        assert_eq!(result.unwrap_err().to_string(), "index failed");
+        assert_eq!(indexed, vec![1, 2, 3]);
+        assert_eq!(rolled_back, Some(2));
+    }
+
+    #[test]
+    fn should_keep_index_error_when_rollback_fails() {
+        let (result, _, rolled_back) =
+            index_items(vec![1, 2], Some(1), Err(Error::from("rollback failed")));
+        assert_eq!(result.unwrap_err().to_string(), "index failed");
+        assert_eq!(rolled_back, Some(0));
+    }
+}
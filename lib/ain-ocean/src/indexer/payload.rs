@@ -0,0 +1,602 @@
+use ain_dftx::{Block as RawBlock, Transaction as RawTransaction};
+use ain_macros::ConsensusEncoding;
+use bitcoin::{
+    consensus::{encode, Decodable, Encodable},
+    io, Script, TxIn, TxOut, VarInt,
+};
+use defichain_rpc::json::blockchain::{Block, Transaction};
+use serde::{
+    de::{
+        value::SeqDeserializer, DeserializeSeed, Deserializer, IntoDeserializer, MapAccess, Visitor,
+    },
+    forward_to_deserialize_any, Deserialize,
+};
+
+use crate::Result;
+
+/// std::vector as serialized by the node, with a CompactSize length.
+/// CompactVec uses the node's VARINT instead, which only matches below 128 items.
+#[derive(Debug, Clone)]
+pub struct NodeVec<T>(pub Vec<T>);
+
+impl<T: Encodable> Encodable for NodeVec<T> {
+    fn consensus_encode<W: io::Write + ?Sized>(&self, w: &mut W) -> Result<usize, io::Error> {
+        let mut len = VarInt(self.0.len() as u64).consensus_encode(w)?;
+        for item in &self.0 {
+            len += item.consensus_encode(w)?;
+        }
+        Ok(len)
+    }
+}
+
+impl<T: Decodable> Decodable for NodeVec<T> {
+    fn consensus_decode<R: io::Read + ?Sized>(r: &mut R) -> Result<Self, encode::Error> {
+        let len = VarInt::consensus_decode(r)?.0;
+        let mut items = Vec::with_capacity(len.min(1024) as usize);
+        for _ in 0..len {
+            items.push(T::consensus_decode(r)?);
+        }
+        Ok(Self(items))
+    }
+}
+
+// Mirrors OceanTxOutInfo in src/ocean.h
+#[derive(ConsensusEncoding, Debug, Clone)]
+struct TxOutInfo {
+    r#type: Vec<u8>,
+    req_sigs: i32,
+    addresses: NodeVec<Vec<u8>>,
+    token_id: u32,
+}
+
+// Mirrors OceanBlockRewards in src/ocean.h
+#[derive(ConsensusEncoding, Debug, Clone)]
+struct BlockRewards {
+    anchor_reward: i64,
+    community_dev_funds: i64,
+    burnt: i64,
+}
+
+// Mirrors OceanBlockInfo in src/ocean.h
+#[derive(ConsensusEncoding, Debug, Clone)]
+struct BlockInfo {
+    hash: [u8; 32],
+    height: u32,
+    confirmations: i32,
+    median_time: i64,
+    chainwork: [u8; 32],
+    masternode: Vec<u8>,
+    minter: Vec<u8>,
+    minted_blocks: u64,
+    stake_modifier: [u8; 32],
+    has_rewards: bool,
+    rewards: BlockRewards,
+    vouts: NodeVec<NodeVec<TxOutInfo>>,
+}
+
+fn to_uint256_hex(bytes: &[u8; 32]) -> String {
+    let mut bytes = *bytes;
+    bytes.reverse();
+    hex::encode(bytes)
+}
+
+fn to_string(bytes: &[u8]) -> String {
+    String::from_utf8_lossy(bytes).into_owned()
+}
+
+fn to_coins(amount: i64) -> f64 {
+    amount as f64 / 100_000_000f64
+}
+
+// Same as GetDifficulty in src/rpc/blockchain.cpp
+fn difficulty(bits: u32) -> f64 {
+    let mut shift = (bits >> 24) & 0xff;
+    let mut diff = f64::from(0x0000_ffff) / f64::from(bits & 0x00ff_ffff);
+    while shift < 29 {
+        diff *= 256.0;
+        shift += 1;
+    }
+    while shift > 29 {
+        diff /= 256.0;
+        shift -= 1;
+    }
+    diff
+}
+
+type DeResult<T> = std::result::Result<T, serde_json::Error>;
+
+/// The fields of one object of the verbose-2 block, in RPC order. They are handed one by one
+/// to the derived Deserialize of the defichain-rpc types, so the block is built in place.
+trait Fields {
+    const KEYS: &'static [&'static str];
+
+    /// Whether the RPC output has the key at all, as for the optional fields of blockToJSON.
+    fn is_set(&self, _key: &str) -> bool {
+        true
+    }
+
+    fn field<'de, S: DeserializeSeed<'de>>(&self, key: &str, seed: S) -> DeResult<S::Value>;
+}
+
+/// Deserializer of a Fields object, read as a map.
+struct Object<T>(T);
+
+impl<'de, T: Fields> Deserializer<'de> for Object<T> {
+    type Error = serde_json::Error;
+
+    fn deserialize_any<V: Visitor<'de>>(self, visitor: V) -> DeResult<V::Value> {
+        visitor.visit_map(ObjectAccess {
+            fields: &self.0,
+            keys: T::KEYS.iter(),
+            key: "",
+        })
+    }
+
+    forward_to_deserialize_any! {
+        bool i8 i16 i32 i64 i128 u8 u16 u32 u64 u128 f32 f64 char str string
+        bytes byte_buf option unit unit_struct newtype_struct seq tuple
+        tuple_struct map struct enum identifier ignored_any
+    }
+}
+
+impl<'de, T: Fields> IntoDeserializer<'de, serde_json::Error> for Object<T> {
+    type Deserializer = Self;
+
+    fn into_deserializer(self) -> Self {
+        self
+    }
+}
+
+struct ObjectAccess<'a, T> {
+    fields: &'a T,
+    keys: std::slice::Iter<'static, &'static str>,
+    key: &'static str,
+}
+
+impl<'de, T: Fields> MapAccess<'de> for ObjectAccess<'_, T> {
+    type Error = serde_json::Error;
+
+    fn next_key_seed<K: DeserializeSeed<'de>>(&mut self, seed: K) -> DeResult<Option<K::Value>> {
+        for &key in self.keys.by_ref() {
+            if self.fields.is_set(key) {
+                self.key = key;
+                return seed.deserialize(key.into_deserializer()).map(Some);
+            }
+        }
+        Ok(None)
+    }
+
+    fn next_value_seed<V: DeserializeSeed<'de>>(&mut self, seed: V) -> DeResult<V::Value> {
+        self.fields.field(self.key, seed)
+    }
+}
+
+/// A present field value. Reads as Some for Option fields, as a serde_json::Value does.
+struct Present<D>(D);
+
+impl<'de, D: Deserializer<'de, Error = serde_json::Error>> Deserializer<'de> for Present<D> {
+    type Error = serde_json::Error;
+
+    fn deserialize_any<V: Visitor<'de>>(self, visitor: V) -> DeResult<V::Value> {
+        self.0.deserialize_any(visitor)
+    }
+
+    fn deserialize_option<V: Visitor<'de>>(self, visitor: V) -> DeResult<V::Value> {
+        visitor.visit_some(self.0)
+    }
+
+    fn deserialize_newtype_struct<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        visitor: V,
+    ) -> DeResult<V::Value> {
+        visitor.visit_newtype_struct(self.0)
+    }
+
+    fn deserialize_enum<V: Visitor<'de>>(
+        self,
+        name: &'static str,
+        variants: &'static [&'static str],
+        visitor: V,
+    ) -> DeResult<V::Value> {
+        self.0.deserialize_enum(name, variants, visitor)
+    }
+
+    forward_to_deserialize_any! {
+        bool i8 i16 i32 i64 i128 u8 u16 u32 u64 u128 f32 f64 char str string
+        bytes byte_buf unit unit_struct seq tuple tuple_struct map struct
+        identifier ignored_any
+    }
+}
+
+fn value<'de, S, D>(seed: S, deserializer: D) -> DeResult<S::Value>
+where
+    S: DeserializeSeed<'de>,
+    D: Deserializer<'de, Error = serde_json::Error>,
+{
+    seed.deserialize(Present(deserializer))
+}
+
+fn plain<'de, S, T>(seed: S, v: T) -> DeResult<S::Value>
+where
+    S: DeserializeSeed<'de>,
+    T: IntoDeserializer<'de, serde_json::Error>,
+{
+    value(seed, v.into_deserializer())
+}
+
+fn seq<'de, S, I>(seed: S, items: I) -> DeResult<S::Value>
+where
+    S: DeserializeSeed<'de>,
+    I: Iterator,
+    I::Item: IntoDeserializer<'de, serde_json::Error>,
+{
+    value(seed, SeqDeserializer::new(items))
+}
+
+struct BlockFields<'a> {
+    block: &'a RawBlock,
+    info: &'a BlockInfo,
+    size: u64,
+    weight: u64,
+}
+
+impl Fields for BlockFields<'_> {
+    const KEYS: &'static [&'static str] = &[
+        "hash",
+        "confirmations",
+        "strippedsize",
+        "size",
+        "weight",
+        "height",
+        "masternode",
+        "minter",
+        "mintedBlocks",
+        "stakeModifier",
+        "version",
+        "versionHex",
+        "merkleroot",
+        "nonutxo",
+        "tx",
+        "time",
+        "mediantime",
+        "bits",
+        "difficulty",
+        "chainwork",
+        "nTx",
+        "previousblockhash",
+    ];
+
+    fn is_set(&self, key: &str) -> bool {
+        match key {
+            "masternode" => !self.info.masternode.is_empty(),
+            "minter" => !self.info.masternode.is_empty() && !self.info.minter.is_empty(),
+            "nonutxo" => self.info.has_rewards,
+            "previousblockhash" => self.info.height > 0,
+            _ => true,
+        }
+    }
+
+    fn field<'de, S: DeserializeSeed<'de>>(&self, key: &str, seed: S) -> DeResult<S::Value> {
+        let (header, info) = (&self.block.header, self.info);
+        match key {
+            "hash" => plain(seed, to_uint256_hex(&info.hash)),
+            "confirmations" => plain(seed, info.confirmations),
+            "strippedsize" => plain(seed, (self.weight - self.size) / 3),
+            "size" => plain(seed, self.size),
+            "weight" => plain(seed, self.weight),
+            "height" => plain(seed, info.height),
+            "masternode" => plain(seed, to_string(&info.masternode)),
+            "minter" => plain(seed, to_string(&info.minter)),
+            "mintedBlocks" => plain(seed, info.minted_blocks),
+            "stakeModifier" => plain(seed, to_uint256_hex(&info.stake_modifier)),
+            "version" => plain(seed, header.version.to_consensus()),
+            "versionHex" => plain(seed, format!("{:08x}", header.version.to_consensus())),
+            "merkleroot" => plain(seed, header.merkle_root.to_string()),
+            "nonutxo" => seq(seed, std::iter::once(Object(&info.rewards))),
+            "tx" => seq(
+                seed,
+                self.block
+                    .txdata
+                    .iter()
+                    .zip(&info.vouts.0)
+                    .map(|(tx, outs)| Object(TxFields::new(tx, &outs.0))),
+            ),
+            "time" => plain(seed, header.time),
+            "mediantime" => plain(seed, info.median_time),
+            "bits" => plain(seed, format!("{:08x}", header.bits.to_consensus())),
+            "difficulty" => plain(seed, difficulty(header.bits.to_consensus())),
+            "chainwork" => plain(seed, to_uint256_hex(&info.chainwork)),
+            "nTx" => plain(seed, self.block.txdata.len()),
+            "previousblockhash" => plain(seed, header.prev_blockhash.to_string()),
+            _ => unreachable!(),
+        }
+    }
+}
+
+impl Fields for &BlockRewards {
+    const KEYS: &'static [&'static str] = &["AnchorReward", "CommunityDevelopmentFunds", "Burnt"];
+
+    fn field<'de, S: DeserializeSeed<'de>>(&self, key: &str, seed: S) -> DeResult<S::Value> {
+        match key {
+            "AnchorReward" => plain(seed, to_coins(self.anchor_reward)),
+            "CommunityDevelopmentFunds" => plain(seed, to_coins(self.community_dev_funds)),
+            "Burnt" => plain(seed, to_coins(self.burnt)),
+            _ => unreachable!(),
+        }
+    }
+}
+
+struct TxFields<'a> {
+    tx: &'a RawTransaction,
+    outs: &'a [TxOutInfo],
+    bytes: Vec<u8>,
+}
+
+impl<'a> TxFields<'a> {
+    fn new(tx: &'a RawTransaction, outs: &'a [TxOutInfo]) -> Self {
+        Self {
+            tx,
+            outs,
+            bytes: bitcoin::consensus::serialize(tx),
+        }
+    }
+}
+
+impl Fields for TxFields<'_> {
+    const KEYS: &'static [&'static str] = &[
+        "txid", "hash", "version", "size", "vsize", "weight", "locktime", "vin", "vout", "hex",
+    ];
+
+    fn field<'de, S: DeserializeSeed<'de>>(&self, key: &str, seed: S) -> DeResult<S::Value> {
+        let tx = self.tx;
+        match key {
+            "txid" => plain(seed, tx.txid().to_string()),
+            "hash" => plain(seed, tx.wtxid().to_string()),
+            "version" => plain(seed, tx.version.0),
+            "size" => plain(seed, self.bytes.len()),
+            "vsize" => plain(seed, (tx.weight().to_wu() + 3) / 4),
+            "weight" => plain(seed, tx.weight().to_wu()),
+            "locktime" => plain(seed, tx.lock_time.to_consensus_u32()),
+            "vin" => {
+                let coinbase = tx.is_coinbase();
+                seq(
+                    seed,
+                    tx.input
+                        .iter()
+                        .map(|txin| Object(VinFields { txin, coinbase })),
+                )
+            }
+            "vout" => {
+                // CTransaction::TOKENS_MIN_VERSION
+                let tokens = tx.version.0 >= 4;
+                seq(
+                    seed,
+                    tx.output
+                        .iter()
+                        .zip(self.outs)
+                        .enumerate()
+                        .map(|(n, (txout, info))| {
+                            Object(VoutFields {
+                                txout,
+                                info,
+                                n,
+                                tokens,
+                            })
+                        }),
+                )
+            }
+            "hex" => plain(seed, hex::encode(&self.bytes)),
+            _ => unreachable!(),
+        }
+    }
+}
+
+struct VinFields<'a> {
+    txin: &'a TxIn,
+    coinbase: bool,
+}
+
+impl Fields for VinFields<'_> {
+    const KEYS: &'static [&'static str] = &[
+        "coinbase",
+        "txid",
+        "vout",
+        "scriptSig",
+        "txinwitness",
+        "sequence",
+    ];
+
+    fn is_set(&self, key: &str) -> bool {
+        match key {
+            "coinbase" => self.coinbase,
+            "txid" | "vout" | "scriptSig" => !self.coinbase,
+            "txinwitness" => !self.coinbase && !self.txin.witness.is_empty(),
+            _ => true,
+        }
+    }
+
+    fn field<'de, S: DeserializeSeed<'de>>(&self, key: &str, seed: S) -> DeResult<S::Value> {
+        let txin = self.txin;
+        match key {
+            "coinbase" => plain(seed, hex::encode(txin.script_sig.as_bytes())),
+            "txid" => plain(seed, txin.previous_output.txid.to_string()),
+            "vout" => plain(seed, txin.previous_output.vout),
+            "scriptSig" => value(
+                seed,
+                Object(ScriptFields {
+                    script: &txin.script_sig,
+                    info: None,
+                }),
+            ),
+            "txinwitness" => seq(seed, txin.witness.iter().map(hex::encode)),
+            "sequence" => plain(seed, txin.sequence.0),
+            _ => unreachable!(),
+        }
+    }
+}
+
+struct VoutFields<'a> {
+    txout: &'a TxOut,
+    info: &'a TxOutInfo,
+    n: usize,
+    tokens: bool,
+}
+
+impl Fields for VoutFields<'_> {
+    const KEYS: &'static [&'static str] = &["value", "n", "scriptPubKey", "tokenId"];
+
+    fn is_set(&self, key: &str) -> bool {
+        key != "tokenId" || self.tokens
+    }
+
+    fn field<'de, S: DeserializeSeed<'de>>(&self, key: &str, seed: S) -> DeResult<S::Value> {
+        match key {
+            "value" => plain(seed, to_coins(self.txout.value.to_sat() as i64)),
+            "n" => plain(seed, self.n),
+            "scriptPubKey" => value(
+                seed,
+                Object(ScriptFields {
+                    script: &self.txout.script_pubkey,
+                    info: Some(self.info),
+                }),
+            ),
+            "tokenId" => plain(seed, self.info.token_id),
+            _ => unreachable!(),
+        }
+    }
+}
+
+/// scriptSig of an input, or scriptPubKey of an output with its solved destinations.
+struct ScriptFields<'a> {
+    script: &'a Script,
+    info: Option<&'a TxOutInfo>,
+}
+
+impl Fields for ScriptFields<'_> {
+    const KEYS: &'static [&'static str] = &["asm", "hex", "reqSigs", "type", "addresses"];
+
+    fn is_set(&self, key: &str) -> bool {
+        match key {
+            "asm" | "hex" => true,
+            "type" => self.info.is_some(),
+            _ => self.info.map_or(false, |info| info.req_sigs >= 0),
+        }
+    }
+
+    fn field<'de, S: DeserializeSeed<'de>>(&self, key: &str, seed: S) -> DeResult<S::Value> {
+        match (key, self.info) {
+            ("asm", _) => plain(seed, self.script.to_asm_string()),
+            ("hex", _) => plain(seed, hex::encode(self.script.as_bytes())),
+            ("reqSigs", Some(info)) => plain(seed, info.req_sigs),
+            ("type", Some(info)) => plain(seed, to_string(&info.r#type)),
+            ("addresses", Some(info)) => seq(seed, info.addresses.0.iter().map(|a| to_string(a))),
+            _ => unreachable!(),
+        }
+    }
+}
+
+/// Decodes the binary block handoff written by blockToOceanPayload in
+/// src/rpc/blockchain.cpp into the verbose-2 block the indexer works on.
+/// Everything except the node-only fields of BlockInfo is derived from the raw block,
+/// and deserialized straight into the defichain-rpc types.
+pub fn decode_block(payload: &[u8]) -> Result<Block<Transaction>> {
+    let mut reader = payload;
+    let block = RawBlock::consensus_decode(&mut reader)?;
+    let info = BlockInfo::consensus_decode(&mut reader)?;
+
+    let fields = BlockFields {
+        block: &block,
+        info: &info,
+        size: bitcoin::consensus::serialize(&block).len() as u64,
+        weight: block.weight().to_wu(),
+    };
+    Ok(Block::deserialize(Object(fields))?)
+}
+
+#[cfg(test)]
+mod tests {
+    use bitcoin::consensus::{deserialize, serialize};
+    use defichain_rpc::json::blockchain::{Transaction, Vin};
+    use serde::Deserialize;
+
+    use super::{decode_block, NodeVec, Object, RawTransaction, TxFields, TxOutInfo};
+
+    const PREV_TXID: &str = "1111111111111111111111111111111111111111111111111111111111111111";
+    const P2PKH: &str = "76a914222222222222222222222222222222222222222288ac";
+
+    fn raw_tx(prevout: &str, script_sig: &str) -> RawTransaction {
+        let script_len = format!("{:02x}", script_sig.len() / 2);
+        let hex = format!(
+            "0200000001{prevout}{script_len}{script_sig}ffffffff0100e1f5050000000019{P2PKH}00000000"
+        );
+        deserialize(&hex::decode(hex).unwrap()).unwrap()
+    }
+
+    fn out_info(req_sigs: i32) -> TxOutInfo {
+        TxOutInfo {
+            r#type: b"pubkeyhash".to_vec(),
+            req_sigs,
+            addresses: NodeVec(vec![b"8K1hW2kgNpYq8u7S9ZEBL5ZWYf1WCmEDDm".to_vec()]),
+            token_id: 0,
+        }
+    }
+
+    fn decode_tx(tx: &RawTransaction, outs: &[TxOutInfo]) -> Transaction {
+        Transaction::deserialize(Object(TxFields::new(tx, outs))).unwrap()
+    }
+
+    #[test]
+    fn should_decode_standard_tx() {
+        let tx = raw_tx(&format!("{PREV_TXID}01000000"), "");
+        let outs = [out_info(1)];
+        let decoded = decode_tx(&tx, &outs);
+
+        assert_eq!(decoded.txid.to_string(), tx.txid().to_string());
+        assert_eq!(decoded.size, serialize(&tx).len() as u64);
+        match &decoded.vin[0] {
+            Vin::Standard(vin) => {
+                assert_eq!(vin.txid.to_string(), PREV_TXID);
+                assert_eq!(vin.vout, 1);
+            }
+            Vin::Coinbase(_) => panic!("standard input decoded as coinbase"),
+        }
+
+        let vout = &decoded.vout[0];
+        assert_eq!(vout.n, 0);
+        assert_eq!(vout.value, 1.0);
+        assert_eq!(vout.script_pub_key.hex, hex::decode(P2PKH).unwrap());
+        assert_eq!(vout.script_pub_key.r#type, "pubkeyhash");
+        assert_eq!(
+            vout.script_pub_key.addresses,
+            Some(vec!["8K1hW2kgNpYq8u7S9ZEBL5ZWYf1WCmEDDm".to_string()])
+        );
+    }
+
+    #[test]
+    fn should_decode_coinbase_without_unsolved_addresses() {
+        let tx = raw_tx(&format!("{}ffffffff", "0".repeat(64)), "0151");
+        let decoded = decode_tx(&tx, &[out_info(-1)]);
+
+        match &decoded.vin[0] {
+            Vin::Coinbase(vin) => assert_eq!(vin.coinbase, "0151"),
+            Vin::Standard(_) => panic!("coinbase input decoded as standard"),
+        }
+        assert_eq!(decoded.vout[0].script_pub_key.addresses, None);
+    }
+
+    #[test]
+    fn should_use_compact_size_for_node_vec() {
+        let items = NodeVec(vec![7u32; 200]);
+        let bytes = serialize(&items);
+        assert_eq!(&bytes[..3], &[0xfd, 200, 0]);
+
+        let read: NodeVec<u32> = deserialize(&bytes).unwrap();
+        assert_eq!(read.0, items.0);
+    }
+
+    #[test]
+    fn should_fail_on_truncated_payload() {
+        assert!(decode_block(&[0; 8]).is_err());
+    }
+}
@@ -10,8 +10,9 @@ pub use api::ocean_router;
 use error::Error;
 use indexer::poolswap::PoolPairCache;
 pub use indexer::{
-    get_block_height, index_block, invalidate_block,
+    get_block_height, index_block, index_blocks, invalidate_block,
     oracle::invalidate_oracle_interval,
+    payload::decode_block,
     transaction::{index_transaction, invalidate_transaction},
     tx_result,
 };
@@ -347,8 +347,10 @@ pub mod ffi {
         fn evm_try_flush_db(result: &mut CrossBoundaryResult);
 
         fn ocean_get_block_height(result: &mut CrossBoundaryResult) -> u32;
-        fn ocean_index_block(result: &mut CrossBoundaryResult, block_str: String);
-        fn ocean_invalidate_block(result: &mut CrossBoundaryResult, block: String);
+        fn ocean_index_block(result: &mut CrossBoundaryResult, block: &[u8]);
+        fn ocean_decode_block(result: &mut CrossBoundaryResult, block: &[u8]);
+        fn ocean_index_blocks(result: &mut CrossBoundaryResult, blocks: &[u8]);
+        fn ocean_invalidate_block(result: &mut CrossBoundaryResult, block: &[u8]);
 
         fn ocean_try_set_tx_result(
             result: &mut CrossBoundaryResult,
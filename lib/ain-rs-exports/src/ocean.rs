@@ -1,6 +1,5 @@
 use ain_macros::ffi_fallible;
 use ain_ocean::Result;
-use defichain_rpc::json::blockchain::{Block, Transaction};
 
 use crate::{
     ffi,
@@ -13,14 +12,25 @@ pub fn ocean_get_block_height() -> Result<u32> {
 }
 
 #[ffi_fallible]
-pub fn ocean_index_block(block_str: String) -> Result<()> {
-    let block: Block<Transaction> = serde_json::from_str(&block_str)?;
+pub fn ocean_index_block(block: &[u8]) -> Result<()> {
+    let block = ain_ocean::decode_block(block)?;
     ain_ocean::index_block(&ain_ocean::SERVICES, block)
 }
 
+// Decode only, the handoff cost without the storage writes of indexing
 #[ffi_fallible]
-pub fn ocean_invalidate_block(block_str: String) -> Result<()> {
-    let block: Block<Transaction> = serde_json::from_str(&block_str)?;
+pub fn ocean_decode_block(block: &[u8]) -> Result<()> {
+    ain_ocean::decode_block(block).map(|_| ())
+}
+
+#[ffi_fallible]
+pub fn ocean_index_blocks(blocks: &[u8]) -> Result<()> {
+    ain_ocean::index_blocks(&ain_ocean::SERVICES, blocks)
+}
+
+#[ffi_fallible]
+pub fn ocean_invalidate_block(block: &[u8]) -> Result<()> {
+    let block = ain_ocean::decode_block(block)?;
     ain_ocean::invalidate_block(&ain_ocean::SERVICES, block)
 }
 
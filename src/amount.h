@@ -6,6 +6,7 @@
 #ifndef DEFI_AMOUNT_H
 #define DEFI_AMOUNT_H
 
+#include <arith_int128.h>
 #include <arith_uint256.h>
 #include <dfi/res.h>
 #include <serialize.h>
@@ -14,6 +15,9 @@
 
 #include <map>
 
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+
 /** Amount in satoshis (Can be negative) */
 typedef int64_t CAmount;
 
@@ -91,7 +95,9 @@ inline std::string GetDecimalString(CAmount nValue)
     return strprintf("%s%d.%08d", sign ? "-" : "", quotient, remainder);
 }
 
-typedef std::map<DCT_ID, CAmount> TAmounts;
+// Sorted in place, with room for 4 tokens before it allocates. Most balances, collateral and loan sets hold
+// 1-4 tokens. Inserting or erasing invalidates iterators and references, unlike std::map.
+typedef boost::container::small_flat_map<DCT_ID, CAmount, 4> TAmounts;
 
 inline ResVal<CAmount> SafeAdd(CAmount _a, CAmount _b) {
     // check limits
@@ -113,17 +119,17 @@ inline ResVal<CAmount> SafeAdd(CAmount _a, CAmount _b) {
 }
 
 inline CAmount MultiplyDivideAmounts(CAmount a, CAmount b, CAmount c) {
-    return (arith_uint256(a) * arith_uint256(b) / arith_uint256(c)).GetLow64();
+    return MulDivLow64(a, b, c);
 }
 
 inline CAmount MultiplyAmounts(CAmount a, CAmount b)
 {
-    return (arith_uint256(a) * arith_uint256(b) / arith_uint256(COIN)).GetLow64();
+    return MulDivLow64(a, b, COIN);
 }
 
 inline CAmount DivideAmounts(CAmount a, CAmount b)
 {
-    return (arith_uint256(a) * arith_uint256(COIN) / arith_uint256(b)).GetLow64();
+    return MulDivLow64(a, COIN, b);
 }
 
 inline base_uint<128> MultiplyAmounts(base_uint<128> a, CAmount b)
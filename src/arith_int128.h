@@ -0,0 +1,151 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DEFI_ARITH_INT128_H
+#define DEFI_ARITH_INT128_H
+
+#include <arith_uint256.h>
+
+#include <stdint.h>
+
+/**
+ * Native 128-bit fast paths for the big integer expressions used by interest,
+ * reward and swap calculations.
+ *
+ * Each helper returns exactly what the arith_uint256 expression quoted in its
+ * comment returns, including for negative CAmount inputs (which base_uint sees
+ * as their unsigned 64-bit two's complement) and for results that get truncated
+ * by GetLow64() or by narrowing to base_uint<128>. Intermediates that are not
+ * guaranteed to fit in 128 bits are checked for overflow, and the helper falls
+ * back to arith_uint256 when they do not fit. Division by zero throws uint_error
+ * just like base_uint::operator/=.
+ *
+ * test/fuzz/arith_int128.cpp checks every helper against its reference
+ * expression and bench/arith_int128.cpp measures both.
+ */
+
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 native_uint128;
+
+inline native_uint128 ToNativeUint128(const base_uint<128>& value)
+{
+    return native_uint128(value.GetUint64(1)) << 64 | value.GetUint64(0);
+}
+
+inline base_uint<128> FromNativeUint128(native_uint128 value)
+{
+    base_uint<128> result;
+    result.SetUint64(0, uint64_t(value));
+    result.SetUint64(1, uint64_t(value >> 64));
+    return result;
+}
+#endif
+
+inline void CheckDivisor(uint64_t divisor)
+{
+    if (divisor == 0) {
+        throw uint_error("Division by zero");
+    }
+}
+
+/** (arith_uint256(a) * arith_uint256(b) / arith_uint256(c)).GetLow64() */
+inline uint64_t MulDivLow64(uint64_t a, uint64_t b, uint64_t c)
+{
+    CheckDivisor(c);
+#ifdef __SIZEOF_INT128__
+    return uint64_t(native_uint128(a) * b / c);
+#else
+    return (arith_uint256(a) * arith_uint256(b) / arith_uint256(c)).GetLow64();
+#endif
+}
+
+/** (arith_uint256(a) * b / arith_uint256(c)).GetLow64() */
+inline uint64_t MulDivLow64(uint64_t a, const arith_uint256& b, uint64_t c)
+{
+    CheckDivisor(c);
+#ifdef __SIZEOF_INT128__
+    if (b.bits() <= 128) {
+        native_uint128 product;
+        const auto b128 = native_uint128(b.GetUint64(1)) << 64 | b.GetUint64(0);
+        if (!__builtin_mul_overflow(native_uint128(a), b128, &product)) {
+            return uint64_t(product / c);
+        }
+    }
+#endif
+    return (arith_uint256(a) * b / arith_uint256(c)).GetLow64();
+}
+
+/** base_uint<128>(arith_uint256(a) * arith_uint256(b) / arith_uint256(c)), never truncates */
+inline base_uint<128> MulDiv128(uint64_t a, uint64_t b, uint64_t c)
+{
+    CheckDivisor(c);
+#ifdef __SIZEOF_INT128__
+    return FromNativeUint128(native_uint128(a) * b / c);
+#else
+    return arith_uint256(a) * arith_uint256(b) / arith_uint256(c);
+#endif
+}
+
+/** base_uint<128>(arith_uint256(a) * b * c / d) */
+inline base_uint<128> MulMulDiv128(uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+    CheckDivisor(d);
+#ifdef __SIZEOF_INT128__
+    native_uint128 product;
+    if (!__builtin_mul_overflow(native_uint128(a) * b, native_uint128(c), &product)) {
+        return FromNativeUint128(product / d);
+    }
+#endif
+    return arith_uint256(a) * arith_uint256(b) * arith_uint256(c) / arith_uint256(d);
+}
+
+/** base_uint<128>(arith_uint256(a) * arith_uint256(b) + arith_uint256(c)), never truncates */
+inline base_uint<128> MulAdd128(uint64_t a, uint64_t b, uint64_t c)
+{
+#ifdef __SIZEOF_INT128__
+    return FromNativeUint128(native_uint128(a) * b + c);
+#else
+    return arith_uint256(a) * arith_uint256(b) + arith_uint256(c);
+#endif
+}
+
+/** base_uint<128>(a) * base_uint<128>(b), never truncates */
+inline base_uint<128> Mul128(uint64_t a, uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+    return FromNativeUint128(native_uint128(a) * b);
+#else
+    return base_uint<128>(a) * base_uint<128>(b);
+#endif
+}
+
+/** (value / base_uint<128>(divisor)).GetLow64() */
+inline uint64_t DivLow64(const base_uint<128>& value, uint64_t divisor)
+{
+    CheckDivisor(divisor);
+#ifdef __SIZEOF_INT128__
+    return uint64_t(ToNativeUint128(value) / divisor);
+#else
+    return (value / base_uint<128>(divisor)).GetLow64();
+#endif
+}
+
+/**
+ * q = (value / base_uint<128>(divisor)).GetLow64();
+ * q + (value != base_uint<128>(q) * divisor)
+ */
+inline uint64_t DivCeilLow64(const base_uint<128>& value, uint64_t divisor)
+{
+    CheckDivisor(divisor);
+#ifdef __SIZEOF_INT128__
+    const auto value128 = ToNativeUint128(value);
+    const auto quotient = uint64_t(value128 / divisor);
+    return quotient + uint64_t(value128 != native_uint128(quotient) * divisor);
+#else
+    const auto quotient = (value / base_uint<128>(divisor)).GetLow64();
+    return quotient + uint64_t(value != base_uint<128>(quotient) * divisor);
+#endif
+}
+
+#endif // DEFI_ARITH_INT128_H
@@ -273,6 +273,19 @@ public:
         return pn[0] | (uint64_t)pn[1] << 32;
     }
 
+    uint64_t GetUint64(int pos) const
+    {
+        assert(pos >= 0 && 2 * pos + 1 < WIDTH);
+        return pn[2 * pos] | (uint64_t)pn[2 * pos + 1] << 32;
+    }
+
+    void SetUint64(int pos, uint64_t b)
+    {
+        assert(pos >= 0 && 2 * pos + 1 < WIDTH);
+        pn[2 * pos] = (unsigned int)b;
+        pn[2 * pos + 1] = (unsigned int)(b >> 32);
+    }
+
     template<typename Stream>
     void Serialize(Stream& s) const
     {
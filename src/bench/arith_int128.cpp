@@ -0,0 +1,88 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_int128.h>
+#include <arith_uint256.h>
+#include <bench/bench.h>
+
+#include <vector>
+
+static constexpr int64_t SCALER = 10000000000000000;
+
+struct ArithInput {
+    int64_t amount;
+    int64_t liquidity;
+    int64_t total;
+};
+
+static std::vector<ArithInput> MakeInputs()
+{
+    std::vector<ArithInput> inputs;
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    for (int i = 0; i < 1000; ++i) {
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        const int64_t total = (seed >> 12) + 1;
+        inputs.push_back({int64_t(seed >> 8), int64_t((seed >> 20) % total), total});
+    }
+    return inputs;
+}
+
+// Liquidity reward / swap style multiply-divide
+static void MulDivArith256(benchmark::State& state)
+{
+    const auto inputs = MakeInputs();
+    uint64_t sum = 0;
+    while (state.KeepRunning()) {
+        for (const auto& in : inputs) {
+            sum += (arith_uint256(in.amount) * arith_uint256(in.liquidity) / arith_uint256(in.total)).GetLow64();
+        }
+    }
+    assert(sum != 0);
+}
+
+static void MulDivNative128(benchmark::State& state)
+{
+    const auto inputs = MakeInputs();
+    uint64_t sum = 0;
+    while (state.KeepRunning()) {
+        for (const auto& in : inputs) {
+            sum += MulDivLow64(in.amount, in.liquidity, in.total);
+        }
+    }
+    assert(sum != 0);
+}
+
+// Interest per block and its ceiling at high precision
+static void InterestArith256(benchmark::State& state)
+{
+    const auto inputs = MakeInputs();
+    uint64_t sum = 0;
+    while (state.KeepRunning()) {
+        for (const auto& in : inputs) {
+            const base_uint<128> perBlock = arith_uint256(in.liquidity) * int64_t{5} * int64_t{100000000} / uint32_t{1051200};
+            int64_t amount = (perBlock / base_uint<128>(SCALER)).GetLow64();
+            amount += int64_t(perBlock != base_uint<128>(amount) * SCALER);
+            sum += amount;
+        }
+    }
+    assert(sum != 0);
+}
+
+static void InterestNative128(benchmark::State& state)
+{
+    const auto inputs = MakeInputs();
+    uint64_t sum = 0;
+    while (state.KeepRunning()) {
+        for (const auto& in : inputs) {
+            const auto perBlock = MulMulDiv128(in.liquidity, 5, 100000000, 1051200);
+            sum += DivCeilLow64(perBlock, SCALER);
+        }
+    }
+    assert(sum != 0);
+}
+
+BENCHMARK(MulDivArith256, 2000);
+BENCHMARK(MulDivNative128, 20000);
+BENCHMARK(InterestArith256, 1000);
+BENCHMARK(InterestNative128, 10000);
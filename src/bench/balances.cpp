@@ -0,0 +1,128 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <chainparams.h>
+#include <dfi/masternodes.h>
+#include <dfi/mn_checks.h>
+#include <dfi/validation.h>
+#include <dfi/vault.h>
+#include <hash.h>
+#include <script/standard.h>
+#include <streams.h>
+#include <validation.h>
+
+// Collateral and loan sets of a liquidated vault, as ProcessLoanEvents splits them into auction batches
+static void LoanEventsAuctionBatches(benchmark::State& state)
+{
+    const DCT_ID dfi{0}, btc{1}, eth{2}, dusd{3}, tsla{4};
+
+    CVaultAssets vaultAssets{};
+    vaultAssets.totalCollaterals = 250000 * COIN;
+    vaultAssets.totalLoans = 200000 * COIN;
+    vaultAssets.collaterals = {{dfi, 100000 * COIN}, {btc, 100000 * COIN}, {eth, 50000 * COIN}};
+    vaultAssets.loans = {{dusd, 150000 * COIN}, {tsla, 50000 * COIN}};
+
+    const TAmounts collBalances{{dfi, 50000 * COIN}, {btc, 3 * COIN}, {eth, 20 * COIN}};
+    const TAmounts loanBalances{{dusd, 150000 * COIN}, {tsla, 200 * COIN}};
+
+    while (state.KeepRunning()) {
+        const auto batches = CollectAuctionBatches(vaultAssets, collBalances, loanBalances);
+        assert(!batches.empty());
+    }
+}
+
+// Vault collaterals and loans read from and written to storage on every vault visited by ProcessLoanEvents
+static void LoanEventsBalancesSerialize(benchmark::State& state)
+{
+    CBalances collaterals;
+    collaterals.Add({DCT_ID{0}, 50000 * COIN});
+    collaterals.Add({DCT_ID{1}, 3 * COIN});
+    collaterals.Add({DCT_ID{2}, 20 * COIN});
+
+    CDataStream stream(SER_DISK, CLIENT_VERSION);
+    while (state.KeepRunning()) {
+        stream << collaterals;
+        CBalances read;
+        stream >> read;
+        read.Add({DCT_ID{3}, COIN});
+        read.Sub({DCT_ID{0}, COIN});
+        assert(read.balances.size() == 4);
+    }
+}
+
+// Balances written with their ids in reverse order, the worst case for reading them back sorted
+static void BalancesUnserializeReversed(benchmark::State& state)
+{
+    constexpr uint32_t count = 80000;
+    CDataStream written(SER_DISK, CLIENT_VERSION);
+    WriteCompactSize(written, count);
+    for (uint32_t id = count; id > 0; --id) {
+        written << id << CAmount{COIN};
+    }
+
+    while (state.KeepRunning()) {
+        CDataStream stream(written);
+        CBalances read;
+        stream >> read;
+        assert(read.balances.size() == count);
+    }
+}
+
+// Pool rewards of one owner over 1000 blocks with custom rewards in 3 tokens changing every 10 blocks
+static constexpr uint32_t OWNER_REWARDS_BLOCKS = 1000;
+
+static void CalculateOwnerRewards(benchmark::State& state)
+{
+    BlockContext dummyContext{std::numeric_limits<uint32_t>::max(), {}, Params().GetConsensus()};
+    CCustomCSView base(*pcustomcsview);
+
+    const auto CreateToken = [&](const std::string& symbol, const uint8_t flags) {
+        CTokenImplementation token;
+        token.symbol = symbol;
+        token.creationTx = Hash(symbol.begin(), symbol.end());
+        token.flags = flags;
+        const auto res = base.CreateToken(token, dummyContext);
+        assert(res);
+        return *res.val;
+    };
+    const auto idA = CreateToken("RWDA", uint8_t(CToken::TokenFlags::Default));
+    const auto idB = CreateToken("RWDB", uint8_t(CToken::TokenFlags::Default));
+    const auto idPool = CreateToken(
+        "RWDA-RWDB", uint8_t(CToken::TokenFlags::Default) | uint8_t(CToken::TokenFlags::DAT) | uint8_t(CToken::TokenFlags::LPS));
+
+    const auto owner = GetScriptForDestination(WitnessV0KeyHash(uint160{}));
+    CPoolPair pool{};
+    pool.idTokenA = idA;
+    pool.idTokenB = idB;
+    pool.status = true;
+    auto res = base.SetPoolPair(idPool, 1, pool);
+    assert(res);
+    res = pool.AddLiquidity(1000 * COIN, 1000 * COIN, [&](const CAmount liqAmount) -> Res {
+        if (auto added = base.AddBalance(owner, {idPool, liqAmount}); !added) {
+            return added;
+        }
+        return base.SetShare(idPool, owner, 1);
+    });
+    assert(res);
+    res = base.SetPoolPair(idPool, 1, pool);
+    assert(res);
+
+    for (uint32_t height = 1; height < OWNER_REWARDS_BLOCKS; height += 10) {
+        const CBalances rewards{TAmounts{{DCT_ID{0}, COIN + height}, {idA, COIN + height}, {idB, COIN + height}}};
+        res = base.UpdatePoolPair(idPool, height, true, -1, {}, rewards);
+        assert(res);
+    }
+
+    while (state.KeepRunning()) {
+        CCustomCSView view(base);
+        const auto updated = view.CalculateOwnerRewards(owner, OWNER_REWARDS_BLOCKS);
+        assert(updated);
+    }
+}
+
+BENCHMARK(LoanEventsAuctionBatches, 100000);
+BENCHMARK(LoanEventsBalancesSerialize, 1000000);
+BENCHMARK(BalancesUnserializeReversed, 10);
+BENCHMARK(CalculateOwnerRewards, 10);
@@ -0,0 +1,82 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <consensus/merkle.h>
+#include <dfi/masternodes.h>
+#include <ffi/ffiexports.h>
+#include <key.h>
+#include <key_io.h>
+#include <rpc/blockchain.h>
+#include <validation.h>
+
+#include <univalue.h>
+
+// Block handoff to the Ocean indexer, one iteration per block: the verbose-2 JSON string
+// against the binary payload, and the payload through to the Block the indexer is given.
+static CBlock MakeOceanBlock()
+{
+    CBlock block;
+    CMutableTransaction coinbase;
+    coinbase.vin.resize(1);
+    coinbase.vin[0].scriptSig = CScript() << 1 << OP_0;
+    coinbase.vout.emplace_back(50 * COIN, CScript() << OP_TRUE);
+    block.vtx.push_back(MakeTransactionRef(coinbase));
+
+    CKey key;
+    key.MakeNewKey(true);
+    const auto pkh = GetScriptForDestination(PKHash(key.GetPubKey()));
+    const auto wpkh = GetScriptForDestination(WitnessV0KeyHash(key.GetPubKey()));
+
+    for (int i = 0; i < 200; ++i) {
+        CMutableTransaction tx;
+        tx.nVersion = CTransaction::TOKENS_MIN_VERSION;
+        tx.vin.emplace_back(COutPoint(uint256S(strprintf("%064x", i + 1)), i % 3));
+        tx.vin[0].scriptSig = CScript() << std::vector<unsigned char>(72, 0x30) << ToByteVector(key.GetPubKey());
+        tx.vout.emplace_back(i * COIN, pkh);
+        tx.vout.emplace_back(COIN / (i + 1), wpkh);
+        block.vtx.push_back(MakeTransactionRef(tx));
+    }
+    block.hashMerkleRoot = BlockMerkleRoot(block);
+    return block;
+}
+
+static void OceanBlockToJson(benchmark::State& state)
+{
+    const auto block = MakeOceanBlock();
+    const CBlockIndex* tip = WITH_LOCK(cs_main, return ::ChainActive().Tip());
+
+    while (state.KeepRunning()) {
+        const auto json = blockToJSON(*pcustomcsview, block, tip, tip, true, 2).write();
+        assert(!json.empty());
+    }
+}
+
+static void OceanBlockToPayload(benchmark::State& state)
+{
+    const auto block = MakeOceanBlock();
+    const CBlockIndex* tip = WITH_LOCK(cs_main, return ::ChainActive().Tip());
+
+    while (state.KeepRunning()) {
+        const auto payload = blockToOceanPayload(*pcustomcsview, block, tip, tip);
+        assert(!payload.empty());
+    }
+}
+
+static void OceanBlockPayloadDecode(benchmark::State& state)
+{
+    const auto block = MakeOceanBlock();
+    const CBlockIndex* tip = WITH_LOCK(cs_main, return ::ChainActive().Tip());
+
+    CrossBoundaryResult result;
+    while (state.KeepRunning()) {
+        const auto payload = blockToOceanPayload(*pcustomcsview, block, tip, tip);
+        ocean_decode_block(result, rust::Slice<const uint8_t>{payload.data(), payload.size()});
+        assert(result.ok);
+    }
+}
+
+BENCHMARK(OceanBlockToJson, 20);
+BENCHMARK(OceanBlockToPayload, 200);
+BENCHMARK(OceanBlockPayloadDecode, 50);
@@ -0,0 +1,76 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <chainparams.h>
+#include <pos_kernel.h>
+
+#include <cstring>
+
+// Kernel search of 256 masternodes over 64 coinstake times each, with a target no kernel meets so every
+// candidate gets hashed.
+static constexpr uint32_t POS_KERNEL_MASTERNODES = 256;
+static constexpr int64_t POS_KERNEL_TIMES = 64;
+static constexpr uint32_t POS_KERNEL_UNATTAINABLE_TARGET = 0x00ffffff;
+
+static std::vector<uint256> KernelMasternodes()
+{
+    std::vector<uint256> masternodes(POS_KERNEL_MASTERNODES);
+    for (uint32_t i = 0; i < POS_KERNEL_MASTERNODES; ++i) {
+        std::memcpy(masternodes[i].begin(), &i, sizeof(i));
+    }
+    return masternodes;
+}
+
+static void PosKernelSearch(benchmark::State& state)
+{
+    const auto& params = Params().GetConsensus();
+    const auto stakeModifier = uint256S("1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef");
+    const auto blockHeight = static_cast<uint64_t>(params.DF10EunosPayaHeight);
+    const auto masternodes = KernelMasternodes();
+
+    std::vector<int64_t> coinstakeTimes(POS_KERNEL_TIMES);
+    for (int64_t t = 0; t < POS_KERNEL_TIMES; ++t) {
+        coinstakeTimes[t] = 1600000000 + t;
+    }
+
+    while (state.KeepRunning()) {
+        for (const auto& masternodeID : masternodes) {
+            const pos::CKernelSearch kernel(
+                stakeModifier, POS_KERNEL_UNATTAINABLE_TARGET, 1, blockHeight, masternodeID, params, 0, 0);
+            const auto kernelTime = kernel.FindKernel(coinstakeTimes.data(), coinstakeTimes.size());
+            assert(!kernelTime);
+        }
+    }
+}
+
+// Same search one kernel hash at a time, as the staker used to do it
+static void PosKernelCheck(benchmark::State& state)
+{
+    const auto& params = Params().GetConsensus();
+    const auto stakeModifier = uint256S("1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef");
+    const auto blockHeight = static_cast<uint64_t>(params.DF10EunosPayaHeight);
+    const auto masternodes = KernelMasternodes();
+    const CheckContextState ctxState{0};
+
+    while (state.KeepRunning()) {
+        for (const auto& masternodeID : masternodes) {
+            for (int64_t t = 0; t < POS_KERNEL_TIMES; ++t) {
+                const auto found = pos::CheckKernelHash(stakeModifier,
+                                                        POS_KERNEL_UNATTAINABLE_TARGET,
+                                                        1,
+                                                        1600000000 + t,
+                                                        blockHeight,
+                                                        masternodeID,
+                                                        params,
+                                                        0,
+                                                        ctxState);
+                assert(!found);
+            }
+        }
+    }
+}
+
+BENCHMARK(PosKernelSearch, 20);
+BENCHMARK(PosKernelCheck, 20);
@@ -0,0 +1,46 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <dfi/masternodes.h>
+#include <dfi/threadpool.h>
+#include <dfi/validation.h>
+#include <script/standard.h>
+#include <validation.h>
+
+#include <cstring>
+
+// Token lock of the balances of 1M synthetic holders, one iteration per lock.
+static constexpr uint32_t TOKEN_LOCK_HOLDERS = 1000000;
+
+static void TokenLockBalances(benchmark::State& state)
+{
+    if (!DfTxTaskPool) {
+        InitDfTxGlobalTaskPool();
+    }
+
+    const DCT_ID lockedTokenId{1};
+    const CBlockIndex* tip = WITH_LOCK(cs_main, return ::ChainActive().Tip());
+    const auto contractAddress = CScript() << OP_RETURN;
+
+    CCustomCSView holders(*pcustomcsview);
+    for (uint32_t i = 0; i < TOKEN_LOCK_HOLDERS; ++i) {
+        uint160 hash;
+        std::memcpy(hash.begin(), &i, sizeof(i));
+        const auto owner = GetScriptForDestination(WitnessV0KeyHash(hash));
+        holders.AddBalance(owner, {lockedTokenId, COIN + i});
+        // Unrelated balances the scan has to skip
+        holders.AddBalance(owner, {DCT_ID{0}, COIN});
+    }
+
+    while (state.KeepRunning()) {
+        CCustomCSView view(holders);
+        CBalances totalLockedFunds;
+        const auto res =
+            LockTokenBalances(tip, view, {lockedTokenId.v}, {}, COIN / 2, contractAddress, totalLockedFunds);
+        assert(res && totalLockedFunds.balances.size() == 1);
+    }
+}
+
+BENCHMARK(TokenLockBalances, 1);
@@ -0,0 +1,47 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <dfi/masternodes.h>
+#include <dfi/threadpool.h>
+#include <dfi/validation.h>
+#include <script/standard.h>
+#include <validation.h>
+
+#include <cstring>
+
+// Balance migration of a token split over 1M synthetic holders, one iteration per split.
+static constexpr uint32_t TOKEN_SPLIT_HOLDERS = 1000000;
+
+static void TokenSplitBalances(benchmark::State& state)
+{
+    if (!DfTxTaskPool) {
+        InitDfTxGlobalTaskPool();
+    }
+
+    const DCT_ID oldTokenId{1};
+    const DCT_ID newTokenId{2};
+    const CBlockIndex* tip = WITH_LOCK(cs_main, return ::ChainActive().Tip());
+
+    CCustomCSView holders(*pcustomcsview);
+    for (uint32_t i = 0; i < TOKEN_SPLIT_HOLDERS; ++i) {
+        uint160 hash;
+        std::memcpy(hash.begin(), &i, sizeof(i));
+        const auto owner = GetScriptForDestination(WitnessV0KeyHash(hash));
+        holders.AddBalance(owner, {oldTokenId, COIN + i});
+        // Unrelated balances the scan has to skip
+        holders.AddBalance(owner, {DCT_ID{0}, COIN});
+    }
+
+    while (state.KeepRunning()) {
+        CCustomCSView view(holders);
+        CAmount totalBalance{};
+        size_t accounts{};
+        const auto res = SplitAccountBalances(
+            tip, view, oldTokenId, newTokenId, [](const CAmount amount) { return amount * 2; }, totalBalance, accounts);
+        assert(res && accounts == TOKEN_SPLIT_HOLDERS);
+    }
+}
+
+BENCHMARK(TokenSplitBalances, 1);
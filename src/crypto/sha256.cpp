@@ -5,6 +5,7 @@
 #include <crypto/sha256.h>
 #include <crypto/common.h>
 
+#include <algorithm>
 #include <assert.h>
 #include <string.h>
 #include <atomic>
@@ -29,6 +30,11 @@ namespace sha256d64_avx2
 void Transform_8way(unsigned char* out, const unsigned char* in);
 }
 
+namespace sha256_avx2
+{
+void Transform_8way(uint32_t* s, const unsigned char* chunks);
+}
+
 namespace sha256d64_shani
 {
 void Transform_2way(unsigned char* out, const unsigned char* in);
@@ -416,6 +422,7 @@ void TransformD64(unsigned char* out, const unsigned char* in)
 
 typedef void (*TransformType)(uint32_t*, const unsigned char*, size_t);
 typedef void (*TransformD64Type)(unsigned char*, const unsigned char*);
+typedef void (*TransformMultiType)(uint32_t*, const unsigned char*);
 
 template<TransformType tr>
 void TransformD64Wrapper(unsigned char* out, const unsigned char* in)
@@ -461,6 +468,7 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+TransformMultiType TransformMulti_8way = nullptr;
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -544,6 +552,21 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
+    // Test TransformMulti_8way against Transform, if available.
+    if (TransformMulti_8way) {
+        uint32_t states[64];
+        for (size_t i = 0; i < 8; ++i) {
+            std::copy(result[i], result[i] + 8, states + 8 * i);
+        }
+        TransformMulti_8way(states, data + 1);
+        for (size_t i = 0; i < 8; ++i) {
+            uint32_t state[8];
+            std::copy(result[i], result[i] + 8, state);
+            Transform(state, data + 1 + 64 * i, 1);
+            if (!std::equal(state, state + 8, states + 8 * i)) return false;
+        }
+    }
+
     return true;
 }
 
@@ -629,6 +652,7 @@ std::string SHA256AutoDetect()
 #if defined(ENABLE_AVX2) && !defined(BUILD_DEFI_INTERNAL)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformMulti_8way = sha256_avx2::Transform_8way;
         ret += ",avx2(8way)";
     }
 #endif
@@ -728,3 +752,64 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+void SHA256DShort(unsigned char* out, const unsigned char* in, size_t length, size_t count)
+{
+    assert(length <= 119);
+    // Messages of up to 55 bytes fit a single padded block, longer ones take two
+    const size_t blocks = length < 56 ? 1 : 2;
+    const size_t lanes = TransformMulti_8way ? 8 : 1;
+
+    unsigned char padded[2 * 8 * 64];  // block b of lane i at (b * 8 + i) * 64
+    unsigned char inner[8 * 64];       // padded first hash of lane i at i * 64
+    uint32_t s[8 * 8];
+
+    while (count) {
+        const size_t n = std::min(count, lanes);
+        memset(padded, 0, sizeof(padded));
+        memset(inner, 0, sizeof(inner));
+        for (size_t i = 0; i < lanes; ++i) {
+            // Lanes past the last message hash a copy of the first one, their results are dropped
+            const unsigned char* message = in + (i < n ? i : 0) * length;
+            unsigned char buffer[128] = {};
+            memcpy(buffer, message, length);
+            buffer[length] = 0x80;
+            WriteBE64(buffer + blocks * 64 - 8, uint64_t{length} << 3);
+            for (size_t b = 0; b < blocks; ++b) {
+                memcpy(padded + (b * 8 + i) * 64, buffer + b * 64, 64);
+            }
+            inner[i * 64 + 32] = 0x80;
+            inner[i * 64 + 62] = 0x01;
+            sha256::Initialize(s + 8 * i);
+        }
+
+        for (size_t b = 0; b < blocks; ++b) {
+            if (lanes == 8) {
+                TransformMulti_8way(s, padded + b * 8 * 64);
+            } else {
+                Transform(s, padded + b * 8 * 64, 1);
+            }
+        }
+        for (size_t i = 0; i < lanes; ++i) {
+            for (size_t j = 0; j < 8; ++j) {
+                WriteBE32(inner + i * 64 + 4 * j, s[8 * i + j]);
+            }
+            sha256::Initialize(s + 8 * i);
+        }
+
+        if (lanes == 8) {
+            TransformMulti_8way(s, inner);
+        } else {
+            Transform(s, inner, 1);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < 8; ++j) {
+                WriteBE32(out + i * 32 + 4 * j, s[8 * i + j]);
+            }
+        }
+
+        out += n * 32;
+        in += n * length;
+        count -= n;
+    }
+}
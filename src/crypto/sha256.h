@@ -38,4 +38,12 @@ std::string SHA256AutoDetect();
  */
 void SHA256D64(unsigned char* output, const unsigned char* input, size_t blocks);
 
+/** Compute multiple double-SHA256's of equal length messages, 8 at a time where AVX2 is available.
+ *  output:  pointer to a count*32 byte output buffer
+ *  input:   pointer to a count*length byte input buffer
+ *  length:  the length of each message, at most 119 bytes
+ *  count:   the number of hashes to compute.
+ */
+void SHA256DShort(unsigned char* output, const unsigned char* input, size_t length, size_t count);
+
 #endif // DEFI_CRYPTO_SHA256_H
@@ -321,4 +321,84 @@ void Transform_8way(unsigned char* out, const unsigned char* in)
 
 }
 
+namespace sha256_avx2 {
+namespace {
+
+using namespace sha256d64_avx2;
+
+const uint32_t ROUND_K[64] = {
+    0x428a2f98ul, 0x71374491ul, 0xb5c0fbcful, 0xe9b5dba5ul, 0x3956c25bul, 0x59f111f1ul, 0x923f82a4ul, 0xab1c5ed5ul,
+    0xd807aa98ul, 0x12835b01ul, 0x243185beul, 0x550c7dc3ul, 0x72be5d74ul, 0x80deb1feul, 0x9bdc06a7ul, 0xc19bf174ul,
+    0xe49b69c1ul, 0xefbe4786ul, 0x0fc19dc6ul, 0x240ca1ccul, 0x2de92c6ful, 0x4a7484aaul, 0x5cb0a9dcul, 0x76f988daul,
+    0x983e5152ul, 0xa831c66dul, 0xb00327c8ul, 0xbf597fc7ul, 0xc6e00bf3ul, 0xd5a79147ul, 0x06ca6351ul, 0x14292967ul,
+    0x27b70a85ul, 0x2e1b2138ul, 0x4d2c6dfcul, 0x53380d13ul, 0x650a7354ul, 0x766a0abbul, 0x81c2c92eul, 0x92722c85ul,
+    0xa2bfe8a1ul, 0xa81a664bul, 0xc24b8b70ul, 0xc76c51a3ul, 0xd192e819ul, 0xd6990624ul, 0xf40e3585ul, 0x106aa070ul,
+    0x19a4c116ul, 0x1e376c08ul, 0x2748774cul, 0x34b0bcb5ul, 0x391c0cb3ul, 0x4ed8aa4aul, 0x5b9cca4ful, 0x682e6ff3ul,
+    0x748f82eeul, 0x78a5636ful, 0x84c87814ul, 0x8cc70208ul, 0x90befffaul, 0xa4506cebul, 0xbef9a3f7ul, 0xc67178f2ul,
+};
+
+/** Word i of the 8 states, in the same lane order Read8 uses for the 8 chunks. */
+__m256i inline LoadState8(const uint32_t* s, int i) {
+    return _mm256_set_epi32(s[i], s[8 + i], s[16 + i], s[24 + i], s[32 + i], s[40 + i], s[48 + i], s[56 + i]);
+}
+
+void inline StoreState8(uint32_t* s, int i, __m256i v) {
+    s[i] = _mm256_extract_epi32(v, 7);
+    s[8 + i] = _mm256_extract_epi32(v, 6);
+    s[16 + i] = _mm256_extract_epi32(v, 5);
+    s[24 + i] = _mm256_extract_epi32(v, 4);
+    s[32 + i] = _mm256_extract_epi32(v, 3);
+    s[40 + i] = _mm256_extract_epi32(v, 2);
+    s[48 + i] = _mm256_extract_epi32(v, 1);
+    s[56 + i] = _mm256_extract_epi32(v, 0);
+}
+
+}
+
+/** Compress one 64-byte chunk into each of 8 independent states.
+ *  s:      8 consecutive states of 8 words
+ *  chunks: 8 consecutive 64-byte chunks, chunk i goes into state i
+ */
+void Transform_8way(uint32_t* s, const unsigned char* chunks)
+{
+    __m256i w[16];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = Read8(chunks, 4 * i);
+    }
+
+    __m256i v[8];
+    for (int i = 0; i < 8; ++i) {
+        v[i] = LoadState8(s, i);
+    }
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+
+    for (int i = 0; i < 64; ++i) {
+        if (i >= 16) {
+            Inc(w[i & 15], sigma1(w[(i - 2) & 15]), w[(i - 7) & 15], sigma0(w[(i - 15) & 15]));
+        }
+        Round(a, b, c, d, e, f, g, h, Add(K(ROUND_K[i]), w[i & 15]));
+        // Rotate the working variables instead of unrolling the rounds
+        const __m256i t = h;
+        h = g;
+        g = f;
+        f = e;
+        e = d;
+        d = c;
+        c = b;
+        b = a;
+        a = t;
+    }
+
+    StoreState8(s, 0, Add(v[0], a));
+    StoreState8(s, 1, Add(v[1], b));
+    StoreState8(s, 2, Add(v[2], c));
+    StoreState8(s, 3, Add(v[3], d));
+    StoreState8(s, 4, Add(v[4], e));
+    StoreState8(s, 5, Add(v[5], f));
+    StoreState8(s, 6, Add(v[6], g));
+    StoreState8(s, 7, Add(v[7], h));
+}
+
+}
+
 #endif
@@ -8,6 +8,8 @@
 #include <dfi/vaulthistory.h>
 #include <key_io.h>
 
+#include <algorithm>
+
 static AccountHistoryKeyNew Convert(const AccountHistoryKey &key) {
     return {key.blockHeight, key.owner, key.txn};
 }
@@ -57,6 +59,223 @@ void CAccountsHistoryView::ForEachAccountHistory(
         {height, owner, txn});
 }
 
+void CAccountsHistoryView::SetSecondaryIndexes(bool enable) {
+    secondaryIndexes = enable;
+    if (enable == HasSecondaryIndexes()) {
+        return;
+    }
+
+    auto startTime = GetTimeMillis();
+
+    if (enable) {
+        LogPrintf("Adding account history token, type and count indexes in progress...\n");
+        AccountHistoryKey startKey{{}, ~0u, ~0u};
+        auto it = LowerBound<ByAccountHistoryKey>(startKey);
+        for (; it.Valid(); it.Next()) {
+            const auto value = it.Value().as<AccountHistoryValue>();
+            WriteSecondaryIndexes(it.Key(), value);
+            ++pendingCounts[{it.Key().owner, value.category}];
+        }
+        Write(SecondaryIndexes::prefix(), true);
+    } else {
+        LogPrintf("Removing account history token, type and count indexes...\n");
+        EraseSecondaryIndexes();
+        Erase(SecondaryIndexes::prefix());
+    }
+
+    Flush();
+
+    LogPrint(BCLog::BENCH, "    - Account history secondary indexes took: %dms\n", GetTimeMillis() - startTime);
+}
+
+bool CAccountsHistoryView::HasSecondaryIndexes() const {
+    return Exists(SecondaryIndexes::prefix());
+}
+
+void CAccountsHistoryView::WriteSecondaryIndexes(const AccountHistoryKey &key, const AccountHistoryValue &value) {
+    const auto newKey = Convert(key);
+    for (const auto &[tokenId, amount] : value.diff) {
+        WriteBy<ByAccountHistoryToken>(AccountHistoryTokenKey{tokenId, newKey}, '\0');
+    }
+    WriteBy<ByAccountHistoryType>(AccountHistoryTypeKey{value.category, newKey}, '\0');
+}
+
+void CAccountsHistoryView::EraseSecondaryIndexes(const AccountHistoryKey &key, const AccountHistoryValue &value) {
+    const auto newKey = Convert(key);
+    for (const auto &[tokenId, amount] : value.diff) {
+        EraseBy<ByAccountHistoryToken>(AccountHistoryTokenKey{tokenId, newKey});
+    }
+    EraseBy<ByAccountHistoryType>(AccountHistoryTypeKey{value.category, newKey});
+}
+
+void CAccountsHistoryView::EraseSecondaryIndexes() {
+    const AccountHistoryKeyNew anyNewKey{~0u, {}, ~0u};
+
+    std::vector<AccountHistoryTokenKey> tokenKeys;
+    auto tokenIt = LowerBound<ByAccountHistoryToken>(AccountHistoryTokenKey{DCT_ID{0}, anyNewKey});
+    for (; tokenIt.Valid(); tokenIt.Next()) {
+        tokenKeys.push_back(tokenIt.Key());
+    }
+    for (const auto &key : tokenKeys) {
+        EraseBy<ByAccountHistoryToken>(key);
+    }
+
+    std::vector<AccountHistoryTypeKey> typeKeys;
+    auto typeIt = LowerBound<ByAccountHistoryType>(AccountHistoryTypeKey{0, anyNewKey});
+    for (; typeIt.Valid(); typeIt.Next()) {
+        typeKeys.push_back(typeIt.Key());
+    }
+    for (const auto &key : typeKeys) {
+        EraseBy<ByAccountHistoryType>(key);
+    }
+
+    std::vector<std::pair<CScript, unsigned char>> ownerCountKeys;
+    auto ownerCountIt = LowerBound<ByOwnerTypeCount>(std::make_pair(CScript{}, static_cast<unsigned char>(0)));
+    for (; ownerCountIt.Valid(); ownerCountIt.Next()) {
+        ownerCountKeys.push_back(ownerCountIt.Key());
+    }
+    for (const auto &key : ownerCountKeys) {
+        EraseBy<ByOwnerTypeCount>(key);
+    }
+
+    std::vector<unsigned char> countKeys;
+    auto countIt = LowerBound<ByTypeCount>(static_cast<unsigned char>(0));
+    for (; countIt.Valid(); countIt.Next()) {
+        countKeys.push_back(countIt.Key());
+    }
+    for (const auto &key : countKeys) {
+        EraseBy<ByTypeCount>(key);
+    }
+}
+
+std::optional<AccountHistoryValue> CAccountsHistoryView::GetRecord(const AccountHistoryKey &key) const {
+    if (auto it = pendingRecords.find(DbTypeToBytes(key)); it != pendingRecords.end()) {
+        return it->second;
+    }
+    return ReadAccountHistory(key);
+}
+
+void CAccountsHistoryView::IndexRecord(const AccountHistoryKey &key, const std::optional<AccountHistoryValue> &value) {
+    // a record can be overwritten within a block, the rows of its previous tokens and type go first
+    if (auto previous = GetRecord(key)) {
+        EraseSecondaryIndexes(key, *previous);
+        --pendingCounts[{key.owner, previous->category}];
+    }
+    if (value) {
+        WriteSecondaryIndexes(key, *value);
+        ++pendingCounts[{key.owner, value->category}];
+    }
+    pendingRecords[DbTypeToBytes(key)] = value;
+}
+
+bool CAccountsHistoryView::Flush() {
+    std::map<unsigned char, int64_t> typeCounts;
+    for (const auto &[key, diff] : pendingCounts) {
+        if (diff == 0) {
+            continue;
+        }
+        const auto count = static_cast<int64_t>(ReadBy<ByOwnerTypeCount, uint64_t>(key).value_or(0)) + diff;
+        if (count > 0) {
+            WriteBy<ByOwnerTypeCount>(key, static_cast<uint64_t>(count));
+        } else {
+            EraseBy<ByOwnerTypeCount>(key);
+        }
+        typeCounts[key.second] += diff;
+    }
+    for (const auto &[category, diff] : typeCounts) {
+        const auto count = static_cast<int64_t>(ReadBy<ByTypeCount, uint64_t>(category).value_or(0)) + diff;
+        if (count > 0) {
+            WriteBy<ByTypeCount>(category, static_cast<uint64_t>(count));
+        } else {
+            EraseBy<ByTypeCount>(category);
+        }
+    }
+    pendingCounts.clear();
+    pendingRecords.clear();
+
+    return CStorageView::Flush();
+}
+
+void CAccountsHistoryView::ForEachAccountHistoryCount(std::function<bool(unsigned char, uint64_t)> callback,
+                                                      const CScript &owner) {
+    if (owner.empty()) {
+        ForEach<ByTypeCount, unsigned char, uint64_t>(
+            [&](const unsigned char &category, uint64_t count) { return callback(category, count); });
+        return;
+    }
+
+    ForEach<ByOwnerTypeCount, std::pair<CScript, unsigned char>, uint64_t>(
+        [&](const std::pair<CScript, unsigned char> &key, uint64_t count) {
+            if (key.first != owner) {
+                return false;
+            }
+            return callback(key.second, count);
+        },
+        std::make_pair(owner, static_cast<unsigned char>(0)));
+}
+
+void CAccountsHistoryView::ForEachAccountHistoryByToken(
+    std::function<bool(const AccountHistoryKey &, AccountHistoryValue)> callback,
+    DCT_ID tokenId,
+    const CScript &owner,
+    uint32_t height,
+    uint32_t txn) {
+    ForEach<ByAccountHistoryToken, AccountHistoryTokenKey, char>(
+        [&](const AccountHistoryTokenKey &indexKey, char) {
+            if (indexKey.tokenId != tokenId) {
+                return false;
+            }
+            if (!owner.empty() && indexKey.key.owner != owner) {
+                return true;
+            }
+            auto key = Convert(indexKey.key);
+            auto value = ReadAccountHistory(key);
+            assert(value);
+            return callback(key, *value);
+        },
+        {tokenId, {height, owner, txn}});
+}
+
+void CAccountsHistoryView::ForEachAccountHistoryByType(
+    std::function<bool(const AccountHistoryKey &, AccountHistoryValue)> callback,
+    const std::set<unsigned char> &categories,
+    const CScript &owner,
+    uint32_t height,
+    uint32_t txn) {
+    using TypeIterator = CStorageIteratorWrapper<ByAccountHistoryType, AccountHistoryTypeKey>;
+
+    std::vector<TypeIterator> iterators;
+    for (const auto category : categories) {
+        auto it = LowerBound<ByAccountHistoryType>(AccountHistoryTypeKey{category, {height, owner, txn}});
+        if (it.Valid() && it.Key().category == category) {
+            iterators.push_back(std::move(it));
+        }
+    }
+
+    // merge the per type ranges back into ByAccountHistoryKeyNew order
+    while (!iterators.empty()) {
+        auto next = std::min_element(iterators.begin(), iterators.end(), [](TypeIterator &a, TypeIterator &b) {
+            return DbTypeToBytes(a.Key().key) < DbTypeToBytes(b.Key().key);
+        });
+
+        const auto indexKey = next->Key();
+        next->Next();
+        if (!next->Valid() || next->Key().category != indexKey.category) {
+            iterators.erase(next);
+        }
+
+        if (!owner.empty() && indexKey.key.owner != owner) {
+            continue;
+        }
+        auto key = Convert(indexKey.key);
+        auto value = ReadAccountHistory(key);
+        assert(value);
+        if (!callback(key, *value)) {
+            return;
+        }
+    }
+}
+
 std::optional<AccountHistoryValue> CAccountsHistoryView::ReadAccountHistory(const AccountHistoryKey &key) const {
     return ReadBy<ByAccountHistoryKey, AccountHistoryValue>(key);
 }
@@ -64,9 +283,15 @@ std::optional<AccountHistoryValue> CAccountsHistoryView::ReadAccountHistory(cons
 void CAccountsHistoryView::WriteAccountHistory(const AccountHistoryKey &key, const AccountHistoryValue &value) {
     WriteBy<ByAccountHistoryKey>(key, value);
     WriteBy<ByAccountHistoryKeyNew>(Convert(key), '\0');
+    if (secondaryIndexes) {
+        IndexRecord(key, value);
+    }
 }
 
 Res CAccountsHistoryView::EraseAccountHistory(const AccountHistoryKey &key) {
+    if (secondaryIndexes) {
+        IndexRecord(key, {});
+    }
     EraseBy<ByAccountHistoryKey>(key);
     EraseBy<ByAccountHistoryKeyNew>(Convert(key));
     return Res::Ok();
@@ -96,6 +321,39 @@ CAccountHistoryStorage::CAccountHistoryStorage(std::shared_ptr<CDBWrapper> &db,
 CBurnHistoryStorage::CBurnHistoryStorage(const fs::path &dbName, std::size_t cacheSize, bool fMemory, bool fWipe)
     : CStorageView(new CStorageLevelDB(dbName, cacheSize, fMemory, fWipe)) {}
 
+CBurnInfo CBurnHistoryStorage::GetBlockBurnInfo(uint32_t height) {
+    CBurnInfo result;
+    ForEachAccountHistory(
+        [&](const AccountHistoryKey &key, const AccountHistoryValue &value) {
+            if (key.blockHeight != height) {
+                return false;
+            }
+            result.AddHistory(value.category, value.diff);
+            return true;
+        },
+        {},
+        height);
+    return result;
+}
+
+void CBurnHistoryStorage::ForEachBlockBurnInfo(std::function<void(uint32_t, const CBurnInfo &)> callback) {
+    std::optional<std::pair<uint32_t, CBurnInfo>> block;
+    ForEachAccountHistory([&](const AccountHistoryKey &key, const AccountHistoryValue &value) {
+        if (block && block->first != key.blockHeight) {
+            callback(block->first, block->second);
+            block.reset();
+        }
+        if (!block) {
+            block.emplace(key.blockHeight, CBurnInfo{});
+        }
+        block->second.AddHistory(value.category, value.diff);
+        return true;
+    });
+    if (block) {
+        callback(block->first, block->second);
+    }
+}
+
 CAccountsHistoryWriter::CAccountsHistoryWriter(CCustomCSView &storage,
                                                uint32_t height,
                                                uint32_t txn,
@@ -30,6 +30,26 @@ public:
                                uint32_t height = std::numeric_limits<uint32_t>::max(),
                                uint32_t txn = std::numeric_limits<uint32_t>::max());
 
+    bool Flush() override;
+
+    // Secondary indexes by token and by transaction type and the record counters, off unless enabled
+    void SetSecondaryIndexes(bool enable);
+    [[nodiscard]] bool HasSecondaryIndexes() const;
+    // Records of the token (and owner if not empty) in ForEachAccountHistory order
+    void ForEachAccountHistoryByToken(std::function<bool(const AccountHistoryKey &, AccountHistoryValue)> callback,
+                                      DCT_ID tokenId,
+                                      const CScript &owner = {},
+                                      uint32_t height = std::numeric_limits<uint32_t>::max(),
+                                      uint32_t txn = std::numeric_limits<uint32_t>::max());
+    // Records of any of the categories (and owner if not empty) in ForEachAccountHistory order
+    void ForEachAccountHistoryByType(std::function<bool(const AccountHistoryKey &, AccountHistoryValue)> callback,
+                                     const std::set<unsigned char> &categories,
+                                     const CScript &owner = {},
+                                     uint32_t height = std::numeric_limits<uint32_t>::max(),
+                                     uint32_t txn = std::numeric_limits<uint32_t>::max());
+    // Record count per category of the owner, or of all owners if empty, as of the last Flush
+    void ForEachAccountHistoryCount(std::function<bool(unsigned char, uint64_t)> callback, const CScript &owner = {});
+
     // tags
     struct ByAccountHistoryKey {
         static constexpr uint8_t prefix() { return 'h'; }
@@ -37,6 +57,33 @@ public:
     struct ByAccountHistoryKeyNew {
         static constexpr uint8_t prefix() { return 'H'; }
     };
+    struct ByAccountHistoryToken {
+        static constexpr uint8_t prefix() { return 'k'; }
+    };
+    struct ByAccountHistoryType {
+        static constexpr uint8_t prefix() { return 'y'; }
+    };
+    struct ByOwnerTypeCount {
+        static constexpr uint8_t prefix() { return 'c'; }
+    };
+    struct ByTypeCount {
+        static constexpr uint8_t prefix() { return 'C'; }
+    };
+    struct SecondaryIndexes {
+        static constexpr uint8_t prefix() { return 'f'; }
+    };
+
+private:
+    void WriteSecondaryIndexes(const AccountHistoryKey &key, const AccountHistoryValue &value);
+    void EraseSecondaryIndexes(const AccountHistoryKey &key, const AccountHistoryValue &value);
+    void EraseSecondaryIndexes();
+    // LevelDB batch is not readable, so records and counters written since the last Flush are tracked here
+    std::optional<AccountHistoryValue> GetRecord(const AccountHistoryKey &key) const;
+    void IndexRecord(const AccountHistoryKey &key, const std::optional<AccountHistoryValue> &value);
+
+    bool secondaryIndexes{};
+    std::map<TBytes, std::optional<AccountHistoryValue>> pendingRecords;
+    std::map<std::pair<CScript, unsigned char>, int64_t> pendingCounts;
 };
 
 class CAccountHistoryStorage : public CAccountsHistoryView, public CAuctionHistoryView {
@@ -52,6 +99,11 @@ public:
 class CBurnHistoryStorage : public CAccountsHistoryView {
 public:
     CBurnHistoryStorage(const fs::path &dbName, std::size_t cacheSize, bool fMemory = false, bool fWipe = false);
+
+    // Burns of a block, its history has to be flushed
+    CBurnInfo GetBlockBurnInfo(uint32_t height);
+    // Burns of every block in the history, from the highest block down
+    void ForEachBlockBurnInfo(std::function<void(uint32_t, const CBurnInfo &)> callback);
 };
 
 class CAccountsHistoryWriter : public CCustomCSView {
@@ -78,6 +130,7 @@ extern std::unique_ptr<CAccountHistoryStorage> paccountHistoryDB;
 extern std::unique_ptr<CBurnHistoryStorage> pburnHistoryDB;
 
 static constexpr bool DEFAULT_ACINDEX = true;
+static constexpr bool DEFAULT_ACINDEX_FILTERS = false;
 static constexpr bool DEFAULT_SNAPSHOT = true;
 
 #endif  // DEFI_DFI_ACCOUNTSHISTORY_H
@@ -7,6 +7,8 @@
 #include <chainparams.h>
 #include <consensus/validation.h>
 #include <dfi/masternodes.h>
+#include <dfi/threadpool.h>
+#include <hash.h>
 #include <key.h>
 #include <logging.h>
 #include <script/standard.h>
@@ -14,6 +16,7 @@
 #include <streams.h>
 #include <timedata.h>
 #include <util/system.h>
+#include <util/time.h>
 #include <util/validation.h>
 #include <validation.h>
 
@@ -24,11 +27,108 @@
 std::unique_ptr<CAnchorAuthIndex> panchorauths;
 std::unique_ptr<CAnchorIndex> panchors;
 std::unique_ptr<CAnchorAwaitingConfirms> panchorAwaitingConfirms;
+CAnchorSignerCache g_anchorSignerCache;
 
 static const char DB_ANCHORS = 'A';
 static const char DB_PENDING = 'p';
 static const char DB_BITCOININDEX = 'Z';  // Bitcoin height to blockhash table
 
+// Cached signers, the cache is dropped when full. Team messages of a few anchors fit many times over.
+static constexpr size_t MAX_ANCHOR_SIGNER_CACHE = 100000;
+// Signatures recovered per worker, below two workers' worth the batch is recovered on the calling thread
+static constexpr size_t ANCHOR_SIGS_PER_WORKER = 8;
+
+std::vector<std::optional<CPubKey>> CAnchorSignerCache::Recover(
+    const std::vector<std::pair<uint256, Signature>> &sigs) {
+    std::vector<std::optional<CPubKey>> result(sigs.size());
+    std::vector<uint256> keys(sigs.size());
+    std::vector<size_t> missing;
+
+    for (size_t i = 0; i < sigs.size(); ++i) {
+        CHashWriter ss(SER_GETHASH, 0);
+        ss << sigs[i].first << sigs[i].second;
+        keys[i] = ss.GetHash();
+    }
+
+    {
+        std::unique_lock lock{cs};
+        for (size_t i = 0; i < sigs.size(); ++i) {
+            if (const auto it = signers.find(keys[i]); it != signers.end()) {
+                result[i] = it->second;
+            } else {
+                missing.push_back(i);
+            }
+        }
+        stats.cacheHits += sigs.size() - missing.size();
+    }
+
+    if (missing.empty()) {
+        return result;
+    }
+
+    const auto recover = [&](const size_t i) {
+        CPubKey pubKey;
+        const auto &[sigHash, sig] = sigs[i];
+        if (!sig.empty() && pubKey.RecoverCompact(sigHash, sig)) {
+            result[i] = pubKey;
+        }
+    };
+
+    const auto workers =
+        DfTxTaskPool ? std::min(DfTxTaskPool->GetAvailableThreads(), missing.size() / ANCHOR_SIGS_PER_WORKER) : 0;
+    if (workers < 2) {
+        for (const auto i : missing) {
+            recover(i);
+        }
+    } else {
+        TaskGroup g;
+        for (size_t worker = 0; worker < workers; ++worker) {
+            g.AddTask();
+            boost::asio::post(DfTxTaskPool->pool, [&, worker] {
+                for (auto j = worker; j < missing.size(); j += workers) {
+                    recover(missing[j]);
+                }
+                g.RemoveTask();
+            });
+        }
+        g.WaitForCompletion();
+    }
+
+    std::unique_lock lock{cs};
+    if (signers.size() + missing.size() > MAX_ANCHOR_SIGNER_CACHE) {
+        signers.clear();
+    }
+    for (const auto i : missing) {
+        signers.emplace(keys[i], result[i]);
+    }
+    stats.recovered += missing.size();
+
+    return result;
+}
+
+std::optional<CPubKey> CAnchorSignerCache::Recover(const uint256 &sigHash, const Signature &sig) {
+    return Recover({{sigHash, sig}}).front();
+}
+
+void CAnchorSignerCache::RecordAuth(int64_t micros) {
+    std::unique_lock lock{cs};
+    ++stats.auths;
+    stats.authMicros += micros;
+    stats.authMaxMicros = std::max(stats.authMaxMicros, micros);
+}
+
+void CAnchorSignerCache::RecordAnchor(int64_t micros) {
+    std::unique_lock lock{cs};
+    ++stats.anchors;
+    stats.anchorMicros += micros;
+    stats.anchorMaxMicros = std::max(stats.anchorMaxMicros, micros);
+}
+
+CAnchorAuthStats CAnchorSignerCache::GetStats() {
+    std::unique_lock lock{cs};
+    return stats;
+}
+
 uint256 CAnchorData::GetSignHash() const {
     CDataStream ss{SER_GETHASH, PROTOCOL_VERSION};
     ss << previousAnchor << height << blockHash << nextTeam;  // << salt_;
@@ -53,12 +153,16 @@ bool CAnchorAuthMessage::SignWithKey(const CKey &key) {
 }
 
 bool CAnchorAuthMessage::GetPubKey(CPubKey &pubKey) const {
-    return !signature.empty() && pubKey.RecoverCompact(GetSignHash(), signature);
+    const auto signer = g_anchorSignerCache.Recover(GetSignHash(), signature);
+    if (signer) {
+        pubKey = *signer;
+    }
+    return signer.has_value();
 }
 
 CKeyID CAnchorAuthMessage::GetSigner() const {
-    CPubKey pubKey;
-    return (!signature.empty() && pubKey.RecoverCompact(GetSignHash(), signature)) ? pubKey.GetID() : CKeyID{};
+    const auto signer = g_anchorSignerCache.Recover(GetSignHash(), signature);
+    return signer ? signer->GetID() : CKeyID{};
 }
 
 CAnchor CAnchor::Create(const std::vector<CAnchorAuthMessage> &auths, const CTxDestination &rewardDest) {
@@ -524,6 +628,19 @@ int CAnchorIndex::GetAnchorConfirmations(const CAnchorIndex::AnchorRec *rec) con
 void CAnchorIndex::CheckPendingAnchors() {
     uint32_t height = spv::pspv ? spv::pspv->GetLastBlockHeight() : 0;
 
+    // Recover the signers of all pending anchors at once and outside cs_main, the checks below hit the cache
+    std::vector<std::pair<uint256, CAnchorSignerCache::Signature>> pendingSigs;
+    {
+        LOCK(cs_main);
+        ForEachPending([&pendingSigs](const uint256 &, AnchorRec &rec) {
+            const auto sigHash = rec.anchor.GetSignHash();
+            for (const auto &sig : rec.anchor.sigs) {
+                pendingSigs.emplace_back(sigHash, sig);
+            }
+        });
+    }
+    g_anchorSignerCache.Recover(pendingSigs);
+
     LOCK(cs_main);
 
     spv::PendingSet anchorsPending(spv::PendingOrder);
@@ -574,7 +691,10 @@ void CAnchorIndex::CheckPendingAnchors() {
         }
 
         // Validate the anchor sigs
-        if (!rec.anchor.CheckAuthSigs(*anchorTeam)) {
+        const auto checkStart = GetTimeMicros();
+        const auto validSigs = rec.anchor.CheckAuthSigs(*anchorTeam);
+        g_anchorSignerCache.RecordAnchor(GetTimeMicros() - checkStart);
+        if (!validSigs) {
             LogPrint(
                 BCLog::ANCHORING, "Signature validation fails. Deleting anchor txHash %s\n", rec.txHash.ToString());
             deletePending.insert(rec.txHash);
@@ -966,8 +1086,8 @@ uint256 CAnchorConfirmMessage::GetHash() const {
 }
 
 CKeyID CAnchorConfirmMessage::GetSigner() const {
-    CPubKey pubKey;
-    return (!signature.empty() && pubKey.RecoverCompact(GetSignHash(), signature)) ? pubKey.GetID() : CKeyID{};
+    const auto signer = g_anchorSignerCache.Recover(GetSignHash(), signature);
+    return signer ? signer->GetID() : CKeyID{};
 }
 
 bool CAnchorFinalizationMessage::CheckConfirmSigs() {
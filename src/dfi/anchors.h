@@ -10,9 +10,12 @@
 #include <script/standard.h>
 #include <serialize.h>
 #include <shutdown.h>
+#include <sync.h>
 #include <uint256.h>
 
 #include <functional>
+#include <map>
+#include <optional>
 #include <vector>
 
 #include <boost/multi_index/composite_key.hpp>
@@ -459,16 +462,57 @@ public:
     void ForEachConfirm(std::function<void(const Confirm &)> callback) const;
 };
 
+struct CAnchorAuthStats {
+    uint64_t auths{};          // anchor auth messages processed
+    int64_t authMicros{};      // total and slowest time spent on one, including the cs_main wait
+    int64_t authMaxMicros{};
+    uint64_t anchors{};        // anchor signature sets checked
+    int64_t anchorMicros{};    // total and slowest time spent on one
+    int64_t anchorMaxMicros{};
+    uint64_t recovered{};      // signers recovered from signatures
+    uint64_t cacheHits{};      // signers found in the cache
+};
+
+/**
+ * Signers recovered from anchor auth, anchor and confirm signatures, cached by the hash of the signed hash
+ * and the signature. Batches are recovered on DfTxTaskPool. Callers recover outside cs_main first, so that
+ * the checks under cs_main are cache hits.
+ */
+class CAnchorSignerCache {
+public:
+    using Signature = std::vector<unsigned char>;
+
+    // Signer of each signature over its hash, null where recovery fails
+    std::vector<std::optional<CPubKey>> Recover(const std::vector<std::pair<uint256, Signature>> &sigs);
+    std::optional<CPubKey> Recover(const uint256 &sigHash, const Signature &sig);
+
+    void RecordAuth(int64_t micros);
+    void RecordAnchor(int64_t micros);
+    CAnchorAuthStats GetStats();
+
+private:
+    AtomicMutex cs;
+    std::map<uint256, std::optional<CPubKey>> signers;
+    CAnchorAuthStats stats;
+};
+
+extern CAnchorSignerCache g_anchorSignerCache;
+
 template <typename TContainer>
 size_t CheckSigs(const uint256 &sigHash, const TContainer &sigs, const std::set<CKeyID> &keys) {
-    std::set<CPubKey> uniqueKeys;
+    std::vector<std::pair<uint256, CAnchorSignerCache::Signature>> hashSigs;
+    hashSigs.reserve(sigs.size());
     for (const auto &sig : sigs) {
-        CPubKey pubkey;
-        if (!pubkey.RecoverCompact(sigHash, sig) || keys.find(pubkey.GetID()) == keys.end()) {
+        hashSigs.emplace_back(sigHash, sig);
+    }
+
+    std::set<CPubKey> uniqueKeys;
+    for (const auto &pubkey : g_anchorSignerCache.Recover(hashSigs)) {
+        if (!pubkey || keys.find(pubkey->GetID()) == keys.end()) {
             return false;
         }
 
-        uniqueKeys.insert(pubkey);
+        uniqueKeys.insert(*pubkey);
     }
     return uniqueKeys.size();
 }
@@ -10,6 +10,32 @@
 #include <serialize.h>
 #include <cstdint>
 
+// Balances are stored as a map of uint32_t token ids to amounts, unlike TAmounts with its varint ids
+template <typename Stream>
+void SerializeAmounts(Stream &s, const TAmounts &amounts) {
+    WriteCompactSize(s, amounts.size());
+    for (const auto &[tokenId, amount] : amounts) {
+        ::Serialize(s, tokenId.v);
+        ::Serialize(s, amount);
+    }
+}
+
+template <typename Stream>
+void UnserializeAmounts(Stream &s, TAmounts &amounts) {
+    amounts.clear();
+    auto seq = amounts.extract_sequence();
+    const auto size = ReadCompactSize(s);
+    for (uint64_t i = 0; i < size; ++i) {
+        uint32_t tokenId;
+        CAmount amount;
+        ::Unserialize(s, tokenId);
+        ::Unserialize(s, amount);
+        seq.emplace_back(DCT_ID{tokenId}, amount);
+    }
+    // Keeps the first of duplicate ids, like the map it used to be read into
+    AdoptFlatMapSequence(amounts, std::move(seq));
+}
+
 struct CBalances {
     TAmounts balances;
 
@@ -128,28 +154,19 @@ struct CBalances {
         return false;
     }
 
-    ADD_SERIALIZE_METHODS;
+    template <typename Stream>
+    void Serialize(Stream &s) const {
+        SerializeAmounts(s, balances);
+    }
 
-    template <typename Stream, typename Operation>
-    inline void SerializationOp(Stream &s, Operation ser_action) {
-        static_assert(std::is_same<decltype(balances), std::map<DCT_ID, CAmount>>::value, "Following code is invalid");
-        std::map<uint32_t, CAmount> serializedBalances;
-        if (ser_action.ForRead()) {
-            READWRITE(serializedBalances);
-            balances.clear();
-            // check that no zero values are written
-            for (auto it = serializedBalances.begin(); it != serializedBalances.end(); /* advance */) {
-                if (it->second == 0) {
-                    throw std::ios_base::failure("non-canonical balances (zero amount)");
-                }
-                balances.emplace(DCT_ID{it->first}, it->second);
-                serializedBalances.erase(it++);
+    template <typename Stream>
+    void Unserialize(Stream &s) {
+        UnserializeAmounts(s, balances);
+        // check that no zero values are written
+        for (const auto &[tokenId, amount] : balances) {
+            if (amount == 0) {
+                throw std::ios_base::failure("non-canonical balances (zero amount)");
             }
-        } else {
-            for (const auto &it : balances) {
-                serializedBalances.emplace(it.first.v, it.second);
-            }
-            READWRITE(serializedBalances);
         }
     }
 };
@@ -240,25 +257,14 @@ struct CStatsTokenBalances {
         return false;
     }
 
-    ADD_SERIALIZE_METHODS;
+    template <typename Stream>
+    void Serialize(Stream &s) const {
+        SerializeAmounts(s, balances);
+    }
 
-    template <typename Stream, typename Operation>
-    inline void SerializationOp(Stream &s, Operation ser_action) {
-        static_assert(std::is_same<decltype(balances), std::map<DCT_ID, CAmount>>::value, "Following code is invalid");
-        std::map<uint32_t, CAmount> serializedBalances;
-        if (ser_action.ForRead()) {
-            READWRITE(serializedBalances);
-            balances.clear();
-            for (auto it = serializedBalances.begin(); it != serializedBalances.end(); /* advance */) {
-                balances.emplace(DCT_ID{it->first}, it->second);
-                serializedBalances.erase(it++);
-            }
-        } else {
-            for (const auto &it : balances) {
-                serializedBalances.emplace(it.first.v, it.second);
-            }
-            READWRITE(serializedBalances);
-        }
+    template <typename Stream>
+    void Unserialize(Stream &s) {
+        UnserializeAmounts(s, balances);
     }
 };
 
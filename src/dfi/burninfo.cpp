@@ -0,0 +1,111 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <dfi/burninfo.h>
+#include <dfi/customtx.h>
+
+static void AddBalances(CBalances &balances, const TAmounts &amounts) {
+    // Negative or overflowing amounts are skipped per token
+    for (const auto &[id, amount] : amounts) {
+        balances.Add({id, amount});
+    }
+}
+
+void CBurnInfo::AddHistory(uint8_t category, const TAmounts &diff) {
+    // UTXO burn
+    if (category == uint8_t(CustomTxType::None)) {
+        for (const auto &[id, amount] : diff) {
+            burntDFI += amount;
+        }
+        return;
+    }
+
+    // Fee burn
+    if (category == uint8_t(CustomTxType::CreateMasternode) || category == uint8_t(CustomTxType::CreateToken) ||
+        category == uint8_t(CustomTxType::Vault) || category == uint8_t(CustomTxType::CreateCfp) ||
+        category == uint8_t(CustomTxType::CreateVoc)) {
+        for (const auto &[id, amount] : diff) {
+            burntFee += amount;
+        }
+        return;
+    }
+
+    // withdraw burn
+    if (category == uint8_t(CustomTxType::PaybackLoan) || category == uint8_t(CustomTxType::PaybackLoanV2) ||
+        category == uint8_t(CustomTxType::PaybackWithCollateral)) {
+        AddBalances(paybackFee, diff);
+        return;
+    }
+
+    // auction burn
+    if (category == uint8_t(CustomTxType::AuctionBid)) {
+        for (const auto &[id, amount] : diff) {
+            auctionFee += amount;
+        }
+        return;
+    }
+
+    // dex fee burn
+    if (category == uint8_t(CustomTxType::PoolSwap) || category == uint8_t(CustomTxType::PoolSwapV2)) {
+        AddBalances(dexfeeburn, diff);
+        return;
+    }
+
+    // Token burn, either with burnToken tx or any other tx type
+    AddBalances(burntTokens, diff);
+}
+
+void CBurnInfo::Add(const CBurnInfo &other) {
+    burntDFI += other.burntDFI;
+    burntFee += other.burntFee;
+    auctionFee += other.auctionFee;
+    AddBalances(burntTokens, other.burntTokens.balances);
+    AddBalances(dexfeeburn, other.dexfeeburn.balances);
+    AddBalances(paybackFee, other.paybackFee.balances);
+}
+
+void CBurnInfo::Sub(const CBurnInfo &other) {
+    burntDFI -= other.burntDFI;
+    burntFee -= other.burntFee;
+    auctionFee -= other.auctionFee;
+    burntTokens.SubBalances(other.burntTokens.balances);
+    dexfeeburn.SubBalances(other.dexfeeburn.balances);
+    paybackFee.SubBalances(other.paybackFee.balances);
+}
+
+bool CBurnInfo::IsEmpty() const {
+    return !burntDFI && !burntFee && !auctionFee && burntTokens.balances.empty() && dexfeeburn.balances.empty() &&
+           paybackFee.balances.empty();
+}
+
+void CBurnInfoView::AddBlockBurnInfo(uint32_t height, const CBurnInfo &burns) {
+    if (burns.IsEmpty()) {
+        return;
+    }
+
+    auto totals = GetBurnInfo();
+    totals.Add(burns);
+    WriteBy<ByBurnTotals>('\0', totals);
+    WriteBy<ByBlockBurns>(height, burns);
+}
+
+void CBurnInfoView::EraseBlockBurnInfo(uint32_t height) {
+    const auto burns = GetBlockBurnInfo(height);
+    if (!burns) {
+        return;
+    }
+
+    auto totals = GetBurnInfo();
+    totals.Sub(*burns);
+    WriteBy<ByBurnTotals>('\0', totals);
+    EraseBy<ByBlockBurns>(height);
+}
+
+std::optional<CBurnInfo> CBurnInfoView::GetBlockBurnInfo(uint32_t height) const {
+    return ReadBy<ByBlockBurns, CBurnInfo>(height);
+}
+
+CBurnInfo CBurnInfoView::GetBurnInfo() const {
+    return ReadBy<ByBurnTotals, CBurnInfo>('\0').value_or(CBurnInfo{});
+}
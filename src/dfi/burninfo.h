@@ -0,0 +1,59 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DEFI_DFI_BURNINFO_H
+#define DEFI_DFI_BURNINFO_H
+
+#include <amount.h>
+#include <dfi/balances.h>
+#include <flushablestorage.h>
+#include <serialize.h>
+
+/// Burn history totals as reported by getburninfo
+struct CBurnInfo {
+    CAmount burntDFI{};
+    CAmount burntFee{};
+    CAmount auctionFee{};
+    CBalances burntTokens;
+    CBalances dexfeeburn;
+    CBalances paybackFee;
+
+    // Adds a burn history entry to the bucket of its transaction type
+    void AddHistory(uint8_t category, const TAmounts &diff);
+    void Add(const CBurnInfo &other);
+    void Sub(const CBurnInfo &other);
+    bool IsEmpty() const;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(burntDFI);
+        READWRITE(burntFee);
+        READWRITE(auctionFee);
+        READWRITE(burntTokens);
+        READWRITE(dexfeeburn);
+        READWRITE(paybackFee);
+    }
+};
+
+class CBurnInfoView : public virtual CStorageView {
+public:
+    // Stores the burns of a block and adds them to the totals
+    void AddBlockBurnInfo(uint32_t height, const CBurnInfo &burns);
+    // Removes the burns of a block from the totals on disconnect
+    void EraseBlockBurnInfo(uint32_t height);
+    std::optional<CBurnInfo> GetBlockBurnInfo(uint32_t height) const;
+    CBurnInfo GetBurnInfo() const;
+
+    // tags
+    struct ByBlockBurns {
+        static constexpr uint8_t prefix() { return 0x1F; }
+    };
+    struct ByBurnTotals {
+        static constexpr uint8_t prefix() { return '9'; }
+    };
+};
+
+#endif  // DEFI_DFI_BURNINFO_H
@@ -130,7 +130,11 @@ Res CMasternodesConsensus::operator()(const CResignMasterNodeMessage &obj) const
         !res) {
         return res;
     }
-    return mnview.ResignMasternode(*node, obj, tx.GetHash(), height);
+    if (auto res = mnview.ResignMasternode(*node, obj, tx.GetHash(), height); !res) {
+        return res;
+    }
+    mnview.InvalidateProposalVotes(obj);
+    return Res::Ok();
 }
 
 Res CMasternodesConsensus::operator()(const CUpdateMasterNodeMessage &obj) const {
@@ -894,14 +894,30 @@ ResVal<CScript> GetFutureSwapContractAddress(const std::string &contract) {
     return {contractAddress, Res::Ok()};
 }
 
+const std::vector<CDataStructureV0> &LiveBalanceKeys() {
+    static const std::vector<CDataStructureV0> keys{
+        {AttributeTypes::Live, ParamIDs::Economy, EconomyKeys::NegativeInt},
+        {AttributeTypes::Live, ParamIDs::Economy, EconomyKeys::Loans},
+        {AttributeTypes::Live, ParamIDs::Auction, EconomyKeys::BatchRoundingExcess},
+        {AttributeTypes::Live, ParamIDs::Auction, EconomyKeys::ConsolidatedInterest},
+    };
+    return keys;
+}
+
+bool IsLiveBalanceKey(const CDataStructureV0 &key) {
+    const auto &keys = LiveBalanceKeys();
+    return std::find_if(keys.begin(), keys.end(), [&](const CDataStructureV0 &liveKey) {
+               return !(key < liveKey) && !(liveKey < key);
+           }) != keys.end();
+}
+
+// Updates the row of a live balance directly instead of reading and writing back all of ATTRIBUTES
 static void TrackLiveBalance(CCustomCSView &mnview,
                              const CTokenAmount &amount,
                              const EconomyKeys dataKey,
                              const bool add) {
-    auto attributes = mnview.GetAttributes();
-
     CDataStructureV0 key{AttributeTypes::Live, ParamIDs::Economy, dataKey};
-    auto balances = attributes->GetValue(key, CBalances{});
+    auto balances = mnview.GetLiveBalances(key).value_or(CBalances{});
     Res res{};
     if (add) {
         res = balances.Add(amount);
@@ -909,8 +925,7 @@ static void TrackLiveBalance(CCustomCSView &mnview,
         res = balances.Sub(amount);
     }
     if (res) {
-        attributes->SetValue(key, balances);
-        mnview.SetVariable(*attributes);
+        mnview.SetLiveBalances(key, balances);
     }
 }
 
@@ -930,15 +945,13 @@ void TrackDUSDSub(CCustomCSView &mnview, const CTokenAmount &amount) {
 }
 
 void TrackLiveBalances(CCustomCSView &mnview, const CBalances &balances, const uint8_t key) {
-    auto attributes = mnview.GetAttributes();
-
     const CDataStructureV0 liveKey{AttributeTypes::Live, ParamIDs::Auction, key};
-    auto storedBalances = attributes->GetValue(liveKey, CBalances{});
+    assert(IsLiveBalanceKey(liveKey));
+    auto storedBalances = mnview.GetLiveBalances(liveKey).value_or(CBalances{});
     for (const auto &[tokenID, amount] : balances.balances) {
         storedBalances.balances[tokenID] += amount;
     }
-    attributes->SetValue(liveKey, storedBalances);
-    mnview.SetVariable(*attributes);
+    mnview.SetLiveBalances(liveKey, storedBalances);
 }
 
 bool IsEVMEnabled(const std::shared_ptr<ATTRIBUTES> attributes) {
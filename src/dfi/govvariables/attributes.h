@@ -399,6 +399,10 @@ using CAttributeValue = std::variant<bool,
                                      CEvmBlockStatsLive,
                                      OracleSplits64>;
 
+// Live economy counters stored outside of the ATTRIBUTES blob, see CGovView::GetLiveBalances
+const std::vector<CDataStructureV0> &LiveBalanceKeys();
+bool IsLiveBalanceKey(const CDataStructureV0 &key);
+
 void TrackNegativeInterest(CCustomCSView &mnview, const CTokenAmount &amount);
 void TrackLiveBalances(CCustomCSView &mnview, const CBalances &balances, const uint8_t key);
 void TrackDUSDAdd(CCustomCSView &mnview, const CTokenAmount &amount);
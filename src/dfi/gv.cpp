@@ -26,30 +26,89 @@ Res CGovView::SetVariable(const GovVariable &var) {
     if (var.GetName() != "ATTRIBUTES") {
         return WriteOrEraseVar(var);
     }
-    auto attributes = GetAttributes();
     auto &current = dynamic_cast<const ATTRIBUTES &>(var);
     if (current.changed.empty()) {
         return Res::Ok();
     }
+    // Merge into the stored blob only, live balances are kept as rows
+    ATTRIBUTES attributes;
+    ReadBy<ByName>(attributes.GetName(), attributes);
+    bool blobChanged{};
     for (auto &key : current.changed) {
         auto it = current.attributes.find(key);
+        if (const auto v0Key = std::get_if<CDataStructureV0>(&key); v0Key && IsLiveBalanceKey(*v0Key)) {
+            if (it == current.attributes.end()) {
+                EraseBy<ByLiveBalance>(*v0Key);
+                continue;
+            }
+            if (const auto balances = std::get_if<CBalances>(&it->second)) {
+                SetLiveBalances(*v0Key, *balances);
+                continue;
+            }
+        }
+        blobChanged = true;
         if (it == current.attributes.end()) {
-            attributes->attributes.erase(key);
+            attributes.attributes.erase(key);
         } else {
-            attributes->attributes[key] = it->second;
+            attributes.attributes[key] = it->second;
         }
     }
-    return WriteOrEraseVar(*attributes);
+    if (!blobChanged) {
+        return Res::Ok();
+    }
+    return WriteOrEraseVar(attributes);
 }
 
 std::shared_ptr<GovVariable> CGovView::GetVariable(const std::string &name) const {
     if (const auto var = GovVariable::Create(name)) {
         ReadBy<ByName>(var->GetName(), *var);
+        if (const auto attributes = dynamic_cast<ATTRIBUTES *>(var.get())) {
+            for (const auto &key : LiveBalanceKeys()) {
+                if (auto balances = GetLiveBalances(key)) {
+                    attributes->attributes[key] = std::move(*balances);
+                }
+            }
+        }
         return var;
     }
     return {};
 }
 
+std::optional<CBalances> CGovView::GetLiveBalances(const CDataStructureV0 &key) const {
+    return ReadBy<ByLiveBalance, CBalances>(key);
+}
+
+void CGovView::SetLiveBalances(const CDataStructureV0 &key, const CBalances &balances) {
+    WriteBy<ByLiveBalance>(key, balances);
+}
+
+void CGovView::BuildLiveBalances() {
+    ATTRIBUTES attributes;
+    if (!ReadBy<ByName>(attributes.GetName(), attributes)) {
+        return;
+    }
+    bool blobChanged{};
+    for (const auto &key : LiveBalanceKeys()) {
+        auto it = attributes.attributes.find(key);
+        if (it == attributes.attributes.end()) {
+            continue;
+        }
+        if (const auto balances = std::get_if<CBalances>(&it->second)) {
+            SetLiveBalances(key, *balances);
+            attributes.attributes.erase(it);
+            blobChanged = true;
+        }
+    }
+    if (!blobChanged) {
+        return;
+    }
+    if (attributes.IsEmpty()) {
+        EraseBy<ByName>(attributes.GetName());
+    } else {
+        WriteBy<ByName>(attributes.GetName(), attributes);
+    }
+}
+
 Res CGovView::SetStoredVariables(const std::set<std::shared_ptr<GovVariable>> &govVars, const uint32_t height) {
     for (auto &item : govVars) {
         auto res = WriteBy<ByHeightVars>(GovVarKey{height, item->GetName()}, *item);
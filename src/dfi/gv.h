@@ -5,6 +5,7 @@
 #ifndef DEFI_DFI_GV_H
 #define DEFI_DFI_GV_H
 
+#include <dfi/balances.h>
 #include <dfi/factory.h>
 #include <dfi/res.h>
 #include <flushablestorage.h>
@@ -12,6 +13,7 @@
 
 class ATTRIBUTES;
 class CCustomCSView;
+struct CDataStructureV0;
 
 using XVmAddressFormatItems = std::set<uint8_t>;
 
@@ -116,6 +118,13 @@ public:
 
     std::shared_ptr<ATTRIBUTES> GetAttributes() const;
 
+    // Live economy counters changed by most loan transactions are stored as their own rows rather than in the
+    // ATTRIBUTES blob, see IsLiveBalanceKey. GetVariable and SetVariable merge them back in and split them out.
+    std::optional<CBalances> GetLiveBalances(const CDataStructureV0 &key) const;
+    void SetLiveBalances(const CDataStructureV0 &key, const CBalances &balances);
+    // Moves the counters out of the stored blob, for databases written before they were kept as rows
+    void BuildLiveBalances();
+
     [[nodiscard]] virtual bool AreTokensLocked(const std::set<uint32_t> &tokenIds) const = 0;
 
     struct ByHeightVars {
@@ -128,6 +137,9 @@ public:
     struct ByUnsetHeightVars {
         static constexpr uint8_t prefix() { return 0x7E; }
     };
+    struct ByLiveBalance {
+        static constexpr uint8_t prefix() { return 0x7F; }
+    };
 };
 
 struct CGovernanceUnsetMessage {
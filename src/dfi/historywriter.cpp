@@ -2,20 +2,118 @@
 // Distributed under the MIT software license, see the accompanying
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
+#include <chain.h>
 #include <dfi/accountshistory.h>
 #include <dfi/historywriter.h>
 #include <dfi/masternodes.h>
 #include <dfi/mn_checks.h>
 #include <dfi/vaulthistory.h>
+#include <util/system.h>
 
 extern std::string ScriptToString(const CScript &script);
 
+std::unique_ptr<CHistoryWriterQueue> phistoryWriterQueue;
+
+CHistoryWriterQueue::CHistoryWriterQueue(size_t maxBlocks)
+    : maxBlocks(maxBlocks),
+      thread(&TraceThread<std::function<void()>>, "histwriter", std::function<void()>([this] { Run(); })) {}
+
+CHistoryWriterQueue::~CHistoryWriterQueue() {
+    {
+        std::lock_guard lock(m);
+        stopping = true;
+    }
+    cv.notify_all();
+    thread.join();
+}
+
+void CHistoryWriterQueue::Push(BlockChanges changes) {
+    std::unique_lock lock(m);
+    if (backlog.size() >= maxBlocks) {
+        const auto startTime = GetTimeMicros();
+        cv.wait(lock, [&] { return backlog.size() < maxBlocks; });
+        LogPrint(BCLog::BENCH, "    - History writer backlog full, waited: %.2fms\n", (GetTimeMicros() - startTime) * 0.001);
+    }
+    backlog.push_back(std::move(changes));
+    lock.unlock();
+    cv.notify_all();
+}
+
+void CHistoryWriterQueue::WaitForCompletion() {
+    std::unique_lock lock(m);
+    cv.wait(lock, [&] { return backlog.empty() && !writing; });
+}
+
+void CHistoryWriterQueue::Run() {
+    while (true) {
+        BlockChanges changes;
+        {
+            std::unique_lock lock(m);
+            cv.wait(lock, [&] { return stopping || !backlog.empty(); });
+            // Everything queued is written before stopping
+            if (backlog.empty()) {
+                return;
+            }
+            changes = std::move(backlog.front());
+            backlog.pop_front();
+            writing = true;
+        }
+        cv.notify_all();
+
+        for (const auto &change : changes) {
+            change();
+        }
+
+        {
+            std::lock_guard lock(m);
+            writing = false;
+        }
+        cv.notify_all();
+    }
+}
+
+void InitHistoryWriterQueue() {
+    const auto maxBlocks = gArgs.GetArg("-historywriterbacklog", DEFAULT_HISTORY_WRITER_BACKLOG);
+    LogPrintf("History writer: Backlog: %d\n", maxBlocks);
+    if (maxBlocks > 0) {
+        phistoryWriterQueue = std::make_unique<CHistoryWriterQueue>(static_cast<size_t>(maxBlocks));
+    }
+}
+
+void ShutdownHistoryWriterQueue() {
+    if (!phistoryWriterQueue) {
+        return;
+    }
+    LogPrintf("History writer: Waiting for queued blocks\n");
+    phistoryWriterQueue.reset();
+    LogPrintf("History writer: Shutdown\n");
+}
+
+void WaitForHistoryWriterQueue() {
+    if (phistoryWriterQueue) {
+        phistoryWriterQueue->WaitForCompletion();
+    }
+}
+
+void RunAfterHistoryWriterQueue(std::function<void()> task) {
+    if (phistoryWriterQueue) {
+        phistoryWriterQueue->Push({std::move(task)});
+        return;
+    }
+    task();
+}
+
 CHistoryWriters::CHistoryWriters(CAccountHistoryStorage *historyView,
                                  CBurnHistoryStorage *burnView,
                                  CVaultHistoryStorage *vaultView)
     : historyView(historyView),
       burnView(burnView),
-      vaultView(vaultView) {}
+      vaultView(vaultView),
+      changes(std::make_shared<CHistoryWriterQueue::BlockChanges>()) {}
+
+void CHistoryWriters::QueueChange(std::function<void()> change) {
+    changes->push_back(std::move(change));
+}
 
 void CHistoryWriters::AddBalance(const CScript &owner, const CTokenAmount &amount, const uint256 &vaultID) {
     if (historyView) {
@@ -72,7 +170,11 @@ void CHistoryWriters::Flush(const uint32_t height,
                      ToString(static_cast<CustomTxType>(type)),
                      ScriptToString(owner),
                      (CBalances{amounts}.ToString()));
-            historyView->WriteAccountHistory({owner, height, txn}, {txid, type, amounts});
+            QueueChange([historyView = historyView,
+                         key = AccountHistoryKey{owner, height, txn},
+                         value = AccountHistoryValue{txid, type, amounts}] {
+                historyView->WriteAccountHistory(key, value);
+            });
         }
     }
     if (burnView) {
@@ -83,15 +185,26 @@ void CHistoryWriters::Flush(const uint32_t height,
     if (vaultView) {
         for (const auto &[vaultID, ownerMap] : vaultDiffs) {
             for (const auto &[owner, amounts] : ownerMap) {
-                vaultView->WriteVaultHistory({height, vaultID, txn, owner}, {txid, type, amounts});
+                QueueChange([vaultView = vaultView,
+                             key = VaultHistoryKey{height, vaultID, txn, owner},
+                             value = VaultHistoryValue{txid, type, amounts}] {
+                    vaultView->WriteVaultHistory(key, value);
+                });
             }
         }
         if (!schemeID.empty()) {
-            vaultView->WriteVaultScheme({vaultID, height}, {type, txid, schemeID, txn});
+            QueueChange([vaultView = vaultView,
+                         key = VaultSchemeKey{vaultID, height},
+                         value = VaultSchemeValue{type, txid, schemeID, txn}] {
+                vaultView->WriteVaultScheme(key, value);
+            });
         }
         if (!globalLoanScheme.identifier.empty()) {
-            vaultView->WriteGlobalScheme({height, txn, globalLoanScheme.schemeCreationTxid},
-                                         {globalLoanScheme, type, txid});
+            QueueChange([vaultView = vaultView,
+                         key = VaultGlobalSchemeKey{height, txn, globalLoanScheme.schemeCreationTxid},
+                         value = VaultGlobalSchemeValue{globalLoanScheme, type, txid}] {
+                vaultView->WriteGlobalScheme(key, value);
+            });
         }
     }
 
@@ -107,18 +220,30 @@ void CHistoryWriters::ClearState() {
     vaultDiffs.clear();
 }
 
+void CHistoryWriters::TakeChanges(CHistoryWriters &other) {
+    if (!other.changes || other.changes->empty()) {
+        return;
+    }
+    if (!changes) {
+        changes = std::make_shared<CHistoryWriterQueue::BlockChanges>();
+    }
+    std::move(other.changes->begin(), other.changes->end(), std::back_inserter(*changes));
+    other.changes->clear();
+}
+
 void CHistoryWriters::EraseHistory(uint32_t height, std::vector<AccountHistoryKey> &eraseBurnEntries) {
+    // Queued after the pending writes, so the disconnected block is erased once it has been written
     if (historyView) {
-        historyView->EraseAccountHistoryHeight(height);
+        QueueChange([historyView = historyView, height] { historyView->EraseAccountHistoryHeight(height); });
     }
 
     if (height >= static_cast<uint32_t>(Params().GetConsensus().DF11FortCanningHeight)) {
         // erase auction fee history
         if (historyView) {
-            historyView->EraseAuctionHistoryHeight(height);
+            QueueChange([historyView = historyView, height] { historyView->EraseAuctionHistoryHeight(height); });
         }
         if (vaultView) {
-            vaultView->EraseVaultHistory(height);
+            QueueChange([vaultView = vaultView, height] { vaultView->EraseVaultHistory(height); });
         }
     }
 
@@ -186,13 +311,13 @@ void CHistoryWriters::WriteAccountHistory(const AccountHistoryKey &key, const Ac
 
 void CHistoryWriters::WriteAuctionHistory(const AuctionHistoryKey &key, const AuctionHistoryValue &value) {
     if (historyView) {
-        historyView->WriteAuctionHistory(key, value);
+        QueueChange([historyView = historyView, key, value] { historyView->WriteAuctionHistory(key, value); });
     }
 }
 
 void CHistoryWriters::WriteVaultHistory(const VaultHistoryKey &key, const VaultHistoryValue &value) {
     if (vaultView) {
-        vaultView->WriteVaultHistory(key, value);
+        QueueChange([vaultView = vaultView, key, value] { vaultView->WriteVaultHistory(key, value); });
     }
 }
 
@@ -200,19 +325,71 @@ void CHistoryWriters::WriteVaultState(CCustomCSView &mnview,
                                       const CBlockIndex &pindex,
                                       const uint256 &vaultID,
                                       const uint32_t ratio) {
-    if (vaultView) {
-        vaultView->WriteVaultState(mnview, pindex, vaultID, ratio);
+    if (!vaultView) {
+        return;
+    }
+
+    // The state is read from the view now, only the write is queued
+    const auto vault = mnview.GetVault(vaultID);
+    assert(vault);
+
+    auto collaterals = mnview.GetVaultCollaterals(vaultID);
+    if (!collaterals) {
+        collaterals = CBalances{};
+    }
+
+    bool useNextPrice = false, requireLivePrice = false;
+    auto rate =
+        mnview.GetVaultAssets(vaultID, *collaterals, pindex.nHeight, pindex.nTime, useNextPrice, requireLivePrice);
+
+    CVaultAssets collateralLoans{0, 0, {}, {}};
+    if (rate) {
+        collateralLoans = *rate.val;
     }
+
+    std::vector<CAuctionBatch> batches;
+    if (auto data = mnview.GetAuction(vaultID, pindex.nHeight)) {
+        for (uint32_t i{0}; i < data->batchCount; ++i) {
+            if (auto batch = mnview.GetAuctionBatch({vaultID, i})) {
+                batches.push_back(*batch);
+            }
+        }
+    }
+
+    QueueChange([vaultView = vaultView,
+                 key = VaultStateKey{vaultID, static_cast<uint32_t>(pindex.nHeight)},
+                 value = VaultStateValue{collaterals->balances, collateralLoans, batches, ratio}] {
+        vaultView->WriteVaultState(key, value);
+    });
 }
 
 void CHistoryWriters::FlushDB() {
-    if (historyView) {
-        historyView->Flush();
-    }
+    // Burn history is read back when connecting the block, it is written right away
     if (burnView) {
         burnView->Flush();
     }
-    if (vaultView) {
-        vaultView->Flush();
+
+    if (!changes) {
+        return;
+    }
+
+    auto blockChanges = std::move(*changes);
+    changes->clear();
+    blockChanges.push_back([historyView = historyView, vaultView = vaultView] {
+        if (historyView) {
+            historyView->Flush();
+        }
+        if (vaultView) {
+            vaultView->Flush();
+        }
+    });
+
+    if (phistoryWriterQueue) {
+        phistoryWriterQueue->Push(std::move(blockChanges));
+        return;
+    }
+
+    for (const auto &change : blockChanges) {
+        change();
     }
 }
@@ -10,6 +10,13 @@
 #include <script/script.h>
 #include <uint256.h>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 class CAccountHistoryStorage;
 struct AuctionHistoryKey;
 struct AuctionHistoryValue;
@@ -18,6 +25,8 @@ class CVaultHistoryStorage;
 struct VaultHistoryKey;
 struct VaultHistoryValue;
 
+static const int DEFAULT_HISTORY_WRITER_BACKLOG = 16;
+
 struct AccountHistoryKey {
     CScript owner;
     uint32_t blockHeight;
@@ -72,6 +81,32 @@ struct AccountHistoryKeyNew {
     }
 };
 
+struct AccountHistoryTokenKey {
+    DCT_ID tokenId;
+    AccountHistoryKeyNew key;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(tokenId);
+        READWRITE(key);
+    }
+};
+
+struct AccountHistoryTypeKey {
+    unsigned char category;
+    AccountHistoryKeyNew key;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(category);
+        READWRITE(key);
+    }
+};
+
 struct AccountHistoryValue {
     uint256 txid;
     unsigned char category;
@@ -87,6 +122,41 @@ struct AccountHistoryValue {
     }
 };
 
+/**
+ * Writes account, auction and vault history on a dedicated thread, one block at a time
+ * in the order the blocks were queued. Queueing waits while the backlog is full.
+ */
+class CHistoryWriterQueue {
+public:
+    using BlockChanges = std::vector<std::function<void()>>;
+
+    explicit CHistoryWriterQueue(size_t maxBlocks);
+    ~CHistoryWriterQueue();
+
+    void Push(BlockChanges changes);
+    void WaitForCompletion();
+
+private:
+    void Run();
+
+    const size_t maxBlocks;
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<BlockChanges> backlog;
+    bool writing{};
+    bool stopping{};
+    std::thread thread;
+};
+
+void InitHistoryWriterQueue();
+void ShutdownHistoryWriterQueue();
+// Account and vault history storages can be read or written directly only after this
+void WaitForHistoryWriterQueue();
+// Runs task on the writer once the history queued so far is written, right away without a queue
+void RunAfterHistoryWriterQueue(std::function<void()> task);
+
+extern std::unique_ptr<CHistoryWriterQueue> phistoryWriterQueue;
+
 class CHistoryWriters {
     CAccountHistoryStorage *historyView{};
     CBurnHistoryStorage *burnView{};
@@ -96,6 +166,11 @@ class CHistoryWriters {
     std::map<CScript, TAmounts> burnDiffs;
     std::map<uint256, std::map<CScript, TAmounts>> vaultDiffs;
 
+    // Account and vault history changes of the block in order, shared with copies
+    std::shared_ptr<CHistoryWriterQueue::BlockChanges> changes;
+
+    void QueueChange(std::function<void()> change);
+
 public:
     CLoanSchemeCreation globalLoanScheme;
     std::string schemeID;
@@ -113,6 +188,8 @@ public:
     void SubVaultCollateral(const CTokenAmount &amount, const uint256 &vaultID);
 
     void ClearState();
+    // Appends the queued history changes of writers used on a child view
+    void TakeChanges(CHistoryWriters &other);
     void FlushDB();
     void Flush(const uint32_t height,
                const uint256 &txid,
@@ -1,4 +1,5 @@
 
+#include <arith_int128.h>
 #include <chainparams.h>
 #include <dfi/govvariables/attributes.h>
 #include <dfi/loan.h>
@@ -207,36 +208,33 @@ inline T InterestPerBlockCalculationV1(CAmount amount, CAmount tokenInterest, CA
 inline base_uint<128> InterestPerBlockCalculationV2(CAmount amount, CAmount tokenInterest, CAmount schemeInterest) {
     const auto netInterest = (tokenInterest + schemeInterest) / 100;  // in %
     static const auto blocksPerYear = 365 * Params().GetConsensus().blocksPerDay();
-    return arith_uint256(amount) * netInterest * COIN / blocksPerYear;
+    return MulMulDiv128(amount, netInterest, COIN, blocksPerYear);
 }
 
 // Precision 128bit with negative interest
 CInterestAmount InterestPerBlockCalculationV3(CAmount amount, CAmount tokenInterest, CAmount schemeInterest) {
     const auto netInterest = (tokenInterest + schemeInterest) / 100;  // in %
     static const auto blocksPerYear = 365 * Params().GetConsensus().blocksPerDay();
-    return {netInterest < 0 && amount > 0, arith_uint256(amount) * std::abs(netInterest) * COIN / blocksPerYear};
+    return {netInterest < 0 && amount > 0, MulMulDiv128(amount, std::abs(netInterest), COIN, blocksPerYear)};
 }
 
 CAmount CeilInterest(const base_uint<128> &value, uint32_t height) {
     if (height >= static_cast<uint32_t>(Params().GetConsensus().DF14FortCanningHillHeight)) {
-        CAmount amount = (value / base_uint<128>(HIGH_PRECISION_SCALER)).GetLow64();
-        amount += CAmount(value != base_uint<128>(amount) * HIGH_PRECISION_SCALER);
-        return amount;
+        return DivCeilLow64(value, HIGH_PRECISION_SCALER);
     }
     return value.GetLow64();
 }
 
 CAmount FloorInterest(const base_uint<128> &value) {
-    return (value / base_uint<128>(HIGH_PRECISION_SCALER)).GetLow64();
+    return DivLow64(value, HIGH_PRECISION_SCALER);
 }
 
 static base_uint<128> ToHigherPrecision(CAmount amount, uint32_t height) {
-    base_uint<128> amountHP = amount;
     if (height >= static_cast<uint32_t>(Params().GetConsensus().DF14FortCanningHillHeight)) {
-        amountHP *= HIGH_PRECISION_SCALER;
+        return Mul128(amount, HIGH_PRECISION_SCALER);
     }
 
-    return amountHP;
+    return amount;
 }
 
 const auto InterestPerBlock = [](const CInterestRateV3 &rate, const uint32_t height) {
@@ -248,6 +248,9 @@ void CMasternodesView::IncrementMintedBy(const uint256 &nodeId) {
     assert(node);
     ++node->mintedBlocks;
     WriteBy<ID>(nodeId, *node);
+    if (node->mintedBlocks == 1 && node->resignHeight == -1) {
+        WriteBy<Minting>(nodeId, uint8_t{1});
+    }
 }
 
 void CMasternodesView::DecrementMintedBy(const uint256 &nodeId) {
@@ -255,6 +258,39 @@ void CMasternodesView::DecrementMintedBy(const uint256 &nodeId) {
     assert(node);
     --node->mintedBlocks;
     WriteBy<ID>(nodeId, *node);
+    if (node->mintedBlocks == 0) {
+        EraseBy<Minting>(nodeId);
+    }
+}
+
+void CMasternodesView::ForEachMintingMasternode(std::function<bool(const uint256 &)> callback, const uint256 &start) {
+    ForEach<Minting, uint256, uint8_t>([&](const uint256 &nodeId, uint8_t) { return callback(nodeId); }, start);
+}
+
+void CMasternodesView::GetMintingMasternodes(int height, std::set<uint256> &active, std::set<uint256> &inactive) {
+    ForEachMintingMasternode([&](const uint256 &nodeId) {
+        auto node = GetMasternode(nodeId);
+        assert(node);
+        if (node->IsActive(height, *this)) {
+            active.insert(nodeId);
+        } else {
+            inactive.insert(nodeId);
+        }
+        return true;
+    });
+}
+
+void CMasternodesView::BuildMintingIndex() {
+    std::vector<uint256> minting;
+    ForEachMasternode([&](const uint256 &nodeId, CMasternode node) {
+        if (node.mintedBlocks > 0 && node.resignHeight == -1) {
+            minting.push_back(nodeId);
+        }
+        return true;
+    });
+    for (const auto &nodeId : minting) {
+        WriteBy<Minting>(nodeId, uint8_t{1});
+    }
 }
 
 std::optional<std::pair<CKeyID, uint256>> CMasternodesView::AmIOperator() const {
@@ -341,6 +377,7 @@ Res CMasternodesView::ResignMasternode(CMasternode &node, const uint256 &nodeId,
     node.resignTx = txid;
     node.resignHeight = height;
     WriteBy<ID>(nodeId, node);
+    EraseBy<Minting>(nodeId);
 
     return Res::Ok();
 }
@@ -452,6 +489,11 @@ void CMasternodesView::SetMasternodeLastBlockTime(const CKeyID &minter,
     assert(nodeId);
 
     WriteBy<Staker>(MNBlockTimeKey{*nodeId, blockHeight}, time);
+
+    const auto last = ReadBy<LastStakerTime, MNLastBlockTime>(*nodeId);
+    if (!last || last->blockHeight <= blockHeight) {
+        WriteBy<LastStakerTime>(*nodeId, MNLastBlockTime{blockHeight, time});
+    }
 }
 
 std::optional<int64_t> CMasternodesView::GetMasternodeLastBlockTime(const CKeyID &minter, const uint32_t height) {
@@ -460,16 +502,26 @@ std::optional<int64_t> CMasternodesView::GetMasternodeLastBlockTime(const CKeyID
 
     int64_t time{0};
 
-    ForEachMinterNode(
-        [&](const MNBlockTimeKey &key, int64_t blockTime) {
-            if (key.masternodeID == nodeId) {
-                time = blockTime;
-            }
+    // The latest entry answers lookups from the tip, otherwise search the history
+    const auto last = ReadBy<LastStakerTime, MNLastBlockTime>(*nodeId);
+    if (!last) {
+        return {};
+    }
 
-            // Get first result only and exit
-            return false;
-        },
-        MNBlockTimeKey{*nodeId, height - 1});
+    if (last->blockHeight <= height - 1) {
+        time = last->time;
+    } else {
+        ForEachMinterNode(
+            [&](const MNBlockTimeKey &key, int64_t blockTime) {
+                if (key.masternodeID == nodeId) {
+                    time = blockTime;
+                }
+
+                // Get first result only and exit
+                return false;
+            },
+            MNBlockTimeKey{*nodeId, height - 1});
+    }
 
     if (time) {
         return time;
@@ -480,6 +532,28 @@ std::optional<int64_t> CMasternodesView::GetMasternodeLastBlockTime(const CKeyID
 
 void CMasternodesView::EraseMasternodeLastBlockTime(const uint256 &nodeId, const uint32_t &blockHeight) {
     EraseBy<Staker>(MNBlockTimeKey{nodeId, blockHeight});
+
+    const auto last = ReadBy<LastStakerTime, MNLastBlockTime>(nodeId);
+    if (!last || last->blockHeight != blockHeight) {
+        return;
+    }
+
+    // Fall back to the entry before the erased one
+    std::optional<MNLastBlockTime> previous;
+    ForEachMinterNode(
+        [&](const MNBlockTimeKey &key, int64_t blockTime) {
+            if (key.masternodeID == nodeId) {
+                previous = MNLastBlockTime{key.blockHeight, blockTime};
+            }
+            return false;
+        },
+        MNBlockTimeKey{nodeId, blockHeight - 1});
+
+    if (previous) {
+        WriteBy<LastStakerTime>(nodeId, *previous);
+    } else {
+        EraseBy<LastStakerTime>(nodeId);
+    }
 }
 
 void CMasternodesView::ForEachMinterNode(std::function<bool(const MNBlockTimeKey &, CLazySerialize<int64_t>)> callback,
@@ -495,6 +569,12 @@ void CMasternodesView::SetSubNodesBlockTime(const CKeyID &minter,
     assert(nodeId);
 
     WriteBy<SubNode>(SubNodeBlockTimeKey{*nodeId, id, blockHeight}, time);
+
+    const auto key = std::make_pair(*nodeId, id);
+    const auto last = ReadBy<LastSubNodeTime, MNLastBlockTime>(key);
+    if (!last || last->blockHeight <= blockHeight) {
+        WriteBy<LastSubNodeTime>(key, MNLastBlockTime{blockHeight, time});
+    }
 }
 
 std::vector<int64_t> CMasternodesView::GetSubNodesBlockTime(const CKeyID &minter, const uint32_t height) {
@@ -502,11 +582,25 @@ std::vector<int64_t> CMasternodesView::GetSubNodesBlockTime(const CKeyID &minter
     assert(nodeId);
 
     std::vector<int64_t> times(SUBNODE_COUNT, 0);
+    const auto fortCanning = height >= static_cast<uint32_t>(Params().GetConsensus().DF11FortCanningHeight);
 
     for (uint8_t i{0}; i < SUBNODE_COUNT; ++i) {
+        // The latest entry answers lookups from the tip. Before Fort Canning a subnode without an entry of its own
+        // could pick up the entry of the next one, so those keep searching the history.
+        if (fortCanning) {
+            const auto last = ReadBy<LastSubNodeTime, MNLastBlockTime>(std::make_pair(*nodeId, i));
+            if (!last) {
+                continue;
+            }
+            if (last->blockHeight <= height - 1) {
+                times[i] = last->time;
+                continue;
+            }
+        }
+
         ForEachSubNode(
             [&](const SubNodeBlockTimeKey &key, int64_t blockTime) {
-                if (height >= static_cast<uint32_t>(Params().GetConsensus().DF11FortCanningHeight)) {
+                if (fortCanning) {
                     if (key.masternodeID == nodeId && key.subnode == i) {
                         times[i] = blockTime;
                     }
@@ -529,9 +623,53 @@ void CMasternodesView::ForEachSubNode(
     ForEach<SubNode, SubNodeBlockTimeKey, int64_t>(callback, start);
 }
 
+void CMasternodesView::BuildLastBlockTimes() {
+    // History is ordered by masternode and subnode with the highest block first
+    std::map<uint256, MNLastBlockTime> lastStakerTimes;
+    ForEachMinterNode([&](const MNBlockTimeKey &key, int64_t time) {
+        lastStakerTimes.emplace(key.masternodeID, MNLastBlockTime{key.blockHeight, time});
+        return true;
+    });
+    std::map<std::pair<uint256, uint8_t>, MNLastBlockTime> lastSubNodeTimes;
+    ForEachSubNode([&](const SubNodeBlockTimeKey &key, int64_t time) {
+        lastSubNodeTimes.emplace(std::make_pair(key.masternodeID, key.subnode), MNLastBlockTime{key.blockHeight, time});
+        return true;
+    });
+
+    for (const auto &[nodeId, last] : lastStakerTimes) {
+        WriteBy<LastStakerTime>(nodeId, last);
+    }
+    for (const auto &[key, last] : lastSubNodeTimes) {
+        WriteBy<LastSubNodeTime>(key, last);
+    }
+}
+
 void CMasternodesView::EraseSubNodesLastBlockTime(const uint256 &nodeId, const uint32_t &blockHeight) {
     for (uint8_t i{0}; i < SUBNODE_COUNT; ++i) {
         EraseBy<SubNode>(SubNodeBlockTimeKey{nodeId, i, blockHeight});
+
+        const auto key = std::make_pair(nodeId, i);
+        const auto last = ReadBy<LastSubNodeTime, MNLastBlockTime>(key);
+        if (!last || last->blockHeight != blockHeight) {
+            continue;
+        }
+
+        // Fall back to the entry before the erased one
+        std::optional<MNLastBlockTime> previous;
+        ForEachSubNode(
+            [&](const SubNodeBlockTimeKey &subNodeKey, int64_t blockTime) {
+                if (subNodeKey.masternodeID == nodeId && subNodeKey.subnode == i) {
+                    previous = MNLastBlockTime{subNodeKey.blockHeight, blockTime};
+                }
+                return false;
+            },
+            SubNodeBlockTimeKey{nodeId, i, blockHeight - 1});
+
+        if (previous) {
+            WriteBy<LastSubNodeTime>(key, *previous);
+        } else {
+            EraseBy<LastSubNodeTime>(key);
+        }
     }
 }
 
@@ -824,6 +962,43 @@ void CCustomCSView::SetDbVersion(int version) {
     Write(DbVersion::prefix(), version);
 }
 
+bool CCustomCSView::UpgradeDb(CBurnHistoryStorage &burnView) {
+    auto version = GetDbVersion();
+    if (version < 1 || version > DbVersion) {
+        return false;
+    }
+
+    for (; version < DbVersion; ++version) {
+        LogPrintf("Upgrading DeFi database to version %d\n", version + 1);
+        switch (version) {
+            case 1:
+                BuildMintingIndex();
+                BuildProposalVoteTallies([this](const uint256 &masternodeId) {
+                    const auto node = GetMasternode(masternodeId);
+                    return !node || node->resignHeight != -1;
+                });
+                break;
+            case 2:
+                burnView.ForEachBlockBurnInfo(
+                    [this](uint32_t height, const CBurnInfo &burns) { AddBlockBurnInfo(height, burns); });
+                break;
+            case 3:
+                BuildPairPriceIndex();
+                break;
+            case 4:
+                BuildLiveBalances();
+                break;
+            case 5:
+                BuildLastBlockTimes();
+                break;
+            default:
+                return false;
+        }
+        SetDbVersion(version + 1);
+    }
+    return true;
+}
+
 CTeamView::CTeam CCustomCSView::CalcNextTeam(int height, const uint256 &stakeModifier) {
     if (stakeModifier == uint256()) {
         return Params().GetGenesisTeam();
@@ -1214,13 +1389,24 @@ uint256 CCustomCSView::MerkleRoot() {
         auto it = NewKVIterator<CGovView::ByName>(attributes, map);
         return it.Valid() && it.Key() == attributes;
     };
+    // Rows derived from other state were not part of the view when the merkle root
+    // was checked by consensus and must stay out of it
+    static const std::set<uint8_t> derivedPrefixes{
+        CMasternodesView::Minting::prefix(),
+        CMasternodesView::LastStakerTime::prefix(),
+        CMasternodesView::LastSubNodeTime::prefix(),
+        CProposalView::ByVoteTally::prefix(),
+    };
+    auto isExcluded = [&](const TBytes &key) {
+        return (!key.empty() && derivedPrefixes.count(key[0])) || isAttributes(key);
+    };
 
     auto it = NewKVIterator<CUndosView::ByUndoKey>(UndoKey{}, rawMap);
     for (; it.Valid(); it.Next()) {
         CUndo value = it.Value();
         auto &map = value.before;
         for (auto it = map.begin(); it != map.end();) {
-            isAttributes(it->first) ? map.erase(it++) : ++it;
+            isExcluded(it->first) ? map.erase(it++) : ++it;
         }
         auto key = std::make_pair(CUndosView::ByUndoKey::prefix(), static_cast<const UndoKey &>(it.Key()));
         rawMap[DbTypeToBytes(key)] = DbTypeToBytes(value);
@@ -1228,7 +1414,7 @@ uint256 CCustomCSView::MerkleRoot() {
 
     std::vector<uint256> hashes;
     for (const auto &[key, value] : rawMap) {
-        if (!isAttributes(key)) {
+        if (!isExcluded(key)) {
             hashes.push_back(Hash2(key, value ? *value : TBytes{}));
         }
     }
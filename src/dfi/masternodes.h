@@ -8,6 +8,7 @@
 #include <amount.h>
 #include <dfi/accounts.h>
 #include <dfi/anchors.h>
+#include <dfi/burninfo.h>
 #include <dfi/evm.h>
 #include <dfi/gv.h>
 #include <dfi/historywriter.h>
@@ -229,6 +230,20 @@ struct SubNodeBlockTimeKey {
     }
 };
 
+// Latest block time of a masternode or of one of its subnodes
+struct MNLastBlockTime {
+    uint32_t blockHeight;
+    int64_t time;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(blockHeight);
+        READWRITE(time);
+    }
+};
+
 struct MNNewOwnerHeightValue {
     uint32_t blockHeight;
     uint256 masternodeID;
@@ -243,8 +258,6 @@ struct MNNewOwnerHeightValue {
 };
 
 class CMasternodesView : public virtual CStorageView {
-    std::map<CKeyID, std::pair<uint32_t, int64_t>> minterTimeCache;
-
 public:
     std::optional<CMasternode> GetMasternode(const uint256 &id) const;
     std::optional<uint256> GetMasternodeIdByOperator(const CKeyID &id) const;
@@ -255,6 +268,12 @@ public:
     void IncrementMintedBy(const uint256 &nodeId);
     void DecrementMintedBy(const uint256 &nodeId);
 
+    // Masternodes that minted at least one block and did not resign, the only ones that can be active
+    void ForEachMintingMasternode(std::function<bool(const uint256 &)> callback, const uint256 &start = uint256());
+    void GetMintingMasternodes(int height, std::set<uint256> &active, std::set<uint256> &inactive);
+    // Fills the index from the masternodes, for databases written before it was kept
+    void BuildMintingIndex();
+
     std::optional<std::pair<CKeyID, uint256>> AmIOperator() const;
     std::optional<std::pair<CKeyID, uint256>> AmIOwner() const;
 
@@ -311,6 +330,8 @@ public:
                         const SubNodeBlockTimeKey &start = {uint256{},
                                                             uint8_t{},
                                                             std::numeric_limits<uint32_t>::max()});
+    // Fills the latest Staker and SubNode entries from the history, for databases written before they were kept
+    void BuildLastBlockTimes();
 
     std::optional<uint16_t> GetTimelock(const uint256 &nodeId, const CMasternode &node, const uint64_t height) const;
 
@@ -343,6 +364,20 @@ public:
     struct Timelock {
         static constexpr uint8_t prefix() { return 'K'; }
     };
+
+    // Index of masternodes with minted blocks that have not resigned
+    struct Minting {
+        static constexpr uint8_t prefix() { return 0x1D; }
+    };
+
+    // Latest Staker and SubNode entry per masternode and per masternode subnode, so lookups at the tip
+    // do not have to seek the block time history
+    struct LastStakerTime {
+        static constexpr uint8_t prefix() { return 0x80; }
+    };
+    struct LastSubNodeTime {
+        static constexpr uint8_t prefix() { return 0x81; }
+    };
 };
 
 class CLastHeightView : public virtual CStorageView {
@@ -490,12 +525,14 @@ class CCustomCSView : public CMasternodesView,
                       public CVaultView,
                       public CSettingsView,
                       public CProposalView,
-                      public CVMDomainGraphView {
+                      public CVMDomainGraphView,
+                      public CBurnInfoView {
     // clang-format off
     void CheckPrefixes()
     {
         CheckPrefix<
-            CMasternodesView        ::  ID, NewCollateral, PendingHeight, Operator, Owner, Staker, SubNode, Timelock,
+            CMasternodesView        ::  ID, NewCollateral, PendingHeight, Operator, Owner, Staker, SubNode, Timelock, Minting,
+                                        LastStakerTime, LastSubNodeTime,
             CLastHeightView         ::  Height,
             CTeamView               ::  AuthTeam, ConfirmTeam, CurrentTeam,
             CFoundationsDebtView    ::  Debt,
@@ -508,9 +545,9 @@ class CCustomCSView : public CMasternodesView,
                                         ByPoolReward, ByDailyReward, ByCustomReward, ByTotalLiquidity, ByDailyLoanReward,
                                         ByPoolLoanReward, ByTokenDexFeePct, ByLoanTokenLiquidityPerBlock, ByLoanTokenLiquidityAverage,
                                         ByTotalRewardPerShare, ByTotalLoanRewardPerShare, ByTotalCustomRewardPerShare, ByTotalCommissionPerShare,
-            CGovView                ::  ByName, ByHeightVars, ByUnsetHeightVars,
+            CGovView                ::  ByName, ByHeightVars, ByUnsetHeightVars, ByLiveBalance,
             CAnchorConfirmsView     ::  BtcTx,
-            COracleView             ::  ByName, FixedIntervalBlockKey, FixedIntervalPriceKey, PriceDeviation,
+            COracleView             ::  ByName, FixedIntervalBlockKey, FixedIntervalPriceKey, PriceDeviation, ByPairPrice,
             CICXOrderView           ::  ICXOrderCreationTx, ICXMakeOfferCreationTx, ICXSubmitDFCHTLCCreationTx,
                                         ICXSubmitEXTHTLCCreationTx, ICXClaimDFCHTLCCreationTx, ICXCloseOrderCreationTx,
                                         ICXCloseOfferCreationTx, ICXOrderOpenKey, ICXOrderCloseKey, ICXMakeOfferOpenKey,
@@ -523,8 +560,9 @@ class CCustomCSView : public CMasternodesView,
                                         LoanInterestV3ByVault,
             CVaultView              ::  VaultKey, OwnerVaultKey, CollateralKey, AuctionBatchKey, AuctionHeightKey, AuctionBidKey, HeightAndFeeKey,
             CSettingsView           ::  KVSettings,
-            CProposalView           ::  ByType, ByCycle, ByMnVote, ByStatus, ByVoting,
-            CVMDomainGraphView      ::  VMDomainBlockEdge, VMDomainTxEdge
+            CProposalView           ::  ByType, ByCycle, ByMnVote, ByStatus, ByVoting, ByVoteTally,
+            CVMDomainGraphView      ::  VMDomainBlockEdge, VMDomainTxEdge,
+            CBurnInfoView           ::  ByBlockBurns, ByBurnTotals
         >();
     }
     // clang-format on
@@ -548,8 +586,8 @@ protected:
     CHistoryWriters writers;
 
 public:
-    // Increase version when underlaying tables are changed
-    static constexpr const int DbVersion = 1;
+    // Increase version when underlaying tables are changed, building the new tables in UpgradeDb
+    static constexpr const int DbVersion = 6;
 
     // Normal constructors
     CCustomCSView();
@@ -613,6 +651,10 @@ public:
 
     int GetDbVersion() const;
 
+    // Builds the tables added since the stored DB version and moves it to the latest one. Returns false
+    // when the stored version cannot be upgraded and the database has to be rebuilt.
+    bool UpgradeDb(CBurnHistoryStorage &burnView);
+
     uint256 MerkleRoot();
 
     virtual CHistoryWriters &GetHistoryWriters() { return writers; }
@@ -516,6 +516,8 @@ void PopulateVaultHistoryData(CHistoryWriters &writers,
         if (!obj.updateHeight) {
             writers.globalLoanScheme.schemeCreationTxid = txid;
         } else {
+            // Needs the vault history of the previous blocks
+            WaitForHistoryWriterQueue();
             writers.GetVaultView()->ForEachGlobalScheme(
                 [&writers](const VaultGlobalSchemeKey &key, CLazySerialize<VaultGlobalSchemeValue> value) {
                     if (value.get().loanScheme.identifier != writers.globalLoanScheme.identifier) {
@@ -1210,9 +1212,8 @@ Res SwapToDFIorDUSD(CCustomCSView &mnview,
         return Res::Err("Cannot find token with id %s!", tokenId.ToString());
     }
 
-    // TODO: Optimize double look up later when first token is DUSD.
-    auto dUsdToken = mnview.GetToken("DUSD");
-    if (!dUsdToken) {
+    const auto dUsdId = mnview.GetDUSDTokenId();
+    if (!dUsdId) {
         return Res::Err("Cannot find token DUSD");
     }
 
@@ -1220,10 +1221,10 @@ Res SwapToDFIorDUSD(CCustomCSView &mnview,
     CDataStructureV0 directBurnKey{AttributeTypes::Param, ParamIDs::DFIP2206A, DFIPKeys::DUSDInterestBurn};
 
     // Direct swap from DUSD to DFI as defined in the CPoolSwapMessage.
-    if (tokenId == dUsdToken->first) {
+    if (tokenId == *dUsdId) {
         if (to == consensus.burnAddress && !forceLoanSwap && attributes->GetValue(directBurnKey, false)) {
             // direct burn dUSD
-            CTokenAmount dUSD{dUsdToken->first, amount};
+            CTokenAmount dUSD{*dUsdId, amount};
 
             if (auto res = mnview.SubBalance(from, dUSD); !res) {
                 return res;
@@ -1236,18 +1237,18 @@ Res SwapToDFIorDUSD(CCustomCSView &mnview,
         }
     }
 
-    auto pooldUSDDFI = mnview.GetPoolPair(dUsdToken->first, DCT_ID{0});
+    auto pooldUSDDFI = mnview.GetPoolPair(*dUsdId, DCT_ID{0});
     if (!pooldUSDDFI) {
         return Res::Err("Cannot find pool pair DUSD-DFI!");
     }
 
-    auto poolTokendUSD = mnview.GetPoolPair(tokenId, dUsdToken->first);
+    auto poolTokendUSD = mnview.GetPoolPair(tokenId, *dUsdId);
     if (!poolTokendUSD) {
         return Res::Err("Cannot find pool pair %s-DUSD!", token->symbol);
     }
 
     if (to == consensus.burnAddress && !forceLoanSwap && attributes->GetValue(directBurnKey, false)) {
-        obj.idTokenTo = dUsdToken->first;
+        obj.idTokenTo = *dUsdId;
 
         // swap tokenID -> dUSD and burn dUSD
         return poolSwap.ExecuteSwap(mnview, {}, consensus);
@@ -248,6 +248,13 @@ ResVal<CAmount> GetAggregatePrice(CCustomCSView &view,
                                   const std::string &token,
                                   const std::string &currency,
                                   uint64_t lastBlockTime);
+// Aggregate prices of all pairs with oracle prices, in one pass over the oracle price index
+std::map<CTokenCurrencyPair, ResVal<CAmount>> GetAggregatePrices(CCustomCSView &view, uint64_t lastBlockTime);
+// Price from GetAggregatePrices, falling back to GetAggregatePrice for pairs without oracle prices
+ResVal<CAmount> GetAggregatePrice(CCustomCSView &view,
+                                  const std::map<CTokenCurrencyPair, ResVal<CAmount>> &prices,
+                                  const CTokenCurrencyPair &priceFeedId,
+                                  uint64_t lastBlockTime);
 bool IsVaultPriceValid(CCustomCSView &mnview, const CVaultId &vaultId, uint32_t height);
 Res SwapToDFIorDUSD(CCustomCSView &mnview,
                     DCT_ID tokenId,
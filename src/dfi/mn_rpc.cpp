@@ -1252,13 +1252,9 @@ UniValue isappliedcustomtx(const JSONRPCRequest &request) {
     uint256 txHash = ParseHashV(request.params[0], "txid");
     int blockHeight = request.params[1].get_int();
 
-    CBlockIndex *blockindex;
-    {
-        LOCK(cs_main);
-        blockindex = ::ChainActive()[blockHeight];
-        if (!blockindex) {
-            return result;
-        }
+    const auto blockindex = GetRpcReadContext().BlockAt(blockHeight);
+    if (!blockindex) {
+        return result;
     }
 
     uint256 hashBlock;
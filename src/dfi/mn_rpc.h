@@ -14,6 +14,7 @@
 #include <dfi/mn_checks.h>
 
 #include <rpc/rawtransaction_util.h>
+#include <rpc/jsonstream.h>
 #include <rpc/resultcache.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
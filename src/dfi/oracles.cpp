@@ -30,10 +30,40 @@ ResVal<CAmount> COracle::GetTokenPrice(const std::string &token, const std::stri
     return ResVal<CAmount>(tokenPrices[token][currency].first, Res::Ok());
 }
 
+void COracleView::WritePairPrice(const COracleId &oracleId,
+                                 const COracle &oracle,
+                                 const std::string &token,
+                                 const std::string &currency) {
+    const auto &[price, timestamp] = oracle.tokenPrices.at(token).at(currency);
+    WriteBy<ByPairPrice>(COraclePairPriceKey{{token, currency}, oracleId},
+                         COraclePairPrice{oracle.weightage, price, timestamp});
+}
+
+void COracleView::WritePairPrices(const COracleId &oracleId, const COracle &oracle) {
+    for (const auto &[token, prices] : oracle.tokenPrices) {
+        for (const auto &[currency, pricePair] : prices) {
+            if (oracle.SupportsPair(token, currency)) {
+                WritePairPrice(oracleId, oracle, token, currency);
+            }
+        }
+    }
+}
+
+void COracleView::ErasePairPrices(const COracleId &oracleId, const COracle &oracle) {
+    for (const auto &[token, prices] : oracle.tokenPrices) {
+        for (const auto &[currency, pricePair] : prices) {
+            if (oracle.SupportsPair(token, currency)) {
+                EraseBy<ByPairPrice>(COraclePairPriceKey{{token, currency}, oracleId});
+            }
+        }
+    }
+}
+
 Res COracleView::AppointOracle(const COracleId &oracleId, const COracle &oracle) {
     if (!WriteBy<ByName>(oracleId, oracle)) {
         return Res::Err("failed to appoint the new oracle <%s>", oracleId.GetHex());
     }
+    WritePairPrices(oracleId, oracle);
 
     return Res::Ok();
 }
@@ -48,6 +78,8 @@ Res COracleView::UpdateOracle(const COracleId &oracleId, COracle &&newOracle) {
         return Res::Err("oracle <%s> has token prices on update", oracleId.GetHex());
     }
 
+    ErasePairPrices(oracleId, oracle);
+
     oracle.weightage = newOracle.weightage;
     oracle.oracleAddress = std::move(newOracle.oracleAddress);
 
@@ -70,15 +102,20 @@ Res COracleView::UpdateOracle(const COracleId &oracleId, COracle &&newOracle) {
     if (!WriteBy<ByName>(oracleId, oracle)) {
         return Res::Err("failed to save oracle <%s>", oracleId.GetHex());
     }
+    // weightage is stored with every price
+    WritePairPrices(oracleId, oracle);
 
     return Res::Ok();
 }
 
 Res COracleView::RemoveOracle(const COracleId &oracleId) {
-    if (!ExistsBy<ByName>(oracleId)) {
+    COracle oracle;
+    if (!ReadBy<ByName>(oracleId, oracle)) {
         return Res::Err("oracle <%s> not found", oracleId.GetHex());
     }
 
+    ErasePairPrices(oracleId, oracle);
+
     // remove oracle
     if (!EraseBy<ByName>(oracleId)) {
         return Res::Err("failed to remove oracle <%s>", oracleId.GetHex());
@@ -106,6 +143,11 @@ Res COracleView::SetOracleData(const COracleId &oracleId, int64_t timestamp, con
     if (!WriteBy<ByName>(oracleId, oracle)) {
         return Res::Err("failed to store oracle %s to database", oracleId.GetHex());
     }
+    for (const auto &[token, prices] : tokenPrices) {
+        for (const auto &[currency, price] : prices) {
+            WritePairPrice(oracleId, oracle, token, currency);
+        }
+    }
     return Res::Ok();
 }
 
@@ -123,6 +165,23 @@ void COracleView::ForEachOracle(std::function<bool(const COracleId &, CLazySeria
     ForEach<ByName, COracleId, COracle>(callback, start);
 }
 
+void COracleView::ForEachOraclePairPrice(
+    std::function<bool(const COraclePairPriceKey &, CLazySerialize<COraclePairPrice>)> callback,
+    const COraclePairPriceKey &start) {
+    ForEach<ByPairPrice, COraclePairPriceKey, COraclePairPrice>(callback, start);
+}
+
+void COracleView::BuildPairPriceIndex() {
+    std::vector<std::pair<COracleId, COracle>> oracles;
+    ForEachOracle([&](const COracleId &oracleId, COracle oracle) {
+        oracles.emplace_back(oracleId, std::move(oracle));
+        return true;
+    });
+    for (const auto &[oracleId, oracle] : oracles) {
+        WritePairPrices(oracleId, oracle);
+    }
+}
+
 bool CFixedIntervalPrice::isLive(const CAmount deviationThreshold) const {
     return (priceRecord[0] > 0 && priceRecord[1] > 0 &&
             (std::abs(priceRecord[1] - priceRecord[0]) < MultiplyAmounts(priceRecord[0], deviationThreshold)));
@@ -96,6 +96,35 @@ struct COracle : public CAppointOracleMessage {
     }
 };
 
+/// Entry of the oracle price index, one per priced pair of an oracle
+struct COraclePairPriceKey {
+    CTokenCurrencyPair priceFeedId;
+    COracleId oracleId;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(priceFeedId);
+        READWRITE(oracleId);
+    }
+};
+
+struct COraclePairPrice {
+    uint8_t weightage;
+    CAmount price;
+    int64_t timestamp;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(weightage);
+        READWRITE(price);
+        READWRITE(timestamp);
+    }
+};
+
 struct CFixedIntervalPrice {
     CTokenCurrencyPair priceFeedId;
     int64_t timestamp;
@@ -140,6 +169,13 @@ public:
     void ForEachOracle(std::function<bool(const COracleId &, CLazySerialize<COracle>)> callback,
                        const COracleId &start = {});
 
+    /// prices of all oracles grouped by pair, in oracle order within a pair
+    void ForEachOraclePairPrice(
+        std::function<bool(const COraclePairPriceKey &, CLazySerialize<COraclePairPrice>)> callback,
+        const COraclePairPriceKey &start = {});
+    /// fills the pair index from the oracles, for databases written before it was kept
+    void BuildPairPriceIndex();
+
     Res SetFixedIntervalPrice(const CFixedIntervalPrice &PriceFeed);
 
     ResVal<CFixedIntervalPrice> GetFixedIntervalPrice(const CTokenCurrencyPair &priceFeedId);
@@ -156,6 +192,15 @@ public:
     Res EraseIntervalBlock();
     uint32_t GetIntervalBlock() const;
 
+private:
+    void WritePairPrice(const COracleId &oracleId,
+                        const COracle &oracle,
+                        const std::string &token,
+                        const std::string &currency);
+    void WritePairPrices(const COracleId &oracleId, const COracle &oracle);
+    void ErasePairPrices(const COracleId &oracleId, const COracle &oracle);
+
+public:
     [[nodiscard]] virtual bool AreTokensLocked(const std::set<uint32_t> &tokenIds) const = 0;
     [[nodiscard]] virtual std::optional<CTokenImplementation> GetTokenGuessId(const std::string &str,
                                                                               DCT_ID &id) const = 0;
@@ -164,6 +209,9 @@ public:
     struct ByName {
         static constexpr uint8_t prefix() { return 'O'; }
     };
+    struct ByPairPrice {
+        static constexpr uint8_t prefix() { return 0x0E; }
+    };
     struct PriceDeviation {
         static constexpr uint8_t prefix() { return 'Y'; }
     };
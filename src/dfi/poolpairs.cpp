@@ -4,6 +4,7 @@
 
 #include <dfi/poolpairs.h>
 
+#include <arith_int128.h>
 #include <core_io.h>
 #include <dfi/govvariables/attributes.h>
 
@@ -176,8 +177,7 @@ std::optional<std::pair<DCT_ID, CPoolPair>> CPoolPairView::GetPoolPair(const DCT
 }
 
 inline CAmount liquidityReward(CAmount reward, CAmount liquidity, CAmount totalLiquidity) {
-    return static_cast<CAmount>(
-        (arith_uint256(reward) * arith_uint256(liquidity) / arith_uint256(totalLiquidity)).GetLow64());
+    return static_cast<CAmount>(MulDivLow64(reward, liquidity, totalLiquidity));
 }
 
 template <typename TIterator>
@@ -245,7 +245,7 @@ void CPoolPairView::CalculateStaticPoolRewards(std::function<CAmount()> onLiquid
     auto calcReward = [&](RewardType type, const arith_uint256 &start, const arith_uint256 &end, const uint32_t id) {
         if (const auto rewardPerShare = end - start; rewardPerShare > 0) {
             // Calculate reward
-            const auto reward = (liquidity * rewardPerShare / HIGH_PRECISION_SCALER).GetLow64();
+            const auto reward = MulDivLow64(liquidity, rewardPerShare, HIGH_PRECISION_SCALER);
             // Pay reward to the owner
             onReward(type, {DCT_ID{id}, static_cast<CAmount>(reward)}, key.height);
         }
@@ -394,8 +394,8 @@ Res CPoolPair::AddLiquidity(CAmount amountA,
         // MINIMUM_LIQUIDITY is a hack for non-zero division
         totalLiquidity = MINIMUM_LIQUIDITY;
     } else {
-        CAmount liqA = (arith_uint256(amountA) * arith_uint256(totalLiquidity) / reserveA).GetLow64();
-        CAmount liqB = (arith_uint256(amountB) * arith_uint256(totalLiquidity) / reserveB).GetLow64();
+        CAmount liqA = MulDivLow64(amountA, totalLiquidity, reserveA);
+        CAmount liqB = MulDivLow64(amountB, totalLiquidity, reserveB);
         liquidity = std::min(liqA, liqB);
 
         if (liquidity <= 0) {
@@ -438,8 +438,8 @@ Res CPoolPair::RemoveLiquidity(CAmount liqAmount, std::function<Res(CAmount, CAm
     }
 
     CAmount resAmountA, resAmountB;
-    resAmountA = (arith_uint256(liqAmount) * arith_uint256(reserveA) / totalLiquidity).GetLow64();
-    resAmountB = (arith_uint256(liqAmount) * arith_uint256(reserveB) / totalLiquidity).GetLow64();
+    resAmountA = MulDivLow64(liqAmount, reserveA, totalLiquidity);
+    resAmountB = MulDivLow64(liqAmount, reserveB, totalLiquidity);
 
     reserveA -= resAmountA;  // safe due to previous math
     reserveB -= resAmountB;
@@ -475,13 +475,12 @@ Res CPoolPair::Swap(CTokenAmount in,
         return Res::Err("Lack of liquidity.");
     }
 
-    const auto maxPrice256 = arith_uint256(maxPrice.integer) * PRECISION + maxPrice.fraction;
+    const auto maxPrice128 = MulAdd128(maxPrice.integer, PRECISION, maxPrice.fraction);
     // NOTE it has a bug prior Dakota hardfork
-    const auto price = height < Params().GetConsensus().DF6DakotaHeight
-                           ? arith_uint256(reserveT) * PRECISION / reserveF
-                           : arith_uint256(reserveF) * PRECISION / reserveT;
+    const auto price = height < Params().GetConsensus().DF6DakotaHeight ? MulDiv128(reserveT, PRECISION, reserveF)
+                                                                        : MulDiv128(reserveF, PRECISION, reserveT);
 
-    if (price > maxPrice256) {
+    if (price > maxPrice128) {
         return Res::Err("Price is higher than indicated.");
     }
     // claim trading fee
@@ -520,32 +519,32 @@ CAmount CPoolPair::slopeSwap(CAmount unswapped, CAmount &poolFrom, CAmount &pool
     assert(unswapped >= 0);
     assert(SafeAdd(unswapped, poolFrom).ok);
 
-    arith_uint256 poolF = arith_uint256(poolFrom);
-    arith_uint256 poolT = arith_uint256(poolTo);
-
-    arith_uint256 swapped = 0;
-    if (height < Params().GetConsensus().DF4BayfrontGardensHeight) {
-        CAmount chunk = poolFrom / SLOPE_SWAP_RATE < unswapped ? poolFrom / SLOPE_SWAP_RATE : unswapped;
-        while (unswapped > 0) {
-            // arith_uint256 stepFrom = std::min(poolFrom/1000, unswapped); // 0.1%
-            CAmount stepFrom = std::min(chunk, unswapped);
-            arith_uint256 stepFrom256(stepFrom);
-            arith_uint256 stepTo = poolT * stepFrom256 / poolF;
-            poolF += stepFrom256;
-            poolT -= stepTo;
-            unswapped -= stepFrom;
-            swapped += stepTo;
-        }
-    } else {
-        arith_uint256 unswappedA = arith_uint256(unswapped);
-
-        swapped = poolT - (poolT * poolF / (poolF + unswappedA));
+    if (height >= Params().GetConsensus().DF4BayfrontGardensHeight) {
+        // poolTo * poolFrom always fits in 128 bits and the quotient is at most poolTo
+        CAmount swapped = poolTo - MulDivLow64(poolTo, poolFrom, poolFrom + unswapped);
         if (height >= Params().GetConsensus().DF14FortCanningHillHeight && swapped != 0) {
             // floor the result
             --swapped;
         }
-        poolF += unswappedA;
-        poolT -= swapped;
+        poolFrom += unswapped;
+        poolTo -= swapped;
+        return swapped;
+    }
+
+    arith_uint256 poolF = arith_uint256(poolFrom);
+    arith_uint256 poolT = arith_uint256(poolTo);
+
+    arith_uint256 swapped = 0;
+    CAmount chunk = poolFrom / SLOPE_SWAP_RATE < unswapped ? poolFrom / SLOPE_SWAP_RATE : unswapped;
+    while (unswapped > 0) {
+        // arith_uint256 stepFrom = std::min(poolFrom/1000, unswapped); // 0.1%
+        CAmount stepFrom = std::min(chunk, unswapped);
+        arith_uint256 stepFrom256(stepFrom);
+        arith_uint256 stepTo = poolT * stepFrom256 / poolF;
+        poolF += stepFrom256;
+        poolT -= stepTo;
+        unswapped -= stepFrom;
+        swapped += stepTo;
     }
 
     poolFrom = poolF.GetLow64();
@@ -627,7 +626,7 @@ std::pair<CAmount, CAmount> CPoolPairView::UpdatePoolRewards(
 
             if (newRewardCalculations) {
                 auto calculateReward = [&](const CAmount reward) {
-                    return (arith_uint256(reward) * HIGH_PRECISION_SCALER) / arith_uint256(totalLiquidity);
+                    return arith_uint256(MulDiv128(reward, HIGH_PRECISION_SCALER, totalLiquidity));
                 };
 
                 // Calculate the reward for each LP
@@ -661,7 +660,7 @@ std::pair<CAmount, CAmount> CPoolPairView::UpdatePoolRewards(
                 for (const auto &[id, poolCustomReward] : poolCustomRewards.balances) {
                     // Calculate the reward for each custom LP
                     const auto sharePerCustomLP =
-                        (arith_uint256(poolCustomReward) * HIGH_PRECISION_SCALER) / arith_uint256(totalLiquidity);
+                        arith_uint256(MulDiv128(poolCustomReward, HIGH_PRECISION_SCALER, totalLiquidity));
                     // Add the reward to the total
                     totalCustom[id.v] += sharePerCustomLP;
                 }
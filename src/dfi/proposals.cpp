@@ -48,6 +48,18 @@ std::string CProposalVoteToString(const CProposalVoteType vote) {
     return "Unknown";
 }
 
+uint32_t &CProposalVoteTally::Count(CProposalVoteType vote) {
+    switch (vote) {
+        case CProposalVoteType::VoteYes:
+            return yes;
+        case CProposalVoteType::VoteNo:
+            return no;
+        case CProposalVoteType::VoteNeutral:
+            return neutral;
+    }
+    return invalid;
+}
+
 Res CProposalView::CreateProposal(const CProposalId &propId,
                                   uint32_t height,
                                   const CCreateProposalMessage &msg,
@@ -179,10 +191,88 @@ Res CProposalView::AddProposalVote(const CProposalId &propId, const uint256 &mas
     }
 
     CMnVotePerCycle key{propId, *cycle, masternodeId};
+    auto tallyKey = std::make_pair(propId, *cycle);
+    auto tally = GetProposalVoteTally(propId, *cycle);
+    if (auto prevVote = ReadBy<ByMnVote, uint8_t>(key)) {
+        --tally.Count(static_cast<CProposalVoteType>(*prevVote));
+    }
+    ++tally.Count(vote);
+
     WriteBy<ByMnVote>(key, uint8_t(vote));
+    WriteBy<ByVoteTally>(tallyKey, tally);
     return Res::Ok();
 }
 
+void CProposalView::InvalidateProposalVotes(const uint256 &masternodeId) {
+    ForEachProposal(
+        [&](const CProposalId &propId, const CProposalObject &prop) {
+            if (prop.status != CProposalStatusType::Voting) {
+                return false;
+            }
+
+            auto vote = GetProposalVote(propId, prop.cycle, masternodeId);
+            if (!vote) {
+                return true;
+            }
+
+            auto tally = GetProposalVoteTally(propId, prop.cycle);
+            --tally.Count(*vote);
+            ++tally.invalid;
+            WriteBy<ByVoteTally>(std::make_pair(propId, prop.cycle), tally);
+            return true;
+        },
+        CProposalStatusType::Voting);
+}
+
+CProposalVoteTally CProposalView::GetProposalVoteTally(const CProposalId &propId, uint8_t cycle) {
+    return ReadBy<ByVoteTally, CProposalVoteTally>(std::make_pair(propId, cycle)).value_or(CProposalVoteTally{});
+}
+
+CProposalVoteTally CProposalView::GetProposalVoteTally(const CProposalId &propId,
+                                                       uint8_t cycle,
+                                                       const std::set<uint256> &inactiveMasternodes) {
+    auto tally = GetProposalVoteTally(propId, cycle);
+    if (!tally.Valid()) {
+        return tally;
+    }
+
+    for (const auto &masternodeId : inactiveMasternodes) {
+        if (auto vote = GetProposalVote(propId, cycle, masternodeId)) {
+            --tally.Count(*vote);
+            ++tally.invalid;
+        }
+    }
+    return tally;
+}
+
+void CProposalView::BuildProposalVoteTallies(std::function<bool(const uint256 &)> isResigned) {
+    std::map<std::pair<CProposalId, uint8_t>, CProposalVoteTally> tallies;
+    ForEachProposal(
+        [&](const CProposalId &propId, const CProposalObject &prop) {
+            if (prop.status != CProposalStatusType::Voting) {
+                return false;
+            }
+
+            // Masternodes cannot vote once resigned, their earlier votes were invalidated on resign
+            auto &tally = tallies[std::make_pair(propId, prop.cycle)];
+            ForEachProposalVote(
+                [&](const CProposalId &id, uint8_t cycle, const uint256 &masternodeId, CProposalVoteType vote) {
+                    if (id != propId || cycle != prop.cycle) {
+                        return false;
+                    }
+                    ++(isResigned(masternodeId) ? tally.invalid : tally.Count(vote));
+                    return true;
+                },
+                CMnVotePerCycle{propId, prop.cycle});
+            return true;
+        },
+        CProposalStatusType::Voting);
+
+    for (const auto &[key, tally] : tallies) {
+        WriteBy<ByVoteTally>(key, tally);
+    }
+}
+
 std::optional<CProposalVoteType> CProposalView::GetProposalVote(const CProposalId &propId,
                                                                 uint8_t cycle,
                                                                 const uint256 &masternodeId) {
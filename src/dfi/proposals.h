@@ -12,6 +12,8 @@
 #include <serialize.h>
 #include <uint256.h>
 
+#include <set>
+
 using CProposalId = uint256;
 constexpr const uint8_t VOC_CYCLES = 1;
 constexpr const uint8_t MAX_CYCLES = 100;
@@ -133,6 +135,27 @@ struct CMnVotePerCycle {
     }
 };
 
+/// Vote counts of a proposal cycle, votes of resigned masternodes are moved to invalid
+struct CProposalVoteTally {
+    uint32_t yes{};
+    uint32_t no{};
+    uint32_t neutral{};
+    uint32_t invalid{};
+
+    uint32_t &Count(CProposalVoteType vote);
+    uint32_t Valid() const { return yes + no + neutral; }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(yes);
+        READWRITE(no);
+        READWRITE(neutral);
+        READWRITE(invalid);
+    }
+};
+
 /// View for managing proposals and their data
 class CProposalView : public virtual CStorageView {
 public:
@@ -147,6 +170,14 @@ public:
     std::optional<CProposalVoteType> GetProposalVote(const CProposalId &propId,
                                                      uint8_t cycle,
                                                      const uint256 &masternodeId);
+    void InvalidateProposalVotes(const uint256 &masternodeId);
+    CProposalVoteTally GetProposalVoteTally(const CProposalId &propId, uint8_t cycle);
+    // Tally with the votes of inactive masternodes moved to invalid
+    CProposalVoteTally GetProposalVoteTally(const CProposalId &propId,
+                                            uint8_t cycle,
+                                            const std::set<uint256> &inactiveMasternodes);
+    // Fills the tallies of proposals in voting from their votes, for databases written before they were kept
+    void BuildProposalVoteTallies(std::function<bool(const uint256 &)> isResigned);
 
     void ForEachProposal(std::function<bool(const CProposalId &, const CProposalObject &)> callback,
                          const CProposalStatusType status,
@@ -178,6 +209,9 @@ public:
     struct ByVoting {
         static constexpr uint8_t prefix() { return 0x2F; }
     };
+    struct ByVoteTally {
+        static constexpr uint8_t prefix() { return 0x1E; }
+    };
 };
 
 #endif  // DEFI_DFI_PROPOSALS_H
@@ -83,6 +83,7 @@ UniValue accountToJSON(const CCustomCSView &view,
 }
 
 UniValue accounthistoryToJSON(const CCustomCSView &view,
+                              const CBlockIndex *tip,
                               const AccountHistoryKey &key,
                               const AccountHistoryValue &value,
                               AmountFormat format = AmountFormat::Symbol) {
@@ -90,12 +91,9 @@ UniValue accounthistoryToJSON(const CCustomCSView &view,
 
     obj.pushKV("owner", ScriptToString(key.owner));
     obj.pushKV("blockHeight", (uint64_t)key.blockHeight);
-    {
-        LOCK(cs_main);
-        if (auto block = ::ChainActive()[key.blockHeight]) {
-            obj.pushKV("blockHash", block->GetBlockHash().GetHex());
-            obj.pushKV("blockTime", block->GetBlockTime());
-        }
+    if (auto block = tip->GetAncestor(key.blockHeight)) {
+        obj.pushKV("blockHash", block->GetBlockHash().GetHex());
+        obj.pushKV("blockTime", block->GetBlockTime());
     }
     obj.pushKV("type", ToString(CustomTxCodeToType(value.category)));
     obj.pushKV("txn", (uint64_t)key.txn);
@@ -105,6 +103,7 @@ UniValue accounthistoryToJSON(const CCustomCSView &view,
 }
 
 UniValue rewardhistoryToJSON(const CCustomCSView &view,
+                             const CBlockIndex *tip,
                              const CScript &owner,
                              uint32_t height,
                              DCT_ID const &poolId,
@@ -114,12 +113,9 @@ UniValue rewardhistoryToJSON(const CCustomCSView &view,
     UniValue obj(UniValue::VOBJ);
     obj.pushKV("owner", ScriptToString(owner));
     obj.pushKV("blockHeight", (uint64_t)height);
-    {
-        LOCK(cs_main);
-        if (auto block = ::ChainActive()[height]) {
-            obj.pushKV("blockHash", block->GetBlockHash().GetHex());
-            obj.pushKV("blockTime", block->GetBlockTime());
-        }
+    if (auto block = tip->GetAncestor(height)) {
+        obj.pushKV("blockHash", block->GetBlockHash().GetHex());
+        obj.pushKV("blockTime", block->GetBlockTime());
     }
     obj.pushKV("type", RewardToString(type));
     if (type & RewardType::Rewards) {
@@ -278,6 +274,43 @@ static void searchInWallet(const CWallet *pwallet,
     }
 }
 
+// Iterates the token or transaction type index covering the filters, false if there is none to use.
+// Those indexes are keyed by height across all owners, the history of a single owner is read faster
+// from the main index, which is keyed by owner first.
+static bool forEachFilteredAccountHistory(
+    CCustomCSView &view,
+    CAccountHistoryStorage &accountView,
+    std::function<bool(const AccountHistoryKey &, AccountHistoryValue)> callback,
+    const std::string &tokenFilter,
+    const std::set<CustomTxType> &txTypes,
+    bool hasTxFilter,
+    const CScript &owner,
+    uint32_t height,
+    uint32_t txn = std::numeric_limits<uint32_t>::max()) {
+    if (!accountView.HasSecondaryIndexes() || !owner.empty()) {
+        return false;
+    }
+
+    if (!tokenFilter.empty()) {
+        if (auto token = view.GetToken(tokenFilter)) {
+            accountView.ForEachAccountHistoryByToken(callback, token->first, owner, height, txn);
+            return true;
+        }
+    }
+
+    // categories which are not a known type all match None
+    if (hasTxFilter && !txTypes.empty() && !txTypes.count(CustomTxType::None)) {
+        std::set<unsigned char> categories;
+        for (const auto type : txTypes) {
+            categories.insert(static_cast<unsigned char>(type));
+        }
+        accountView.ForEachAccountHistoryByType(callback, categories, owner, height, txn);
+        return true;
+    }
+
+    return false;
+}
+
 static CScript hexToScript(const std::string &str) {
     if (!IsHex(str)) {
         throw JSONRPCError(RPC_INVALID_PARAMETER, "(" + str + ") doesn't represent a correct hex:\n");
@@ -300,6 +333,29 @@ static BalanceKey decodeBalanceKey(const std::string &str) {
     return {hexToScript(pair.first), tokenID};
 }
 
+static std::string encodeHistoryCursor(const AccountHistoryKey &key) {
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << key;
+    return HexStr(ss.begin(), ss.end());
+}
+
+static AccountHistoryKey decodeHistoryCursor(const std::string &str) {
+    if (!IsHex(str)) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "(" + str + ") doesn't represent a correct hex:\n");
+    }
+    AccountHistoryKey key;
+    try {
+        CDataStream ss(ParseHex(str), SER_DISK, CLIENT_VERSION);
+        ss >> key;
+        if (!ss.empty()) {
+            throw std::ios_base::failure("unexpected trailing data");
+        }
+    } catch (const std::ios_base::failure &) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "(" + str + ") doesn't represent a correct cursor");
+    }
+    return key;
+}
+
 static UniValue DecodeRecipientsGetRecipients(const UniValue &values) {
     UniValue recipients(UniValue::VOBJ);
     for (const auto &key : values.getKeys()) {
@@ -429,7 +485,7 @@ UniValue listaccounts(const JSONRPCRequest &request) {
         isMineOnly = request.params[3].get_bool();
     }
 
-    UniValue ret(UniValue::VARR);
+    RPCResultWriter ret(request, UniValue::VARR);
 
     auto [view, accountView, vaultView] = GetSnapshots();
     auto targetHeight = view->GetLastHeight() + 1;
@@ -460,7 +516,7 @@ UniValue listaccounts(const JSONRPCRequest &request) {
         },
         start.owner);
 
-    return GetRPCResultCache().Set(request, ret);
+    return GetRPCResultCache().Set(request, ret.get());
 }
 
 UniValue getaccount(const JSONRPCRequest &request) {
@@ -1278,10 +1334,17 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
                      RPCArg::Type::STR,
                      RPCArg::Optional::OMITTED,
                      "Return amounts with the following: 'id' -> <amount>@id; (default)'symbol' -> <amount>@symbol"},
+                    {"cursor",
+                     RPCArg::Type::STR,
+                     RPCArg::Optional::OMITTED,
+                     "Page through the history of a single owner with no_rewards. Empty for the first page, then the "
+                     "\"next\" value of the previous page. Wallet transactions are not included"},
 
                 },
             }, },
-        RPCResult{"[{},{}...]     (array) Objects with account history information\n"},
+        RPCResult{"[{},{}...]     (array) Objects with account history information\n"
+                  "{\"history\":[{},{}...],\"next\":\"cursor\"}     (object) With cursor, \"next\" is omitted on the "
+                  "last page\n"},
         RPCExamples{HelpExampleCli("listaccounthistory", "all '{\"maxBlockHeight\":160,\"depth\":10}'") +
                     HelpExampleRpc("listaccounthistory", "address false")},
     }
@@ -1306,6 +1369,8 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
     bool includingStart = true;
     uint32_t txn = std::numeric_limits<uint32_t>::max();
     AmountFormat format = AmountFormat::Symbol;
+    bool hasCursor = false;
+    std::optional<AccountHistoryKey> cursor;
 
     if (request.params.size() > 1) {
         UniValue optionsObj = request.params[1].get_obj();
@@ -1321,7 +1386,8 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
                             {"start",           UniValueType(UniValue::VNUM) },
                             {"including_start", UniValueType(UniValue::VBOOL)},
                             {"txn",             UniValueType(UniValue::VNUM) },
-                            {"format",          UniValueType(UniValue::VSTR) }
+                            {"format",          UniValueType(UniValue::VSTR) },
+                            {"cursor",          UniValueType(UniValue::VSTR) }
         },
                         true,
                         true);
@@ -1391,6 +1457,13 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
             }
         }
 
+        if (!optionsObj["cursor"].isNull()) {
+            hasCursor = true;
+            if (const auto cursorStr = optionsObj["cursor"].get_str(); !cursorStr.empty()) {
+                cursor = decodeHistoryCursor(cursorStr);
+            }
+        }
+
         if (!includingStart) {
             start++;
         }
@@ -1423,10 +1496,19 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
         }
     }
 
+    if (hasCursor) {
+        if (!noRewards || accountSet.size() != 1 || accountSet.begin()->empty()) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "cursor requires a single owner and no_rewards");
+        }
+        if (cursor && cursor->owner != *accountSet.begin()) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "cursor belongs to another owner");
+        }
+    }
+
     std::set<uint256> txs;
-    const bool shouldSearchInWallet = (tokenFilter.empty() || tokenFilter == "DFI") && !hasTxFilter;
+    const bool shouldSearchInWallet = (tokenFilter.empty() || tokenFilter == "DFI") && !hasTxFilter && !hasCursor;
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     auto hasToken = [&, &view = view](const TAmounts &diffs) {
         for (auto const &diff : diffs) {
@@ -1440,17 +1522,80 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
     };
 
     std::map<uint32_t, UniValue, std::greater<>> ret;
+    std::optional<AccountHistoryKey> nextKey;
     const uint32_t height = view->GetLastHeight();
 
     maxBlockHeight = std::min(maxBlockHeight, height);
     depth = std::min(depth, maxBlockHeight);
 
+    UniValue history(UniValue::VARR);
+    RPCResultWriter slice(request, UniValue::VARR);
+
+    // Hands out the merged records above height in order, skipping start and up to limit of them
+    auto flushAbove = [&](const int64_t above) {
+        for (auto it = ret.begin(); it != ret.end() && it->first > above; it = ret.erase(it)) {
+            for (const auto &item : it->second.getValues()) {
+                if (limit == 0) {
+                    break;
+                }
+                if (start != 0) {
+                    --start;
+                    continue;
+                }
+                if (hasCursor) {
+                    history.push_back(item);
+                } else {
+                    slice.push_back(item);
+                }
+                --limit;
+            }
+        }
+    };
+
     for (const auto &account : accountSet) {
         const auto startBlock = maxBlockHeight - depth;
         auto shouldSkipBlock = [startBlock, maxBlockHeight](uint32_t blockHeight) {
             return startBlock > blockHeight || blockHeight > maxBlockHeight;
         };
 
+        // Records of a single owner come in descending height, so while the last owner is read everything
+        // above its current height is final and can be handed out instead of merged into ret first
+        const auto mergeWhileReading = !account.empty() && &account == &*accountSet.rbegin();
+
+        // Wallet entries are read first to be merged by height, those already in the history are left out then
+        std::map<uint32_t, std::vector<std::pair<uint256, UniValue>>, std::greater<>> walletEntries;
+        if (shouldSearchInWallet) {
+            searchInWallet(
+                pwallet,
+                account,
+                filter,
+                [&](const CBlockIndex *index, const CWalletTx *pwtx) {
+                    uint32_t height = index->nHeight;
+                    return startBlock > height || height > maxBlockHeight;
+                },
+                [&, &view = view](const COutputEntry &entry, const CBlockIndex *index, const CWalletTx *pwtx) {
+                    uint32_t height = index->nHeight;
+                    uint32_t nIndex = pwtx->nIndex;
+                    if (txn != std::numeric_limits<uint32_t>::max() && height == maxBlockHeight && nIndex > txn) {
+                        return true;
+                    }
+                    walletEntries[height].emplace_back(pwtx->GetHash(),
+                                                       outputEntryToJSON(*view, entry, index, pwtx, format));
+                    return true;
+                });
+        }
+
+        auto mergeWalletAbove = [&](const int64_t above) {
+            for (auto it = walletEntries.begin(); it != walletEntries.end() && it->first > above;
+                 it = walletEntries.erase(it)) {
+                for (auto &[txid, item] : it->second) {
+                    if (!txs.count(txid)) {
+                        ret.emplace(it->first, UniValue::VARR).first->second.push_back(std::move(item));
+                    }
+                }
+            }
+        };
+
         CScript lastOwner;
         auto count = limit + start;
         auto lastHeight = maxBlockHeight;
@@ -1461,8 +1606,8 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
             isMatchOwner = [](const CScript &owner) { return true; };
         }
 
-        auto shouldContinueToNextAccountHistory = [&, &view = view](const AccountHistoryKey &key,
-                                                                    AccountHistoryValue value) -> bool {
+        auto shouldContinueToNextAccountHistory = [&, &view = view, tip = tip](const AccountHistoryKey &key,
+                                                                               AccountHistoryValue value) -> bool {
             if (!isMatchOwner(key.owner)) {
                 return false;
             }
@@ -1510,7 +1655,7 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
 
             if (accountRecord && (tokenFilter.empty() || hasToken(value.diff))) {
                 auto &array = ret.emplace(workingHeight, UniValue::VARR).first->second;
-                array.push_back(accounthistoryToJSON(*view, key, value, format));
+                array.push_back(accounthistoryToJSON(*view, tip, key, value, format));
                 if (shouldSearchInWallet) {
                     txs.insert(value.txid);
                 }
@@ -1528,7 +1673,7 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
                                   })) {
                                       auto &array = ret.emplace(height, UniValue::VARR).first->second;
                                       array.push_back(
-                                          rewardhistoryToJSON(*view, key.owner, height, poolId, type, amount, format));
+                                          rewardhistoryToJSON(*view, tip, key.owner, height, poolId, type, amount, format));
                                       count ? --count : 0;
                                   }
                               });
@@ -1536,6 +1681,11 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
 
             lastHeight = workingHeight;
 
+            if (mergeWhileReading) {
+                mergeWalletAbove(workingHeight);
+                flushAbove(workingHeight);
+            }
+
             return count != 0 || isMine;
         };
 
@@ -1555,45 +1705,69 @@ UniValue listaccounthistory(const JSONRPCRequest &request) {
                 account);
         }
 
-        accountView->ForEachAccountHistory(shouldContinueToNextAccountHistory, account, maxBlockHeight, txn);
+        // A cursor resumes at the first record not returned yet, reading one record past the page to find it
+        auto seekHeight = maxBlockHeight;
+        auto seekTxn = txn;
+        if (cursor) {
+            seekHeight = cursor->blockHeight;
+            seekTxn = cursor->txn;
+        }
 
-        if (shouldSearchInWallet) {
-            count = limit + start;
-            searchInWallet(
-                pwallet,
-                account,
-                filter,
-                [&](const CBlockIndex *index, const CWalletTx *pwtx) {
-                    uint32_t height = index->nHeight;
-                    return txs.count(pwtx->GetHash()) || startBlock > height || height > maxBlockHeight;
-                },
-                [&, &view = view](const COutputEntry &entry, const CBlockIndex *index, const CWalletTx *pwtx) {
-                    uint32_t height = index->nHeight;
-                    uint32_t nIndex = pwtx->nIndex;
-                    if (txn != std::numeric_limits<uint32_t>::max() && height == maxBlockHeight && nIndex > txn) {
-                        return true;
-                    }
-                    auto &array = ret.emplace(index->nHeight, UniValue::VARR).first->second;
-                    array.push_back(outputEntryToJSON(*view, entry, index, pwtx, format));
-                    return --count != 0;
-                });
+        auto shouldContinueToNextPageRecord = [&](const AccountHistoryKey &key, AccountHistoryValue value) -> bool {
+            if (key.owner != account || key.blockHeight < startBlock) {
+                return false;
+            }
+            if (count == 0) {
+                nextKey = key;
+                return false;
+            }
+            shouldContinueToNextAccountHistory(key, std::move(value));
+            return true;
+        };
+
+        std::function<bool(const AccountHistoryKey &, AccountHistoryValue)> onRecord =
+            shouldContinueToNextAccountHistory;
+        if (hasCursor) {
+            onRecord = shouldContinueToNextPageRecord;
         }
+
+        // Without rewards and wallet filtering records are independent, so the filter indexes can be used
+        const auto useIndex = noRewards && !isMine &&
+                              forEachFilteredAccountHistory(
+                                  *view,
+                                  *accountView,
+                                  [&](const AccountHistoryKey &key, AccountHistoryValue value) {
+                                      if (key.blockHeight < startBlock) {
+                                          return false;
+                                      }
+                                      return onRecord(key, std::move(value));
+                                  },
+                                  tokenFilter,
+                                  txTypes,
+                                  hasTxFilter,
+                                  account,
+                                  seekHeight,
+                                  seekTxn);
+
+        if (!useIndex) {
+            accountView->ForEachAccountHistory(onRecord, account, seekHeight, seekTxn);
+        }
+
+        mergeWalletAbove(-1);
     }
 
-    UniValue slice(UniValue::VARR);
-    for (auto it = ret.cbegin(); limit != 0 && it != ret.cend(); ++it) {
-        const auto &array = it->second.get_array();
-        for (size_t i = 0; limit != 0 && i < array.size(); ++i) {
-            if (start != 0) {
-                --start;
-                continue;
-            }
-            slice.push_back(array[i]);
-            --limit;
+    flushAbove(-1);
+
+    if (hasCursor) {
+        UniValue page(UniValue::VOBJ);
+        page.pushKV("history", history);
+        if (nextKey) {
+            page.pushKV("next", encodeHistoryCursor(*nextKey));
         }
+        return GetRPCResultCache().Set(request, page);
     }
 
-    return GetRPCResultCache().Set(request, slice);
+    return GetRPCResultCache().Set(request, slice.get());
 }
 
 UniValue getaccounthistory(const JSONRPCRequest &request) {
@@ -1623,13 +1797,12 @@ UniValue getaccounthistory(const JSONRPCRequest &request) {
     uint32_t blockHeight = request.params[1].get_int();
     uint32_t txn = request.params[2].get_int();
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     UniValue result(UniValue::VOBJ);
     AccountHistoryKey AccountKey{owner, blockHeight, txn};
-    LOCK(cs_main);
     if (auto value = accountView->ReadAccountHistory(AccountKey)) {
-        result = accounthistoryToJSON(*view, AccountKey, *value);
+        result = accounthistoryToJSON(*view, tip, AccountKey, *value);
     }
 
     return GetRPCResultCache().Set(request, result);
@@ -1731,7 +1904,7 @@ UniValue listburnhistory(const JSONRPCRequest &request) {
 
     std::set<uint256> txs;
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     auto hasToken = [&, &view = view](const TAmounts &diffs) {
         for (auto const &diff : diffs) {
@@ -1757,8 +1930,8 @@ UniValue listburnhistory(const JSONRPCRequest &request) {
 
     auto count = limit;
 
-    auto shouldContinueToNextAccountHistory = [&, &view = view](const AccountHistoryKey &key,
-                                                                AccountHistoryValue value) -> bool {
+    auto shouldContinueToNextAccountHistory = [&, &view = view, tip = tip](const AccountHistoryKey &key,
+                                                                           AccountHistoryValue value) -> bool {
         if (!isMatchOwner(key.owner)) {
             return false;
         }
@@ -1776,7 +1949,7 @@ UniValue listburnhistory(const JSONRPCRequest &request) {
         }
 
         auto &array = ret.emplace(key.blockHeight, UniValue::VARR).first->second;
-        array.push_back(accounthistoryToJSON(*view, key, value));
+        array.push_back(accounthistoryToJSON(*view, tip, key, value));
 
         --count;
 
@@ -1943,7 +2116,23 @@ UniValue accounthistorycount(const JSONRPCRequest &request) {
 
     uint64_t count{};
 
+    // Records per transaction type are counted on write when the filter indexes are enabled
+    const auto useCounts =
+        noRewards && tokenFilter.empty() && hasTxFilter && accounts != "mine" && accountView->HasSecondaryIndexes();
+
     for (const auto &owner : accountSet) {
+        if (useCounts) {
+            accountView->ForEachAccountHistoryCount(
+                [&](unsigned char category, uint64_t typeCount) {
+                    if (txTypes.count(CustomTxCodeToType(category))) {
+                        count += typeCount;
+                    }
+                    return true;
+                },
+                owner);
+            continue;
+        }
+
         CScript lastOwner;
         uint32_t lastHeight = view->GetLastHeight();
         const auto currentHeight = lastHeight;
@@ -1997,7 +2186,18 @@ UniValue accounthistorycount(const JSONRPCRequest &request) {
             return true;
         };
 
-        accountView->ForEachAccountHistory(shouldContinueToNextAccountHistory, owner, currentHeight);
+        const auto useIndex = noRewards && forEachFilteredAccountHistory(*view,
+                                                                         *accountView,
+                                                                         shouldContinueToNextAccountHistory,
+                                                                         tokenFilter,
+                                                                         txTypes,
+                                                                         hasTxFilter,
+                                                                         owner,
+                                                                         currentHeight);
+
+        if (!useIndex) {
+            accountView->ForEachAccountHistory(shouldContinueToNextAccountHistory, owner, currentHeight);
+        }
 
         if (shouldSearchInWallet) {
             searchInWallet(
@@ -2537,8 +2737,6 @@ UniValue getburninfo(const JSONRPCRequest &request) {
     if (auto res = GetRPCResultCache().TryGet(request)) {
         return *res;
     }
-    auto initialResult = GetMemoizedResultCache().GetOrDefault(request);
-    auto totalResult = std::get_if<CGetBurnInfoResult>(&initialResult.data);
 
     CAmount dfiPaybackFee{0};
     CAmount burnt{0};
@@ -2551,11 +2749,6 @@ UniValue getburninfo(const JSONRPCRequest &request) {
 
     auto [view, accountView, vaultView] = GetSnapshots();
     const auto height = view->GetLastHeight();
-    uint256 hash;
-    {
-        LOCK(cs_main);
-        hash = ::ChainActive().Tip()->GetBlockHash();
-    }
     auto fortCanningHeight = Params().GetConsensus().DF11FortCanningHeight;
     auto burnAddress = Params().GetConsensus().burnAddress;
     const auto attributes = view->GetAttributes();
@@ -2587,133 +2780,18 @@ UniValue getburninfo(const JSONRPCRequest &request) {
         }
     }
 
-    auto nWorkers = DfTxTaskPool->GetAvailableThreads();
-    if (static_cast<size_t>(height) < nWorkers) {
-        nWorkers = height;
-    }
-
-    const auto chunkSize = height / nWorkers;
-
-    TaskGroup g;
-    BufferPool<CGetBurnInfoResult> resultsPool{nWorkers};
-
-    LOCK(cs_main);  // Lock for pburnHistoryDB
-
-    auto &pool = DfTxTaskPool->pool;
-    auto processedHeight = initialResult.height;
-    auto i = 0;
-    while (processedHeight < height) {
-        auto startHeight = initialResult.height + (chunkSize * (i + 1));
-        auto stopHeight = initialResult.height + (chunkSize * (i));
-
-        g.AddTask();
-        boost::asio::post(pool, [startHeight, stopHeight, &g, &resultsPool] {
-            auto currentResult = resultsPool.Acquire();
-
-            pburnHistoryDB->ForEachAccountHistory(
-                [currentResult, stopHeight](const AccountHistoryKey &key, const AccountHistoryValue &value) {
-                    // Stop on chunk range for worker
-                    if (key.blockHeight <= stopHeight) {
-                        return false;
-                    }
-
-                    // UTXO burn
-                    if (value.category == uint8_t(CustomTxType::None)) {
-                        for (auto const &diff : value.diff) {
-                            currentResult->burntDFI += diff.second;
-                        }
-                        return true;
-                    }
-
-                    // Fee burn
-                    if (value.category == uint8_t(CustomTxType::CreateMasternode) ||
-                        value.category == uint8_t(CustomTxType::CreateToken) ||
-                        value.category == uint8_t(CustomTxType::Vault) ||
-                        value.category == uint8_t(CustomTxType::CreateCfp) ||
-                        value.category == uint8_t(CustomTxType::CreateVoc)) {
-                        for (auto const &diff : value.diff) {
-                            currentResult->burntFee += diff.second;
-                        }
-                        return true;
-                    }
-
-                    // withdraw burn
-                    if (value.category == uint8_t(CustomTxType::PaybackLoan) ||
-                        value.category == uint8_t(CustomTxType::PaybackLoanV2) ||
-                        value.category == uint8_t(CustomTxType::PaybackWithCollateral)) {
-                        for (const auto &[id, amount] : value.diff) {
-                            currentResult->paybackFee.Add({id, amount});
-                        }
-                        return true;
-                    }
-
-                    // auction burn
-                    if (value.category == uint8_t(CustomTxType::AuctionBid)) {
-                        for (auto const &diff : value.diff) {
-                            currentResult->auctionFee += diff.second;
-                        }
-                        return true;
-                    }
-
-                    // dex fee burn
-                    if (value.category == uint8_t(CustomTxType::PoolSwap) ||
-                        value.category == uint8_t(CustomTxType::PoolSwapV2)) {
-                        for (auto const &diff : value.diff) {
-                            currentResult->dexfeeburn.Add({diff.first, diff.second});
-                        }
-                        return true;
-                    }
-
-                    // token burn with burnToken tx
-                    if (value.category == uint8_t(CustomTxType::BurnToken)) {
-                        for (auto const &diff : value.diff) {
-                            currentResult->burntTokens.Add({diff.first, diff.second});
-                        }
-                        return true;
-                    }
-
-                    // Token burn
-                    for (auto const &diff : value.diff) {
-                        currentResult->burntTokens.Add({diff.first, diff.second});
-                    }
-
-                    return true;
-                },
-                {},
-                startHeight,
-                std::numeric_limits<uint32_t>::max());
-
-            resultsPool.Release(currentResult);
-            g.RemoveTask();
-        });
-
-        // perfect accuracy: processedHeight += (startHeight > height) ? chunksRemainder : chunkSize;
-        processedHeight += chunkSize;
-        i++;
-    }
-
-    g.WaitForCompletion();
-
-    for (const auto &r : resultsPool.GetBuffer()) {
-        totalResult->burntDFI += r->burntDFI;
-        totalResult->burntFee += r->burntFee;
-        totalResult->auctionFee += r->auctionFee;
-        totalResult->burntTokens.AddBalances(r->burntTokens.balances);
-        totalResult->dexfeeburn.AddBalances(r->dexfeeburn.balances);
-        totalResult->paybackFee.AddBalances(r->paybackFee.balances);
-    }
-
-    GetMemoizedResultCache().Set(request, {height, hash, *totalResult});
+    // Burn history totals are kept up to date as blocks connect
+    const auto burnInfo = view->GetBurnInfo();
 
     UniValue result(UniValue::VOBJ);
     result.pushKV("address", ScriptToString(burnAddress));
-    result.pushKV("amount", ValueFromAmount(totalResult->burntDFI));
+    result.pushKV("amount", ValueFromAmount(burnInfo.burntDFI));
 
-    result.pushKV("tokens", AmountsToJSON(*view, totalResult->burntTokens.balances));
-    result.pushKV("feeburn", ValueFromAmount(totalResult->burntFee));
-    result.pushKV("auctionburn", ValueFromAmount(totalResult->auctionFee));
-    result.pushKV("paybackburn", AmountsToJSON(*view, totalResult->paybackFee.balances));
-    result.pushKV("dexfeetokens", AmountsToJSON(*view, totalResult->dexfeeburn.balances));
+    result.pushKV("tokens", AmountsToJSON(*view, burnInfo.burntTokens.balances));
+    result.pushKV("feeburn", ValueFromAmount(burnInfo.burntFee));
+    result.pushKV("auctionburn", ValueFromAmount(burnInfo.auctionFee));
+    result.pushKV("paybackburn", AmountsToJSON(*view, burnInfo.paybackFee.balances));
+    result.pushKV("dexfeetokens", AmountsToJSON(*view, burnInfo.dexfeeburn.balances));
 
     result.pushKV("dfipaybackfee", ValueFromAmount(dfiPaybackFee));
     result.pushKV("dfipaybacktokens", AmountsToJSON(*view, dfipaybacktokens.balances));
@@ -218,7 +218,7 @@ UniValue vmmap(const JSONRPCRequest &request) {
         throwInvalidParam();
     }
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     auto tryResolveMapBlockOrTxResult = [&view = view](ResVal<std::string> &res, const std::string &input) {
         res = view->GetVMDomainTxEdge(VMDomainEdge::DVMToEVM, input);
@@ -250,7 +250,7 @@ UniValue vmmap(const JSONRPCRequest &request) {
         }
     };
 
-    auto tryResolveBlockNumberType = [](const std::string &input) {
+    auto tryResolveBlockNumberType = [tip = tip](const std::string &input) {
         uint64_t height;
         if (!ParseUInt64(input, &height)) {
             return VMDomainRPCMapType::Unknown;
@@ -258,11 +258,7 @@ UniValue vmmap(const JSONRPCRequest &request) {
 
         CrossBoundaryResult evmResult;
         evm_try_get_block_hash_by_number(evmResult, height);
-        CBlockIndex *dvmBlock;
-        {
-            LOCK(cs_main);
-            dvmBlock = ::ChainActive()[static_cast<int>(height)];
-        }
+        const auto dvmBlock = tip->GetAncestor(static_cast<int>(height));
         if (evmResult.ok && dvmBlock != nullptr) {
             return VMDomainRPCMapType::Unknown;
         } else if (evmResult.ok) {
@@ -308,18 +304,14 @@ UniValue vmmap(const JSONRPCRequest &request) {
     };
 
     auto handleMapBlockNumberDVMToEVMRequest =
-        [&view = view, &throwInvalidParam, &crossBoundaryOkOrThrow](const std::string &input) {
+        [&view = view, tip = tip, &throwInvalidParam, &crossBoundaryOkOrThrow](const std::string &input) {
             uint64_t height;
-            const int current_tip = ::ChainActive().Height();
+            const int current_tip = tip->nHeight;
             bool success = ParseUInt64(input, &height);
             if (!success || height < 0 || height > static_cast<uint64_t>(current_tip)) {
                 throwInvalidParam(DeFiErrors::InvalidBlockNumberString(input).msg);
             }
-            CBlockIndex *pindex;
-            {
-                LOCK(cs_main);
-                pindex = ::ChainActive()[static_cast<int>(height)];
-            }
+            const auto pindex = tip->GetAncestor(static_cast<int>(height));
             auto evmBlockHash = view->GetVMDomainBlockEdge(VMDomainEdge::DVMToEVM, pindex->GetBlockHash().GetHex());
             if (!evmBlockHash.val.has_value()) {
                 throwInvalidParam(evmBlockHash.msg);
@@ -1513,15 +1513,10 @@ UniValue getloaninfo(const JSONRPCRequest &request) {
     }
     UniValue ret{UniValue::VOBJ};
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, lastBlockTime] = GetRpcReadContext();
     auto height = view->GetLastHeight() + 1;
 
     bool useNextPrice = false, requireLivePrice = true;
-    int64_t lastBlockTime{};
-    {
-        LOCK(cs_main);
-        lastBlockTime = ::ChainActive().Tip()->GetBlockTime();
-    }
 
     uint64_t totalCollateralValue = 0, totalLoanValue = 0, totalVaults = 0, totalAuctions = 0, totalLoanSchemes = 0,
              totalCollateralTokens = 0, totalLoanTokens = 0;
@@ -1585,7 +1580,8 @@ UniValue getloaninfo(const JSONRPCRequest &request) {
     std::atomic<uint64_t> colsValTotal{0};
     std::atomic<uint64_t> loansValTotal{0};
 
-    view->ForEachVault([&, &view = view](const CVaultId &vaultId, const CVaultData &data) {
+    view->ForEachVault([&, &view = view, lastBlockTime = lastBlockTime](const CVaultId &vaultId,
+                                                                        const CVaultData &data) {
         g.AddTask();
         boost::asio::post(pool,
                           [&,
@@ -1595,7 +1591,8 @@ UniValue getloaninfo(const JSONRPCRequest &request) {
                            vaultId = vaultId,
                            height = height,
                            useNextPrice = useNextPrice,
-                           requireLivePrice = requireLivePrice] {
+                           requireLivePrice = requireLivePrice,
+                           lastBlockTime = lastBlockTime] {
                               auto collaterals = view->GetVaultCollaterals(vaultId);
                               if (!collaterals) {
                                   collaterals = CBalances{};
@@ -1,4 +1,5 @@
 #include <dfi/accountshistory.h>
+#include <dfi/anchors.h>
 #include <dfi/mn_rpc.h>
 #include <dfi/vaulthistory.h>
 
@@ -710,7 +711,7 @@ UniValue getmasternodeblocks(const JSONRPCRequest &request) {
         ++idCount;
     }
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     if (!identifier["ownerAddress"].isNull()) {
         CKeyID ownerAddressID;
@@ -775,7 +776,7 @@ UniValue getmasternodeblocks(const JSONRPCRequest &request) {
     depth = std::min(depth, currentHeight);
     auto startBlock = currentHeight - depth;
 
-    auto masternodeBlocks = [&](const uint256 &masternodeID, int blockHeight) {
+    auto masternodeBlocks = [&, tip = tip](const uint256 &masternodeID, int blockHeight) {
         if (masternodeID != mn_id) {
             return false;
         }
@@ -784,16 +785,14 @@ UniValue getmasternodeblocks(const JSONRPCRequest &request) {
             return true;
         }
 
-        if (auto tip = ::ChainActive()[blockHeight]; tip) {
-            lastHeight = tip->nHeight;
-            mintedBlocks.emplace(lastHeight, tip->GetBlockHash());
+        if (auto block = tip->GetAncestor(blockHeight); block) {
+            lastHeight = block->nHeight;
+            mintedBlocks.emplace(lastHeight, block->GetBlockHash());
         }
 
         return true;
     };
 
-    LOCK(cs_main);
-
     view->ForEachSubNode([&](const SubNodeBlockTimeKey &key,
                              CLazySerialize<int64_t>) { return masternodeBlocks(key.masternodeID, key.blockHeight); },
                          SubNodeBlockTimeKey{mn_id, 0, std::numeric_limits<uint32_t>::max()});
@@ -804,12 +803,12 @@ UniValue getmasternodeblocks(const JSONRPCRequest &request) {
         },
         MNBlockTimeKey{mn_id, std::numeric_limits<uint32_t>::max()});
 
-    auto tip = ::ChainActive()[std::min(lastHeight, Params().GetConsensus().DF7DakotaCrescentHeight) - 1];
+    auto block = tip->GetAncestor(std::min(lastHeight, Params().GetConsensus().DF7DakotaCrescentHeight) - 1);
 
-    for (; tip && tip->nHeight > creationHeight && tip->nHeight > startBlock; tip = tip->pprev) {
-        auto id = view->GetMasternodeIdByOperator(tip->minterKey());
+    for (; block && block->nHeight > creationHeight && block->nHeight > startBlock; block = block->pprev) {
+        auto id = view->GetMasternodeIdByOperator(block->minterKey());
         if (id && *id == mn_id) {
-            mintedBlocks.emplace(tip->nHeight, tip->GetBlockHash());
+            mintedBlocks.emplace(block->nHeight, block->GetBlockHash());
         }
     }
 
@@ -889,6 +888,40 @@ UniValue getanchorteams(const JSONRPCRequest &request) {
     return GetRPCResultCache().Set(request, result);
 }
 
+UniValue getanchorauthstats(const JSONRPCRequest &request) {
+    RPCHelpMan{
+        "getanchorauthstats",
+        "\nReturns anchor auth processing and signature recovery statistics since node start\n",
+        {},
+        RPCResult{"{                              (json object)\n"
+                  "  \"auths\": n,                  (numeric) Anchor auth messages processed\n"
+                  "  \"authavgus\": n,              (numeric) Average time per auth message in microseconds\n"
+                  "  \"authmaxus\": n,              (numeric) Slowest auth message in microseconds\n"
+                  "  \"anchors\": n,                (numeric) Pending anchor signature sets checked\n"
+                  "  \"anchoravgus\": n,            (numeric) Average time per anchor in microseconds\n"
+                  "  \"anchormaxus\": n,            (numeric) Slowest anchor in microseconds\n"
+                  "  \"recovered\": n,              (numeric) Signers recovered from signatures\n"
+                  "  \"cachehits\": n,              (numeric) Signers found in the signer cache\n"
+                  "}\n"},
+        RPCExamples{HelpExampleCli("getanchorauthstats", "") + HelpExampleRpc("getanchorauthstats", "")},
+    }
+        .Check(request);
+
+    const auto stats = g_anchorSignerCache.GetStats();
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("auths", stats.auths);
+    result.pushKV("authavgus", stats.auths ? stats.authMicros / static_cast<int64_t>(stats.auths) : 0);
+    result.pushKV("authmaxus", stats.authMaxMicros);
+    result.pushKV("anchors", stats.anchors);
+    result.pushKV("anchoravgus", stats.anchors ? stats.anchorMicros / static_cast<int64_t>(stats.anchors) : 0);
+    result.pushKV("anchormaxus", stats.anchorMaxMicros);
+    result.pushKV("recovered", stats.recovered);
+    result.pushKV("cachehits", stats.cacheHits);
+
+    return result;
+}
+
 UniValue getactivemasternodecount(const JSONRPCRequest &request) {
     RPCHelpMan{
         "getactivemasternodecount",
@@ -913,13 +946,8 @@ UniValue getactivemasternodecount(const JSONRPCRequest &request) {
 
     std::set<uint256> masternodes;
 
-    CBlockIndex *pindex;
-    {
-        LOCK(cs_main);
-        pindex = ::ChainActive().Tip();
-    }
-
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
+    auto pindex = tip;
 
     // Get active MNs from last week's worth of blocks
     for (int i{0}; pindex && i < blockSample; pindex = pindex->pprev, ++i) {
@@ -985,6 +1013,7 @@ static const CRPCCommand commands[] = {
     {"masternodes", "getmasternode",            &getmasternode,            {"mn_id"}                                    },
     {"masternodes", "getmasternodeblocks",      &getmasternodeblocks,      {"identifier", "depth"}                      },
     {"masternodes", "getanchorteams",           &getanchorteams,           {"blockHeight"}                              },
+    {"masternodes", "getanchorauthstats",       &getanchorauthstats,       {}                                           },
     {"masternodes", "getactivemasternodecount", &getactivemasternodecount, {"blockCount"}                               },
     {"masternodes", "listanchors",              &listanchors,              {}                                           },
 };
@@ -834,49 +834,53 @@ UniValue listlatestrawprices(const JSONRPCRequest &request) {
         tokenPair = DecodeTokenCurrencyPair(request.params[0]);
     }
 
-    int64_t lastBlockTime{};
-    {
-        LOCK(cs_main);
-        lastBlockTime = ::ChainActive().Tip()->GetBlockTime();
-    }
-
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, lastBlockTime] = GetRpcReadContext();
 
     UniValue result(UniValue::VARR);
+    auto rawPriceToJSON = [&, lastBlockTime = lastBlockTime](const CTokenCurrencyPair &tokenCurrency,
+                                                              const COracleId &oracleId,
+                                                              uint8_t weightage,
+                                                              CAmount amount,
+                                                              int64_t timestamp) {
+        UniValue value{UniValue::VOBJ};
+        value.pushKV(oraclefields::PriceFeeds, PriceFeedToJSON(tokenCurrency));
+        value.pushKV(oraclefields::OracleId, oracleId.GetHex());
+        value.pushKV(oraclefields::Weightage, weightage);
+        value.pushKV(oraclefields::Timestamp, timestamp);
+        value.pushKV(oraclefields::RawPrice, ValueFromAmount(amount));
+        auto state = diffInHour(timestamp, lastBlockTime) ? oraclefields::Alive : oraclefields::Expired;
+        value.pushKV(oraclefields::State, state);
+        result.push_back(value);
+        limit--;
+    };
+
+    // A single pair is read from the price index, in the same oracle order
+    if (tokenPair) {
+        view->ForEachOraclePairPrice(
+            [&](const COraclePairPriceKey &key, COraclePairPrice price) {
+                if (key.priceFeedId != *tokenPair) {
+                    return false;
+                }
+                if (!including_start) {
+                    including_start = true;
+                    return true;
+                }
+                rawPriceToJSON(key.priceFeedId, key.oracleId, price.weightage, price.price, price.timestamp);
+                return limit != 0;
+            },
+            COraclePairPriceKey{*tokenPair, start});
+        return GetRPCResultCache().Set(request, result);
+    }
+
     view->ForEachOracle(
         [&](const COracleId &oracleId, COracle oracle) {
             if (!including_start) {
                 including_start = true;
                 return (true);
             }
-            if (tokenPair && !oracle.SupportsPair(tokenPair->first, tokenPair->second)) {
-                return true;
-            }
-            for (const auto &tokenPrice : oracle.tokenPrices) {
-                const auto &token = tokenPrice.first;
-                if (tokenPair && tokenPair->first != token) {
-                    continue;
-                }
-                for (const auto &price : tokenPrice.second) {
-                    const auto &currency = price.first;
-                    if (tokenPair && tokenPair->second != currency) {
-                        continue;
-                    }
-                    const auto &pricePair = price.second;
-                    auto amount = pricePair.first;
-                    auto timestamp = pricePair.second;
-
-                    UniValue value{UniValue::VOBJ};
-                    auto tokenCurrency = std::make_pair(token, currency);
-                    value.pushKV(oraclefields::PriceFeeds, PriceFeedToJSON(tokenCurrency));
-                    value.pushKV(oraclefields::OracleId, oracleId.GetHex());
-                    value.pushKV(oraclefields::Weightage, oracle.weightage);
-                    value.pushKV(oraclefields::Timestamp, timestamp);
-                    value.pushKV(oraclefields::RawPrice, ValueFromAmount(amount));
-                    auto state = diffInHour(timestamp, lastBlockTime) ? oraclefields::Alive : oraclefields::Expired;
-                    value.pushKV(oraclefields::State, state);
-                    result.push_back(value);
-                    limit--;
+            for (const auto &[token, prices] : oracle.tokenPrices) {
+                for (const auto &[currency, pricePair] : prices) {
+                    rawPriceToJSON({token, currency}, oracleId, oracle.weightage, pricePair.first, pricePair.second);
                 }
             }
             return limit != 0;
@@ -885,6 +889,35 @@ UniValue listlatestrawprices(const JSONRPCRequest &request) {
     return GetRPCResultCache().Set(request, result);
 }
 
+namespace {
+
+    struct CAggregatePrice {
+        arith_uint256 weightedSum = 0;
+        uint64_t numLiveOracles = 0, sumWeights = 0;
+
+        void Add(const COraclePairPrice &price, uint64_t lastBlockTime) {
+            if (!diffInHour(price.timestamp, lastBlockTime)) {
+                return;
+            }
+            ++numLiveOracles;
+            sumWeights += price.weightage;
+            weightedSum += arith_uint256(price.price) * arith_uint256(price.weightage);
+        }
+
+        ResVal<CAmount> Get() const {
+            static const uint64_t minimumLiveOracles = Params().NetworkIDString() == CBaseChainParams::REGTEST ? 1 : 2;
+            if (numLiveOracles < minimumLiveOracles) {
+                return Res::Err("no live oracles for specified request");
+            }
+            if (sumWeights <= 0) {
+                return Res::Err("all live oracles which meet specified request, have zero weight");
+            }
+            return ResVal<CAmount>((weightedSum / arith_uint256(sumWeights)).GetLow64(), Res::Ok());
+        }
+    };
+
+}  // namespace
+
 ResVal<CAmount> GetAggregatePrice(CCustomCSView &view,
                                   const std::string &token,
                                   const std::string &currency,
@@ -893,45 +926,55 @@ ResVal<CAmount> GetAggregatePrice(CCustomCSView &view,
     if (token == "DUSD" && currency == "USD") {
         return ResVal<CAmount>(COIN, Res::Ok());
     }
-    arith_uint256 weightedSum = 0;
-    uint64_t numLiveOracles = 0, sumWeights = 0;
-    view.ForEachOracle([&](const COracleId &, COracle oracle) {
-        if (!oracle.SupportsPair(token, currency)) {
-            return true;
-        }
-        for (const auto &tokenPrice : oracle.tokenPrices) {
-            if (token != tokenPrice.first) {
-                continue;
-            }
-            for (const auto &price : tokenPrice.second) {
-                if (currency != price.first) {
-                    continue;
-                }
-                const auto &pricePair = price.second;
-                auto amount = pricePair.first;
-                auto timestamp = pricePair.second;
-                if (!diffInHour(timestamp, lastBlockTime)) {
-                    continue;
-                }
-                ++numLiveOracles;
-                sumWeights += oracle.weightage;
-                weightedSum += arith_uint256(amount) * arith_uint256(oracle.weightage);
+    const CTokenCurrencyPair priceFeedId{token, currency};
+    CAggregatePrice aggregate;
+    view.ForEachOraclePairPrice(
+        [&](const COraclePairPriceKey &key, COraclePairPrice price) {
+            if (key.priceFeedId != priceFeedId) {
+                return false;
             }
+            aggregate.Add(price, lastBlockTime);
+            return true;
+        },
+        COraclePairPriceKey{priceFeedId, {}});
+
+    return aggregate.Get();
+}
+
+std::map<CTokenCurrencyPair, ResVal<CAmount>> GetAggregatePrices(CCustomCSView &view, uint64_t lastBlockTime) {
+    std::map<CTokenCurrencyPair, CAggregatePrice> aggregates;
+    // Prices of a pair are adjacent in the index
+    CAggregatePrice *aggregate{};
+    const CTokenCurrencyPair *priceFeedId{};
+    view.ForEachOraclePairPrice([&](const COraclePairPriceKey &key, COraclePairPrice price) {
+        if (!aggregate || *priceFeedId != key.priceFeedId) {
+            auto it = aggregates.emplace(key.priceFeedId, CAggregatePrice{}).first;
+            priceFeedId = &it->first;
+            aggregate = &it->second;
         }
+        aggregate->Add(price, lastBlockTime);
         return true;
     });
 
-    static const uint64_t minimumLiveOracles = Params().NetworkIDString() == CBaseChainParams::REGTEST ? 1 : 2;
-    if (numLiveOracles < minimumLiveOracles) {
-        return Res::Err("no live oracles for specified request");
+    std::map<CTokenCurrencyPair, ResVal<CAmount>> prices;
+    for (const auto &[pair, aggregatePrice] : aggregates) {
+        prices.emplace(pair, aggregatePrice.Get());
     }
-    if (sumWeights <= 0) {
-        return Res::Err("all live oracles which meet specified request, have zero weight");
+    // DUSD-USD always returns 1.00000000
+    if (auto it = prices.find({"DUSD", "USD"}); it != prices.end()) {
+        it->second = ResVal<CAmount>(COIN, Res::Ok());
     }
+    return prices;
+}
 
-    ResVal<CAmount> res((weightedSum / arith_uint256(sumWeights)).GetLow64(), Res::Ok());
-
-    return res;
+ResVal<CAmount> GetAggregatePrice(CCustomCSView &view,
+                                  const std::map<CTokenCurrencyPair, ResVal<CAmount>> &prices,
+                                  const CTokenCurrencyPair &priceFeedId,
+                                  uint64_t lastBlockTime) {
+    if (auto it = prices.find(priceFeedId); it != prices.end()) {
+        return it->second;
+    }
+    return GetAggregatePrice(view, priceFeedId.first, priceFeedId.second, lastBlockTime);
 }
 
 namespace {
@@ -972,6 +1015,7 @@ namespace {
             throw JSONRPCError(RPC_MISC_ERROR, "start index greater than number of prices available");
         }
 
+        const auto prices = GetAggregatePrices(view, lastBlockTime);
         for (auto tokenCurrency :
              std::set<CTokenCurrencyPair>(std::next(setTokenCurrency.begin(), start), setTokenCurrency.end())) {
             UniValue item{UniValue::VOBJ};
@@ -979,7 +1023,7 @@ namespace {
             const auto &currency = tokenCurrency.second;
             item.pushKV(oraclefields::Token, token);
             item.pushKV(oraclefields::Currency, currency);
-            auto aggregatePrice = GetAggregatePrice(view, token, currency, lastBlockTime);
+            auto aggregatePrice = GetAggregatePrice(view, prices, tokenCurrency, lastBlockTime);
             if (aggregatePrice) {
                 item.pushKV(oraclefields::AggregatedPrice, ValueFromAmount(*aggregatePrice.val));
                 item.pushKV(oraclefields::ValidityFlag, oraclefields::FlagIsValid);
@@ -1027,13 +1071,7 @@ UniValue getprice(const JSONRPCRequest &request) {
 
     auto tokenPair = DecodeTokenCurrencyPair(request.params[0]);
 
-    int64_t lastBlockTime{};
-    {
-        LOCK(cs_main);
-        lastBlockTime = ::ChainActive().Tip()->GetBlockTime();
-    }
-
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, lastBlockTime] = GetRpcReadContext();
     auto result = GetAggregatePrice(*view, tokenPair.first, tokenPair.second, lastBlockTime);
     if (!result) {
         throw JSONRPCError(RPC_MISC_ERROR, result.msg);
@@ -1101,13 +1139,7 @@ UniValue listprices(const JSONRPCRequest &request) {
         paginationObj = request.params[0].get_obj();
     }
 
-    int64_t lastBlockTime{};
-    {
-        LOCK(cs_main);
-        lastBlockTime = ::ChainActive().Tip()->GetBlockTime();
-    }
-
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, lastBlockTime] = GetRpcReadContext();
     auto res = GetAllAggregatePrices(*view, lastBlockTime, paginationObj);
     return GetRPCResultCache().Set(request, res);
 }
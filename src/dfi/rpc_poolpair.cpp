@@ -1382,7 +1382,7 @@ UniValue listpoolshares(const JSONRPCRequest &request) {
     PoolShareKey startKey{start, CScript{}};
     auto [view, accountView, vaultView] = GetSnapshots();
 
-    UniValue ret(UniValue::VOBJ);
+    RPCResultWriter ret(request, UniValue::VOBJ);
     view->ForEachPoolShare(
         [&, &view = view](DCT_ID const &poolId, const CScript &provider, uint32_t) {
             const CTokenAmount tokenAmount = view->GetBalance(provider, poolId);
@@ -1405,7 +1405,7 @@ UniValue listpoolshares(const JSONRPCRequest &request) {
         },
         startKey);
 
-    return GetRPCResultCache().Set(request, ret);
+    return GetRPCResultCache().Set(request, ret.get());
 }
 
 UniValue listloantokenliquidity(const JSONRPCRequest &request) {
@@ -1422,10 +1422,10 @@ UniValue listloantokenliquidity(const JSONRPCRequest &request) {
         return *res;
     }
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     UniValue ret(UniValue::VARR);
-    const auto height = ::ChainActive().Height();
+    const auto height = tip->nHeight;
 
     const auto attributes = view->GetAttributes();
 
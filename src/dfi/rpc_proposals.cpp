@@ -970,7 +970,29 @@ UniValue listgovproposalvotes(const JSONRPCRequest &request) {
         throw JSONRPCError(RPC_INVALID_PARAMETER, "Incorrect cycle value");
     }
 
-    UniValue ret(UniValue::VARR);
+    RPCResultWriter ret(request, UniValue::VARR);
+
+    // Valid vote totals of the current cycle come straight from the vote tally
+    if (aggregate && validOnly && !isMine && mnId.IsNull() && !propId.IsNull() && inputCycle != -1) {
+        auto prop = view->GetProposal(propId);
+        if (prop && prop->status == CProposalStatusType::Voting && prop->cycle == cycle) {
+            std::set<uint256> activeMasternodes, inactiveMasternodes;
+            view->GetMintingMasternodes(view->GetLastHeight() + 1, activeMasternodes, inactiveMasternodes);
+            const auto tally = view->GetProposalVoteTally(propId, cycle, inactiveMasternodes);
+            if (tally.Valid()) {
+                UniValue stats(UniValue::VOBJ);
+
+                stats.pushKV("proposalId", propId.GetHex());
+                stats.pushKV("total", int32_t(tally.Valid()));
+                stats.pushKV("yes", int32_t(tally.yes));
+                stats.pushKV("neutral", int32_t(tally.neutral));
+                stats.pushKV("no", int32_t(tally.no));
+
+                ret.push_back(stats);
+            }
+            return ret.get();
+        }
+    }
 
     std::map<std::string, VotingInfo> map;
 
@@ -1076,7 +1098,7 @@ UniValue listgovproposalvotes(const JSONRPCRequest &request) {
         }
     }
 
-    return ret;
+    return ret.get();
 }
 
 UniValue getgovproposal(const JSONRPCRequest &request) {
@@ -1107,6 +1129,29 @@ UniValue getgovproposal(const JSONRPCRequest &request) {
         targetHeight = prop->cycleEndHeight;
     }
 
+    // Minting masternodes index and vote tallies reflect the tip only
+    if (prop->status == CProposalStatusType::Voting) {
+        std::set<uint256> activeMasternodes, inactiveMasternodes;
+        view->GetMintingMasternodes(targetHeight, activeMasternodes, inactiveMasternodes);
+        if (activeMasternodes.empty()) {
+            return proposalToJSON(propId, *prop, std::nullopt);
+        }
+
+        const auto tally = view->GetProposalVoteTally(propId, prop->cycle, inactiveMasternodes);
+        if (!tally.Valid()) {
+            return proposalToJSON(propId, *prop, std::nullopt);
+        }
+
+        VotingInfo info;
+        info.votesPossible = activeMasternodes.size();
+        info.votesPresent = tally.Valid();
+        info.votesYes = tally.yes;
+        info.votesNo = tally.no;
+        info.votesNeutral = tally.neutral;
+        info.votesInvalid = tally.invalid;
+        return proposalToJSON(propId, *prop, info);
+    }
+
     std::set<uint256> activeMasternodes;
     view->ForEachMasternode([&, &view = view](const uint256 &mnId, CMasternode node) {
         if (node.IsActive(targetHeight, *view) && node.mintedBlocks) {
@@ -52,13 +52,8 @@ namespace {
         return VaultState::Unknown;
     }
 
-    bool WillLiquidateNext(CCustomCSView &view, const CVaultId &vaultId, const CVaultData &vault) {
+    bool WillLiquidateNext(CCustomCSView &view, int64_t blockTime, const CVaultId &vaultId, const CVaultData &vault) {
         auto height = view.GetLastHeight();
-        int64_t blockTime{};
-        {
-            LOCK(cs_main);
-            blockTime = ::ChainActive()[height]->GetBlockTime();
-        }
 
         auto collaterals = view.GetVaultCollaterals(vaultId);
         if (!collaterals) {
@@ -75,11 +70,15 @@ namespace {
         return (vaultRate.val->ratio() < loanScheme->ratio);
     }
 
-    VaultState GetVaultState(CCustomCSView &view, const CVaultId &vaultId, const CVaultData &vault) {
+    // Block time is that of the block the view is at
+    VaultState GetVaultState(CCustomCSView &view,
+                             int64_t blockTime,
+                             const CVaultId &vaultId,
+                             const CVaultData &vault) {
         auto height = view.GetLastHeight();
         auto inLiquidation = vault.isUnderLiquidation;
         auto priceIsValid = IsVaultPriceValid(view, vaultId, height);
-        auto willLiquidateNext = WillLiquidateNext(view, vaultId, vault);
+        auto willLiquidateNext = WillLiquidateNext(view, blockTime, vaultId, vault);
 
         // Can possibly optimize with flags, but provides clarity for now.
         if (!inLiquidation && priceIsValid && !willLiquidateNext) {
@@ -131,11 +130,12 @@ namespace {
     }
 
     UniValue VaultToJSON(CCustomCSView &view,
+                         int64_t blockTime,
                          const CVaultId &vaultId,
                          const CVaultData &vault,
                          const bool verbose = false) {
         UniValue result{UniValue::VOBJ};
-        auto vaultState = GetVaultState(view, vaultId, vault);
+        auto vaultState = GetVaultState(view, blockTime, vaultId, vault);
         auto height = view.GetLastHeight();
 
         const auto scheme = view.GetLoanScheme(vault.schemeId);
@@ -158,11 +158,6 @@ namespace {
             collaterals = CBalances{};
         }
 
-        int64_t blockTime{};
-        {
-            LOCK(cs_main);
-            blockTime = ::ChainActive().Tip()->GetBlockTime();
-        }
         bool useNextPrice = false, requireLivePrice = vaultState != VaultState::Frozen;
 
         if (auto rate =
@@ -224,15 +219,15 @@ namespace {
                                 interestsPerBlockHighPrecission[tokenId] = rate->interestPerBlock;
                             } else {
                                 const auto interestPerBlock = rate->interestPerBlock.amount.GetLow64();
-                                interestsPerBlock.insert({tokenId, interestPerBlock});
+                                interestsPerBlock.emplace(tokenId, interestPerBlock);
                                 totalInterestsPerBlock +=
                                     MultiplyAmounts(price, static_cast<CAmount>(interestPerBlock));
                             }
                         }
                     }
 
-                    totalBalances.insert({tokenId, value});
-                    interestBalances.insert({tokenId, totalInterest});
+                    totalBalances.emplace(tokenId, value);
+                    interestBalances.emplace(tokenId, totalInterest);
                 }
                 if (view.AreTokensLocked({tokenId.v})) {
                     isVaultTokenLocked = true;
@@ -615,12 +610,12 @@ UniValue listvaults(const JSONRPCRequest &request) {
         }
     }
 
-    UniValue valueArr{UniValue::VARR};
+    RPCResultWriter valueArr(request, UniValue::VARR);
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     view->ForEachVault(
-        [&, &view = view](const CVaultId &vaultId, const CVaultData &data) {
+        [&, &view = view, blockTime = blockTime](const CVaultId &vaultId, const CVaultData &data) {
             if (!including_start) {
                 including_start = true;
                 return (true);
@@ -628,7 +623,7 @@ UniValue listvaults(const JSONRPCRequest &request) {
             if (!ownerAddress.empty() && ownerAddress != data.ownerAddress) {
                 return false;
             }
-            auto vaultState = GetVaultState(*view, vaultId, data);
+            auto vaultState = GetVaultState(*view, blockTime, vaultId, data);
 
             if ((loanSchemeId.empty() || loanSchemeId == data.schemeId) &&
                 (state == VaultState::Unknown || state == vaultState)) {
@@ -639,7 +634,7 @@ UniValue listvaults(const JSONRPCRequest &request) {
                     vaultObj.pushKV("loanSchemeId", data.schemeId);
                     vaultObj.pushKV("state", VaultStateToString(vaultState));
                 } else {
-                    vaultObj = VaultToJSON(*view, vaultId, data);
+                    vaultObj = VaultToJSON(*view, blockTime, vaultId, data);
                 }
                 valueArr.push_back(vaultObj);
                 limit--;
@@ -649,7 +644,7 @@ UniValue listvaults(const JSONRPCRequest &request) {
         start,
         ownerAddress);
 
-    return GetRPCResultCache().Set(request, valueArr);
+    return GetRPCResultCache().Set(request, valueArr.get());
 }
 
 UniValue getvault(const JSONRPCRequest &request) {
@@ -678,14 +673,14 @@ UniValue getvault(const JSONRPCRequest &request) {
         verbose = request.params[1].get_bool();
     }
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     auto vault = view->GetVault(vaultId);
     if (!vault) {
         throw JSONRPCError(RPC_DATABASE_ERROR, strprintf("Vault <%s> not found", vaultId.GetHex()));
     }
 
-    auto res = VaultToJSON(*view, vaultId, *vault, verbose);
+    auto res = VaultToJSON(*view, blockTime, vaultId, *vault, verbose);
     return GetRPCResultCache().Set(request, res);
 }
 
@@ -1240,7 +1235,7 @@ UniValue listauctions(const JSONRPCRequest &request) {
         }
     }
 
-    UniValue valueArr{UniValue::VARR};
+    RPCResultWriter valueArr(request, UniValue::VARR);
 
     auto [view, accountView, vaultView] = GetSnapshots();
 
@@ -1256,22 +1251,20 @@ UniValue listauctions(const JSONRPCRequest &request) {
         height,
         vaultId);
 
-    return GetRPCResultCache().Set(request, valueArr);
+    return GetRPCResultCache().Set(request, valueArr.get());
 }
 
 UniValue auctionhistoryToJSON(const CCustomCSView &view,
+                              const CBlockIndex *tip,
                               const AuctionHistoryKey &key,
                               const AuctionHistoryValue &value) {
     UniValue obj(UniValue::VOBJ);
 
     obj.pushKV("winner", ScriptToString(key.owner));
     obj.pushKV("blockHeight", (uint64_t)key.blockHeight);
-    {
-        LOCK(cs_main);
-        if (auto block = ::ChainActive()[key.blockHeight]) {
-            obj.pushKV("blockHash", block->GetBlockHash().GetHex());
-            obj.pushKV("blockTime", block->GetBlockTime());
-        }
+    if (auto block = tip->GetAncestor(key.blockHeight)) {
+        obj.pushKV("blockHash", block->GetBlockHash().GetHex());
+        obj.pushKV("blockTime", block->GetBlockTime());
     }
     obj.pushKV("vaultId", key.vaultId.GetHex());
     obj.pushKV("batchIndex", (uint64_t)key.index);
@@ -1364,10 +1357,11 @@ UniValue listauctionhistory(const JSONRPCRequest &request) {
 
     UniValue ret(UniValue::VARR);
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     accountView->ForEachAuctionHistory(
-        [&, &view = view](const AuctionHistoryKey &key, CLazySerialize<AuctionHistoryValue> valueLazy) -> bool {
+        [&, &view = view, tip = tip](const AuctionHistoryKey &key,
+                                     CLazySerialize<AuctionHistoryValue> valueLazy) -> bool {
             if (filter == 0 && start.owner != key.owner) {
                 return true;
             }
@@ -1380,7 +1374,7 @@ UniValue listauctionhistory(const JSONRPCRequest &request) {
                 return true;
             }
 
-            ret.push_back(auctionhistoryToJSON(*view, key, valueLazy.get()));
+            ret.push_back(auctionhistoryToJSON(*view, tip, key, valueLazy.get()));
 
             return --limit != 0;
         },
@@ -1390,6 +1384,7 @@ UniValue listauctionhistory(const JSONRPCRequest &request) {
 }
 
 UniValue vaultToJSON(const CCustomCSView &view,
+                     const CBlockIndex *tip,
                      const uint256 &vaultID,
                      const std::string &address,
                      const uint64_t blockHeight,
@@ -1403,12 +1398,9 @@ UniValue vaultToJSON(const CCustomCSView &view,
         obj.pushKV("address", address);
     }
     obj.pushKV("blockHeight", blockHeight);
-    {
-        LOCK(cs_main);
-        if (auto block = ::ChainActive()[blockHeight]) {
-            obj.pushKV("blockHash", block->GetBlockHash().GetHex());
-            obj.pushKV("blockTime", block->GetBlockTime());
-        }
+    if (auto block = tip->GetAncestor(blockHeight)) {
+        obj.pushKV("blockHash", block->GetBlockHash().GetHex());
+        obj.pushKV("blockTime", block->GetBlockTime());
     }
     if (!type.empty()) {
         obj.pushKV("type", type);
@@ -1439,8 +1431,11 @@ UniValue BatchToJSON(const CCustomCSView &view, const std::vector<CAuctionBatch>
     return batchArray;
 }
 
-UniValue stateToJSON(const CCustomCSView &view, const VaultStateKey &key, const VaultStateValue &value) {
-    auto obj = vaultToJSON(view, key.vaultID, "", key.blockHeight, "", 0, "", {});
+UniValue stateToJSON(const CCustomCSView &view,
+                     const CBlockIndex *tip,
+                     const VaultStateKey &key,
+                     const VaultStateValue &value) {
+    auto obj = vaultToJSON(view, tip, key.vaultID, "", key.blockHeight, "", 0, "", {});
 
     UniValue snapshot(UniValue::VOBJ);
     snapshot.pushKV("state", !value.auctionBatches.empty() ? "inLiquidation" : "active");
@@ -1458,8 +1453,12 @@ UniValue stateToJSON(const CCustomCSView &view, const VaultStateKey &key, const
     return obj;
 }
 
-UniValue historyToJSON(const CCustomCSView &view, const VaultHistoryKey &key, const VaultHistoryValue &value) {
+UniValue historyToJSON(const CCustomCSView &view,
+                       const CBlockIndex *tip,
+                       const VaultHistoryKey &key,
+                       const VaultHistoryValue &value) {
     return vaultToJSON(view,
+                       tip,
                        key.vaultID,
                        ScriptToString(key.address),
                        key.blockHeight,
@@ -1469,8 +1468,12 @@ UniValue historyToJSON(const CCustomCSView &view, const VaultHistoryKey &key, co
                        value.diff);
 }
 
-UniValue collateralToJSON(const CCustomCSView &view, const VaultHistoryKey &key, const VaultHistoryValue &value) {
+UniValue collateralToJSON(const CCustomCSView &view,
+                          const CBlockIndex *tip,
+                          const VaultHistoryKey &key,
+                          const VaultHistoryValue &value) {
     return vaultToJSON(view,
+                       tip,
                        key.vaultID,
                        "vaultCollateral",
                        key.blockHeight,
@@ -1480,8 +1483,12 @@ UniValue collateralToJSON(const CCustomCSView &view, const VaultHistoryKey &key,
                        value.diff);
 }
 
-UniValue schemeToJSON(const CCustomCSView &view, const VaultSchemeKey &key, const VaultGlobalSchemeValue &value) {
+UniValue schemeToJSON(const CCustomCSView &view,
+                      const CBlockIndex *tip,
+                      const VaultSchemeKey &key,
+                      const VaultGlobalSchemeValue &value) {
     auto obj = vaultToJSON(view,
+                           tip,
                            key.vaultID,
                            "",
                            key.blockHeight,
@@ -1606,7 +1613,7 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
 
     std::set<uint256> txs;
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     auto hasToken = [&, &view = view](const TAmounts &diffs) {
         for (auto const &diff : diffs) {
@@ -1633,8 +1640,8 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
     // Get vault TXs
     auto count = limit;
 
-    auto shouldContinue = [&, &view = view](const VaultHistoryKey &key,
-                                            CLazySerialize<VaultHistoryValue> valueLazy) -> bool {
+    auto shouldContinue = [&, &view = view, tip = tip](const VaultHistoryKey &key,
+                                                       CLazySerialize<VaultHistoryValue> valueLazy) -> bool {
         if (!isMatchVault(key.vaultID)) {
             return true;
         }
@@ -1656,9 +1663,9 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
         auto &array = ret.emplace(key.blockHeight, UniValue::VARR).first->second;
 
         if (key.address.empty()) {
-            array.push_back(collateralToJSON(*view, key, value));
+            array.push_back(collateralToJSON(*view, tip, key, value));
         } else {
-            array.push_back(historyToJSON(*view, key, value));
+            array.push_back(historyToJSON(*view, tip, key, value));
         }
 
         return --count != 0;
@@ -1670,8 +1677,8 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
     // Get vault state changes
     count = limit;
 
-    auto shouldContinueState = [&, &view = view](const VaultStateKey &key,
-                                                 CLazySerialize<VaultStateValue> valueLazy) -> bool {
+    auto shouldContinueState = [&, &view = view, tip = tip](const VaultStateKey &key,
+                                                            CLazySerialize<VaultStateValue> valueLazy) -> bool {
         if (!isMatchVault(key.vaultID)) {
             return false;
         }
@@ -1683,7 +1690,7 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
         const auto &value = valueLazy.get();
 
         auto &array = ret.emplace(key.blockHeight, UniValue::VARR).first->second;
-        array.push_back(stateToJSON(*view, key, value));
+        array.push_back(stateToJSON(*view, tip, key, value));
 
         return --count != 0;
     };
@@ -1698,7 +1705,7 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
 
     std::map<uint32_t, uint256> schemes;
 
-    auto shouldContinueScheme = [&, &view = view, &vaultView = vaultView](
+    auto shouldContinueScheme = [&, &view = view, &vaultView = vaultView, tip = tip](
                                     const VaultSchemeKey &key, CLazySerialize<VaultSchemeValue> valueLazy) -> bool {
         if (!isMatchVault(key.vaultID)) {
             return false;
@@ -1727,7 +1734,7 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
             {key.blockHeight, value.txn});
 
         auto &array = ret.emplace(key.blockHeight, UniValue::VARR).first->second;
-        array.push_back(schemeToJSON(*view, key, {loanScheme, value.category, value.txid}));
+        array.push_back(schemeToJSON(*view, tip, key, {loanScheme, value.category, value.txid}));
 
         return --count != 0;
     };
@@ -1753,7 +1760,8 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
             auto nit = std::next(it);
             uint32_t endHeight = nit != schemes.cend() ? nit->first - 1 : std::numeric_limits<uint32_t>::max();
             vaultView->ForEachGlobalScheme(
-                [&, &view = view](const VaultGlobalSchemeKey &key, CLazySerialize<VaultGlobalSchemeValue> valueLazy) {
+                [&, &view = view, tip = tip](const VaultGlobalSchemeKey &key,
+                                             CLazySerialize<VaultGlobalSchemeValue> valueLazy) {
                     if (key.blockHeight < minHeight) {
                         return false;
                     }
@@ -1773,7 +1781,7 @@ UniValue listvaulthistory(const JSONRPCRequest &request) {
                     }
 
                     auto &array = ret.emplace(key.blockHeight, UniValue::VARR).first->second;
-                    array.push_back(schemeToJSON(*view, {vaultID, key.blockHeight}, value));
+                    array.push_back(schemeToJSON(*view, tip, {vaultID, key.blockHeight}, value));
 
                     return --count != 0;
                 },
@@ -1832,14 +1840,14 @@ UniValue estimateloan(const JSONRPCRequest &request) {
 
     CVaultId vaultId = ParseHashV(request.params[0], "vaultId");
 
-    auto [view, accountView, vaultView] = GetSnapshots();
+    auto [view, accountView, vaultView, tip, blockTime] = GetRpcReadContext();
 
     auto vault = view->GetVault(vaultId);
     if (!vault) {
         throw JSONRPCError(RPC_DATABASE_ERROR, strprintf("Vault <%s> not found.", vaultId.GetHex()));
     }
 
-    auto vaultState = GetVaultState(*view, vaultId, *vault);
+    auto vaultState = GetVaultState(*view, blockTime, vaultId, *vault);
     if (vaultState == VaultState::InLiquidation) {
         throw JSONRPCError(RPC_MISC_ERROR, strprintf("Vault <%s> is in liquidation.", vaultId.GetHex()));
     }
@@ -1856,11 +1864,6 @@ UniValue estimateloan(const JSONRPCRequest &request) {
     }
 
     auto height = view->GetLastHeight();
-    int64_t blockTime{};
-    {
-        LOCK(cs_main);
-        blockTime = ::ChainActive().Tip()->GetBlockTime();
-    }
     auto rate = view->GetVaultAssets(vaultId, *collaterals, height + 1, blockTime, false, true);
     if (!rate.ok) {
         throw JSONRPCError(RPC_MISC_ERROR, rate.msg);
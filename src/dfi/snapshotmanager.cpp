@@ -1,6 +1,7 @@
 #include <dfi/snapshotmanager.h>
 
 #include <dfi/accountshistory.h>
+#include <dfi/historywriter.h>
 #include <dfi/masternodes.h>
 #include <dfi/vaulthistory.h>
 
@@ -16,20 +17,52 @@ static void CheckoutSnapshot(T &checkedOutMap, const CBlockSnapshot &snapshot) {
 }
 
 SnapshotCollection GetSnapshots() {
-    return psnapshotManager->GetSnapshots();
+    auto context = GetRpcReadContext();
+    return std::make_tuple(std::move(context.view), std::move(context.history), std::move(context.vault));
+}
+
+RpcReadContext GetRpcReadContext() {
+    if (!LockWaitScope::Active()) {
+        return psnapshotManager->GetReadContext();
+    }
+    // The whole checkout counts as lock wait, without adding any cs_main wait twice
+    const auto start = GetTimeMicros();
+    const auto waited = LockWaitScope::Waited();
+    auto context = psnapshotManager->GetReadContext();
+    LockWaitScope::Add(GetTimeMicros() - start - (LockWaitScope::Waited() - waited));
+    return context;
+}
+
+const CBlockIndex *RpcReadContext::BlockAt(int height) const {
+    return tip->GetAncestor(height);
 }
 
 SnapshotCollection CSnapshotManager::GetSnapshots() {
+    auto context = GetReadContext();
+    return std::make_tuple(std::move(context.view), std::move(context.history), std::move(context.vault));
+}
+
+RpcReadContext CSnapshotManager::GetReadContext() {
     if (auto currentSnapshots = GetCurrentSnapshots()) {
         return std::move(*currentSnapshots);
     }
     return GetGlobalSnapshots();
 }
 
-std::optional<SnapshotCollection> CSnapshotManager::GetCurrentSnapshots() {
+std::optional<RpcReadContext> CSnapshotManager::GetCurrentSnapshots() {
     std::unique_lock lock(mtx);
 
-    if (!currentViewSnapshot || (historyDB && !currentHistorySnapshot) || (vaultDB && !currentVaultSnapshot)) {
+    // History snapshots of the current block are taken once the writer has written its history
+    cv.wait(lock, [&] {
+        return !currentBlock || ((!historyDB || currentHistorySnapshot) && (!vaultDB || currentVaultSnapshot));
+    });
+
+    return CheckoutCurrentSnapshots();
+}
+
+std::optional<RpcReadContext> CSnapshotManager::CheckoutCurrentSnapshots() {
+    if (!currentBlock || !currentViewSnapshot || (historyDB && !currentHistorySnapshot) ||
+        (vaultDB && !currentVaultSnapshot)) {
         return {};
     }
 
@@ -48,30 +81,31 @@ std::optional<SnapshotCollection> CSnapshotManager::GetCurrentSnapshots() {
         vaultSnapshot = std::make_unique<CVaultHistoryStorage>(vaultDB, snapshot);
     }
 
-    return std::make_tuple(std::move(viewSnapshot), std::move(historySnapshot), std::move(vaultSnapshot));
+    return RpcReadContext{std::move(viewSnapshot),
+                          std::move(historySnapshot),
+                          std::move(vaultSnapshot),
+                          currentBlock,
+                          currentBlock->GetBlockTime()};
 }
 
-SnapshotCollection CSnapshotManager::GetGlobalSnapshots() {
+RpcReadContext CSnapshotManager::GetGlobalSnapshots() {
     // Same lock order as ConnectBlock
     LOCK(cs_main);
-    std::unique_lock lock(mtx);
 
-    auto [changed, snapshotDB] = GetGlobalViewSnapshot();
-    auto viewSnapshot = std::make_unique<CCustomCSView>(snapshotDB, changed);
+    // No block queues history while cs_main is held, this only waits for the history up to the tip
+    WaitForHistoryWriterQueue();
 
-    std::unique_ptr<CAccountHistoryStorage> historySnapshot{};
-    if (historyDB) {
-        auto snapshot = GetGlobalHistorySnapshot();
-        historySnapshot = std::make_unique<CAccountHistoryStorage>(historyDB, snapshot);
-    }
+    std::unique_lock lock(mtx);
 
-    std::unique_ptr<CVaultHistoryStorage> vaultSnapshot{};
-    if (vaultDB) {
-        auto snapshot = GetGlobalVaultSnapshot();
-        vaultSnapshot = std::make_unique<CVaultHistoryStorage>(vaultDB, snapshot);
-    }
+    // Snapshots of the tip become the current ones until the next block
+    const auto tip = ::ChainActive().Tip();
+    TakeCurrentSnapshots(pcustomcsview->GetStorage(), tip);
+    TakeHistorySnapshots(paccountHistoryDB.get(), pvaultHistoryDB.get(), tip);
+    cv.notify_all();
 
-    return std::make_tuple(std::move(viewSnapshot), std::move(historySnapshot), std::move(vaultSnapshot));
+    auto snapshots = CheckoutCurrentSnapshots();
+    assert(snapshots);
+    return std::move(*snapshots);
 }
 
 CCheckedOutSnapshot::~CCheckedOutSnapshot() {
@@ -127,80 +161,54 @@ void CSnapshotManager::SetBlockSnapshots(CFlushableStorageKV &viewStorge,
                                          const bool nearTip) {
     std::unique_lock lock(mtx);
 
-    // Return current snapshots
-    ::ReturnSnapshot(viewDB, currentViewSnapshot, checkedOutViewMap);
-    ::ReturnSnapshot(historyDB, currentHistorySnapshot, checkedOutHistoryMap);
-    ::ReturnSnapshot(vaultDB, currentVaultSnapshot, checkedOutVaultMap);
-
     // Do not create current snapshots if snapshots are disabled or not near tip
     if (!gArgs.GetBoolArg("-enablesnapshots", DEFAULT_SNAPSHOT) || !nearTip) {
+        ReturnCurrentSnapshots();
+        cv.notify_all();
         return;
     }
 
-    // Get view database snapshot and flushable storage changed map
-    auto [changedView, snapshotView] = viewStorge.CreateSnapshotData();
-
-    // Set current view snapshot
-    currentViewSnapshot = std::make_unique<CBlockSnapshot>(
-        snapshotView, changedView, CBlockSnapshotKey{SnapshotType::VIEW, block->nHeight, block->GetBlockHash()});
+    TakeCurrentSnapshots(viewStorge, block);
+    lock.unlock();
 
-    // Set current snapshots
-    ::SetCurrentSnapshot(historyView, currentHistorySnapshot, SnapshotType::HISTORY, block);
-    ::SetCurrentSnapshot(vaultView, currentVaultSnapshot, SnapshotType::VAULT, block);
+    // History snapshots include the history of the block, the writer takes them once it is written
+    RunAfterHistoryWriterQueue([this, historyView, vaultView, block] {
+        std::unique_lock lock(mtx);
+        TakeHistorySnapshots(historyView, vaultView, block);
+        cv.notify_all();
+    });
 }
 
-std::pair<MapKV, std::unique_ptr<CStorageLevelDB>> CSnapshotManager::GetGlobalViewSnapshot() {
-    // Get database snapshot and flushable storage changed map
-    auto [changedMap, snapshot] = pcustomcsview->GetStorage().CreateSnapshotData();
-
-    // Create checked out snapshot
-    const auto blockIndex = ::ChainActive().Tip();
-    CBlockSnapshotKey key{SnapshotType::VIEW, blockIndex->nHeight, blockIndex->GetBlockHash()};
-    auto globalSnapshot = std::make_unique<CCheckedOutSnapshot>(snapshot, key);
-
-    // Set global as current snapshot
-    currentViewSnapshot = std::make_unique<CBlockSnapshot>(globalSnapshot->GetLevelDBSnapshot(), changedMap, key);
-
-    // Track checked out snapshot
-    ::CheckoutSnapshot(checkedOutViewMap, *currentViewSnapshot);
-
-    return {changedMap, std::make_unique<CStorageLevelDB>(viewDB, globalSnapshot)};
+void CSnapshotManager::ReturnCurrentSnapshots() {
+    ::ReturnSnapshot(viewDB, currentViewSnapshot, checkedOutViewMap);
+    ::ReturnSnapshot(historyDB, currentHistorySnapshot, checkedOutHistoryMap);
+    ::ReturnSnapshot(vaultDB, currentVaultSnapshot, checkedOutVaultMap);
+    currentBlock = nullptr;
 }
 
-std::unique_ptr<CCheckedOutSnapshot> CSnapshotManager::GetGlobalHistorySnapshot() {
-    // Get database snapshot and flushable storage changed map
-    auto snapshot = paccountHistoryDB->GetStorage().CreateLevelDBSnapshot();
-
-    const auto blockIndex = ::ChainActive().Tip();
-    CBlockSnapshotKey key{SnapshotType::HISTORY, blockIndex->nHeight, blockIndex->GetBlockHash()};
-    auto globalSnapshot = std::make_unique<CCheckedOutSnapshot>(snapshot, key);
+void CSnapshotManager::TakeCurrentSnapshots(CFlushableStorageKV &viewStorge, const CBlockIndex *block) {
+    ReturnCurrentSnapshots();
 
-    // Set global as current snapshot
-    currentHistorySnapshot = std::make_unique<CBlockSnapshot>(globalSnapshot->GetLevelDBSnapshot(), MapKV{}, key);
-
-    // Track checked out snapshot
-    ::CheckoutSnapshot(checkedOutHistoryMap, *currentHistorySnapshot);
+    // Get view database snapshot and flushable storage changed map
+    auto [changedView, snapshotView] = viewStorge.CreateSnapshotData();
 
-    // Create checked out snapshot
-    return globalSnapshot;
+    // Set current view snapshot
+    currentViewSnapshot = std::make_unique<CBlockSnapshot>(
+        snapshotView, changedView, CBlockSnapshotKey{SnapshotType::VIEW, block->nHeight, block->GetBlockHash()});
+    currentBlock = block;
 }
 
-std::unique_ptr<CCheckedOutSnapshot> CSnapshotManager::GetGlobalVaultSnapshot() {
-    // Get database snapshot and flushable storage changed map
-    auto snapshot = pvaultHistoryDB->GetStorage().CreateLevelDBSnapshot();
-
-    const auto blockIndex = ::ChainActive().Tip();
-    CBlockSnapshotKey key{SnapshotType::VAULT, blockIndex->nHeight, blockIndex->GetBlockHash()};
-    auto globalSnapshot = std::make_unique<CCheckedOutSnapshot>(snapshot, key);
-
-    // Set global as current snapshot
-    currentVaultSnapshot = std::make_unique<CBlockSnapshot>(globalSnapshot->GetLevelDBSnapshot(), MapKV{}, key);
-
-    // Track checked out snapshot
-    ::CheckoutSnapshot(checkedOutVaultMap, *currentVaultSnapshot);
+void CSnapshotManager::TakeHistorySnapshots(CAccountHistoryStorage *historyView,
+                                            CVaultHistoryStorage *vaultView,
+                                            const CBlockIndex *block) {
+    // Snapshots of another block replaced the current ones meanwhile
+    if (currentBlock != block || currentHistorySnapshot || currentVaultSnapshot) {
+        return;
+    }
 
-    // Create checked out snapshot
-    return globalSnapshot;
+    // Set current snapshots
+    ::SetCurrentSnapshot(historyView, currentHistorySnapshot, SnapshotType::HISTORY, block);
+    ::SetCurrentSnapshot(vaultView, currentVaultSnapshot, SnapshotType::VAULT, block);
 }
 
 std::pair<MapKV, std::unique_ptr<CStorageLevelDB>> CSnapshotManager::CheckoutViewSnapshot() {
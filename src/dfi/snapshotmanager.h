@@ -3,6 +3,7 @@
 
 #include <uint256.h>
 
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -31,6 +32,24 @@ using SnapshotCollection = std::tuple<std::unique_ptr<CCustomCSView>,
 
 SnapshotCollection GetSnapshots();
 
+/**
+ * Consistent read state for RPCs: the DeFi view and history snapshots and the block they
+ * were taken at. Taking it needs no cs_main unless snapshots are disabled or not near tip.
+ * Block indexes are never freed, so the tip and its ancestors can be read without cs_main.
+ */
+struct RpcReadContext {
+    std::unique_ptr<CCustomCSView> view;
+    std::unique_ptr<CAccountHistoryStorage> history;
+    std::unique_ptr<CVaultHistoryStorage> vault;
+    const CBlockIndex *tip{};
+    int64_t blockTime{};
+
+    // Block at height on the chain of the snapshot, null above its tip
+    [[nodiscard]] const CBlockIndex *BlockAt(int height) const;
+};
+
+RpcReadContext GetRpcReadContext();
+
 enum class SnapshotType : uint8_t { VIEW, HISTORY, VAULT };
 
 struct CBlockSnapshotKey {
@@ -100,6 +119,8 @@ class CSnapshotManager {
     std::unique_ptr<CBlockSnapshot> currentVaultSnapshot;
 
     std::mutex mtx;
+    // Notified when the current snapshots change
+    std::condition_variable cv;
     std::shared_ptr<CDBWrapper> viewDB;
     std::shared_ptr<CDBWrapper> historyDB;
     std::shared_ptr<CDBWrapper> vaultDB;
@@ -109,6 +130,9 @@ class CSnapshotManager {
     CheckoutOutMap checkedOutHistoryMap;
     CheckoutOutMap checkedOutVaultMap;
 
+    // Block of the current snapshots
+    const CBlockIndex *currentBlock{};
+
 public:
     CSnapshotManager() = delete;
     CSnapshotManager(std::unique_ptr<CCustomCSView> &otherViewDB,
@@ -119,6 +143,7 @@ public:
     CSnapshotManager &operator=(const CSnapshotManager &other) = delete;
 
     SnapshotCollection GetSnapshots();
+    RpcReadContext GetReadContext();
     void SetBlockSnapshots(CFlushableStorageKV &viewStorge,
                            CAccountHistoryStorage *historyView,
                            CVaultHistoryStorage *vaultView,
@@ -127,14 +152,19 @@ public:
     void ReturnSnapshot(const CBlockSnapshotKey &key);
 
 private:
-    std::optional<SnapshotCollection> GetCurrentSnapshots();
-    SnapshotCollection GetGlobalSnapshots();
+    std::optional<RpcReadContext> GetCurrentSnapshots();
+    RpcReadContext GetGlobalSnapshots();
+
+    // Callers hold mtx
+    std::optional<RpcReadContext> CheckoutCurrentSnapshots();
+    void ReturnCurrentSnapshots();
+    void TakeCurrentSnapshots(CFlushableStorageKV &viewStorge, const CBlockIndex *block);
+    void TakeHistorySnapshots(CAccountHistoryStorage *historyView,
+                              CVaultHistoryStorage *vaultView,
+                              const CBlockIndex *block);
     std::pair<MapKV, std::unique_ptr<CStorageLevelDB>> CheckoutViewSnapshot();
     std::unique_ptr<CCheckedOutSnapshot> CheckoutHistorySnapshot();
     std::unique_ptr<CCheckedOutSnapshot> CheckoutVaultSnapshot();
-    std::pair<MapKV, std::unique_ptr<CStorageLevelDB>> GetGlobalViewSnapshot();
-    std::unique_ptr<CCheckedOutSnapshot> GetGlobalHistorySnapshot();
-    std::unique_ptr<CCheckedOutSnapshot> GetGlobalVaultSnapshot();
 };
 
 extern std::unique_ptr<CSnapshotManager> psnapshotManager;
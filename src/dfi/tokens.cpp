@@ -21,11 +21,23 @@ const DCT_ID CTokensView::DCT_ID_START = DCT_ID{128};
 
 extern const std::string CURRENCY_UNIT;
 
+CTokenTable g_tokenTable;
+
 std::optional<CTokensView::CTokenImpl> CTokensView::GetToken(DCT_ID id) const {
+    if (g_tokenTable.Covers(DB(), DbTypeToBytes(std::make_pair(ID::prefix(), id)))) {
+        return g_tokenTable.GetToken(id);
+    }
     return ReadBy<ID, CTokenImpl>(id);
 }
 
 std::optional<CTokensView::TokenIDPair> CTokensView::GetToken(const std::string &symbolKey) const {
+    if (g_tokenTable.Covers(DB(), DbTypeToBytes(std::make_pair(Symbol::prefix(), symbolKey)))) {
+        if (const auto id = g_tokenTable.GetTokenId(symbolKey)) {
+            return std::make_pair(*id, GetToken(*id));
+        }
+        return {};
+    }
+
     DCT_ID id;
     if (ReadBy<Symbol, std::string>(symbolKey, id)) {
         return std::make_pair(id, GetToken(id));
@@ -34,6 +46,14 @@ std::optional<CTokensView::TokenIDPair> CTokensView::GetToken(const std::string
     return {};
 }
 
+std::optional<DCT_ID> CTokensView::GetDUSDTokenId() const {
+    const std::string symbolKey{"DUSD"};
+    if (g_tokenTable.Covers(DB(), DbTypeToBytes(std::make_pair(Symbol::prefix(), symbolKey)))) {
+        return g_tokenTable.GetDUSDTokenId();
+    }
+    return ReadBy<Symbol, DCT_ID>(symbolKey);
+}
+
 std::optional<std::pair<DCT_ID, CTokensView::CTokenImpl>> CTokensView::GetTokenByCreationTx(const uint256 &txid) const {
     DCT_ID id;
     if (ReadBy<CreationTx, uint256>(txid, id)) {
@@ -417,3 +437,117 @@ void CTokensView::EraseNewTokenCollateral(const uint32_t tokenID) {
     EraseBy<NewTokenCollateralTXID>(txid);
     EraseBy<NewTokenCollateralID>(tokenID);
 }
+
+void CTokenTable::Load(CStorageLevelDB &db) {
+    std::unique_lock lock{cs};
+    anchor = &db;
+    tokens.clear();
+    symbols.clear();
+    dusdId.reset();
+
+    for (const auto prefix : {CTokensView::ID::prefix(), CTokensView::Symbol::prefix()}) {
+        auto it = db.NewIterator();
+        for (it->Seek(TBytes{prefix}); it->Valid(); it->Next()) {
+            const auto key = it->Key();
+            if (key.empty() || key.front() != prefix) {
+                break;
+            }
+            Apply(key, it->Value());
+        }
+    }
+
+    db.SetCommitHook({CTokensView::ID::prefix(), CTokensView::Symbol::prefix()}, [this](const MapKV &changes) {
+        std::unique_lock lock{cs};
+        for (const auto &[key, value] : changes) {
+            Apply(key, value);
+        }
+    });
+}
+
+void CTokenTable::Reset() {
+    std::unique_lock lock{cs};
+    anchor = nullptr;
+    tokens.clear();
+    symbols.clear();
+    dusdId.reset();
+}
+
+bool CTokenTable::Covers(const CStorageKV &storage, const TBytes &key) const {
+    const CStorageKV *root{};
+    {
+        std::shared_lock lock{cs};
+        root = anchor;
+    }
+    if (!root) {
+        return false;
+    }
+    for (auto layer = &storage; layer; layer = layer->GetParent()) {
+        if (layer == root) {
+            return true;
+        }
+        if (layer->HasChange(key)) {
+            return false;
+        }
+    }
+    return false;
+}
+
+std::optional<CTokenTable::CTokenImpl> CTokenTable::GetToken(DCT_ID id) const {
+    std::shared_lock lock{cs};
+    if (id.v >= tokens.size()) {
+        return {};
+    }
+    return tokens[id.v];
+}
+
+std::optional<DCT_ID> CTokenTable::GetTokenId(const std::string &symbol) const {
+    std::shared_lock lock{cs};
+    if (const auto it = symbols.find(symbol); it != symbols.end()) {
+        return it->second;
+    }
+    return {};
+}
+
+std::optional<DCT_ID> CTokenTable::GetDUSDTokenId() const {
+    std::shared_lock lock{cs};
+    return dusdId;
+}
+
+void CTokenTable::Apply(const TBytes &key, const std::optional<TBytes> &value) {
+    if (key.front() == CTokensView::ID::prefix()) {
+        std::pair<uint8_t, DCT_ID> idKey;
+        if (!BytesToDbType(key, idKey)) {
+            return;
+        }
+        const auto id = idKey.second.v;
+        if (id >= tokens.size()) {
+            if (!value) {
+                return;
+            }
+            tokens.resize(id + 1);
+        }
+        CTokenImpl token;
+        if (value && BytesToDbType(*value, token)) {
+            tokens[id] = std::move(token);
+        } else {
+            tokens[id].reset();
+        }
+    } else {
+        std::pair<uint8_t, std::string> symbolKey;
+        if (!BytesToDbType(key, symbolKey)) {
+            return;
+        }
+        auto &symbol = symbolKey.second;
+        DCT_ID id;
+        std::optional<DCT_ID> entry;
+        if (value && BytesToDbType(*value, id)) {
+            entry = id;
+            symbols[symbol] = id;
+        } else {
+            symbols.erase(symbol);
+        }
+        if (symbol == "DUSD") {
+            dusdId = entry;
+        }
+    }
+}
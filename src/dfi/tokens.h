@@ -15,6 +15,9 @@
 #include <uint256.h>
 #include <validation.h>
 
+#include <shared_mutex>
+#include <unordered_map>
+
 class BlockContext;
 class CTransaction;
 class UniValue;
@@ -210,6 +213,8 @@ public:
     using TokenIDPair = std::pair<DCT_ID, std::optional<CTokenImpl>>;
     std::optional<CTokenImpl> GetToken(DCT_ID id) const;
     std::optional<CTokensView::TokenIDPair> GetToken(const std::string &symbol) const;
+    // Cached handle of the DUSD token, without a storage lookup while its symbol row is unchanged
+    std::optional<DCT_ID> GetDUSDTokenId() const;
     // the only possible type of token (with creationTx) is CTokenImpl
     std::optional<std::pair<DCT_ID, CTokenImpl>> GetTokenByCreationTx(const uint256 &txid) const;
     [[nodiscard]] virtual std::optional<CTokenImpl> GetTokenGuessId(const std::string &str, DCT_ID &id) const = 0;
@@ -262,4 +267,37 @@ private:
     std::optional<DCT_ID> ReadLastDctId() const;
 };
 
+/**
+ * Tokens committed to pcustomcsDB, indexed by DCT_ID, and their symbol rows in a hash map. It follows the
+ * commits of the token rows, so creation, update, split, deprecation and their undo on disconnect all reach
+ * it. A view reads a row from it when no layer between the view and pcustomcsDB holds that row.
+ */
+class CTokenTable {
+public:
+    using CTokenImpl = CTokensView::CTokenImpl;
+
+    // Builds the table from db and follows the commits of db from then on
+    void Load(CStorageLevelDB &db);
+    // Has to be called before the loaded db goes away
+    void Reset();
+
+    // Whether reading key through storage ends at the table
+    bool Covers(const CStorageKV &storage, const TBytes &key) const;
+
+    std::optional<CTokenImpl> GetToken(DCT_ID id) const;
+    std::optional<DCT_ID> GetTokenId(const std::string &symbol) const;
+    std::optional<DCT_ID> GetDUSDTokenId() const;
+
+private:
+    void Apply(const TBytes &key, const std::optional<TBytes> &value);
+
+    mutable std::shared_mutex cs;
+    const CStorageKV *anchor{};
+    std::vector<std::optional<CTokenImpl>> tokens;
+    std::unordered_map<std::string, DCT_ID> symbols;
+    std::optional<DCT_ID> dusdId;
+};
+
+extern CTokenTable g_tokenTable;
+
 #endif  // DEFI_DFI_TOKENS_H
@@ -21,6 +21,7 @@
 #include <dfi/vaulthistory.h>
 #include <ffi/ffiexports.h>
 #include <ffi/ffihelpers.h>
+#include <ocean.h>
 #include <rpc/blockchain.h>
 #include <validation.h>
 
@@ -529,6 +530,7 @@ static void ProcessOracleEvents(const CBlockIndex *pindex, CCustomCSView &cache,
     if (pindex->nHeight % blockInterval != 0) {
         return;
     }
+    const auto aggregatePrices = GetAggregatePrices(cache, pindex->nTime);
     cache.ForEachFixedIntervalPrice([&](const CTokenCurrencyPair &, CFixedIntervalPrice fixedIntervalPrice) {
         // Ensure that we update active and next regardless of state of things
         // And SetFixedIntervalPrice on each evaluation of this block.
@@ -551,8 +553,7 @@ static void ProcessOracleEvents(const CBlockIndex *pindex, CCustomCSView &cache,
         fixedIntervalPrice.timestamp = pindex->nTime;
         // Use -1 to indicate empty price
         fixedIntervalPrice.priceRecord[1] = -1;
-        auto aggregatePrice = GetAggregatePrice(
-            cache, fixedIntervalPrice.priceFeedId.first, fixedIntervalPrice.priceFeedId.second, pindex->nTime);
+        auto aggregatePrice = GetAggregatePrice(cache, aggregatePrices, fixedIntervalPrice.priceFeedId, pindex->nTime);
         if (aggregatePrice) {
             fixedIntervalPrice.priceRecord[1] = aggregatePrice;
         } else {
@@ -780,7 +781,7 @@ static void ProcessLoanEvents(const CBlockIndex *pindex, CCustomCSView &cache, c
                     // Remove loan from the vault
                     cache.SubLoanToken(vaultId, {tokenId, tokenValue});
 
-                    if (const auto token = cache.GetToken("DUSD"); token && token->first == tokenId) {
+                    if (const auto dusdId = cache.GetDUSDTokenId(); dusdId && *dusdId == tokenId) {
                         TrackDUSDSub(cache, {tokenId, tokenValue});
                     }
 
@@ -861,9 +862,7 @@ static void ProcessLoanEvents(const CBlockIndex *pindex, CCustomCSView &cache, c
                                                 cache.GetLoanLiquidationPenalty()});
 
                 // Store state in vault DB
-                if (pvaultHistoryDB) {
-                    pvaultHistoryDB->WriteVaultState(cache, *pindex, vaultId, vaultAssets.ratio());
-                }
+                cache.GetHistoryWriters().WriteVaultState(cache, *pindex, vaultId, vaultAssets.ratio());
             }
         }
     }
@@ -950,7 +949,7 @@ static void ProcessLoanEvents(const CBlockIndex *pindex, CCustomCSView &cache, c
                     balances.Add({batch->loanAmount.nTokenId, batch->loanInterest});
 
                     // When tracking loan amounts remove interest.
-                    if (const auto token = view.GetToken("DUSD"); token && token->first == batch->loanAmount.nTokenId) {
+                    if (const auto dusdId = view.GetDUSDTokenId(); dusdId && *dusdId == batch->loanAmount.nTokenId) {
                         TrackDUSDAdd(view,
                                      {batch->loanAmount.nTokenId, batch->loanAmount.nValue - batch->loanInterest});
                     }
@@ -1175,6 +1174,143 @@ static auto GetLoanTokensForFutures(CCustomCSView &cache, ATTRIBUTES attributes)
     return loanTokens;
 }
 
+// Below this many items per worker per-owner items are applied on the block view
+static constexpr size_t OWNER_ITEMS_PER_WORKER = 1000;
+
+// Owners applied in one chunk of a one-shot migration, such as a token split or lock
+static constexpr size_t OWNERS_PER_CHUNK = 50000;
+
+// Applies per-owner items, anything with an owner, through apply(view, item). Owners are split across
+// DfTxTaskPool workers, each applying its items in order on its own child view and history writers, and
+// the child views are merged in worker order. Items of different owners must touch different keys; then
+// state and history are the same as applying the items one by one. Burn history is written directly, so
+// burn address items stay on the view. Returns the first failure; with stopOnFailure nothing more is
+// applied or merged after one, and the caller is expected to drop the view.
+template <typename T, typename Apply>
+static Res ApplyPerOwner(CCustomCSView &view,
+                         const std::vector<T> &items,
+                         const bool stopOnFailure,
+                         size_t &workers,
+                         Apply &&apply) {
+    const auto threads = DfTxTaskPool ? DfTxTaskPool->GetAvailableThreads() : 1;
+    workers = std::min(threads, items.size() / OWNER_ITEMS_PER_WORKER);
+    if (workers < 2) {
+        workers = 1;
+        auto result = Res::Ok();
+        for (const auto &item : items) {
+            auto res = apply(view, item);
+            if (!res && result) {
+                if (stopOnFailure) {
+                    return res;
+                }
+                result = res;
+            }
+        }
+        return result;
+    }
+
+    const auto &burnAddress = Params().GetConsensus().burnAddress;
+    std::vector<std::vector<size_t>> partitions(workers);
+    std::vector<size_t> burnItems;
+    for (size_t i{}; i < items.size(); ++i) {
+        if (items[i].owner == burnAddress) {
+            burnItems.push_back(i);
+        } else {
+            partitions[SerializeHash(items[i].owner).GetUint64(0) % workers].push_back(i);
+        }
+    }
+
+    auto &historyWriters = view.GetHistoryWriters();
+    std::vector<std::unique_ptr<CCustomCSView>> views;
+    for (size_t i{}; i < workers; ++i) {
+        views.push_back(std::make_unique<CCustomCSView>(
+            view, historyWriters.GetHistoryView(), nullptr, historyWriters.GetVaultView()));
+    }
+
+    // First failed item of each worker. With stopOnFailure a worker stops past the lowest failed index
+    // seen so far, items below it still run, so the first failure in item order is always found.
+    std::vector<std::optional<std::pair<size_t, Res>>> failures(workers);
+    std::atomic<size_t> firstFailed{std::numeric_limits<size_t>::max()};
+
+    TaskGroup g;
+    for (size_t i{}; i < workers; ++i) {
+        g.AddTask();
+        boost::asio::post(DfTxTaskPool->pool, [&, i] {
+            for (const auto index : partitions[i]) {
+                if (stopOnFailure && index > firstFailed.load(std::memory_order_relaxed)) {
+                    break;
+                }
+                auto res = apply(*views[i], items[index]);
+                if (!res && !failures[i]) {
+                    failures[i].emplace(index, res);
+                    auto current = firstFailed.load(std::memory_order_relaxed);
+                    while (index < current && !firstFailed.compare_exchange_weak(current, index)) {
+                    }
+                    if (stopOnFailure) {
+                        break;
+                    }
+                }
+            }
+            g.RemoveTask();
+        });
+    }
+    g.WaitForCompletion();
+
+    std::optional<std::pair<size_t, Res>> failure;
+    for (const auto &workerFailure : failures) {
+        if (workerFailure && (!failure || workerFailure->first < failure->first)) {
+            failure = workerFailure;
+        }
+    }
+    if (failure && stopOnFailure) {
+        // A burn address item before it may fail first, the view is dropped either way
+        for (const auto index : burnItems) {
+            if (index > failure->first) {
+                break;
+            }
+            if (auto res = apply(view, items[index]); !res) {
+                return res;
+            }
+        }
+        return failure->second;
+    }
+
+    for (auto &workerView : views) {
+        workerView->Flush();
+        historyWriters.TakeChanges(workerView->GetHistoryWriters());
+    }
+
+    for (const auto index : burnItems) {
+        auto res = apply(view, items[index]);
+        if (!res && (!failure || index < failure->first)) {
+            if (stopOnFailure) {
+                return res;
+            }
+            failure.emplace(index, res);
+        }
+    }
+
+    return failure ? failure->second : Res::Ok();
+}
+
+Res ApplyAccountChanges(const CBlockIndex *pindex,
+                        CCustomCSView &view,
+                        const std::vector<CAccountChange> &changes,
+                        const uint8_t type,
+                        const bool stopOnFailure,
+                        size_t &workers) {
+    return ApplyPerOwner(
+        view, changes, stopOnFailure, workers, [pindex, type](CCustomCSView &view, const CAccountChange &change) {
+            CAccountsHistoryWriter writer(view, pindex->nHeight, change.txn, pindex->GetBlockHash(), type);
+            auto res = change.sub ? writer.SubBalance(change.owner, change.amount)
+                                  : writer.AddBalance(change.owner, change.amount);
+            if (res) {
+                writer.Flush();
+            }
+            return res;
+        });
+}
+
 static void ProcessFutures(const CBlockIndex *pindex, CCustomCSView &cache, const Consensus::Params &consensus) {
     if (pindex->nHeight < consensus.DF15FortCanningRoadHeight) {
         return;
@@ -1240,30 +1376,53 @@ static void ProcessFutures(const CBlockIndex *pindex, CCustomCSView &cache, cons
     auto dUsdToTokenSwapsCounter = 0;
     auto tokenTodUsdSwapsCounter = 0;
 
+    // Payouts are priced in order and credited afterwards, minted amounts are added per token
+    std::vector<CAccountChange> payouts;
+    // Minted amount of each token before and after the payouts. A payout that would overflow it is left out
+    // of it, as AddMintedTokens refused it when called per payout.
+    std::map<DCT_ID, std::pair<CAmount, CAmount>> mintedTokens;
+    const auto addMinted = [&](const DCT_ID &id, const CAmount amount) {
+        auto it = mintedTokens.find(id);
+        if (it == mintedTokens.end()) {
+            const auto token = cache.GetToken(id);
+            if (!token) {
+                return;
+            }
+            it = mintedTokens.emplace(id, std::make_pair(token->minted, token->minted)).first;
+        }
+        if (const auto sum = SafeAdd(it->second.second, amount)) {
+            it->second.second = *sum;
+        }
+    };
+    std::map<DCT_ID, std::string> loanTokenSymbols;
+    std::optional<DCT_ID> dusdId;
+
+    const auto loanTokenSymbol = [&](const DCT_ID &id) -> const std::string & {
+        auto it = loanTokenSymbols.find(id);
+        if (it == loanTokenSymbols.end()) {
+            const auto loanToken = cache.GetLoanTokenByID(id);
+            assert(loanToken);
+            it = loanTokenSymbols.emplace(id, loanToken->symbol).first;
+        }
+        return it->second;
+    };
+
     cache.ForEachFuturesUserValues(
         [&](const CFuturesUserKey &key, const CFuturesUserValue &futuresValues) {
-            CAccountsHistoryWriter view(cache,
-                                        pindex->nHeight,
-                                        GetNextAccPosition(),
-                                        pindex->GetBlockHash(),
-                                        uint8_t(CustomTxType::FutureSwapExecution));
+            const auto txn = GetNextAccPosition();
 
             deletionPending.insert(key);
 
-            const auto source = view.GetLoanTokenByID(futuresValues.source.nTokenId);
-            assert(source);
-
-            if (source->symbol == "DUSD") {
+            if (loanTokenSymbol(futuresValues.source.nTokenId) == "DUSD") {
                 const DCT_ID destId{futuresValues.destination};
-                const auto destToken = view.GetLoanTokenByID(destId);
-                assert(destToken);
+                loanTokenSymbol(destId);
                 try {
                     const auto &premiumPrice = futuresPrices.at(destId).premium;
                     if (premiumPrice > 0) {
                         const auto total = DivideAmounts(futuresValues.source.nValue, premiumPrice);
-                        view.AddMintedTokens(destId, total);
+                        addMinted(destId, total);
                         CTokenAmount destination{destId, total};
-                        view.AddBalance(key.owner, destination);
+                        payouts.push_back({key.owner, destination, txn, false});
                         burned.Add(futuresValues.source);
                         minted.Add(destination);
                         dUsdToTokenSwapsCounter++;
@@ -1278,15 +1437,17 @@ static void ProcessFutures(const CBlockIndex *pindex, CCustomCSView &cache, cons
                 }
 
             } else {
-                const auto tokenDUSD = view.GetToken("DUSD");
-                assert(tokenDUSD);
+                if (!dusdId) {
+                    dusdId = cache.GetDUSDTokenId();
+                    assert(dusdId);
+                }
 
                 try {
                     const auto &discountPrice = futuresPrices.at(futuresValues.source.nTokenId).discount;
                     const auto total = MultiplyAmounts(futuresValues.source.nValue, discountPrice);
-                    view.AddMintedTokens(tokenDUSD->first, total);
-                    CTokenAmount destination{tokenDUSD->first, total};
-                    view.AddBalance(key.owner, destination);
+                    addMinted(*dusdId, total);
+                    CTokenAmount destination{*dusdId, total};
+                    payouts.push_back({key.owner, destination, txn, false});
                     burned.Add(futuresValues.source);
                     minted.Add(destination);
                     tokenTodUsdSwapsCounter++;
@@ -1300,12 +1461,20 @@ static void ProcessFutures(const CBlockIndex *pindex, CCustomCSView &cache, cons
                 }
             }
 
-            view.Flush();
-
             return true;
         },
         {static_cast<uint32_t>(pindex->nHeight), {}, std::numeric_limits<uint32_t>::max()});
 
+    const auto pricingTime = GetTimeMillis() - time;
+
+    for (const auto &[id, amounts] : mintedTokens) {
+        if (const auto res = cache.AddMintedTokens(id, amounts.second - amounts.first); !res) {
+            LogPrintf("Future swap settlement failed on AddMintedTokens %s\n", res.msg);
+        }
+    }
+    size_t workers{};
+    ApplyAccountChanges(pindex, cache, payouts, uint8_t(CustomTxType::FutureSwapExecution), false, workers);
+
     const auto contractAddressValue = GetFutureSwapContractAddress(SMART_CONTRACT_DFIP_2203);
     assert(contractAddressValue);
 
@@ -1351,12 +1520,14 @@ static void ProcessFutures(const CBlockIndex *pindex, CCustomCSView &cache, cons
 
     LogPrintf(
         "Future swap settlement completed: (%d DUSD->Token swaps," /* Continued */
-        " %d Token->DUSD swaps, %d refunds (height: %d, time: %dms)\n",
+        " %d Token->DUSD swaps, %d refunds (height: %d, time: %dms, pricing: %dms, workers: %d)\n",
         dUsdToTokenSwapsCounter,
         tokenTodUsdSwapsCounter,
         failedContractsCounter,
         pindex->nHeight,
-        GetTimeMillis() - time);
+        GetTimeMillis() - time,
+        pricingTime,
+        workers);
 
     cache.SetVariable(*attributes);
 }
@@ -1548,11 +1719,6 @@ static inline T CalculateNewAmount(const int32_t multiplier, const T amount) {
     return multiplier < 0 ? amount / std::abs(multiplier) : amount * multiplier;
 }
 
-size_t RewardConsolidationWorkersCount() {
-    const size_t workersMax = GetNumCores() - 1;
-    return workersMax > 2 ? workersMax : 3;
-}
-
 // Note: Be careful with lambda captures and default args. GCC 11.2.0, appears the if the captures are
 // unused in the function directly, but inside the lambda, it completely disassociates them from the fn
 // possibly when the lambda is lifted up and with default args, ends up inling the default arg
@@ -1565,10 +1731,9 @@ void ConsolidateRewards(CCustomCSView &view,
                         const std::unordered_set<CScript, CScriptHasher> &owners,
                         bool interruptOnShutdown,
                         bool skipStatic) {
-    const auto nWorkers = RewardConsolidationWorkersCount();
+    const auto nWorkers = DfTxTaskPool ? DfTxTaskPool->GetAvailableThreads() : 1;
     auto rewardsTime = GetTimeMicros();
-    boost::asio::thread_pool workerPool(nWorkers);
-    boost::asio::thread_pool mergeWorker(1);
+    AtomicMutex mergeMutex;
     std::atomic<uint64_t> tasksCompleted{0};
     std::atomic<uint64_t> reportedTs{0};
 
@@ -1582,41 +1747,50 @@ void ConsolidateRewards(CCustomCSView &view,
         LogPrintf("%s: addrs: %s\n", __func__, logAddrJsonArr.write(2));
     }
 
-    for (auto &owner : owners) {
-        // See https://github.com/DeFiCh/ain/pull/1291
-        // https://github.com/DeFiCh/ain/pull/1291#issuecomment-1137638060
-        // Technically not fully synchronized, but avoid races
-        // due to the segregated areas of operation.
-        boost::asio::post(workerPool, [&, &account = owner]() {
-            if (interruptOnShutdown && ShutdownRequested()) {
-                return;
-            }
-            auto tempView = std::make_unique<CCustomCSView>(view);
-            tempView->CalculateOwnerRewards(account, height, skipStatic);
+    const auto consolidate = [&](const CScript &account) {
+        if (interruptOnShutdown && ShutdownRequested()) {
+            return;
+        }
+        auto tempView = std::make_unique<CCustomCSView>(view);
+        tempView->CalculateOwnerRewards(account, height, skipStatic);
 
-            boost::asio::post(mergeWorker, [&, tempView = std::move(tempView)]() {
-                if (interruptOnShutdown && ShutdownRequested()) {
-                    return;
-                }
-                tempView->Flush();
-
-                // This entire block is already serialized with single merge worker.
-                // So, relaxed ordering is more than sufficient - don't even need
-                // atomics really.
-                auto itemsCompleted = tasksCompleted.fetch_add(1, std::memory_order::memory_order_relaxed);
-                const auto logTimeIntervalMillis = 3 * 1000;
-                if (GetTimeMillis() - reportedTs > logTimeIntervalMillis) {
-                    LogPrintf("Reward consolidation: %.2f%% completed (%d/%d)\n",
-                              (itemsCompleted * 1.f / owners.size()) * 100.0,
-                              itemsCompleted,
-                              owners.size());
-                    reportedTs.store(GetTimeMillis(), std::memory_order::memory_order_relaxed);
-                }
+        // Merges are serialized, so relaxed ordering is more than sufficient
+        std::unique_lock lock{mergeMutex};
+        if (interruptOnShutdown && ShutdownRequested()) {
+            return;
+        }
+        tempView->Flush();
+
+        auto itemsCompleted = tasksCompleted.fetch_add(1, std::memory_order::memory_order_relaxed);
+        const auto logTimeIntervalMillis = 3 * 1000;
+        if (GetTimeMillis() - reportedTs > logTimeIntervalMillis) {
+            LogPrintf("Reward consolidation: %.2f%% completed (%d/%d)\n",
+                      (itemsCompleted * 1.f / owners.size()) * 100.0,
+                      itemsCompleted,
+                      owners.size());
+            reportedTs.store(GetTimeMillis(), std::memory_order::memory_order_relaxed);
+        }
+    };
+
+    if (!DfTxTaskPool) {
+        for (auto &owner : owners) {
+            consolidate(owner);
+        }
+    } else {
+        TaskGroup g;
+        for (auto &owner : owners) {
+            // See https://github.com/DeFiCh/ain/pull/1291
+            // https://github.com/DeFiCh/ain/pull/1291#issuecomment-1137638060
+            // Technically not fully synchronized, but avoid races
+            // due to the segregated areas of operation.
+            g.AddTask();
+            boost::asio::post(DfTxTaskPool->pool, [&, &account = owner]() {
+                consolidate(account);
+                g.RemoveTask();
             });
-        });
+        }
+        g.WaitForCompletion();
     }
-    workerPool.join();
-    mergeWorker.join();
 
     auto itemsCompleted = tasksCompleted.load();
     LogPrintf("Reward consolidation: 100%% completed (%d/%d, time: %dms)\n",
@@ -1647,6 +1821,19 @@ static Res UpdateLiquiditySplits(CCustomCSView &view,
     return Res::Ok();
 }
 
+// Liquidity of one owner moved to the new pool by a token split. Without liquidity, amounts A and B are refunded.
+struct CPoolSplitChange {
+    CScript owner;
+    CAmount balance{};
+    CAmount amount{};
+    CAmount amountA{};
+    CAmount amountB{};
+    CAmount liquidity{};
+    std::optional<uint32_t> subTxn;
+    uint32_t addTxn{};
+    bool consolidate{};
+};
+
 template <typename T>
 static Res PoolSplits(CCustomCSView &view,
                       std::map<uint32_t, CAmount> &totalBalancePerNewToken,
@@ -1765,7 +1952,6 @@ static Res PoolSplits(CCustomCSView &view,
             }
 
             std::vector<std::pair<CScript, CAmount>> balancesToMigrate;
-            // only needed for ConsolidateRewards, but kept here to ensure same behaviour as old code
             uint64_t totalAccounts = 0;
             view.ForEachBalance([&, oldPoolId = oldPoolId](const CScript &owner, CTokenAmount balance) {
                 if (oldPoolId.v == balance.nTokenId.v && balance.nValue > 0) {
@@ -1782,137 +1968,159 @@ static Res PoolSplits(CCustomCSView &view,
                           return a.second > b.second;
                       });
 
-            {
-                // consolidate after sorting to keep existing behaviour/ordering, should be irrelevant, but safety sake.
-                std::unordered_set<CScript, CScriptHasher> ownersToConsolidate;
-                for (auto &[owner, _] : balancesToMigrate) {
-                    ownersToConsolidate.emplace(owner);
-                }
-                LogPrintf("Pool migration: Consolidating rewards (count: %d, total: %d)..\n",
-                          ownersToConsolidate.size(),
-                          totalAccounts);
-                ConsolidateRewards(view, pindex->nHeight, ownersToConsolidate, false);
-            }
+            LogPrintf("Pool migration: Consolidating rewards and moving liquidity (count: %d, total: %d)..\n",
+                      balancesToMigrate.size(),
+                      totalAccounts);
 
             // Special case. No liquidity providers in a previously used pool.
-            if (balancesToMigrate.empty() && oldPoolPair->totalLiquidity == CPoolPair::MINIMUM_LIQUIDITY) {
+            const auto noProviders =
+                balancesToMigrate.empty() && oldPoolPair->totalLiquidity == CPoolPair::MINIMUM_LIQUIDITY;
+            if (noProviders) {
                 balancesToMigrate.emplace_back(Params().GetConsensus().burnAddress,
                                                CAmount{CPoolPair::MINIMUM_LIQUIDITY});
             }
 
-            for (auto &[owner, amount] : balancesToMigrate) {
-                if (owner != Params().GetConsensus().burnAddress) {
+            // Rewards are consolidated before an owner's liquidity is removed, as ConsolidateRewards did for all
+            // owners up front. They only depend on the owner's own shares and balance.
+            const auto applyOwnerChange = [&, oldPoolId = oldPoolId](CCustomCSView &view,
+                                                                     const CPoolSplitChange &change) {
+                if (change.consolidate) {
+                    view.CalculateOwnerRewards(change.owner, pindex->nHeight);
+                }
+
+                if (change.subTxn) {
                     CAccountsHistoryWriter subView(view,
                                                    pindex->nHeight,
-                                                   GetNextAccPosition(),
+                                                   *change.subTxn,
                                                    pindex->GetBlockHash(),
                                                    uint8_t(CustomTxType::TokenSplit));
 
-                    res = subView.SubBalance(owner, CTokenAmount{oldPoolId, amount});
+                    auto res = subView.SubBalance(change.owner, CTokenAmount{oldPoolId, change.balance});
                     if (!res.ok) {
-                        throw std::runtime_error(strprintf("SubBalance failed: %s", res.msg));
+                        return Res::Err("SubBalance failed: %s", res.msg);
                     }
                     subView.Flush();
                 }
 
-                if (oldPoolPair->totalLiquidity < CPoolPair::MINIMUM_LIQUIDITY) {
-                    throw std::runtime_error("totalLiquidity less than minimum.");
-                }
+                CAccountsHistoryWriter addView(
+                    view, pindex->nHeight, change.addTxn, pindex->GetBlockHash(), uint8_t(CustomTxType::TokenSplit));
 
-                // First deposit to the pool has MINIMUM_LIQUIDITY removed and does not
-                // belong to anyone. Give this to the last person leaving the pool.
-                if (oldPoolPair->totalLiquidity - amount == CPoolPair::MINIMUM_LIQUIDITY) {
-                    amount += CPoolPair::MINIMUM_LIQUIDITY;
+                if (change.liquidity > 0 && addView.AddBalance(change.owner, {newPoolId, change.liquidity})) {
+                    addView.Flush();
+                    LogPrint(BCLog::TOKENSPLIT,
+                             "TokenSplit: LP (%s: %s => %s)\n",
+                             ScriptToString(change.owner),
+                             CTokenAmount{oldPoolId, change.amount}.ToString(),
+                             CTokenAmount{newPoolId, change.liquidity}.ToString());
+                    view.SetShare(newPoolId, change.owner, pindex->nHeight);
+                    return Res::Ok();
                 }
 
-                CAmount resAmountA =
-                    (arith_uint256(amount) * oldPoolPair->reserveA / oldPoolPair->totalLiquidity).GetLow64();
-                CAmount resAmountB =
-                    (arith_uint256(amount) * oldPoolPair->reserveB / oldPoolPair->totalLiquidity).GetLow64();
-                oldPoolPair->reserveA -= resAmountA;
-                oldPoolPair->reserveB -= resAmountB;
-                oldPoolPair->totalLiquidity -= amount;
-
-                CAmount amountA{0}, amountB{0};
-                if (tokenMap.count(oldPoolPair->idTokenA.v)) {
-                    amountA = CalculateNewAmount(multiplier, resAmountA);
-                    totalBalancePerNewToken[newPoolPair.idTokenA.v] += amountA;
-                } else {
-                    amountA = resAmountA;
-                }
-                if (tokenMap.count(oldPoolPair->idTokenB.v)) {
-                    amountB = CalculateNewAmount(multiplier, resAmountB);
-                    totalBalancePerNewToken[newPoolPair.idTokenB.v] += amountB;
-                } else {
-                    amountB = resAmountB;
-                }
+                // Refund
+                addView.AddBalance(change.owner, {newPoolPair.idTokenA, change.amountA});
+                addView.AddBalance(change.owner, {newPoolPair.idTokenB, change.amountB});
+                addView.Flush();
+                return Res::Ok();
+            };
+
+            // Pool amounts depend on the owners before, so they are worked out in order and the owners' balances
+            // are then changed in parallel, one chunk at a time
+            std::vector<CPoolSplitChange> changes;
+            for (size_t begin{}; begin < balancesToMigrate.size(); begin += OWNERS_PER_CHUNK) {
+                const auto end = std::min(balancesToMigrate.size(), begin + OWNERS_PER_CHUNK);
+
+                changes.clear();
+                for (auto i = begin; i < end; ++i) {
+                    auto &[owner, amount] = balancesToMigrate[i];
+                    auto &change = changes.emplace_back();
+                    change.owner = owner;
+                    change.balance = amount;
+                    change.consolidate = !noProviders;
+                    const auto isBurnAddress = owner == Params().GetConsensus().burnAddress;
+                    if (!isBurnAddress) {
+                        change.subTxn = GetNextAccPosition();
+                    }
 
-                CAccountsHistoryWriter addView(view,
-                                               pindex->nHeight,
-                                               GetNextAccPosition(),
-                                               pindex->GetBlockHash(),
-                                               uint8_t(CustomTxType::TokenSplit));
+                    if (oldPoolPair->totalLiquidity < CPoolPair::MINIMUM_LIQUIDITY) {
+                        throw std::runtime_error("totalLiquidity less than minimum.");
+                    }
 
-                auto refundBalances = [&, owner = owner]() {
-                    addView.AddBalance(owner, {newPoolPair.idTokenA, amountA});
-                    addView.AddBalance(owner, {newPoolPair.idTokenB, amountB});
-                    addView.Flush();
-                };
+                    // First deposit to the pool has MINIMUM_LIQUIDITY removed and does not
+                    // belong to anyone. Give this to the last person leaving the pool.
+                    if (oldPoolPair->totalLiquidity - amount == CPoolPair::MINIMUM_LIQUIDITY) {
+                        amount += CPoolPair::MINIMUM_LIQUIDITY;
+                    }
 
-                if (amountA <= 0 || amountB <= 0 || owner == Params().GetConsensus().burnAddress) {
-                    refundBalances();
-                    continue;
-                }
+                    CAmount resAmountA =
+                        (arith_uint256(amount) * oldPoolPair->reserveA / oldPoolPair->totalLiquidity).GetLow64();
+                    CAmount resAmountB =
+                        (arith_uint256(amount) * oldPoolPair->reserveB / oldPoolPair->totalLiquidity).GetLow64();
+                    oldPoolPair->reserveA -= resAmountA;
+                    oldPoolPair->reserveB -= resAmountB;
+                    oldPoolPair->totalLiquidity -= amount;
+
+                    CAmount amountA{0}, amountB{0};
+                    if (tokenMap.count(oldPoolPair->idTokenA.v)) {
+                        amountA = CalculateNewAmount(multiplier, resAmountA);
+                        totalBalancePerNewToken[newPoolPair.idTokenA.v] += amountA;
+                    } else {
+                        amountA = resAmountA;
+                    }
+                    if (tokenMap.count(oldPoolPair->idTokenB.v)) {
+                        amountB = CalculateNewAmount(multiplier, resAmountB);
+                        totalBalancePerNewToken[newPoolPair.idTokenB.v] += amountB;
+                    } else {
+                        amountB = resAmountB;
+                    }
+                    change.amount = amount;
+                    change.amountA = amountA;
+                    change.amountB = amountB;
+                    change.addTxn = GetNextAccPosition();
 
-                CAmount liquidity{0};
-                if (newPoolPair.totalLiquidity == 0) {
-                    liquidity = (arith_uint256(amountA) * amountB).sqrt().GetLow64();
-                    liquidity -= CPoolPair::MINIMUM_LIQUIDITY;
-                    newPoolPair.totalLiquidity = CPoolPair::MINIMUM_LIQUIDITY;
-                } else {
-                    CAmount liqA =
-                        (arith_uint256(amountA) * newPoolPair.totalLiquidity / newPoolPair.reserveA).GetLow64();
-                    CAmount liqB =
-                        (arith_uint256(amountB) * newPoolPair.totalLiquidity / newPoolPair.reserveB).GetLow64();
-                    liquidity = std::min(liqA, liqB);
-
-                    if (liquidity == 0) {
-                        refundBalances();
+                    if (amountA <= 0 || amountB <= 0 || isBurnAddress) {
                         continue;
                     }
-                }
 
-                auto resTotal = SafeAdd(newPoolPair.totalLiquidity, liquidity);
-                if (!resTotal) {
-                    refundBalances();
-                    continue;
-                }
-                newPoolPair.totalLiquidity = resTotal;
+                    CAmount liquidity{0};
+                    if (newPoolPair.totalLiquidity == 0) {
+                        liquidity = (arith_uint256(amountA) * amountB).sqrt().GetLow64();
+                        liquidity -= CPoolPair::MINIMUM_LIQUIDITY;
+                        newPoolPair.totalLiquidity = CPoolPair::MINIMUM_LIQUIDITY;
+                    } else {
+                        CAmount liqA =
+                            (arith_uint256(amountA) * newPoolPair.totalLiquidity / newPoolPair.reserveA).GetLow64();
+                        CAmount liqB =
+                            (arith_uint256(amountB) * newPoolPair.totalLiquidity / newPoolPair.reserveB).GetLow64();
+                        liquidity = std::min(liqA, liqB);
+
+                        if (liquidity == 0) {
+                            continue;
+                        }
+                    }
 
-                auto resA = SafeAdd(newPoolPair.reserveA, amountA);
-                auto resB = SafeAdd(newPoolPair.reserveB, amountB);
-                if (resA && resB) {
-                    newPoolPair.reserveA = resA;
-                    newPoolPair.reserveB = resB;
-                } else {
-                    refundBalances();
-                    continue;
+                    auto resTotal = SafeAdd(newPoolPair.totalLiquidity, liquidity);
+                    if (!resTotal) {
+                        continue;
+                    }
+                    newPoolPair.totalLiquidity = resTotal;
+
+                    auto resA = SafeAdd(newPoolPair.reserveA, amountA);
+                    auto resB = SafeAdd(newPoolPair.reserveB, amountB);
+                    if (resA && resB) {
+                        newPoolPair.reserveA = resA;
+                        newPoolPair.reserveB = resB;
+                    } else {
+                        continue;
+                    }
+
+                    change.liquidity = liquidity;
                 }
 
-                res = addView.AddBalance(owner, {newPoolId, liquidity});
+                size_t workers{};
+                res = ApplyPerOwner(view, changes, true, workers, applyOwnerChange);
                 if (!res) {
-                    refundBalances();
-                    continue;
+                    throw std::runtime_error(res.msg);
                 }
-                addView.Flush();
-                auto oldPoolLogStr = CTokenAmount{oldPoolId, amount}.ToString();
-                auto newPoolLogStr = CTokenAmount{newPoolId, liquidity}.ToString();
-                LogPrint(BCLog::TOKENSPLIT,
-                         "TokenSplit: LP (%s: %s => %s)\n",
-                         ScriptToString(owner),
-                         oldPoolLogStr,
-                         newPoolLogStr);
-                view.SetShare(newPoolId, owner, pindex->nHeight);
             }
 
             DCT_ID maxToken{std::numeric_limits<uint32_t>::max()};
@@ -1992,6 +2200,26 @@ static Res PoolSplits(CCustomCSView &view,
     return Res::Ok();
 }
 
+// Collateral or loan amount of one vault moved to the new token by a token split
+struct CVaultSplitChange {
+    CScript owner;
+    CVaultId vaultId;
+    CAmount amount{};
+    bool loan{};
+    bool hasVault{};
+    CAmount newAmount{};
+    uint32_t subTxn{};
+    uint32_t addTxn{};
+};
+
+struct CVaultSplitInterest {
+    CScript owner;
+    CVaultId vaultId;
+    CInterestRateV3 rate;
+    std::string schemeId;
+    CAmount schemeRate{};
+};
+
 template <typename T>
 static Res VaultSplits(CCustomCSView &view,
                        ATTRIBUTES &attributes,
@@ -2003,42 +2231,45 @@ static Res VaultSplits(CCustomCSView &view,
     auto time = GetTimeMillis();
     LogPrintf("Vaults rebalance in progress.. (token %d -> %d, height: %d)\n", oldTokenId.v, newTokenId.v, height);
 
-    std::vector<std::pair<CVaultId, CAmount>> collTokenAmounts;
+    // Collaterals first, then loans, each keyed by the vault owner so a vault stays on one worker
+    std::vector<CVaultSplitChange> changes;
     view.ForEachVaultCollateral([&](const CVaultId &vaultId, const CBalances &balances) {
         for (const auto &[tokenId, amount] : balances.balances) {
             if (tokenId == oldTokenId) {
-                collTokenAmounts.emplace_back(vaultId, amount);
+                changes.push_back({{}, vaultId, amount, false});
             }
         }
         return true;
     });
 
-    for (auto &[vaultId, amount] : collTokenAmounts) {
-        const auto res = view.SubVaultCollateral(vaultId, {oldTokenId, amount});
-        if (!res) {
-            return res;
-        }
-    }
-
-    std::vector<std::pair<CVaultId, CAmount>> loanTokenAmounts;
     view.ForEachLoanTokenAmount([&](const CVaultId &vaultId, const CBalances &balances) {
         for (const auto &[tokenId, amount] : balances.balances) {
             if (tokenId == oldTokenId) {
-                loanTokenAmounts.emplace_back(vaultId, amount);
+                changes.push_back({{}, vaultId, amount, true});
             }
         }
         return true;
     });
 
-    for (auto &[vaultId, amount] : loanTokenAmounts) {
-        const auto res = view.SubLoanToken(vaultId, {oldTokenId, amount});
-        if (!res) {
-            return res;
+    for (auto &change : changes) {
+        if (const auto vault = view.GetVault(change.vaultId)) {
+            change.owner = vault->ownerAddress;
+            change.hasVault = true;
         }
     }
 
+    size_t workers{};
+    auto res = ApplyPerOwner(view, changes, true, workers, [&](CCustomCSView &view, const CVaultSplitChange &change) {
+        const CTokenAmount oldTokenAmount{oldTokenId, change.amount};
+        return change.loan ? view.SubLoanToken(change.vaultId, oldTokenAmount)
+                           : view.SubVaultCollateral(change.vaultId, oldTokenAmount);
+    });
+    if (!res) {
+        return res;
+    }
+
     CVaultId failedVault;
-    std::vector<std::tuple<CVaultId, CInterestRateV3, std::string>> loanInterestRates;
+    std::vector<CVaultSplitInterest> loanInterestRates;
     if (height >= Params().GetConsensus().DF18FortCanningGreatWorldHeight) {
         view.ForEachVaultInterestV3([&](const CVaultId &vaultId, DCT_ID tokenId, const CInterestRateV3 &rate) {
             if (tokenId == oldTokenId) {
@@ -2047,7 +2278,7 @@ static Res VaultSplits(CCustomCSView &view,
                     failedVault = vaultId;
                     return false;
                 }
-                loanInterestRates.emplace_back(vaultId, rate, vaultData->schemeId);
+                loanInterestRates.push_back({vaultData->ownerAddress, vaultId, rate, vaultData->schemeId});
             }
             return true;
         });
@@ -2059,7 +2290,8 @@ static Res VaultSplits(CCustomCSView &view,
                     failedVault = vaultId;
                     return false;
                 }
-                loanInterestRates.emplace_back(vaultId, ConvertInterestRateToV3(rate), vaultData->schemeId);
+                loanInterestRates.push_back(
+                    {vaultData->ownerAddress, vaultId, ConvertInterestRateToV3(rate), vaultData->schemeId});
             }
             return true;
         });
@@ -2072,69 +2304,55 @@ static Res VaultSplits(CCustomCSView &view,
     attributes.EraseKey(CDataStructureV0{AttributeTypes::Locks, ParamIDs::TokenID, oldTokenId.v});
     attributes.SetValue(CDataStructureV0{AttributeTypes::Locks, ParamIDs::TokenID, newTokenId.v}, true);
 
-    if (auto res = attributes.Apply(view, height); !res) {
+    res = attributes.Apply(view, height);
+    if (!res) {
         return res;
     }
     view.SetVariable(attributes);
 
-    for (const auto &[vaultId, amount] : collTokenAmounts) {
-        auto newAmount = CalculateNewAmount(multiplier, amount);
-
-        auto oldTokenAmount = CTokenAmount{oldTokenId, amount};
-        auto newTokenAmount = CTokenAmount{newTokenId, newAmount};
-        totalBalance += newAmount;
-
-        LogPrint(BCLog::TOKENSPLIT,
-                 "TokenSplit: V Collateral (%s: %s => %s)\n",
-                 vaultId.ToString(),
-                 oldTokenAmount.ToString(),
-                 newTokenAmount.ToString());
-
-        if (auto res = view.AddVaultCollateral(vaultId, newTokenAmount); !res) {
-            return res;
+    // New amounts and history positions are handed out in order, then applied per owner
+    for (auto &change : changes) {
+        change.newAmount = CalculateNewAmount(multiplier, change.amount);
+        if (!change.loan) {
+            totalBalance += change.newAmount;
         }
 
-        if (const auto vault = view.GetVault(vaultId)) {
-            // no address -> vault collateral
-            VaultHistoryKey subKey{static_cast<uint32_t>(height), vaultId, GetNextAccPosition(), {}};
-            VaultHistoryValue subValue{
-                uint256{}, static_cast<uint8_t>(CustomTxType::TokenSplit), {{oldTokenId, -amount}}};
-            view.GetHistoryWriters().WriteVaultHistory(subKey, subValue);
+        LogPrint(BCLog::TOKENSPLIT,
+                 "TokenSplit: V %s (%s: %s => %s)\n",
+                 change.loan ? "Loan" : "Collateral",
+                 change.vaultId.ToString(),
+                 CTokenAmount{oldTokenId, change.amount}.ToString(),
+                 CTokenAmount{newTokenId, change.newAmount}.ToString());
 
-            VaultHistoryKey addKey{static_cast<uint32_t>(height), vaultId, GetNextAccPosition(), {}};
-            VaultHistoryValue addValue{
-                uint256{}, static_cast<uint8_t>(CustomTxType::TokenSplit), {{newTokenId, newAmount}}};
-            view.GetHistoryWriters().WriteVaultHistory(addKey, addValue);
+        if (change.hasVault) {
+            change.subTxn = GetNextAccPosition();
+            change.addTxn = GetNextAccPosition();
         }
     }
 
-    for (const auto &[vaultId, amount] : loanTokenAmounts) {
-        auto newAmount = CalculateNewAmount(multiplier, amount);
-
-        auto oldTokenAmount = CTokenAmount{oldTokenId, amount};
-        auto newTokenAmount = CTokenAmount{newTokenId, newAmount};
-
-        LogPrint(BCLog::TOKENSPLIT,
-                 "TokenSplit: V Loan (%s: %s => %s)\n",
-                 vaultId.ToString(),
-                 oldTokenAmount.ToString(),
-                 newTokenAmount.ToString());
-
-        if (auto res = view.AddLoanToken(vaultId, newTokenAmount); !res) {
+    res = ApplyPerOwner(view, changes, true, workers, [&](CCustomCSView &view, const CVaultSplitChange &change) {
+        const CTokenAmount newTokenAmount{newTokenId, change.newAmount};
+        auto res = change.loan ? view.AddLoanToken(change.vaultId, newTokenAmount)
+                               : view.AddVaultCollateral(change.vaultId, newTokenAmount);
+        if (!res || !change.hasVault) {
             return res;
         }
 
-        if (const auto vault = view.GetVault(vaultId)) {
-            VaultHistoryKey subKey{static_cast<uint32_t>(height), vaultId, GetNextAccPosition(), vault->ownerAddress};
-            VaultHistoryValue subValue{
-                uint256{}, static_cast<uint8_t>(CustomTxType::TokenSplit), {{oldTokenId, -amount}}};
-            view.GetHistoryWriters().WriteVaultHistory(subKey, subValue);
+        // no address -> vault collateral
+        const auto address = change.loan ? change.owner : CScript{};
+        VaultHistoryKey subKey{static_cast<uint32_t>(height), change.vaultId, change.subTxn, address};
+        VaultHistoryValue subValue{
+            uint256{}, static_cast<uint8_t>(CustomTxType::TokenSplit), {{oldTokenId, -change.amount}}};
+        view.GetHistoryWriters().WriteVaultHistory(subKey, subValue);
 
-            VaultHistoryKey addKey{static_cast<uint32_t>(height), vaultId, GetNextAccPosition(), vault->ownerAddress};
-            VaultHistoryValue addValue{
-                uint256{}, static_cast<uint8_t>(CustomTxType::TokenSplit), {{newTokenId, newAmount}}};
-            view.GetHistoryWriters().WriteVaultHistory(addKey, addValue);
-        }
+        VaultHistoryKey addKey{static_cast<uint32_t>(height), change.vaultId, change.addTxn, address};
+        VaultHistoryValue addValue{
+            uint256{}, static_cast<uint8_t>(CustomTxType::TokenSplit), {{newTokenId, change.newAmount}}};
+        view.GetHistoryWriters().WriteVaultHistory(addKey, addValue);
+        return Res::Ok();
+    });
+    if (!res) {
+        return res;
     }
 
     const auto loanToken = view.GetLoanTokenByID(newTokenId);
@@ -2149,41 +2367,50 @@ static Res VaultSplits(CCustomCSView &view,
         return true;
     });
 
-    for (auto &[vaultId, rate, schemeId] : loanInterestRates) {
-        CAmount loanSchemeRate{0};
-        try {
-            loanSchemeRate = loanSchemes.at(schemeId);
-        } catch (const std::out_of_range &) {
+    for (auto &interest : loanInterestRates) {
+        const auto it = loanSchemes.find(interest.schemeId);
+        if (it == loanSchemes.end()) {
             return Res::Err("Failed to get loan scheme.");
         }
+        interest.schemeRate = it->second;
+    }
 
-        view.EraseInterest(vaultId, oldTokenId, height);
-        auto oldRateToHeight = rate.interestToHeight;
-        auto newRateToHeight = CalculateNewAmount(multiplier, rate.interestToHeight.amount);
+    res = ApplyPerOwner(
+        view, loanInterestRates, true, workers, [&](CCustomCSView &view, const CVaultSplitInterest &interest) {
+            const auto &vaultId = interest.vaultId;
+            auto rate = interest.rate;
 
-        rate.interestToHeight.amount = newRateToHeight;
+            view.EraseInterest(vaultId, oldTokenId, height);
+            auto oldRateToHeight = rate.interestToHeight;
+            auto newRateToHeight = CalculateNewAmount(multiplier, rate.interestToHeight.amount);
 
-        auto oldInterestPerBlock = rate.interestPerBlock;
-        CInterestAmount newInterestRatePerBlock{};
+            rate.interestToHeight.amount = newRateToHeight;
 
-        auto amounts = view.GetLoanTokens(vaultId);
-        if (amounts) {
-            newInterestRatePerBlock =
-                InterestPerBlockCalculationV3(amounts->balances[newTokenId], loanToken->interest, loanSchemeRate);
-            rate.interestPerBlock = newInterestRatePerBlock;
-        }
+            auto oldInterestPerBlock = rate.interestPerBlock;
+            CInterestAmount newInterestRatePerBlock{};
 
-        if (LogAcceptCategory(BCLog::TOKENSPLIT)) {
-            LogPrint(BCLog::TOKENSPLIT,
-                     "TokenSplit: V Interest (%s: %s => %s, %s => %s)\n",
-                     vaultId.ToString(),
-                     GetInterestPerBlockHighPrecisionString(oldRateToHeight),
-                     GetInterestPerBlockHighPrecisionString({oldRateToHeight.negative, newRateToHeight}),
-                     GetInterestPerBlockHighPrecisionString(oldInterestPerBlock),
-                     GetInterestPerBlockHighPrecisionString(newInterestRatePerBlock));
-        }
+            auto amounts = view.GetLoanTokens(vaultId);
+            if (amounts) {
+                newInterestRatePerBlock = InterestPerBlockCalculationV3(
+                    amounts->balances[newTokenId], loanToken->interest, interest.schemeRate);
+                rate.interestPerBlock = newInterestRatePerBlock;
+            }
 
-        view.WriteInterestRate(std::make_pair(vaultId, newTokenId), rate, rate.height);
+            if (LogAcceptCategory(BCLog::TOKENSPLIT)) {
+                LogPrint(BCLog::TOKENSPLIT,
+                         "TokenSplit: V Interest (%s: %s => %s, %s => %s)\n",
+                         vaultId.ToString(),
+                         GetInterestPerBlockHighPrecisionString(oldRateToHeight),
+                         GetInterestPerBlockHighPrecisionString({oldRateToHeight.negative, newRateToHeight}),
+                         GetInterestPerBlockHighPrecisionString(oldInterestPerBlock),
+                         GetInterestPerBlockHighPrecisionString(newInterestRatePerBlock));
+            }
+
+            view.WriteInterestRate(std::make_pair(vaultId, newTokenId), rate, rate.height);
+            return Res::Ok();
+        });
+    if (!res) {
+        return res;
     }
 
     std::vector<std::pair<CVaultView::AuctionStoreKey, CAuctionBatch>> auctionBatches;
@@ -2365,6 +2592,77 @@ static void UpdateOracleSplitKeys(const uint32_t id, ATTRIBUTES &attributes) {
     }
 }
 
+Res SplitAccountBalances(const CBlockIndex *pindex,
+                         CCustomCSView &view,
+                         const DCT_ID oldTokenId,
+                         const DCT_ID newTokenId,
+                         const std::function<CAmount(const CAmount)> &newAmount,
+                         CAmount &totalBalance,
+                         size_t &accounts) {
+    const auto time = GetTimeMillis();
+
+    std::vector<std::pair<CScript, CAmount>> holders;
+    view.ForEachBalance([&](const CScript &owner, const CTokenAmount &balance) {
+        if (oldTokenId.v == balance.nTokenId.v) {
+            holders.emplace_back(owner, balance.nValue);
+        }
+        return true;
+    });
+
+    // History positions are handed out in owner order, as they were when balances were collected in a map
+    const auto ownerLess = [](const auto &a, const auto &b) { return a.first < b.first; };
+    if (!std::is_sorted(holders.begin(), holders.end(), ownerLess)) {
+        std::sort(holders.begin(), holders.end(), ownerLess);
+    }
+    accounts = holders.size();
+
+    std::vector<CAccountChange> changes;
+    auto reportedTs = time;
+    for (size_t begin{}; begin < holders.size(); begin += OWNERS_PER_CHUNK) {
+        const auto end = std::min(holders.size(), begin + OWNERS_PER_CHUNK);
+
+        changes.clear();
+        for (auto i = begin; i < end; ++i) {
+            const auto &[owner, amount] = holders[i];
+            const CTokenAmount oldBalance{oldTokenId, amount};
+            const CTokenAmount newBalance{newTokenId, newAmount(amount)};
+            totalBalance += newBalance.nValue;
+
+            LogPrint(BCLog::TOKENSPLIT,
+                     "TokenSplit: T (%s: %s => %s)\n",
+                     ScriptToString(owner),
+                     oldBalance.ToString(),
+                     newBalance.ToString());
+
+            changes.push_back({owner, oldBalance, GetNextAccPosition(), true});
+            changes.push_back({owner, newBalance, GetNextAccPosition(), false});
+        }
+
+        size_t workers{};
+        auto res = ApplyAccountChanges(pindex, view, changes, uint8_t(CustomTxType::TokenSplit), true, workers);
+        if (!res) {
+            return res;
+        }
+
+        const auto logTimeIntervalMillis = 3 * 1000;
+        if (GetTimeMillis() - reportedTs > logTimeIntervalMillis) {
+            LogPrintf("Token split: %.2f%% of balances migrated (%d/%d, workers: %d)\n",
+                      (end * 1.f / holders.size()) * 100.0,
+                      end,
+                      holders.size(),
+                      workers);
+            reportedTs = GetTimeMillis();
+        }
+    }
+
+    LogPrint(BCLog::TOKENSPLIT,
+             "TokenSplit: balances migrated (accounts: %d, time: %dms)\n",
+             holders.size(),
+             GetTimeMillis() - time);
+
+    return Res::Ok();
+}
+
 template <typename T>
 static void ExecuteTokenSplits(const CBlockIndex *pindex,
                                CCustomCSView &cache,
@@ -2515,28 +2813,6 @@ static void ExecuteTokenSplits(const CBlockIndex *pindex,
 
         auto totalBalance = totalBalanceMap[newTokenId.v];
 
-        std::map<CScript, std::pair<CTokenAmount, CTokenAmount>> balanceUpdates;
-
-        view.ForEachBalance([&, multiplier = multiplier](const CScript &owner, const CTokenAmount &balance) {
-            if (oldTokenId.v == balance.nTokenId.v) {
-                const auto newBalance = CalculateNewAmount(multiplier, balance.nValue);
-                balanceUpdates.emplace(owner,
-                                       std::pair<CTokenAmount, CTokenAmount>{
-                                           {newTokenId, newBalance},
-                                           balance
-                });
-                totalBalance += newBalance;
-
-                auto newBalanceStr = CTokenAmount{newTokenId, newBalance}.ToString();
-                LogPrint(BCLog::TOKENSPLIT,
-                         "TokenSplit: T (%s: %s => %s)\n",
-                         ScriptToString(owner),
-                         balance.ToString(),
-                         newBalanceStr);
-            }
-            return true;
-        });
-
         // convert lock values
         if (pindex->nHeight >= consensus.DF24Height) {
             auto multi = multiplier;
@@ -2559,46 +2835,29 @@ static void ExecuteTokenSplits(const CBlockIndex *pindex,
             });
         }
 
+        size_t accounts{};
+        res = SplitAccountBalances(
+            pindex,
+            view,
+            oldTokenId,
+            newTokenId,
+            [multiplier = multiplier](const CAmount amount) { return CalculateNewAmount(multiplier, amount); },
+            totalBalance,
+            accounts);
+        if (!res) {
+            LogPrintf("Token split failed. %s\n", res.msg);
+            splitSuccess = false;
+            continue;
+        }
+
         LogPrintf(
             "Token split info: rebalance " /* Continued */
             "(id: %d, symbol: %s, accounts: %d, val: %d)\n",
             id,
             newToken.symbol,
-            balanceUpdates.size(),
+            accounts,
             totalBalance);
 
-        try {
-            for (const auto &[owner, balances] : balanceUpdates) {
-                CAccountsHistoryWriter subView(view,
-                                               pindex->nHeight,
-                                               GetNextAccPosition(),
-                                               pindex->GetBlockHash(),
-                                               uint8_t(CustomTxType::TokenSplit));
-
-                res = subView.SubBalance(owner, balances.second);
-                if (!res) {
-                    throw std::runtime_error(res.msg);
-                }
-                subView.Flush();
-
-                CAccountsHistoryWriter addView(view,
-                                               pindex->nHeight,
-                                               GetNextAccPosition(),
-                                               pindex->GetBlockHash(),
-                                               uint8_t(CustomTxType::TokenSplit));
-
-                res = addView.AddBalance(owner, balances.first);
-                if (!res) {
-                    throw std::runtime_error(res.msg);
-                }
-                addView.Flush();
-            }
-        } catch (const std::runtime_error &e) {
-            LogPrintf("Token split failed. %s\n", res.msg);
-            splitSuccess = false;
-            continue;
-        }
-
         res = VaultSplits(view, attributes, oldTokenId, newTokenId, pindex->nHeight, multiplier, totalBalance);
         if (!res) {
             LogPrintf("Token splits failed: %s\n", res.msg);
@@ -3294,7 +3553,7 @@ static Res ForceCloseAllAuctions(const CBlockIndex *pindex, CCustomCSView &cache
                 balances.Add({batch->loanAmount.nTokenId, batch->loanInterest});
 
                 // When tracking loan amounts remove interest.
-                if (const auto token = view.GetToken("DUSD"); token && token->first == batch->loanAmount.nTokenId) {
+                if (const auto dusdId = view.GetDUSDTokenId(); dusdId && *dusdId == batch->loanAmount.nTokenId) {
                     TrackDUSDAdd(view, {batch->loanAmount.nTokenId, batch->loanAmount.nValue - batch->loanInterest});
                 }
 
@@ -3754,70 +4013,82 @@ static CAmount calcLockedAmount(const CAmount &input, const CAmount &lockRatio)
     return locked;
 };
 
-static Res LockTokensOfBalancesCollAndPools(const CBlock &block,
-                                            const CBlockIndex *pindex,
-                                            CCustomCSView &cache,
-                                            BlockContext &blockCtx,
-                                            const CAmount lockRatio) {
+// Token lock changes of one owner's balances and pool shares, written as one history entry
+struct CTokenLockOwnerChange {
+    CScript owner;
+    uint32_t txn{};
+    TAmounts balances;
+    std::vector<CTokenAmount> locks;
+    std::vector<DCT_ID> shares;
+};
+
+// Token lock of one collateral token of a vault
+struct CTokenLockCollateral {
+    CScript owner;
+    CVaultId vaultId;
+    CTokenAmount amount;
+    uint32_t txn{};
+};
+
+static Res StoreTokenLocks(CCustomCSView &view, const CScript &owner, const std::vector<CTokenAmount> &amounts) {
+    auto currentLock = view.GetTokenLockUserValue({owner});
+    for (const auto &amount : amounts) {
+        currentLock.Add(amount);
+    }
+    return view.StoreTokenLockUserValues({owner}, currentLock);
+}
+
+Res LockTokenBalances(const CBlockIndex *pindex,
+                      CCustomCSView &cache,
+                      const std::unordered_set<uint32_t> &tokensToBeLocked,
+                      const std::unordered_set<uint32_t> &affectedPools,
+                      const CAmount lockRatio,
+                      const CScript &contractAddressValue,
+                      CBalances &totalLockedFunds) {
     auto lockedAmount = [&](CAmount input) { return calcLockedAmount(input, lockRatio); };
 
-    // to have it all in one history
-    std::map<CScript, TAmounts> balanceChangePerAddress;
-    CBalances totalLockedFunds;
+    const auto lockToken = [&](std::vector<CTokenAmount> &locks, const CTokenAmount &amount) {
+        locks.push_back(amount);
+        return totalLockedFunds.Add(amount);
+    };
 
-    std::unordered_set<uint32_t> tokensToBeLocked;
-    std::unordered_set<uint32_t> affectedPools;
-    ForEachLockTokenAndPool(
-        [&](const DCT_ID &id, const CLoanSetLoanTokenImplementation &token) {
-            tokensToBeLocked.emplace(id.v);
-            return true;
-        },
-        [&](const DCT_ID &id, const CPoolPair &token) {
-            affectedPools.emplace(id.v);
-            return true;
-        },
-        cache);
+    // to have it all in one history
+    std::map<CScript, CTokenLockOwnerChange> changePerAddress;
 
     // from balances
     LogPrintf("locking %.2f%% of loan tokens in balances and pools\n", lockRatio * 100.0 / COIN);
-    const auto contractAddressValue = blockCtx.GetConsensus().smartContracts.at(SMART_CONTRACT_TOKENLOCK);
     auto res = Res::Ok();
-    std::vector<std::pair<CScript, DCT_ID>> ownersWithTokens;
+    std::vector<std::pair<CScript, CTokenAmount>> ownersWithTokens;
     cache.ForEachBalance([&](const CScript &owner, const CTokenAmount &amount) {
-        if (owner == blockCtx.GetConsensus().burnAddress || owner == contractAddressValue) {
+        if (owner == Params().GetConsensus().burnAddress || owner == contractAddressValue) {
             return true;  // no lock from burn or lock address
         }
 
         if (tokensToBeLocked.count(amount.nTokenId.v) && amount.nValue > 0) {
-            ownersWithTokens.emplace_back(owner, amount.nTokenId);
+            ownersWithTokens.emplace_back(owner, amount);
         }
         if (affectedPools.count(amount.nTokenId.v) && amount.nValue > 0) {
-            ownersWithTokens.emplace_back(owner, amount.nTokenId);
+            ownersWithTokens.emplace_back(owner, amount);
         }
         return true;
     });
 
-    uint64_t reportedTs = 0;
-    uint64_t done = 0;
+    // Balances are not changed before the history entries are written, so the amounts to lock and the pool
+    // reserves taken out are worked out in order up front, then applied per owner on DfTxTaskPool workers.
     std::map<DCT_ID, CPoolPair> poolsCache;
-    for (const auto &[owner, tokenId] : ownersWithTokens) {
-        const auto amount = cache.GetBalance(owner, tokenId);
+    for (const auto &[owner, amount] : ownersWithTokens) {
+        auto &change = changePerAddress[owner];
 
-        if (tokensToBeLocked.count(amount.nTokenId.v) && amount.nValue > 0) {
+        if (tokensToBeLocked.count(amount.nTokenId.v)) {
             const auto amountToLock = lockedAmount(amount.nValue);
-            balanceChangePerAddress[owner][amount.nTokenId] -= amountToLock;
-
-            res = LockToken(cache,
-                            pindex->nHeight,
-                            pindex->GetBlockHash(),
-                            owner,
-                            {amount.nTokenId, amountToLock},
-                            totalLockedFunds);
+            change.balances[amount.nTokenId] -= amountToLock;
+
+            res = lockToken(change.locks, {amount.nTokenId, amountToLock});
             if (!res) {
                 return res;
             }
         }
-        if (affectedPools.count(amount.nTokenId.v) && amount.nValue > 0) {
+        if (affectedPools.count(amount.nTokenId.v)) {
             if (poolsCache.count(amount.nTokenId) == 0) {
                 auto pp = cache.GetPoolPair(amount.nTokenId);
                 if (!pp) {
@@ -3827,7 +4098,7 @@ static Res LockTokensOfBalancesCollAndPools(const CBlock &block,
             }
             auto poolPair = &poolsCache.at(amount.nTokenId);
             auto amountToLock = lockedAmount(amount.nValue);
-            balanceChangePerAddress[owner][amount.nTokenId] -= amountToLock;
+            change.balances[amount.nTokenId] -= amountToLock;
 
             CAmount resAmountA = MultiplyDivideAmounts(amountToLock, poolPair->reserveA, poolPair->totalLiquidity);
             CAmount resAmountB = MultiplyDivideAmounts(amountToLock, poolPair->reserveB, poolPair->totalLiquidity);
@@ -3836,45 +4107,27 @@ static Res LockTokensOfBalancesCollAndPools(const CBlock &block,
             poolPair->totalLiquidity -= amountToLock;
 
             if (tokensToBeLocked.count(poolPair->idTokenA.v)) {
-                res = LockToken(cache,
-                                pindex->nHeight,
-                                pindex->GetBlockHash(),
-                                owner,
-                                {poolPair->idTokenA, resAmountA},
-                                totalLockedFunds);
+                res = lockToken(change.locks, {poolPair->idTokenA, resAmountA});
                 if (!res) {
                     return res;
                 }
             } else {
-                balanceChangePerAddress[owner][poolPair->idTokenA] += resAmountA;
+                change.balances[poolPair->idTokenA] += resAmountA;
             }
 
             if (tokensToBeLocked.count(poolPair->idTokenB.v)) {
-                res = LockToken(cache,
-                                pindex->nHeight,
-                                pindex->GetBlockHash(),
-                                owner,
-                                {poolPair->idTokenB, resAmountB},
-                                totalLockedFunds);
+                res = lockToken(change.locks, {poolPair->idTokenB, resAmountB});
                 if (!res) {
                     return res;
                 }
             } else {
-                balanceChangePerAddress[owner][poolPair->idTokenB] += resAmountB;
+                change.balances[poolPair->idTokenB] += resAmountB;
             }
 
-            cache.SetShare(amount.nTokenId, owner, pindex->nHeight);
-        }
-
-        ++done;
-        if (GetTimeMillis() - reportedTs > 3000) {
-            LogPrintf("locking balances and pools: %.2f%% completed (%d/%d)\n",
-                      (done * 1.f / ownersWithTokens.size()) * 100.0,
-                      done,
-                      ownersWithTokens.size());
-            reportedTs = GetTimeMillis();
+            change.shares.push_back(amount.nTokenId);
         }
     }
+    ownersWithTokens = {};
 
     for (const auto &[tokenId, poolPair] : poolsCache) {
         res = cache.SetPoolPair(tokenId, pindex->nHeight, poolPair);
@@ -3884,26 +4137,99 @@ static Res LockTokensOfBalancesCollAndPools(const CBlock &block,
     }
 
     // add one history entry per address for tokenLock
-    for (const auto &[owner, amounts] : balanceChangePerAddress) {
-        CAccountsHistoryWriter changeView(
-            cache, pindex->nHeight, GetNextAccPosition(), pindex->GetBlockHash(), uint8_t(CustomTxType::TokenLock));
+    const auto applyOwnerChange = [&](CCustomCSView &view, const CTokenLockOwnerChange &change) {
+        if (!change.locks.empty()) {
+            if (auto res = StoreTokenLocks(view, change.owner, change.locks); !res) {
+                return res;
+            }
+        }
+        for (const auto &poolId : change.shares) {
+            view.SetShare(poolId, change.owner, pindex->nHeight);
+        }
 
-        for (const auto &[tokenId, amount] : amounts) {
+        CAccountsHistoryWriter changeView(
+            view, pindex->nHeight, change.txn, pindex->GetBlockHash(), uint8_t(CustomTxType::TokenLock));
+        for (const auto &[tokenId, amount] : change.balances) {
+            auto res = Res::Ok();
             if (amount > 0) {
-                res = changeView.AddBalance(owner, CTokenAmount{tokenId, amount});
+                res = changeView.AddBalance(change.owner, CTokenAmount{tokenId, amount});
             } else if (amount < 0) {
-                res = changeView.SubBalance(owner, CTokenAmount{tokenId, -amount});
+                res = changeView.SubBalance(change.owner, CTokenAmount{tokenId, -amount});
             }
             if (!res) {
                 return res;
             }
         }
         changeView.Flush();
+        return Res::Ok();
+    };
+
+    const auto owners = changePerAddress.size();
+    uint64_t reportedTs = 0;
+    uint64_t done = 0;
+    std::vector<CTokenLockOwnerChange> chunk;
+    while (!changePerAddress.empty()) {
+        chunk.clear();
+        while (!changePerAddress.empty() && chunk.size() < OWNERS_PER_CHUNK) {
+            auto node = changePerAddress.extract(changePerAddress.begin());
+            auto &change = chunk.emplace_back(std::move(node.mapped()));
+            change.owner = std::move(node.key());
+            change.txn = GetNextAccPosition();
+        }
+
+        size_t workers{};
+        res = ApplyPerOwner(cache, chunk, true, workers, applyOwnerChange);
+        if (!res) {
+            return res;
+        }
+
+        done += chunk.size();
+        if (GetTimeMillis() - reportedTs > 3000) {
+            LogPrintf("locking balances and pools: %.2f%% completed (%d/%d, workers: %d)\n",
+                      (done * 1.f / owners) * 100.0,
+                      done,
+                      owners,
+                      workers);
+            reportedTs = GetTimeMillis();
+        }
+    }
+
+    return Res::Ok();
+}
+
+static Res LockTokensOfBalancesCollAndPools(const CBlock &block,
+                                            const CBlockIndex *pindex,
+                                            CCustomCSView &cache,
+                                            BlockContext &blockCtx,
+                                            const CAmount lockRatio) {
+    auto lockedAmount = [&](CAmount input) { return calcLockedAmount(input, lockRatio); };
+
+    CBalances totalLockedFunds;
+
+    std::unordered_set<uint32_t> tokensToBeLocked;
+    std::unordered_set<uint32_t> affectedPools;
+    ForEachLockTokenAndPool(
+        [&](const DCT_ID &id, const CLoanSetLoanTokenImplementation &token) {
+            tokensToBeLocked.emplace(id.v);
+            return true;
+        },
+        [&](const DCT_ID &id, const CPoolPair &token) {
+            affectedPools.emplace(id.v);
+            return true;
+        },
+        cache);
+
+    const auto contractAddressValue = blockCtx.GetConsensus().smartContracts.at(SMART_CONTRACT_TOKENLOCK);
+    auto res = LockTokenBalances(
+        pindex, cache, tokensToBeLocked, affectedPools, lockRatio, contractAddressValue, totalLockedFunds);
+    if (!res) {
+        return res;
     }
 
     // from vault collaterals (only USDD)
     LogPrintf("locking %.2f%% of loan tokens in collaterals\n", lockRatio * 100.0 / COIN);
 
+    std::vector<CTokenLockCollateral> collaterals;
     cache.ForEachVaultCollateral([&](const CVaultId &vaultId, const CBalances &balances) {
         for (const auto &[tokenId, amount] : balances.balances) {
             if (tokensToBeLocked.count(tokenId.v)) {
@@ -3911,22 +4237,11 @@ static Res LockTokensOfBalancesCollAndPools(const CBlock &block,
 
                 const auto amountToLock = lockedAmount(amount);
 
-                res = cache.SubVaultCollateral(vaultId, {tokenId, amountToLock});
-                if (!res) {
-                    return false;
-                }
-                res = LockToken(
-                    cache, pindex->nHeight, pindex->GetBlockHash(), owner, {tokenId, amountToLock}, totalLockedFunds);
+                res = totalLockedFunds.Add({tokenId, amountToLock});
                 if (!res) {
                     return false;
                 }
-
-                // history entry
-                VaultHistoryKey subCollKey{static_cast<uint32_t>(pindex->nHeight), vaultId, GetNextAccPosition(), {}};
-                VaultHistoryValue subCollValue{
-                    uint256{}, static_cast<uint8_t>(CustomTxType::TokenLock), {{tokenId, -amountToLock}}};
-                cache.GetHistoryWriters().WriteVaultHistory(subCollKey, subCollValue);
-                // ---
+                collaterals.push_back({std::move(owner), vaultId, {tokenId, amountToLock}, GetNextAccPosition()});
             }
         }
         return true;
@@ -3936,6 +4251,31 @@ static Res LockTokensOfBalancesCollAndPools(const CBlock &block,
         return res;
     }
 
+    size_t workers{};
+    res = ApplyPerOwner(
+        cache, collaterals, true, workers, [&](CCustomCSView &view, const CTokenLockCollateral &collateral) {
+            auto res = view.SubVaultCollateral(collateral.vaultId, collateral.amount);
+            if (!res) {
+                return res;
+            }
+            res = StoreTokenLocks(view, collateral.owner, {collateral.amount});
+            if (!res) {
+                return res;
+            }
+
+            // history entry
+            VaultHistoryKey subCollKey{
+                static_cast<uint32_t>(pindex->nHeight), collateral.vaultId, collateral.txn, {}};
+            VaultHistoryValue subCollValue{uint256{},
+                                           static_cast<uint8_t>(CustomTxType::TokenLock),
+                                           {{collateral.amount.nTokenId, -collateral.amount.nValue}}};
+            view.GetHistoryWriters().WriteVaultHistory(subCollKey, subCollValue);
+            return Res::Ok();
+        });
+    if (!res) {
+        return res;
+    }
+
     CAccountsHistoryWriter addView(
         cache, pindex->nHeight, GetNextAccPosition(), pindex->GetBlockHash(), uint8_t(CustomTxType::TokenLock));
     for (const auto &[tokenId, amount] : totalLockedFunds.balances) {
@@ -4149,23 +4489,31 @@ static void ProcessFuturesDUSD(const CBlockIndex *pindex, CCustomCSView &cache,
 
     auto swapCounter{0};
 
+    std::vector<CAccountChange> payouts;
+    // Minted DUSD before and after the payouts, a payout that would overflow it is left out of it as in ProcessFutures
+    std::pair<CAmount, CAmount> mintedDUSD{};
+    std::optional<DCT_ID> dusdId;
+
     cache.ForEachFuturesDUSD(
         [&](const CFuturesUserKey &key, const CAmount &amount) {
-            CAccountsHistoryWriter view(cache,
-                                        pindex->nHeight,
-                                        GetNextAccPosition(),
-                                        pindex->GetBlockHash(),
-                                        uint8_t(CustomTxType::FutureSwapExecution));
+            const auto txn = GetNextAccPosition();
 
             deletionPending.insert(key);
 
-            const auto tokenDUSD = view.GetToken("DUSD");
-            assert(tokenDUSD);
+            if (!dusdId) {
+                dusdId = cache.GetDUSDTokenId();
+                assert(dusdId);
+                const auto token = cache.GetToken(*dusdId);
+                assert(token);
+                mintedDUSD = {token->minted, token->minted};
+            }
 
             const auto total = MultiplyAmounts(amount, discountPrice);
-            view.AddMintedTokens(tokenDUSD->first, total);
-            CTokenAmount destination{tokenDUSD->first, total};
-            view.AddBalance(key.owner, destination);
+            if (const auto sum = SafeAdd(mintedDUSD.second, total)) {
+                mintedDUSD.second = *sum;
+            }
+            CTokenAmount destination{*dusdId, total};
+            payouts.push_back({key.owner, destination, txn, false});
             burned.Add({dfiID, amount});
             minted.Add(destination);
             ++swapCounter;
@@ -4175,12 +4523,20 @@ static void ProcessFuturesDUSD(const CBlockIndex *pindex, CCustomCSView &cache,
                      amount,
                      destination.ToString());
 
-            view.Flush();
-
             return true;
         },
         {static_cast<uint32_t>(pindex->nHeight), {}, std::numeric_limits<uint32_t>::max()});
 
+    const auto pricingTime = GetTimeMillis() - time;
+
+    if (dusdId) {
+        if (const auto res = cache.AddMintedTokens(*dusdId, mintedDUSD.second - mintedDUSD.first); !res) {
+            LogPrintf("DUSD futures settlement failed on AddMintedTokens %s\n", res.msg);
+        }
+    }
+    size_t workers{};
+    ApplyAccountChanges(pindex, cache, payouts, uint8_t(CustomTxType::FutureSwapExecution), false, workers);
+
     for (const auto &key : deletionPending) {
         cache.EraseFuturesDUSD(key);
     }
@@ -4188,10 +4544,12 @@ static void ProcessFuturesDUSD(const CBlockIndex *pindex, CCustomCSView &cache,
     attributes->SetValue(burnKey, std::move(burned));
     attributes->SetValue(mintedKey, std::move(minted));
 
-    LogPrintf("Future swap DUSD settlement completed: (%d swaps (height: %d, time: %dms)\n",
+    LogPrintf("Future swap DUSD settlement completed: (%d swaps (height: %d, time: %dms, pricing: %dms, workers: %d)\n",
               swapCounter,
               pindex->nHeight,
-              GetTimeMillis() - time);
+              GetTimeMillis() - time,
+              pricingTime,
+              workers);
 
     cache.SetVariable(*attributes);
 }
@@ -4262,7 +4620,7 @@ static void ProcessProposalEvents(const CBlockIndex *pindex, CCustomCSView &cach
         cache.AddCommunityBalance(CommunityAccountType::CommunityDevFunds, balance.nValue);
     }
 
-    std::set<uint256> activeMasternodes;
+    std::set<uint256> activeMasternodes, inactiveMasternodes;
     cache.ForEachCycleProposal(
         [&](const CProposalId &propId, const CProposalObject &prop) {
             if (prop.status != CProposalStatusType::Voting) {
@@ -4270,41 +4628,33 @@ static void ProcessProposalEvents(const CBlockIndex *pindex, CCustomCSView &cach
             }
 
             if (activeMasternodes.empty()) {
-                cache.ForEachMasternode([&](const uint256 &mnId, CMasternode node) {
-                    if (node.IsActive(pindex->nHeight, cache) && node.mintedBlocks) {
-                        activeMasternodes.insert(mnId);
-                    }
-                    return true;
-                });
+                cache.GetMintingMasternodes(pindex->nHeight, activeMasternodes, inactiveMasternodes);
                 if (activeMasternodes.empty()) {
                     return false;
                 }
             }
 
-            uint32_t voteYes = 0, voteNeutral = 0;
-            std::set<uint256> voters{};
-            cache.ForEachProposalVote(
-                [&](const CProposalId &pId, uint8_t cycle, const uint256 &mnId, CProposalVoteType vote) {
-                    if (pId != propId || cycle != prop.cycle) {
-                        return false;
-                    }
-                    if (activeMasternodes.count(mnId)) {
-                        voters.insert(mnId);
-                        if (vote == CProposalVoteType::VoteYes) {
-                            ++voteYes;
-                        } else if (vote == CProposalVoteType::VoteNeutral) {
-                            ++voteNeutral;
-                        }
-                    }
-                    return true;
-                },
-                CMnVotePerCycle{propId, prop.cycle});
+            const auto tally = cache.GetProposalVoteTally(propId, prop.cycle, inactiveMasternodes);
+            const auto voteYes = tally.yes, voteNeutral = tally.neutral, votersCount = tally.Valid();
 
             // Redistributes fee among voting masternodes
             CDataStructureV0 feeRedistributionKey{
                 AttributeTypes::Governance, GovernanceIDs::Proposals, GovernanceKeys::FeeRedistribution};
 
-            if (voters.size() > 0 && attributes->GetValue(feeRedistributionKey, false)) {
+            if (votersCount > 0 && attributes->GetValue(feeRedistributionKey, false)) {
+                std::set<uint256> voters{};
+                cache.ForEachProposalVote(
+                    [&](const CProposalId &pId, uint8_t cycle, const uint256 &mnId, CProposalVoteType) {
+                        if (pId != propId || cycle != prop.cycle) {
+                            return false;
+                        }
+                        if (activeMasternodes.count(mnId)) {
+                            voters.insert(mnId);
+                        }
+                        return true;
+                    },
+                    CMnVotePerCycle{propId, prop.cycle});
+
                 // return half fee among voting masternodes, the rest is burned at creation
                 auto feeBack = prop.fee - prop.feeBurnAmount;
                 auto amountPerVoter = DivideAmounts(feeBack, voters.size() * COIN);
@@ -4352,19 +4702,19 @@ static void ProcessProposalEvents(const CBlockIndex *pindex, CCustomCSView &cach
                 }
             }
 
-            if (lround(voters.size() * 10000.f / activeMasternodes.size()) <= prop.quorum) {
+            if (lround(votersCount * 10000.f / activeMasternodes.size()) <= prop.quorum) {
                 cache.UpdateProposalStatus(propId, pindex->nHeight, CProposalStatusType::Rejected);
                 return true;
             }
 
             if (pindex->nHeight < consensus.DF22MetachainHeight &&
-                lround(voteYes * 10000.f / voters.size()) <= prop.approvalThreshold) {
+                lround(voteYes * 10000.f / votersCount) <= prop.approvalThreshold) {
                 cache.UpdateProposalStatus(propId, pindex->nHeight, CProposalStatusType::Rejected);
                 return true;
             } else if (pindex->nHeight >= consensus.DF22MetachainHeight) {
-                auto onlyNeutral = voters.size() == voteNeutral;
+                auto onlyNeutral = votersCount == voteNeutral;
                 if (onlyNeutral ||
-                    lround(voteYes * 10000.f / (voters.size() - voteNeutral)) <= prop.approvalThreshold) {
+                    lround(voteYes * 10000.f / (votersCount - voteNeutral)) <= prop.approvalThreshold) {
                     cache.UpdateProposalStatus(propId, pindex->nHeight, CProposalStatusType::Rejected);
                     return true;
                 }
@@ -4623,18 +4973,19 @@ static void FlushCacheCreateUndo(const CBlockIndex *pindex,
     }
 }
 
-static CrossBoundaryResult OceanIndex(const UniValue b, const uint32_t height) {
+static CrossBoundaryResult OceanIndexBlock(const std::vector<uint8_t> &payload, const uint32_t height) {
     auto time = GetTimeMillis();
     CrossBoundaryResult result;
-    ocean_index_block(result, b.write());
+    const rust::Slice<const uint8_t> block{payload.data(), payload.size()};
+    ocean_index_block(result, block);
     if (!result.ok) {
         LogPrintf("Error indexing block %d : %s\n", height, result.reason);
-        ocean_invalidate_block(result, b.write());
+        ocean_invalidate_block(result, block);
         if (!result.ok) {
             LogPrintf("Error invalidating block %d: %s\n", height, result.reason);
             return result;
         }
-        OceanIndex(b, height);
+        OceanIndexBlock(payload, height);
     }
     LogPrint(BCLog::OCEAN, "Indexing ocean block %d took: %dms\n", height, GetTimeMillis() - time);
     return result;
@@ -4668,11 +5019,12 @@ Res ProcessDeFiEventFallible(const CBlock &block,
     FlushCacheCreateUndo(pindex, mnview, cache, uint256S(std::string(64, '1')));
 
     // Ocean archive
-    if (gArgs.GetBoolArg("-oceanarchive", DEFAULT_OCEAN_INDEXER_ENABLED) ||
-        gArgs.GetBoolArg("-expr-oceanarchive", DEFAULT_OCEAN_INDEXER_ENABLED)) {
-        const UniValue b = blockToJSON(cache, block, ::ChainActive().Tip(), pindex, true, 2);
+    if ((gArgs.GetBoolArg("-oceanarchive", DEFAULT_OCEAN_INDEXER_ENABLED) ||
+         gArgs.GetBoolArg("-expr-oceanarchive", DEFAULT_OCEAN_INDEXER_ENABLED)) &&
+        !IsOceanCatchupActive()) {
+        const auto payload = blockToOceanPayload(cache, block, ::ChainActive().Tip(), pindex);
 
-        if (CrossBoundaryResult result = OceanIndex(b, static_cast<uint32_t>(pindex->nHeight)); !result.ok) {
+        if (CrossBoundaryResult result = OceanIndexBlock(payload, static_cast<uint32_t>(pindex->nHeight)); !result.ok) {
             return Res::Err(result.reason.c_str());
         }
     }
@@ -6,6 +6,7 @@
 #define DEFI_DFI_VALIDATION_H
 
 #include <amount.h>
+#include <script/script.h>
 
 struct CAuctionBatch;
 class CBlock;
@@ -41,6 +42,41 @@ std::vector<CAuctionBatch> CollectAuctionBatches(const CVaultAssets &vaultAssets
 
 Res GetTokenSuffix(const CCustomCSView &view, const ATTRIBUTES &attributes, const uint32_t id, std::string &newSuffix);
 
+struct CAccountChange {
+    CScript owner;
+    CTokenAmount amount;
+    uint32_t txn;
+    bool sub;
+};
+
+// Applies account changes, each as its own history entry at the position it was assigned. Large sets are
+// split by owner across DfTxTaskPool workers, with the same state, history and first failure as in order.
+Res ApplyAccountChanges(const CBlockIndex *pindex,
+                        CCustomCSView &view,
+                        const std::vector<CAccountChange> &changes,
+                        const uint8_t type,
+                        const bool stopOnFailure,
+                        size_t &workers);
+
+// Moves every balance of a split token to the new token in chunks of owners, spread over DfTxTaskPool
+Res SplitAccountBalances(const CBlockIndex *pindex,
+                         CCustomCSView &view,
+                         const DCT_ID oldTokenId,
+                         const DCT_ID newTokenId,
+                         const std::function<CAmount(const CAmount)> &newAmount,
+                         CAmount &totalBalance,
+                         size_t &accounts);
+
+// Locks lockRatio of the balances of locked tokens and of the tokens behind shares of affected pools, in
+// chunks of owners spread over DfTxTaskPool
+Res LockTokenBalances(const CBlockIndex *pindex,
+                      CCustomCSView &cache,
+                      const std::unordered_set<uint32_t> &tokensToBeLocked,
+                      const std::unordered_set<uint32_t> &affectedPools,
+                      const CAmount lockRatio,
+                      const CScript &contractAddressValue,
+                      CBalances &totalLockedFunds);
+
 bool ExecuteTokenMigrationEVM(std::size_t mnview_ptr, const TokenAmount oldAmount, TokenAmount &newAmount);
 Res ExecuteTokenMigrationTransferDomain(CCustomCSView &view, CTokenAmount &amount, bool &includedLock);
 Res ExecuteLockTransferDomain(CCustomCSView &view,
@@ -1,7 +1,5 @@
 #include <dfi/vaulthistory.h>
 
-#include <chain.h>
-
 void CVaultHistoryView::ForEachVaultHistory(
     std::function<bool(const VaultHistoryKey &, CLazySerialize<VaultHistoryValue>)> callback,
     const VaultHistoryKey &start) {
@@ -61,38 +59,8 @@ void CVaultHistoryView::ForEachGlobalScheme(
     ForEach<ByVaultGlobalSchemeKey, VaultGlobalSchemeKey, VaultGlobalSchemeValue>(callback, start);
 }
 
-void CVaultHistoryView::WriteVaultState(CCustomCSView &mnview,
-                                        const CBlockIndex &pindex,
-                                        const uint256 &vaultID,
-                                        const uint32_t ratio) {
-    const auto vault = mnview.GetVault(vaultID);
-    assert(vault);
-
-    auto collaterals = mnview.GetVaultCollaterals(vaultID);
-    if (!collaterals) {
-        collaterals = CBalances{};
-    }
-
-    bool useNextPrice = false, requireLivePrice = false;
-    auto rate =
-        mnview.GetVaultAssets(vaultID, *collaterals, pindex.nHeight, pindex.nTime, useNextPrice, requireLivePrice);
-
-    CVaultAssets collateralLoans{0, 0, {}, {}};
-    if (rate) {
-        collateralLoans = *rate.val;
-    }
-
-    std::vector<CAuctionBatch> batches;
-    if (auto data = mnview.GetAuction(vaultID, pindex.nHeight)) {
-        for (uint32_t i{0}; i < data->batchCount; ++i) {
-            if (auto batch = mnview.GetAuctionBatch({vaultID, i})) {
-                batches.push_back(*batch);
-            }
-        }
-    }
-
-    VaultStateValue value{collaterals->balances, collateralLoans, batches, ratio};
-    WriteBy<ByVaultStateKey>(VaultStateKey{vaultID, static_cast<uint32_t>(pindex.nHeight)}, value);
+void CVaultHistoryView::WriteVaultState(const VaultStateKey &key, const VaultStateValue &value) {
+    WriteBy<ByVaultStateKey>(key, value);
 }
 
 void CVaultHistoryView::EraseGlobalScheme(const VaultGlobalSchemeKey &key) {
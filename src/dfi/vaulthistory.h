@@ -155,10 +155,7 @@ class CVaultHistoryView : public virtual CStorageView {
 public:
     void WriteVaultHistory(const VaultHistoryKey &key, const VaultHistoryValue &value);
     void WriteVaultScheme(const VaultSchemeKey &key, const VaultSchemeValue &value);
-    void WriteVaultState(CCustomCSView &mnview,
-                         const CBlockIndex &pindex,
-                         const uint256 &vaultID,
-                         const uint32_t ratio = 0);
+    void WriteVaultState(const VaultStateKey &key, const VaultStateValue &value);
 
     void EraseVaultHistory(const uint32_t height);
 
@@ -15,6 +15,7 @@
 #include <memusage.h>
 
 #include <optional>
+#include <set>
 
 extern CCriticalSection cs_main;
 
@@ -77,6 +78,10 @@ public:
     virtual std::unique_ptr<CStorageKVIterator> NewIterator() = 0;
     virtual size_t SizeEstimate() const = 0;
     virtual bool Flush() = 0;
+    // Storage this one is layered over, if any
+    virtual const CStorageKV* GetParent() const { return nullptr; }
+    // Whether this layer holds a write or erase of key not yet flushed to its parent
+    virtual bool HasChange(const TBytes&) const { return false; }
 };
 
 // doesn't serialize/deserialize vector size
@@ -160,11 +165,17 @@ public:
     bool Write(const TBytes& key, const TBytes& value) override {
         if (snapshot) throw std::runtime_error("Cannot Write to storage based off a snapshot");
         batch.Write(refTBytes(key), refTBytes(value));
+        if (IsHooked(key)) {
+            hooked[key] = value;
+        }
         return true;
     }
     bool Erase(const TBytes& key) override {
         if (snapshot) throw std::runtime_error("Cannot Erase from storage based off a snapshot");
         batch.Erase(refTBytes(key));
+        if (IsHooked(key)) {
+            hooked[key] = {};
+        }
         return true;
     }
     bool Read(const TBytes& key, TBytes& value) const override {
@@ -180,6 +191,10 @@ public:
         if (snapshot) return true;
         auto result = db->WriteBatch(batch);
         batch.Clear();
+        if (result && !hooked.empty()) {
+            commitHook(hooked);
+        }
+        hooked.clear();
         return result;
     }
     size_t SizeEstimate() const override {
@@ -211,11 +226,27 @@ public:
         return db;
     }
 
+    // Hands the writes and erases of keys starting with one of prefixes to onCommit once the batch holding
+    // them is written
+    void SetCommitHook(std::set<uint8_t> prefixes, std::function<void(const MapKV&)> onCommit) {
+        hookPrefixes = std::move(prefixes);
+        commitHook = std::move(onCommit);
+        hooked.clear();
+    }
+
 private:
+    bool IsHooked(const TBytes& key) const {
+        return commitHook && !key.empty() && hookPrefixes.count(key.front());
+    }
+
     std::shared_ptr<CDBWrapper> db;
     CDBBatch batch;
     leveldb::ReadOptions options;
 
+    std::set<uint8_t> hookPrefixes;
+    std::function<void(const MapKV&)> commitHook;
+    MapKV hooked;
+
     // If this snapshot is set it will be used when
     // reading from the DB.
     std::unique_ptr<CCheckedOutSnapshot> snapshot;
@@ -365,6 +396,12 @@ public:
     std::unique_ptr<CStorageKVIterator> NewIterator() override {
         return std::make_unique<CFlushableStorageKVIterator>(db.NewIterator(), changed);
     }
+    const CStorageKV* GetParent() const override {
+        return &db;
+    }
+    bool HasChange(const TBytes& key) const override {
+        return changed.count(key);
+    }
 
     MapKV& GetRaw() {
         return changed;
@@ -7,6 +7,7 @@
 #include <chainparams.h>
 #include <crypto/hmac_sha256.h>
 #include <httpserver.h>
+#include <rpc/jsonstream.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
 #include <rpc/stats.h>
@@ -16,6 +17,8 @@
 #include <util/translation.h>
 #include <walletinitinterface.h>
 
+#include <map>
+#include <optional>
 #include <memory>
 #include <stdio.h>
 
@@ -68,6 +71,37 @@ static std::unique_ptr<HTTPRPCTimerInterface> httpRPCTimerInterface;
 /* The host to be used for CORS header */
 static std::string corsOriginHost;
 
+/** Request bodies up to this size are scanned on the event thread to classify them */
+static const size_t MAX_CLASSIFY_BODY = 64 * 1024;
+
+/** Cost class of each method that is not NORMAL, extended by -rpccostclass */
+static std::map<std::string, HTTPWorkClass> rpcCostClasses = {
+    {"getblockcount", HTTPWorkClass::CHEAP},
+    {"getbestblockhash", HTTPWorkClass::CHEAP},
+    {"getblockhash", HTTPWorkClass::CHEAP},
+    {"getconnectioncount", HTTPWorkClass::CHEAP},
+    {"getmininginfo", HTTPWorkClass::CHEAP},
+    {"getnetworkinfo", HTTPWorkClass::CHEAP},
+    {"getrpccacheinfo", HTTPWorkClass::CHEAP},
+    {"getrpcstats", HTTPWorkClass::CHEAP},
+    {"ping", HTTPWorkClass::CHEAP},
+    {"sendrawtransaction", HTTPWorkClass::CHEAP},
+    {"uptime", HTTPWorkClass::CHEAP},
+    {"accounthistorycount", HTTPWorkClass::HEAVY},
+    {"getburninfo", HTTPWorkClass::HEAVY},
+    {"gettxoutsetinfo", HTTPWorkClass::HEAVY},
+    {"listaccounthistory", HTTPWorkClass::HEAVY},
+    {"listaccounts", HTTPWorkClass::HEAVY},
+    {"listauctionhistory", HTTPWorkClass::HEAVY},
+    {"listburnhistory", HTTPWorkClass::HEAVY},
+    {"listgovproposalvotes", HTTPWorkClass::HEAVY},
+    {"listvaulthistory", HTTPWorkClass::HEAVY},
+    {"listvaults", HTTPWorkClass::HEAVY},
+    {"logaccountbalances", HTTPWorkClass::HEAVY},
+    {"logdbhashes", HTTPWorkClass::HEAVY},
+    {"scantxoutset", HTTPWorkClass::HEAVY},
+};
+
 static void JSONErrorReply(HTTPRequest* req, const UniValue& objError, const UniValue& id)
 {
     // Send error reply from json-rpc error object
@@ -85,6 +119,18 @@ static void JSONErrorReply(HTTPRequest* req, const UniValue& objError, const Uni
     req->WriteReply(nStatus, strReply);
 }
 
+// Once a streamed result has started the status is sent already, so the reply is cut off for the client to see it failed
+static bool JSONStreamErrorReply(HTTPRequest* req, const JSONRPCRequest& jreq, const UniValue& objError)
+{
+    if (!jreq.replyStream || !jreq.replyStream->Started())
+        return false;
+
+    LogPrintf("%s: aborting streamed reply of %s: %s\n", __func__, jreq.strMethod, find_value(objError, "message").getValStr());
+    jreq.replyStream->Abort();
+    req->AbortReply();
+    return true;
+}
+
 //This function checks username and password against -rpcauth
 //entries from config file.
 static bool multiUserAuthorized(std::string strUserPass)
@@ -172,7 +218,8 @@ static bool CorsHandler(HTTPRequest *req) {
 
 static bool HTTPReq_JSONRPC(HTTPRequest* req, const std::string &)
 {
-    int64_t time = GetTimeMillis();
+    int64_t time = GetTimeMicros();
+    LockWaitScope lockWait;
     // Handle CORS
     if (CorsHandler(req))
         return true;
@@ -221,9 +268,22 @@ static bool HTTPReq_JSONRPC(HTTPRequest* req, const std::string &)
         // singleton request
         if (valRequest.isObject()) {
             jreq.parse(valRequest);
+            jreq.replyStream = std::make_shared<JSONRPCReplyStream>(
+                [req] {
+                    req->WriteHeader("Content-Type", "application/json");
+                    req->StartReply(HTTP_OK);
+                },
+                [req](const std::string& chunk) { return req->WriteReplyChunk(chunk); });
 
             UniValue result = tableRPC.execute(jreq);
 
+            if (jreq.replyStream->Started()) {
+                jreq.replyStream->Finish(jreq.id);
+                req->EndReply();
+                if (statsRPC.isActive()) statsRPC.add(jreq.strMethod, GetTimeMicros() - time, jreq.replyStream->Written(), req->GetQueueTime(), lockWait.Micros());
+                return true;
+            }
+
             // Send reply
             strReply = JSONRPCReply(result, NullUniValue, jreq.id);
 
@@ -236,17 +296,207 @@ static bool HTTPReq_JSONRPC(HTTPRequest* req, const std::string &)
         req->WriteHeader("Content-Type", "application/json");
         req->WriteReply(HTTP_OK, strReply);
 
-        if (statsRPC.isActive()) statsRPC.add(jreq.strMethod, GetTimeMillis() - time, strReply.length());
+        if (statsRPC.isActive()) statsRPC.add(jreq.strMethod, GetTimeMicros() - time, strReply.length(), req->GetQueueTime(), lockWait.Micros());
     } catch (const UniValue& objError) {
-        JSONErrorReply(req, objError, jreq.id);
+        if (!JSONStreamErrorReply(req, jreq, objError))
+            JSONErrorReply(req, objError, jreq.id);
         return false;
     } catch (const std::exception& e) {
-        JSONErrorReply(req, JSONRPCError(RPC_PARSE_ERROR, e.what()), jreq.id);
+        if (!JSONStreamErrorReply(req, jreq, JSONRPCError(RPC_PARSE_ERROR, e.what())))
+            JSONErrorReply(req, JSONRPCError(RPC_PARSE_ERROR, e.what()), jreq.id);
         return false;
     }
     return true;
 }
 
+namespace {
+/** Reads the top level of a JSON-RPC request body for the methods it calls, without building it */
+class JSONRPCMethodScanner
+{
+public:
+    explicit JSONRPCMethodScanner(const std::string& body) : it(body.begin()), end(body.end()) {}
+
+    std::optional<HTTPWorkClass> Scan()
+    {
+        SkipSpace();
+        if (Peek() == '{')
+            return Object();
+        if (!Consume('['))
+            return {};
+        SkipSpace();
+        // An empty batch is rejected without running a call
+        if (Consume(']'))
+            return HTTPWorkClass::NORMAL;
+        auto workClass = HTTPWorkClass::CHEAP;
+        do {
+            SkipSpace();
+            std::optional<HTTPWorkClass> callClass = HTTPWorkClass::NORMAL;
+            if (Peek() == '{') {
+                callClass = Object();
+            } else if (!SkipValue()) {
+                return {};
+            }
+            if (!callClass)
+                return {};
+            workClass = std::max(workClass, *callClass);
+            SkipSpace();
+        } while (Consume(','));
+        if (!Consume(']'))
+            return {};
+        return workClass;
+    }
+
+private:
+    std::string::const_iterator it;
+    const std::string::const_iterator end;
+
+    char Peek() const { return it != end ? *it : '\0'; }
+
+    bool Consume(char c)
+    {
+        if (Peek() != c)
+            return false;
+        ++it;
+        return true;
+    }
+
+    void SkipSpace()
+    {
+        while (it != end && (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r'))
+            ++it;
+    }
+
+    // The raw contents of a string, escaped is set if it holds escapes
+    std::optional<std::string> String(bool& escaped)
+    {
+        if (!Consume('"'))
+            return {};
+        const auto begin = it;
+        escaped = false;
+        for (; it != end && *it != '"'; ++it) {
+            if (*it == '\\') {
+                escaped = true;
+                if (++it == end)
+                    return {};
+            }
+        }
+        if (it == end)
+            return {};
+        return std::string(begin, it++);
+    }
+
+    bool SkipValue()
+    {
+        // Nested containers only need their brackets matched, strings may hold any of them
+        size_t depth = 0;
+        bool escaped;
+        while (it != end) {
+            const auto c = *it;
+            if (c == '"') {
+                if (!String(escaped))
+                    return false;
+                continue;
+            }
+            if (depth == 0 && (c == ',' || c == '}' || c == ']'))
+                return true;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                --depth;
+            }
+            ++it;
+        }
+        return depth == 0;
+    }
+
+    // The class of a single call, the first "method" key counts as for JSONRPCRequest::parse
+    std::optional<HTTPWorkClass> Object()
+    {
+        if (!Consume('{'))
+            return {};
+        SkipSpace();
+        if (Consume('}'))
+            return HTTPWorkClass::NORMAL;
+        std::optional<HTTPWorkClass> workClass;
+        do {
+            SkipSpace();
+            bool escaped;
+            const auto key = String(escaped);
+            // An escaped key could still read "method"
+            if (!key || (escaped && !workClass))
+                return {};
+            SkipSpace();
+            if (!Consume(':'))
+                return {};
+            SkipSpace();
+            if (*key == "method" && !workClass) {
+                workClass = HTTPWorkClass::NORMAL;
+                if (Peek() == '"') {
+                    const auto method = String(escaped);
+                    if (!method || escaped)
+                        return {};
+                    const auto found = rpcCostClasses.find(*method);
+                    if (found != rpcCostClasses.end())
+                        workClass = found->second;
+                } else if (!SkipValue()) {
+                    return {};
+                }
+            } else if (!SkipValue()) {
+                return {};
+            }
+            SkipSpace();
+        } while (Consume(','));
+        if (!Consume('}'))
+            return {};
+        return workClass.value_or(HTTPWorkClass::NORMAL);
+    }
+};
+} // namespace
+
+HTTPWorkClass JSONRPCWorkClass(const std::string& body)
+{
+    // Not scanned on the event thread, so it may hold any call
+    if (body.size() > MAX_CLASSIFY_BODY)
+        return HTTPWorkClass::HEAVY;
+    // Neither is a body the scan can't read with certainty
+    return JSONRPCMethodScanner(body).Scan().value_or(HTTPWorkClass::HEAVY);
+}
+
+static HTTPWorkClass HTTPReq_JSONRPCClass(const HTTPRequest* req, const std::string &)
+{
+    if (req->GetRequestMethod() != HTTPRequest::POST)
+        return HTTPWorkClass::NORMAL;
+    // The body of a request is only looked at once it is authorized, the worker rejects the others
+    const auto authHeader = req->GetHeader("authorization");
+    std::string authUser;
+    if (!authHeader.first || !RPCAuthorized(authHeader.second, authUser))
+        return HTTPWorkClass::NORMAL;
+    return JSONRPCWorkClass(req->PeekBody(MAX_CLASSIFY_BODY + 1));
+}
+
+static bool InitRPCCostClasses()
+{
+    for (const auto& arg : gArgs.GetArgs("-rpccostclass")) {
+        const auto pos = arg.find(':');
+        const auto name = arg.substr(pos + 1);
+        if (pos == std::string::npos || pos == 0) {
+            LogPrintf("Invalid -rpccostclass=%s\n", arg);
+            return false;
+        }
+        if (name == "cheap") {
+            rpcCostClasses[arg.substr(0, pos)] = HTTPWorkClass::CHEAP;
+        } else if (name == "normal") {
+            rpcCostClasses[arg.substr(0, pos)] = HTTPWorkClass::NORMAL;
+        } else if (name == "heavy") {
+            rpcCostClasses[arg.substr(0, pos)] = HTTPWorkClass::HEAVY;
+        } else {
+            LogPrintf("Invalid -rpccostclass=%s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
 static bool InitRPCAuthentication()
 {
     if (gArgs.GetArg("-rpcpassword", "") == "")
@@ -274,13 +524,15 @@ bool StartHTTPRPC()
     LogPrint(BCLog::RPC, "Starting HTTP RPC server\n");
     if (!InitRPCAuthentication())
         return false;
+    if (!InitRPCCostClasses())
+        return false;
 
     // Setup Cors origin host name from arg.
     corsOriginHost = gArgs.GetArg("-rpcallowcors", "");
 
-    RegisterHTTPHandler("/", true, HTTPReq_JSONRPC);
+    RegisterHTTPHandler("/", true, HTTPReq_JSONRPC, HTTPReq_JSONRPCClass);
     if (g_wallet_init_interface.HasWalletSupport()) {
-        RegisterHTTPHandler("/wallet/", false, HTTPReq_JSONRPC);
+        RegisterHTTPHandler("/wallet/", false, HTTPReq_JSONRPC, HTTPReq_JSONRPCClass);
     }
     struct event_base* eventBase = EventBase();
     assert(eventBase);
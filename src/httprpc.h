@@ -8,6 +8,8 @@
 #include <string>
 #include <map>
 
+enum class HTTPWorkClass;
+
 /** Start HTTP RPC subsystem.
  * Precondition; HTTP and RPC has been started.
  */
@@ -20,6 +22,11 @@ void InterruptHTTPRPC();
  */
 void StopHTTPRPC();
 
+/** Cost class of a JSON-RPC request body, after parsing it as the worker will.
+ * A batch is as heavy as its heaviest call, a body too large to parse quickly is HEAVY.
+ */
+HTTPWorkClass JSONRPCWorkClass(const std::string& body);
+
 /** Start HTTP REST subsystem.
  * Precondition; HTTP and RPC has been started.
  */
@@ -3,6 +3,7 @@
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
 #include <httpserver.h>
+#include <httpworkqueue.h>
 
 #include <chainparamsbase.h>
 #include <compat.h>
@@ -15,8 +16,13 @@
 #include <sync.h>
 #include <ui_interface.h>
 
+#include <array>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
@@ -42,97 +48,55 @@
 
 /** Maximum size of http request (request line + headers) */
 static const size_t MAX_HEADERS_SIZE = 8192;
+/** Unsent bytes of a chunked reply beyond which WriteReplyChunk waits */
+static const size_t MAX_REPLY_BACKLOG = 1024 * 1024;
 
 /** HTTP request work item */
 class HTTPWorkItem final : public HTTPClosure
 {
 public:
-    HTTPWorkItem(std::unique_ptr<HTTPRequest> _req, const std::string &_path, const HTTPRequestHandler& _func):
-        req(std::move(_req)), path(_path), func(_func)
+    HTTPWorkItem(std::unique_ptr<HTTPRequest> _req, const std::string &_path, const HTTPRequestHandler& _func, HTTPWorkClass _workClass):
+        req(std::move(_req)), workClass(_workClass), client(req->GetPeer().ToStringIP()), path(_path), func(_func)
     {
     }
     void operator()() override
     {
+        req->SetQueueTime(GetTimeMicros() - enqueueTime);
         func(req.get(), path);
     }
 
     std::unique_ptr<HTTPRequest> req;
+    const HTTPWorkClass workClass;
+    const std::string client;
+    int64_t enqueueTime{};
 
 private:
     std::string path;
     HTTPRequestHandler func;
 };
 
-/** Simple work queue for distributing work over multiple threads.
- * Work items are simply callable objects.
- */
-template <typename WorkItem>
-class WorkQueue
+size_t HTTPWorkQueueDepth(HTTPWorkClass workClass)
 {
-private:
-    /** Mutex protects entire object */
-    Mutex cs;
-    std::condition_variable cond;
-    std::deque<std::unique_ptr<WorkItem>> queue;
-    bool running;
-    size_t maxDepth;
-
-public:
-    explicit WorkQueue(size_t _maxDepth) : running(true),
-                                 maxDepth(_maxDepth)
-    {
-    }
-    /** Precondition: worker threads have all stopped (they have been joined).
-     */
-    ~WorkQueue()
-    {
-    }
-    /** Enqueue a work item */
-    bool Enqueue(WorkItem* item)
-    {
-        LOCK(cs);
-        if (queue.size() >= maxDepth) {
-            return false;
-        }
-        queue.emplace_back(std::unique_ptr<WorkItem>(item));
-        cond.notify_one();
-        return true;
-    }
-    /** Thread function */
-    void Run()
-    {
-        while (true) {
-            std::unique_ptr<WorkItem> i;
-            {
-                WAIT_LOCK(cs, lock);
-                while (running && queue.empty())
-                    cond.wait(lock);
-                if (!running)
-                    break;
-                i = std::move(queue.front());
-                queue.pop_front();
-            }
-            (*i)();
-        }
-    }
-    /** Interrupt and exit loops */
-    void Interrupt()
-    {
-        LOCK(cs);
-        running = false;
-        cond.notify_all();
+    switch (workClass) {
+    case HTTPWorkClass::CHEAP:
+        return std::max<int64_t>(gArgs.GetArg("-rpccheapworkqueue", DEFAULT_HTTP_CHEAP_WORKQUEUE), 1);
+    case HTTPWorkClass::HEAVY:
+        return std::max<int64_t>(gArgs.GetArg("-rpcheavyworkqueue", DEFAULT_HTTP_HEAVY_WORKQUEUE), 1);
+    default:
+        return std::max<int64_t>(gArgs.GetArg("-rpcworkqueue", DEFAULT_HTTP_WORKQUEUE), 1);
     }
-};
+}
 
 struct HTTPPathHandler
 {
-    HTTPPathHandler(std::string _prefix, bool _exactMatch, HTTPRequestHandler _handler):
-        prefix(_prefix), exactMatch(_exactMatch), handler(_handler)
+    HTTPPathHandler(std::string _prefix, bool _exactMatch, HTTPRequestHandler _handler, HTTPRequestClassifier _classifier):
+        prefix(_prefix), exactMatch(_exactMatch), handler(_handler), classifier(_classifier)
     {
     }
     std::string prefix;
     bool exactMatch;
     HTTPRequestHandler handler;
+    HTTPRequestClassifier classifier;
 };
 
 /** HTTP module state */
@@ -144,7 +108,7 @@ static struct evhttp* eventHTTP = nullptr;
 //! List of subnets to allow RPC connections from
 static std::vector<CSubNet> rpc_allow_subnets;
 //! Work queue for handling longer requests off the event loop thread
-static WorkQueue<HTTPClosure>* workQueue = nullptr;
+static WorkQueue<HTTPWorkItem>* workQueue = nullptr;
 //! Handlers for (sub)paths
 static std::vector<HTTPPathHandler> pathHandlers;
 //! Bound listening sockets
@@ -266,12 +230,14 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
 
     // Dispatch to worker thread
     if (i != iend) {
-        std::unique_ptr<HTTPWorkItem> item(new HTTPWorkItem(std::move(hreq), path, i->handler));
+        const auto workClass = i->classifier ? i->classifier(hreq.get(), path) : HTTPWorkClass::NORMAL;
+        std::unique_ptr<HTTPWorkItem> item(new HTTPWorkItem(std::move(hreq), path, i->handler, workClass));
         assert(workQueue);
         if (workQueue->Enqueue(item.get()))
             item.release(); /* if true, queue took ownership */
         else {
-            LogPrintf("WARNING: request rejected because http work queue depth exceeded, it can be increased with the -rpcworkqueue= setting\n");
+            LogPrintf("WARNING: request rejected because http work queue depth exceeded, it can be increased with the %s= setting\n",
+                      workClass == HTTPWorkClass::CHEAP ? "-rpccheapworkqueue" : workClass == HTTPWorkClass::HEAVY ? "-rpcheavyworkqueue" : "-rpcworkqueue");
             item->req->WriteReply(HTTP_INTERNAL, "Work queue depth exceeded");
         }
     } else {
@@ -353,10 +319,10 @@ static bool HTTPBindAddresses(struct evhttp* http)
 }
 
 /** Simple wrapper to set thread name and run work queue */
-static void HTTPWorkQueueRun(WorkQueue<HTTPClosure>* queue, int worker_num)
+static void HTTPWorkQueueRun(WorkQueue<HTTPWorkItem>* queue, int worker_num, bool cheapOnly)
 {
-    util::ThreadRename(strprintf("httpworker.%i", worker_num));
-    queue->Run();
+    util::ThreadRename(strprintf(cheapOnly ? "httpcheap.%i" : "httpworker.%i", worker_num));
+    queue->Run(cheapOnly);
 }
 
 /** libevent event log callback */
@@ -418,10 +384,18 @@ bool InitHTTPServer()
     }
 
     LogPrint(BCLog::HTTP, "Initialized HTTP server\n");
-    int workQueueDepth = std::max((long)gArgs.GetArg("-rpcworkqueue", DEFAULT_HTTP_WORKQUEUE), 1L);
-    LogPrintf("HTTP: creating work queue of depth %d\n", workQueueDepth);
-
-    workQueue = new WorkQueue<HTTPClosure>(workQueueDepth);
+    int rpcThreads = std::max((long)gArgs.GetArg("-rpcthreads", DEFAULT_HTTP_THREADS), 1L);
+    int heavyThreads = std::max((long)gArgs.GetArg("-rpcheavythreads", std::max(rpcThreads / 2, 1)), 1L);
+    int clientThreads = std::max((long)gArgs.GetArg("-rpcclientthreads", DEFAULT_HTTP_CLIENT_THREADS), 0L);
+    const std::array<size_t, HTTP_WORK_CLASSES> workQueueDepths{
+        HTTPWorkQueueDepth(HTTPWorkClass::CHEAP),
+        HTTPWorkQueueDepth(HTTPWorkClass::NORMAL),
+        HTTPWorkQueueDepth(HTTPWorkClass::HEAVY),
+    };
+    LogPrintf("HTTP: creating work queues of depth %d/%d/%d (cheap/normal/heavy), heavy work on up to %d threads\n",
+              workQueueDepths[0], workQueueDepths[1], workQueueDepths[2], heavyThreads);
+
+    workQueue = new WorkQueue<HTTPWorkItem>(workQueueDepths, heavyThreads, clientThreads);
     // transfer ownership to eventBase/HTTP via .release()
     eventBase = base_ctr.release();
     eventHTTP = http_ctr.release();
@@ -449,11 +423,15 @@ void StartHTTPServer()
 {
     LogPrint(BCLog::HTTP, "Starting HTTP server\n");
     int rpcThreads = std::max((long)gArgs.GetArg("-rpcthreads", DEFAULT_HTTP_THREADS), 1L);
-    LogPrintf("HTTP: starting %d worker threads\n", rpcThreads);
+    int cheapThreads = std::max((long)gArgs.GetArg("-rpccheapthreads", DEFAULT_HTTP_CHEAP_THREADS), 0L);
+    LogPrintf("HTTP: starting %d worker threads and %d for cheap calls\n", rpcThreads, cheapThreads);
     threadHTTP = std::thread(ThreadHTTP, eventBase);
 
     for (int i = 0; i < rpcThreads; i++) {
-        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, workQueue, i);
+        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, workQueue, i, false);
+    }
+    for (int i = 0; i < cheapThreads; i++) {
+        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, workQueue, i, true);
     }
 }
 
@@ -532,12 +510,60 @@ void HTTPEvent::trigger(struct timeval* tv)
     else
         evtimer_add(ev, tv); // trigger after timeval passed
 }
+/** Chunked reply state, shared between the worker writing it and the http thread */
+struct HTTPReplyStream
+{
+    std::mutex m;
+    std::condition_variable cv;
+    size_t posted{};   // handed to the http thread, not in the connection buffer yet
+    size_t buffered{}; // in the connection output buffer
+    bool closed{};     // the connection and the request are gone
+};
+
+static void http_reply_sent_cb(struct evhttp_connection*, void* arg)
+{
+    auto stream = static_cast<HTTPReplyStream*>(arg);
+    {
+        std::lock_guard<std::mutex> lock(stream->m);
+        stream->buffered = 0;
+    }
+    stream->cv.notify_all();
+}
+
+static void http_reply_closed_cb(struct evhttp_connection*, void* arg)
+{
+    auto stream = static_cast<HTTPReplyStream*>(arg);
+    {
+        std::lock_guard<std::mutex> lock(stream->m);
+        stream->closed = true;
+    }
+    stream->cv.notify_all();
+}
+
+// Re-enable reading from the socket. This is the second part of the libevent
+// workaround in http_request_cb.
+static void http_enable_read(struct evhttp_request* req)
+{
+    if (event_get_version_number() >= 0x02010600 && event_get_version_number() < 0x02020001) {
+        evhttp_connection* conn = evhttp_request_get_connection(req);
+        if (conn) {
+            bufferevent* bev = evhttp_connection_get_bufferevent(conn);
+            if (bev) {
+                bufferevent_enable(bev, EV_READ | EV_WRITE);
+            }
+        }
+    }
+}
+
 HTTPRequest::HTTPRequest(struct evhttp_request* _req) : req(_req),
                                                        replySent(false)
 {
 }
 HTTPRequest::~HTTPRequest()
 {
+    if (replyStream) {
+        EndReply();
+    }
     if (!replySent) {
         // Keep track of whether reply was sent to avoid request leaks
         LogPrintf("%s: Unhandled request\n", __func__);
@@ -577,6 +603,17 @@ std::string HTTPRequest::ReadBody()
     return rv;
 }
 
+std::string HTTPRequest::PeekBody(size_t maxSize) const
+{
+    struct evbuffer* buf = evhttp_request_get_input_buffer(req);
+    if (!buf)
+        return "";
+    std::string rv(std::min(evbuffer_get_length(buf), maxSize), '\0');
+    const auto size = evbuffer_copyout(buf, &rv[0], rv.size());
+    rv.resize(std::max<ev_ssize_t>(size, 0));
+    return rv;
+}
+
 void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
 {
     struct evkeyvalq* headers = evhttp_request_get_output_headers(req);
@@ -602,23 +639,128 @@ void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
     auto req_copy = req;
     HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
         evhttp_send_reply(req_copy, nStatus, nullptr, nullptr);
-        // Re-enable reading from the socket. This is the second part of the libevent
-        // workaround above.
-        if (event_get_version_number() >= 0x02010600 && event_get_version_number() < 0x02020001) {
-            evhttp_connection* conn = evhttp_request_get_connection(req_copy);
-            if (conn) {
-                bufferevent* bev = evhttp_connection_get_bufferevent(conn);
-                if (bev) {
-                    bufferevent_enable(bev, EV_READ | EV_WRITE);
-                }
-            }
+        http_enable_read(req_copy);
+    });
+    ev->trigger(nullptr);
+    replySent = true;
+    req = nullptr; // transferred back to main thread
+}
+
+void HTTPRequest::StartReply(int nStatus)
+{
+    assert(!replySent && req);
+    if (ShutdownRequested()) {
+        WriteHeader("Connection", "close");
+    }
+    auto stream = std::make_shared<HTTPReplyStream>();
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus, stream]{
+        // The request is freed with the connection, the callback tells the later events
+        evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+        if (conn) {
+            evhttp_connection_set_closecb(conn, http_reply_closed_cb, stream.get());
         }
+        evhttp_send_reply_start(req_copy, nStatus, nullptr);
     });
     ev->trigger(nullptr);
     replySent = true;
+    replyStream = stream;
+}
+
+bool HTTPRequest::WriteReplyChunk(const std::string& chunk)
+{
+    assert(replyStream && req);
+    auto stream = replyStream;
+    {
+        std::unique_lock<std::mutex> lock(stream->m);
+        while (!stream->closed && stream->posted + stream->buffered > MAX_REPLY_BACKLOG && !ShutdownRequested()) {
+            stream->cv.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        if (stream->closed) {
+            return false;
+        }
+        stream->posted += chunk.size();
+    }
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, stream, chunk]{
+        {
+            std::lock_guard<std::mutex> lock(stream->m);
+            stream->posted -= chunk.size();
+            if (stream->closed) {
+                return;
+            }
+        }
+        struct evbuffer* evb = evbuffer_new();
+        assert(evb);
+        evbuffer_add(evb, chunk.data(), chunk.size());
+        evhttp_send_reply_chunk_with_cb(req_copy, evb, http_reply_sent_cb, stream.get());
+        evbuffer_free(evb);
+
+        size_t buffered = 0;
+        evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+        if (conn) {
+            bufferevent* bev = evhttp_connection_get_bufferevent(conn);
+            if (bev) {
+                buffered = evbuffer_get_length(bufferevent_get_output(bev));
+            }
+        }
+        std::lock_guard<std::mutex> lock(stream->m);
+        stream->buffered = buffered;
+    });
+    ev->trigger(nullptr);
+    return true;
+}
+
+void HTTPRequest::EndReply()
+{
+    assert(replyStream && req);
+    auto req_copy = req;
+    auto stream = replyStream;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, stream]{
+        {
+            std::lock_guard<std::mutex> lock(stream->m);
+            if (stream->closed) {
+                return;
+            }
+        }
+        evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+        if (conn) {
+            evhttp_connection_set_closecb(conn, nullptr, nullptr);
+        }
+        // Before ending, which may already free the request
+        http_enable_read(req_copy);
+        evhttp_send_reply_end(req_copy);
+    });
+    ev->trigger(nullptr);
+    replyStream.reset();
     req = nullptr; // transferred back to main thread
 }
 
+void HTTPRequest::AbortReply()
+{
+    assert(replyStream && req);
+    auto req_copy = req;
+    auto stream = replyStream;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, stream]{
+        {
+            std::lock_guard<std::mutex> lock(stream->m);
+            if (stream->closed) {
+                return;
+            }
+            stream->closed = true;
+        }
+        // Without the final empty chunk the client sees the reply cut off rather than complete
+        evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+        if (conn) {
+            evhttp_connection_set_closecb(conn, nullptr, nullptr);
+            evhttp_connection_free(conn);
+        }
+    });
+    ev->trigger(nullptr);
+    replyStream.reset();
+    req = nullptr; // freed with the connection on the main thread
+}
+
 CService HTTPRequest::GetPeer() const
 {
     evhttp_connection* con = evhttp_request_get_connection(req);
@@ -662,10 +804,10 @@ HTTPRequest::RequestMethod HTTPRequest::GetRequestMethod() const
     }
 }
 
-void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler)
+void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler, const HTTPRequestClassifier &classifier)
 {
     LogPrint(BCLog::HTTP, "Registering HTTP handler for %s (exactmatch %d)\n", prefix, exactMatch);
-    pathHandlers.push_back(HTTPPathHandler(prefix, exactMatch, handler));
+    pathHandlers.push_back(HTTPPathHandler(prefix, exactMatch, handler, classifier));
 }
 
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch)
@@ -8,15 +8,21 @@
 #include <string>
 #include <stdint.h>
 #include <functional>
+#include <memory>
 
 static const int DEFAULT_HTTP_THREADS=4;
 static const int DEFAULT_HTTP_WORKQUEUE=16;
+static const int DEFAULT_HTTP_CHEAP_WORKQUEUE=16;
+static const int DEFAULT_HTTP_HEAVY_WORKQUEUE=4;
 static const int DEFAULT_HTTP_SERVER_TIMEOUT=30;
+static const int DEFAULT_HTTP_CHEAP_THREADS=1;
+static const int DEFAULT_HTTP_CLIENT_THREADS=0;
 
 struct evhttp_request;
 struct event_base;
 class CService;
 class HTTPRequest;
+struct HTTPReplyStream;
 
 /** Initialize HTTP server.
  * Call this before RegisterHTTPHandler or EventBase().
@@ -36,13 +42,26 @@ void StopHTTPServer();
  * libevent doesn't support debug logging.*/
 bool UpdateHTTPServerLogging(bool enable);
 
+/** Cost class of a request. Each class has its own queue. */
+enum class HTTPWorkClass {
+    CHEAP,  //!< Latency sensitive, also served by the -rpccheapthreads reserved workers
+    NORMAL,
+    HEAVY,  //!< At most -rpcheavythreads of these run at once
+};
+static const size_t HTTP_WORK_CLASSES = 3;
+
+/** Depth of the queue of a class: -rpcworkqueue for NORMAL, -rpccheapworkqueue and -rpcheavyworkqueue for the others */
+size_t HTTPWorkQueueDepth(HTTPWorkClass workClass);
+
 /** Handler for requests to a certain HTTP path */
 typedef std::function<bool(HTTPRequest* req, const std::string &)> HTTPRequestHandler;
+/** Classifies a request before it is queued. Runs on the event loop thread, so it has to be quick. */
+typedef std::function<HTTPWorkClass(const HTTPRequest* req, const std::string &)> HTTPRequestClassifier;
 /** Register handler for prefix.
  * If multiple handlers match a prefix, the first-registered one will
- * be invoked.
+ * be invoked. Requests without a classifier are NORMAL.
  */
-void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler);
+void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler, const HTTPRequestClassifier &classifier = nullptr);
 /** Unregister handler for prefix */
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch);
 
@@ -59,6 +78,8 @@ class HTTPRequest
 private:
     struct evhttp_request* req;
     bool replySent;
+    std::shared_ptr<HTTPReplyStream> replyStream;
+    int64_t queueTime{};
 
 public:
     explicit HTTPRequest(struct evhttp_request* req);
@@ -99,6 +120,15 @@ public:
      */
     std::string ReadBody();
 
+    /**
+     * Read up to maxSize bytes of the request body, leaving it in place.
+     */
+    std::string PeekBody(size_t maxSize) const;
+
+    /** Microseconds the request waited in the work queue */
+    int64_t GetQueueTime() const { return queueTime; }
+    void SetQueueTime(int64_t time) { queueTime = time; }
+
     /**
      * Write output header.
      *
@@ -115,6 +145,34 @@ public:
      * main thread, do not call any other HTTPRequest methods after calling this.
      */
     void WriteReply(int nStatus, const std::string& strReply = "");
+
+    /**
+     * Start a chunked HTTP reply instead, with the headers written so far. The body
+     * is sent with WriteReplyChunk and completed with EndReply.
+     */
+    void StartReply(int nStatus);
+
+    /**
+     * Send part of the body of a reply started with StartReply. Waits while too much
+     * of the reply is still unsent, so a slow client holds back the writer.
+     * Returns false once the client has gone away.
+     */
+    bool WriteReplyChunk(const std::string& chunk);
+
+    /**
+     * Complete a reply started with StartReply.
+     *
+     * @note Like WriteReply, do not call any other HTTPRequest methods after calling this.
+     */
+    void EndReply();
+
+    /**
+     * Drop the connection of a reply started with StartReply without completing it, so the
+     * client sees it failed instead of receiving a truncated body as a whole reply.
+     *
+     * @note Like EndReply, do not call any other HTTPRequest methods after calling this.
+     */
+    void AbortReply();
 };
 
 /** Event handler closure.
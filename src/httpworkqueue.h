@@ -0,0 +1,130 @@
+// Copyright (c) 2015-2018 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DEFI_HTTPWORKQUEUE_H
+#define DEFI_HTTPWORKQUEUE_H
+
+#include <httpserver.h>
+#include <sync.h>
+#include <util/time.h>
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+
+/** Work queue for distributing work over multiple threads, with a queue per cost class.
+ * Cheap work is taken first and reserved workers take nothing else. Heavy work and the
+ * work of a single client are limited in how much of it runs at once. Work items are
+ * callable objects with workClass, client and enqueueTime members.
+ */
+template <typename WorkItem>
+class WorkQueue
+{
+private:
+    static constexpr size_t CLASSES = HTTP_WORK_CLASSES;
+
+    /** Mutex protects entire object */
+    Mutex cs;
+    std::condition_variable cond;
+    std::deque<std::unique_ptr<WorkItem>> queues[CLASSES];
+    bool running;
+    std::array<size_t, CLASSES> maxDepth;
+    size_t maxHeavy;
+    size_t maxPerClient;
+    size_t runningHeavy{0};
+    std::map<std::string, size_t> runningPerClient;
+
+    std::unique_ptr<WorkItem> Next(bool cheapOnly) EXCLUSIVE_LOCKS_REQUIRED(cs)
+    {
+        for (size_t c = 0; c < CLASSES; ++c) {
+            const auto workClass = static_cast<HTTPWorkClass>(c);
+            if (cheapOnly && workClass != HTTPWorkClass::CHEAP)
+                break;
+            if (workClass == HTTPWorkClass::HEAVY && runningHeavy >= maxHeavy)
+                continue;
+            auto& queue = queues[c];
+            for (auto it = queue.begin(); it != queue.end(); ++it) {
+                if (maxPerClient && runningPerClient[(*it)->client] >= maxPerClient)
+                    continue;
+                auto item = std::move(*it);
+                queue.erase(it);
+                if (workClass == HTTPWorkClass::HEAVY)
+                    ++runningHeavy;
+                ++runningPerClient[item->client];
+                return item;
+            }
+        }
+        return nullptr;
+    }
+
+    void Done(const WorkItem& item) EXCLUSIVE_LOCKS_REQUIRED(cs)
+    {
+        if (item.workClass == HTTPWorkClass::HEAVY)
+            --runningHeavy;
+        auto it = runningPerClient.find(item.client);
+        if (--it->second == 0)
+            runningPerClient.erase(it);
+    }
+
+public:
+    WorkQueue(const std::array<size_t, CLASSES>& _maxDepth, size_t _maxHeavy, size_t _maxPerClient) : running(true),
+                                 maxDepth(_maxDepth),
+                                 maxHeavy(_maxHeavy),
+                                 maxPerClient(_maxPerClient)
+    {
+    }
+    /** Precondition: worker threads have all stopped (they have been joined).
+     */
+    ~WorkQueue()
+    {
+    }
+    /** Enqueue a work item */
+    bool Enqueue(WorkItem* item)
+    {
+        LOCK(cs);
+        const auto c = static_cast<size_t>(item->workClass);
+        auto& queue = queues[c];
+        if (queue.size() >= maxDepth[c]) {
+            return false;
+        }
+        item->enqueueTime = GetTimeMicros();
+        queue.emplace_back(std::unique_ptr<WorkItem>(item));
+        // Not every worker takes every item
+        cond.notify_all();
+        return true;
+    }
+    /** Thread function, cheapOnly for the workers reserved for cheap work */
+    void Run(bool cheapOnly)
+    {
+        while (true) {
+            std::unique_ptr<WorkItem> i;
+            {
+                WAIT_LOCK(cs, lock);
+                while (running && !(i = Next(cheapOnly)))
+                    cond.wait(lock);
+                if (!running)
+                    break;
+            }
+            (*i)();
+            {
+                LOCK(cs);
+                Done(*i);
+            }
+            // A heavy or client slot may have been freed
+            cond.notify_all();
+        }
+    }
+    /** Interrupt and exit loops */
+    void Interrupt()
+    {
+        LOCK(cs);
+        running = false;
+        cond.notify_all();
+    }
+};
+
+#endif // DEFI_HTTPWORKQUEUE_H
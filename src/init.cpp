@@ -275,6 +275,9 @@ void Shutdown(InitInterfaces& interfaces)
         fFeeEstimatesInitialized = false;
     }
 
+    // Queued history is written before the chainstate that includes it is flushed
+    ShutdownHistoryWriterQueue();
+
     //  generates a ChainStateFlushed callback, which we should avoid missing
     //
     // g_chainstate is referenced here directly (instead of ::ChainstateActive()) because it
@@ -310,6 +313,7 @@ void Shutdown(InitInterfaces& interfaces)
         panchorAwaitingConfirms.reset();
         panchorauths.reset();
         pcustomcsview.reset();
+        g_tokenTable.Reset();
         pcustomcsDB.reset();
         pblocktree.reset();
     }
@@ -465,6 +469,8 @@ void SetupServerArgs()
 #endif
     gArgs.AddArg("-txindex", strprintf("Maintain a full transaction index, used by the getrawtransaction rpc call (default: %u)", DEFAULT_TXINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     gArgs.AddArg("-acindex", strprintf("Maintain a full account history index, tracking all accounts balances changes. Used by the listaccounthistory, getaccounthistory and accounthistorycount rpc calls (default: %u)", DEFAULT_ACINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    gArgs.AddArg("-acindex-filters", strprintf("Maintain account history indexes by token and by transaction type, used by listaccounthistory and accounthistorycount with the token, txtype or txtypes filters. Requires -acindex (default: %u)", DEFAULT_ACINDEX_FILTERS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    gArgs.AddArg("-historywriterbacklog=<n>", strprintf("Number of blocks whose account and vault history can be queued for the history writer thread, 0 writes history while connecting blocks (default: %d)", DEFAULT_HISTORY_WRITER_BACKLOG), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     gArgs.AddArg("-vaultindex", strprintf("Maintain a full vault history index, tracking all vault changes. Used by the listvaulthistory rpc call (default: %u)", DEFAULT_VAULTINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     gArgs.AddArg("-blockfilterindex=<type>",
                  strprintf("Maintain an index of compact filters by block (default: %s, values: %s).", DEFAULT_BLOCKFILTERINDEX, ListBlockFilterTypes()) +
@@ -650,8 +656,15 @@ void SetupServerArgs()
     gArgs.AddArg("-healthendpoints", strprintf("Provide health check endpoints to check for the current status of the node.(default: %u)", DEFAULT_HEALTH_ENDPOINTS_ENABLE), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-rpcallowip=<ip>", "Allow JSON-RPC connections from specified source. Valid for <ip> are a single IP (e.g. 1.2.3.4), a network/netmask (e.g. 1.2.3.4/255.255.255.0) or a network/CIDR (e.g. 1.2.3.4/24). This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-rpcauth=<userpw>", "Username and HMAC-SHA-256 hashed password for JSON-RPC connections. The field <userpw> comes in the format: <USERNAME>:<SALT>$<HASH>. A canonical python script is included in share/rpcauth. The client then connects normally using the rpcuser=<USERNAME>/rpcpassword=<PASSWORD> pair of arguments. This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    gArgs.AddArg("-rpcbatchthreads=<n>", strprintf("Set the number of threads to run the read-only calls of JSON-RPC batches concurrently, 0 to run them in order (default: %d)", DEFAULT_RPC_BATCH_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-rpcbind=<addr>[:port]", "Bind to given address to listen for JSON-RPC connections. Do not expose the RPC server to untrusted networks such as the public internet! This option is ignored unless -rpcallowip is also passed. Port is optional and overrides -rpcport. Use [host]:port notation for IPv6. This option can be specified multiple times (default: 127.0.0.1 and ::1 i.e., localhost)", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
+    gArgs.AddArg("-rpccheapthreads=<n>", strprintf("Set the number of extra threads that only service cheap RPC calls such as getblockcount and sendrawtransaction (default: %d)", DEFAULT_HTTP_CHEAP_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    gArgs.AddArg("-rpccheapworkqueue=<n>", strprintf("Set the depth of the separate work queue of cheap RPC calls (default: %d)", DEFAULT_HTTP_CHEAP_WORKQUEUE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::RPC);
+    gArgs.AddArg("-rpcclientthreads=<n>", strprintf("Set the maximum number of RPC calls of a single client IP serviced at once, 0 for no limit (default: %d)", DEFAULT_HTTP_CLIENT_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-rpccookiefile=<loc>", "Location of the auth cookie. Relative paths will be prefixed by a net-specific datadir location. (default: data dir)", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    gArgs.AddArg("-rpccostclass=<method>:<class>", "Set the cost class of an RPC method to cheap, normal or heavy, which decides the queue its calls wait in. This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    gArgs.AddArg("-rpcheavythreads=<n>", "Set the maximum number of threads servicing heavy RPC calls such as listaccounthistory at once (default: half of -rpcthreads)", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    gArgs.AddArg("-rpcheavyworkqueue=<n>", strprintf("Set the depth of the separate work queue of heavy RPC calls (default: %d)", DEFAULT_HTTP_HEAVY_WORKQUEUE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::RPC);
     gArgs.AddArg("-rpcpassword=<pw>", "Password for JSON-RPC connections", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-rpcport=<port>", strprintf("Listen for JSON-RPC connections on <port> (default: %u, testnet: %u, devnet: %u, regtest: %u)", defaultBaseParams->RPCPort(), testnetBaseParams->RPCPort(), devnetBaseParams->RPCPort(), regtestBaseParams->RPCPort()), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
     gArgs.AddArg("-rpcserialversion", strprintf("Sets the serialization of raw transaction or block hex returned in non-verbose mode, non-segwit(0) or segwit(1) (default: %d)", DEFAULT_RPC_SERIALIZE_VERSION), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
@@ -664,6 +677,7 @@ void SetupServerArgs()
     gArgs.AddArg("-rpcstats", strprintf("Log RPC stats. (default: %u)", DEFAULT_RPC_STATS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-consolidaterewards=<token-or-pool-symbol>", "Consolidate rewards on startup. Accepted multiple times for each token symbol", ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-rpccache=<0/1/2>", "Cache rpc results - uses additional memory to hold on to the last results per block, but faster (0=none, 1=all, 2=smart)", ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
+    gArgs.AddArg("-rpccachesize=<n>", strprintf("Maximum size of cached rpc results in MiB, least recently used results are dropped beyond it (default: %u)", DEFAULT_RPC_CACHE_SIZE), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-negativeinterest", "(experimental) Track negative interest values", ArgsManager::ALLOW_ANY, OptionsCategory::HIDDEN);
     gArgs.AddArg("-rpc-governance-accept-neutral", "Allow voting with neutral votes for JellyFish purpose", ArgsManager::ALLOW_ANY, OptionsCategory::HIDDEN);
     gArgs.AddArg("-dftxworkers=<n>", strprintf("No. of parallel workers associated with the DfTx related work pool. Stock splits, parallel processing of the chain where appropriate, etc use this worker pool (default: %d)", DEFAULT_DFTX_WORKERS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -681,6 +695,9 @@ void SetupServerArgs()
     gArgs.AddArg("-ethsubscription", strprintf("Enable subscription notifications ETH RPCs (default: %b)", DEFAULT_ETH_SUBSCRIPTION_ENABLED), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-oceanarchive", strprintf("Enable ocean archive indexer (default: %b)", DEFAULT_OCEAN_INDEXER_ENABLED), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-expr-oceanarchive", strprintf("Enable ocean archive indexer (default: %b)", DEFAULT_OCEAN_INDEXER_ENABLED), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    gArgs.AddArg("-oceancatchupthreads=<n>", strprintf("Number of threads reading and encoding blocks ahead of the ocean indexer during catch-up (default: %d)", DEFAULT_OCEAN_CATCHUP_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    gArgs.AddArg("-oceancatchupqueue=<n>", strprintf("Maximum number of blocks read ahead of the ocean indexer during catch-up (default: %d)", DEFAULT_OCEAN_CATCHUP_QUEUE), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    gArgs.AddArg("-oceanindexbatch=<n>", strprintf("Maximum number of blocks handed to the ocean indexer at once during catch-up (default: %d)", DEFAULT_OCEAN_INDEX_BATCH), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-oceanarchiveserver", strprintf("Enable ocean archive server (default: %b)", DEFAULT_OCEAN_SERVER_ENABLED), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     gArgs.AddArg("-oceanarchiveport=<port>", strprintf("Listen for ocean archive connections on <port> (default: %u)", DEFAULT_OCEAN_SERVER_PORT), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
     gArgs.AddArg("-oceanarchivebind=<addr>[:port]", "Bind to given address to listen for Ocean connections. Do not expose the Ocean server to untrusted networks such as the public internet! This option is ignored unless -rpcallowip is also passed. Port is optional and overrides -oceanarchiveport. This option can be specified multiple times (default: 127.0.0.1 i.e., localhost)", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
@@ -924,13 +941,11 @@ static bool AppInitServers()
     auto rpcCacheMode = [=](){
         switch (rpcCacheModeVal) {
         case 1: return RPCResultCache::RPCCacheMode::All;
-        // For the moment, there is smart is dumb, just redirects to all.
-        // Future implementations could be smarter based on size / latency.
-        case 2: return RPCResultCache::RPCCacheMode::All;
+        case 2: return RPCResultCache::RPCCacheMode::Smart;
         default: return RPCResultCache::RPCCacheMode::None;
     }}();
-    GetRPCResultCache().Init(rpcCacheMode);
-    GetMemoizedResultCache().Init(rpcCacheMode);
+    const auto rpcCacheSize = std::max<int64_t>(gArgs.GetArg("-rpccachesize", DEFAULT_RPC_CACHE_SIZE), 1);
+    GetRPCResultCache().Init(rpcCacheMode, rpcCacheSize << 20);
 
     RPCServer::OnStarted(&OnRPCStarted);
     RPCServer::OnStopped(&OnRPCStopped);
@@ -1865,6 +1880,7 @@ bool AppInitMain(InitInterfaces& interfaces)
     CacheSizes nCacheSizes;
     SetupCacheSizes(nCacheSizes);
     InitDfTxGlobalTaskPool();
+    InitHistoryWriterQueue();
 
     bool fLoaded = false;
     fReindex = gArgs.GetBoolArg("-reindex", false);
@@ -1945,32 +1961,37 @@ bool AppInitMain(InitInterfaces& interfaces)
                         "", CClientUIInterface::MSG_ERROR);
                 });
 
+                g_tokenTable.Reset();
                 pcustomcsDB.reset();
                 pcustomcsDB = std::make_unique<CStorageLevelDB>(GetDataDir() / "enhancedcs", nCacheSizes.customCacheSize, false, fReset || fReindexChainState);
                 pcustomcsview.reset();
                 pcustomcsview = std::make_unique<CCustomCSView>(*pcustomcsDB.get());
-
-                if (!fReset && !fReindexChainState) {
-                    if (!pcustomcsDB->IsEmpty() && pcustomcsview->GetDbVersion() != CCustomCSView::DbVersion) {
-                        strLoadError = _("Account database is unsuitable").translated;
-                        break;
-                    }
-                }
-
-                // Ensure we are on latest DB version
-                pcustomcsview->SetDbVersion(CCustomCSView::DbVersion);
+                g_tokenTable.Load(*pcustomcsDB);
 
                 // make account history db
+                WaitForHistoryWriterQueue();
                 paccountHistoryDB.reset();
                 if (gArgs.GetBoolArg("-acindex", DEFAULT_ACINDEX)) {
                     paccountHistoryDB = std::make_unique<CAccountHistoryStorage>(GetDataDir() / "history", nCacheSizes.customCacheSize, false, fReset || fReindexChainState);
                     paccountHistoryDB->CreateMultiIndexIfNeeded();
+                    paccountHistoryDB->SetSecondaryIndexes(gArgs.GetBoolArg("-acindex-filters", DEFAULT_ACINDEX_FILTERS));
                 }
 
                 pburnHistoryDB.reset();
                 pburnHistoryDB = std::make_unique<CBurnHistoryStorage>(GetDataDir() / "burn", nCacheSizes.customCacheSize, false, fReset || fReindexChainState);
                 pburnHistoryDB->CreateMultiIndexIfNeeded();
 
+                // Ensure we are on latest DB version, building the tables added since it was written.
+                // Burn totals are built from the burn history.
+                if (!fReset && !fReindexChainState && !pcustomcsDB->IsEmpty()) {
+                    if (!pcustomcsview->UpgradeDb(*pburnHistoryDB)) {
+                        strLoadError = _("Account database is unsuitable").translated;
+                        break;
+                    }
+                } else {
+                    pcustomcsview->SetDbVersion(CCustomCSView::DbVersion);
+                }
+
                 // Create vault history DB
                 pvaultHistoryDB.reset();
                 if (gArgs.GetBoolArg("-vaultindex", DEFAULT_VAULTINDEX)) {
@@ -2556,9 +2577,9 @@ bool AppInitMain(InitInterfaces& interfaces)
             tip = ::ChainActive().Tip();
         }
 
-        const UniValue b = blockToJSON(*pcustomcsview, block, tip, pblockindex, true, 2);
+        const auto payload = blockToOceanPayload(*pcustomcsview, block, tip, pblockindex);
 
-        if (bool isIndexed = OceanIndex(b, 0); !isIndexed) {
+        if (bool isIndexed = OceanIndex(payload, 0); !isIndexed) {
             return false;
         }
 
@@ -1202,6 +1202,9 @@ namespace pos {
     int64_t Staker::nFutureTime{0};
     uint256 Staker::lastBlockSeen{};
 
+    // Candidate coinstake times checked per kernel search call, between shutdown checks and yields
+    static constexpr size_t KERNEL_SEARCH_BATCH = 64;
+
     // Only using one item a time to avoid outdata block data
     boost::lockfree::queue<std::vector<ThreadStaker::Args> *> stakersParamsQueue(1);
 
@@ -1295,70 +1298,45 @@ namespace pos {
                     std::unique_lock l{pos::cs_MNLastBlockCreationAttemptTs};
                     pos::Staker::mapMNLastBlockCreationAttemptTs[masternodeID] = GetTime();
                 }
-                CheckContextState ctxState{subNode};
+                const CKernelSearch kernel(stakeModifier,
+                                           nBits,
+                                           creationHeight,
+                                           blockHeight,
+                                           masternodeID,
+                                           chainparams.GetConsensus(),
+                                           subNodeBlockTime,
+                                           subNode);
+
                 // Search backwards in time first
+                std::vector<int64_t> coinstakeTimes;
                 if (currentTime > lastSearchTime) {
                     for (uint32_t t = 0; t < currentTime - lastSearchTime; ++t) {
-                        if (ShutdownRequested()) {
-                            break;
-                        }
-
-                        blockTime = (static_cast<uint32_t>(currentTime) - t);
-
-                        if (pos::CheckKernelHash(stakeModifier,
-                                                 nBits,
-                                                 creationHeight,
-                                                 blockTime,
-                                                 blockHeight,
-                                                 masternodeID,
-                                                 chainparams.GetConsensus(),
-                                                 subNodeBlockTime,
-                                                 ctxState)) {
-                            LogPrint(BCLog::STAKING,
-                                     "MakeStake: kernel found. height: %d time: %d\n",
-                                     blockHeight,
-                                     blockTime);
-
-                            found = true;
-                            break;
-                        }
-
-                        std::this_thread::yield();  // give a slot to other threads
+                        coinstakeTimes.push_back(static_cast<uint32_t>(currentTime) - t);
                     }
                 }
 
-                if (!found) {
-                    // Search from current time or lastSearchTime set in the future
-                    int64_t searchTime = lastSearchTime > currentTime ? lastSearchTime : currentTime;
+                // Then forwards in time, from current time or lastSearchTime set in the future
+                int64_t searchTime = lastSearchTime > currentTime ? lastSearchTime : currentTime;
+                for (uint32_t t = 1; t <= futureTime - searchTime; ++t) {
+                    coinstakeTimes.push_back(static_cast<uint32_t>(searchTime) + t);
+                }
+
+                for (size_t i = 0; i < coinstakeTimes.size(); i += KERNEL_SEARCH_BATCH) {
+                    if (ShutdownRequested()) {
+                        break;
+                    }
 
-                    // Search forwards in time
-                    for (uint32_t t = 1; t <= futureTime - searchTime; ++t) {
-                        if (ShutdownRequested()) {
-                            break;
-                        }
+                    const auto count = std::min(KERNEL_SEARCH_BATCH, coinstakeTimes.size() - i);
+                    if (const auto kernelTime = kernel.FindKernel(coinstakeTimes.data() + i, count)) {
+                        blockTime = *kernelTime;
 
-                        blockTime = (static_cast<uint32_t>(searchTime) + t);
-
-                        if (pos::CheckKernelHash(stakeModifier,
-                                                 nBits,
-                                                 creationHeight,
-                                                 blockTime,
-                                                 blockHeight,
-                                                 masternodeID,
-                                                 chainparams.GetConsensus(),
-                                                 subNodeBlockTime,
-                                                 ctxState)) {
-                            LogPrint(BCLog::STAKING,
-                                     "MakeStake: kernel found. height: %d time: %d\n",
-                                     blockHeight,
-                                     blockTime);
-
-                            found = true;
-                            break;
-                        }
+                        LogPrint(BCLog::STAKING, "MakeStake: kernel found. height: %d time: %d\n", blockHeight, blockTime);
 
-                        std::this_thread::yield();  // give a slot to other threads
+                        found = true;
+                        break;
                     }
+
+                    std::this_thread::yield();  // give a slot to other threads
                 }
             },
             blockHeight);
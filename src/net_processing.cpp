@@ -2425,14 +2425,19 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         CAnchorAuthMessage auth;
         vRecv >> auth;
 
+        const auto authStart = GetTimeMicros();
+        // Recover the signer before taking cs_main, the lookups below hit the signer cache
+        const auto signer = auth.GetSigner();
+
         // don't check spv here, but only our anchor index!
+        bool valid{};
         {
             LOCK(cs_main);
             if (panchorauths->GetAuth(auth.GetHash())) {
                 // reject ? or just skip&
                 return false;
             }
-            if (panchorauths->GetVote(auth.GetSignHash(), auth.GetSigner())) {
+            if (panchorauths->GetVote(auth.GetSignHash(), signer)) {
                 // disconnect immidiately! possible even ban here, but only if sender peer is an author itself
                 pfrom->fDisconnect = true;
                 return false;
@@ -2441,13 +2446,14 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
             LogPrint(BCLog::ANCHORING, "Got anchor auth, hash %s, blockheight: %d\n", auth.GetHash().ToString(), auth.height);
 
             // if valid, add and rebroadcast
-            if (panchorauths->ValidateAuth(auth)) {
+            valid = panchorauths->ValidateAuth(auth);
+            if (valid) {
                 panchorauths->AddAuth(auth);
                 RelayAnchorAuths({CInv(MSG_ANCHOR_AUTH, auth.GetHash())}, *connman, pfrom);
-                return true;
             }
         }
-        return false;
+        g_anchorSignerCache.RecordAuth(GetTimeMicros() - authStart);
+        return valid;
     }
 
     if (strCommand == NetMsgType::ANCHORCONFIRM) {
@@ -1,27 +1,56 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <consensus/validation.h>
+#include <dfi/accountshistory.h>
 #include <dfi/masternodes.h>
+#include <dfi/snapshotmanager.h>
+#include <dfi/vaulthistory.h>
 #include <ffi/ffiexports.h>
 #include <ffi/ffihelpers.h>
 #include <logging.h>
+#include <ocean.h>
 #include <primitives/block.h>
 #include <rpc/blockchain.h>
+#include <shutdown.h>
+#include <streams.h>
 #include <sync.h>
-#include <univalue.h>
 #include <util/system.h>
+#include <util/time.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
-bool OceanIndex(const UniValue b, uint32_t blockHeight) {
+// Catch-up state, shared with ConnectTip and DisconnectTip. Lock order: cs_main, cs_oceanCatchup.
+static Mutex cs_oceanCatchup;
+static bool catchupActive GUARDED_BY(cs_oceanCatchup){};
+// Highest block Ocean holds and the next one catch-up indexes
+static uint32_t catchupIndexedHeight GUARDED_BY(cs_oceanCatchup){};
+static uint32_t catchupNextHeight GUARDED_BY(cs_oceanCatchup){};
+// Bumped on every disconnect so that prefetched blocks of the old chain are dropped
+static uint64_t catchupGeneration GUARDED_BY(cs_oceanCatchup){};
+// Set while a batch is indexed without cs_oceanCatchup. Indexed blocks disconnected meanwhile
+// are invalidated by catch-up after the batch, newest first.
+static bool catchupIndexing GUARDED_BY(cs_oceanCatchup){};
+static std::vector<std::pair<uint32_t, std::vector<uint8_t>>> catchupDisconnected GUARDED_BY(cs_oceanCatchup);
+
+static Mutex cs_oceanProgress;
+static OceanCatchupProgress catchupProgress GUARDED_BY(cs_oceanProgress);
+
+bool OceanIndex(const std::vector<uint8_t> &payload, uint32_t blockHeight) {
     CrossBoundaryResult result;
-    ocean_index_block(result, b.write());
+    const rust::Slice<const uint8_t> block{payload.data(), payload.size()};
+    ocean_index_block(result, block);
     if (!result.ok) {
         LogPrintf("Error indexing ocean block %d: %s\n", blockHeight, result.reason);
-        ocean_invalidate_block(result, b.write());
+        ocean_invalidate_block(result, block);
         if (!result.ok) {
             LogPrintf("Error invalidating ocean %d block: %s\n", blockHeight, result.reason);
         }
@@ -30,6 +59,198 @@ bool OceanIndex(const UniValue b, uint32_t blockHeight) {
     return true;
 };
 
+static bool OceanInvalidate(const std::vector<uint8_t> &payload, uint32_t blockHeight) {
+    CrossBoundaryResult result;
+    ocean_invalidate_block(result, rust::Slice<const uint8_t>{payload.data(), payload.size()});
+    if (!result.ok) {
+        LogPrintf("Error invalidating ocean %d block: %s\n", blockHeight, result.reason);
+        return false;
+    }
+    return true;
+}
+
+bool OceanIndexBlocks(const std::vector<std::vector<uint8_t>> &payloads, uint32_t firstHeight) {
+    const auto lastHeight = firstHeight + payloads.size() - 1;
+    const auto time = GetTimeMillis();
+    CDataStream batch(SER_NETWORK, PROTOCOL_VERSION);
+    batch << payloads;
+
+    CrossBoundaryResult result;
+    ocean_index_blocks(result, rust::Slice<const uint8_t>{reinterpret_cast<const uint8_t *>(batch.data()), batch.size()});
+    if (!result.ok) {
+        // The indexer has tried to roll back the blocks of the batch it indexed
+        LogPrintf("Error indexing ocean blocks %d-%d: %s\n", firstHeight, lastHeight, result.reason);
+        return false;
+    }
+    LogPrint(BCLog::OCEAN,
+             "Indexing ocean blocks %d-%d (%d blocks, %d bytes) took: %dms\n",
+             firstHeight,
+             lastHeight,
+             payloads.size(),
+             batch.size(),
+             GetTimeMillis() - time);
+    return true;
+}
+
+bool IsOceanCatchupActive() {
+    AssertLockHeld(cs_main);
+    LOCK(cs_oceanCatchup);
+    return catchupActive;
+}
+
+bool OceanCatchupDisconnect(uint32_t blockHeight, std::vector<uint8_t> &payload) {
+    AssertLockHeld(cs_main);
+    LOCK(cs_oceanCatchup);
+    if (!catchupActive) {
+        return true;
+    }
+    ++catchupGeneration;
+    if (blockHeight > catchupIndexedHeight) {
+        return false;
+    }
+    catchupIndexedHeight = blockHeight - 1;
+    catchupNextHeight = blockHeight;
+    if (catchupIndexing) {
+        // Invalidated after the blocks of the batch above it
+        catchupDisconnected.emplace_back(blockHeight, std::move(payload));
+        return false;
+    }
+    return true;
+}
+
+OceanCatchupProgress GetOceanCatchupProgress() {
+    LOCK(cs_oceanProgress);
+    return catchupProgress;
+}
+
+/**
+ * Reads and encodes blocks ahead of the indexer on worker threads. The consumer adds
+ * block indexes in height order, never more than the queue depth ahead of the block it
+ * takes next, and takes the encoded blocks back in the same order.
+ */
+class COceanCatchupPipeline {
+public:
+    struct Block {
+        const CBlockIndex *pindex{};
+        const CBlockIndex *tip{};
+        uint64_t generation{};
+        uint64_t epoch{};
+        bool reading{};
+        bool ready{};
+        bool ok{};
+        std::vector<uint8_t> payload;
+    };
+
+    explicit COceanCatchupPipeline(int threads) {
+        for (int i = 0; i < threads; ++i) {
+            workers.emplace_back(&TraceThread<std::function<void()>>, "oceancatchup", [this] { Run(); });
+        }
+    }
+
+    ~COceanCatchupPipeline() {
+        {
+            std::lock_guard lock(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    void Add(const CBlockIndex *pindex, const CBlockIndex *tip, uint64_t generation) {
+        {
+            std::lock_guard lock(m);
+            blocks[pindex->nHeight] = Block{pindex, tip, generation, epoch};
+        }
+        cv.notify_all();
+    }
+
+    // Waits for the block at height, it must have been added
+    Block Take(uint32_t height) {
+        std::unique_lock lock(m);
+        cv.wait(lock, [&] { return blocks.at(height).ready; });
+        auto block = std::move(blocks.at(height));
+        blocks.erase(height);
+        return block;
+    }
+
+    // Drops everything queued, blocks still being read are discarded when done
+    void Reset() {
+        std::lock_guard lock(m);
+        blocks.clear();
+        ++epoch;
+    }
+
+    size_t Queued() {
+        std::lock_guard lock(m);
+        return blocks.size();
+    }
+
+private:
+    void Run() {
+        std::unique_ptr<CCustomCSView> view;
+        size_t viewUses{};
+        while (true) {
+            uint32_t height{};
+            Block block;
+            {
+                std::unique_lock lock(m);
+                auto it = blocks.end();
+                cv.wait(lock, [&] {
+                    if (stopping) {
+                        return true;
+                    }
+                    for (it = blocks.begin(); it != blocks.end(); ++it) {
+                        if (!it->second.reading && !it->second.ready) {
+                            return true;
+                        }
+                    }
+                    return false;
+                });
+                if (stopping) {
+                    return;
+                }
+                it->second.reading = true;
+                height = it->first;
+                block = it->second;
+            }
+
+            // Minter info is read from a view snapshot, renewed so that it is not pinned for the whole catch-up
+            if (!view || ++viewUses > 1000) {
+                view = std::get<0>(GetSnapshots());
+                viewUses = 0;
+            }
+
+            CBlock rawBlock;
+            block.ok = ReadBlockFromDisk(rawBlock, block.pindex, Params().GetConsensus());
+            if (block.ok) {
+                block.payload = blockToOceanPayload(*view, rawBlock, block.tip, block.pindex);
+            } else {
+                LogPrintf("Error: Failed to read block %s from disk\n", block.pindex->GetBlockHash().ToString());
+            }
+
+            {
+                std::lock_guard lock(m);
+                auto it = blocks.find(height);
+                if (it != blocks.end() && it->second.epoch == block.epoch) {
+                    block.reading = false;
+                    block.ready = true;
+                    it->second = std::move(block);
+                }
+            }
+            cv.notify_all();
+        }
+    }
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::map<uint32_t, Block> blocks;
+    uint64_t epoch{};
+    bool stopping{};
+    std::vector<std::thread> workers;
+};
+
 bool CatchupOceanIndexer() {
     if (!gArgs.GetBoolArg("-oceanarchive", DEFAULT_OCEAN_INDEXER_ENABLED) &&
         !gArgs.GetBoolArg("-expr-oceanarchive", DEFAULT_OCEAN_INDEXER_ENABLED)) {
@@ -44,73 +265,168 @@ bool CatchupOceanIndexer() {
         return false;
     }
 
-    CBlockIndex *tip = nullptr;
+    uint32_t tipHeight{};
     {
-        LOCK(cs_main);
-        tip = ::ChainActive().Tip();
+        LOCK2(cs_main, cs_oceanCatchup);
+        const auto tip = ::ChainActive().Tip();
         if (!tip) {
             LogPrintf("Error: Cannot get chain tip\n");
             return false;
         }
-    }
-    const uint32_t tipHeight = tip->nHeight;
+        tipHeight = tip->nHeight;
+        if (tipHeight == oceanBlockHeight) {
+            return true;
+        }
 
-    if (tipHeight == oceanBlockHeight) {
-        return true;
+        // From here on ConnectTip leaves new blocks to the catch-up
+        catchupActive = true;
+        catchupIndexedHeight = oceanBlockHeight;
+        catchupNextHeight = oceanBlockHeight;
     }
 
-    LogPrintf("Starting Ocean index catchup...\n");
+    const auto maxQueued = std::max<int64_t>(1, gArgs.GetArg("-oceancatchupqueue", DEFAULT_OCEAN_CATCHUP_QUEUE));
+    const auto threads = std::max<int64_t>(1, gArgs.GetArg("-oceancatchupthreads", DEFAULT_OCEAN_CATCHUP_THREADS));
+    const auto maxBatch = static_cast<uint32_t>(std::max<int64_t>(1, gArgs.GetArg("-oceanindexbatch", DEFAULT_OCEAN_INDEX_BATCH)));
 
-    uint32_t currentHeight = oceanBlockHeight;
-
-    LogPrintf("Ocean catchup: Current height=%u, Target height=%u\n", currentHeight, tipHeight);
+    LogPrintf("Starting Ocean index catchup...\n");
+    LogPrintf("Ocean catchup: Current height=%u, Target height=%u, Threads=%d, Queue=%d, Batch=%u\n",
+              oceanBlockHeight,
+              tipHeight,
+              threads,
+              maxQueued,
+              maxBatch);
 
-    uint32_t remainingBlocks = tipHeight - currentHeight;
     const uint32_t startHeight = oceanBlockHeight;
     int lastProgress = -1;
     const auto startTime = std::chrono::steady_clock::now();
 
-    CBlockIndex *pindex = nullptr;
+    {
+        LOCK(cs_oceanProgress);
+        catchupProgress = OceanCatchupProgress{true, startHeight, oceanBlockHeight, tipHeight};
+    }
+
+    auto finish = [&](bool ok) {
+        {
+            LOCK(cs_oceanCatchup);
+            catchupActive = false;
+        }
+        LOCK(cs_oceanProgress);
+        catchupProgress.active = false;
+        catchupProgress.queued = 0;
+        return ok;
+    };
+
+    COceanCatchupPipeline pipeline(static_cast<int>(threads));
 
-    // Lock for the whole catchup duration
-    LOCK(cs_main);
+    uint32_t currentHeight = oceanBlockHeight;
+    // Next height whose block index is handed to the pipeline
+    uint32_t queuedHeight = oceanBlockHeight;
 
-    while (currentHeight <= tipHeight) {
+    while (true) {
         if (ShutdownRequested()) {
             LogPrintf("Shutdown requested, exiting ocean catchup...\n");
-            return false;
+            return finish(false);
         }
 
-        pindex = ::ChainActive()[currentHeight];
-        if (!pindex) {
-            LogPrintf("Error: Cannot find block at height %u\n", currentHeight);
-            return false;
+        // Block index snapshots in short cs_main windows, ahead of the consumer by up to the queue depth
+        if (queuedHeight - currentHeight < static_cast<uint32_t>(maxQueued) / 2 + 1) {
+            LOCK2(cs_main, cs_oceanCatchup);
+            const auto tip = ::ChainActive().Tip();
+            tipHeight = tip->nHeight;
+            if (currentHeight > tipHeight) {
+                // Caught up, new blocks are indexed by ConnectTip again
+                catchupActive = false;
+                break;
+            }
+            const auto end = std::min<uint32_t>(tipHeight + 1, currentHeight + maxQueued);
+            for (; queuedHeight < end; ++queuedHeight) {
+                pipeline.Add(::ChainActive()[queuedHeight], tip, catchupGeneration);
+            }
         }
 
-        CBlock block;
-        if (!ReadBlockFromDisk(block, pindex, Params().GetConsensus())) {
-            LogPrintf("Error: Failed to read block %s from disk\n", pindex->GetBlockHash().ToString());
-            return false;
+        // Batches shrink with the lag, down to single blocks close to the tip
+        const auto batchSize = std::min<uint32_t>(maxBatch, queuedHeight - currentHeight);
+        std::vector<COceanCatchupPipeline::Block> blocks;
+        blocks.reserve(batchSize);
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            blocks.push_back(pipeline.Take(currentHeight + i));
         }
 
-        const UniValue b = blockToJSON(*pcustomcsview, block, tip, pindex, true, 2);
-
-        if (bool isIndexed = OceanIndex(b, currentHeight); !isIndexed) {
-            return false;
+        std::vector<std::vector<uint8_t>> payloads;
+        uint64_t generation{};
+        {
+            LOCK(cs_oceanCatchup);
+            const auto stale = std::any_of(blocks.begin(), blocks.end(), [](const auto &block) {
+                return block.generation != catchupGeneration;
+            });
+            if (stale) {
+                // Disconnected while queued, start again from the first block Ocean lacks
+                LogPrint(BCLog::OCEAN, "Ocean catchup: chain changed, restarting from height %u\n", catchupNextHeight);
+                currentHeight = queuedHeight = catchupNextHeight;
+                pipeline.Reset();
+                continue;
+            }
+            payloads.reserve(blocks.size());
+            for (auto &block : blocks) {
+                if (!block.ok) {
+                    return finish(false);
+                }
+                payloads.push_back(std::move(block.payload));
+            }
+            generation = catchupGeneration;
+            catchupIndexing = true;
         }
 
-        currentHeight++;
+        // Indexed without cs_oceanCatchup, ConnectTip and DisconnectTip do not wait for the batch
+        const auto indexed = OceanIndexBlocks(payloads, currentHeight);
+
+        {
+            LOCK(cs_oceanCatchup);
+            catchupIndexing = false;
+            if (generation != catchupGeneration) {
+                // Blocks of the batch may be disconnected, undo it and the indexed blocks disconnected
+                // meanwhile, newest first. Rare, so done holding the lock.
+                bool ok{indexed};
+                for (uint32_t i = indexed ? payloads.size() : 0; i > 0; --i) {
+                    ok = OceanInvalidate(payloads[i - 1], currentHeight + i - 1) && ok;
+                }
+                for (const auto &[height, payload] : catchupDisconnected) {
+                    ok = OceanInvalidate(payload, height) && ok;
+                }
+                catchupDisconnected.clear();
+                if (!ok) {
+                    return finish(false);
+                }
+                LogPrint(BCLog::OCEAN, "Ocean catchup: chain changed, restarting from height %u\n", catchupNextHeight);
+                currentHeight = queuedHeight = catchupNextHeight;
+                pipeline.Reset();
+                continue;
+            }
+            if (!indexed) {
+                return finish(false);
+            }
+            currentHeight += batchSize;
+            catchupIndexedHeight = currentHeight - 1;
+            catchupNextHeight = currentHeight;
+        }
 
         uint32_t blocksProcessed = currentHeight - startHeight;
         int currentProgress = static_cast<int>((static_cast<double>(currentHeight * 100) / tipHeight));
 
-        if (currentProgress > lastProgress || currentHeight % 10000 == 0) {
-            auto currentTime = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count();
+        auto currentTime = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count();
+        double blocksPerSecond = elapsed > 0 ? static_cast<double>(blocksProcessed) / elapsed : 0;
 
-            double blocksPerSecond = elapsed > 0 ? static_cast<double>(blocksProcessed) / elapsed : 0;
+        {
+            LOCK(cs_oceanProgress);
+            catchupProgress.indexedHeight = currentHeight - 1;
+            catchupProgress.targetHeight = tipHeight;
+            catchupProgress.queued = pipeline.Queued();
+            catchupProgress.blocksPerSecond = blocksPerSecond;
+        }
 
-            remainingBlocks = tipHeight - currentHeight;
+        if (currentProgress > lastProgress || currentHeight % 10000 == 0) {
+            uint32_t remainingBlocks = currentHeight > tipHeight ? 0 : tipHeight - currentHeight;
             int estimatedSecondsLeft = blocksPerSecond > 0 ? static_cast<int>(remainingBlocks / blocksPerSecond) : 0;
 
             LogPrintf(
@@ -136,5 +452,5 @@ bool CatchupOceanIndexer() {
               (totalTime % 3600) / 60,
               totalTime % 60);
 
-    return true;
+    return finish(true);
 }
@@ -1,9 +1,116 @@
 #ifndef DEFI_OCEAN_H
 #define DEFI_OCEAN_H
 
-#include <univalue.h>
+#include <amount.h>
+#include <serialize.h>
+#include <uint256.h>
 
+#include <string>
+#include <vector>
+
+/**
+ * Binary block handoff to the Ocean indexer.
+ *
+ * The payload is the serialized CBlock followed by OceanBlockInfo. The indexer decodes
+ * hashes, sizes, weights, inputs, amounts and scripts from the block itself, so the
+ * info only carries what needs the node: chain index fields, minter and rewards, and the
+ * decoded output destinations.
+ */
+struct OceanTxOutInfo {
+    std::string type;
+    int32_t reqSigs{};  // -1 when no destinations could be extracted
+    std::vector<std::string> addresses;
+    uint32_t tokenId{};
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(type);
+        READWRITE(reqSigs);
+        READWRITE(addresses);
+        READWRITE(tokenId);
+    }
+};
+
+struct OceanBlockRewards {
+    CAmount anchorReward{};
+    CAmount communityDevFunds{};
+    CAmount burnt{};
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(anchorReward);
+        READWRITE(communityDevFunds);
+        READWRITE(burnt);
+    }
+};
+
+struct OceanBlockInfo {
+    uint256 hash;
+    uint32_t height{};
+    int32_t confirmations{};
+    int64_t medianTime{};
+    uint256 chainwork;
+    std::string masternode;
+    std::string minter;
+    uint64_t mintedBlocks{};
+    uint256 stakeModifier;
+    bool hasRewards{};
+    OceanBlockRewards rewards;
+    std::vector<std::vector<OceanTxOutInfo>> vouts;  // per transaction, per output
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream &s, Operation ser_action) {
+        READWRITE(hash);
+        READWRITE(height);
+        READWRITE(confirmations);
+        READWRITE(medianTime);
+        READWRITE(chainwork);
+        READWRITE(masternode);
+        READWRITE(minter);
+        READWRITE(mintedBlocks);
+        READWRITE(stakeModifier);
+        READWRITE(hasRewards);
+        READWRITE(rewards);
+        READWRITE(vouts);
+    }
+};
+
+static const int DEFAULT_OCEAN_CATCHUP_THREADS = 4;
+static const int DEFAULT_OCEAN_CATCHUP_QUEUE = 256;
+static const int DEFAULT_OCEAN_INDEX_BATCH = 64;
+
+struct OceanCatchupProgress {
+    bool active{};
+    uint32_t startHeight{};
+    uint32_t indexedHeight{};
+    uint32_t targetHeight{};
+    size_t queued{};
+    double blocksPerSecond{};
+};
+
+/**
+ * Indexes the blocks Ocean is missing up to the tip. Blocks are read and encoded ahead
+ * on -oceancatchupthreads threads and indexed in order, in batches of up to
+ * -oceanindexbatch blocks while far behind. cs_main is only taken in short windows to
+ * snapshot block indexes. Until it is done ConnectTip leaves new blocks to it.
+ */
 bool CatchupOceanIndexer();
-bool OceanIndex (const UniValue b, uint32_t blockHeight);
+bool OceanIndex(const std::vector<uint8_t> &payload, uint32_t blockHeight);
+// Indexes consecutive blocks starting at firstHeight in a single call. On failure the indexer
+// invalidates the blocks it indexed again, best effort.
+bool OceanIndexBlocks(const std::vector<std::vector<uint8_t>> &payloads, uint32_t firstHeight);
+OceanCatchupProgress GetOceanCatchupProgress();
+
+// Both require cs_main
+bool IsOceanCatchupActive();
+// Whether a block being disconnected has to be invalidated in Ocean now. Takes its payload
+// when catch-up invalidates it after the batch it is indexing.
+bool OceanCatchupDisconnect(uint32_t blockHeight, std::vector<uint8_t> &payload);
 
 #endif  // DEFI_OCEAN_H
@@ -1,6 +1,8 @@
 #include <pos_kernel.h>
 #include <amount.h>
 #include <arith_uint256.h>
+#include <crypto/common.h>
+#include <crypto/sha256.h>
 #include <key.h>
 #include <validation.h>
 
@@ -8,6 +10,9 @@
 
 extern CAmount GetMnCollateralAmount(int); // from masternodes.h
 
+// The coinstake time follows the stake modifier in the kernel
+static constexpr size_t KERNEL_TIME_OFFSET = 32;
+
 namespace pos {
     uint256 CalcKernelHash(const uint256& stakeModifier, int64_t height, int64_t coinstakeTime, const uint256& masternodeID) {
         // Calculate hash
@@ -72,6 +77,52 @@ namespace pos {
         return (hashProofOfStake / static_cast<uint64_t>( GetMnCollateralAmount( static_cast<int>(creationHeight) ) ) ) <= targetProofOfStake;
     }
 
+    CKernelSearch::CKernelSearch(const uint256& stakeModifier, uint32_t nBits, int64_t creationHeight, uint64_t blockHeight,
+                                 const uint256& masternodeID, const Consensus::Params& params, const int64_t subNodeBlockTime, const uint8_t subNode)
+        : params(params),
+          collateral(static_cast<uint64_t>(GetMnCollateralAmount(static_cast<int>(creationHeight)))),
+          subNodeBlockTime(subNodeBlockTime),
+          // Weighted from EunosPaya on as well, as CheckKernelHash does whatever the order of the forks
+          coinDayWeighted(blockHeight >= static_cast<uint64_t>(params.DF10EunosPayaHeight) ||
+                          blockHeight >= static_cast<uint64_t>(params.DF7DakotaCrescentHeight))
+    {
+        targetProofOfStake.SetCompact(nBits);
+
+        CDataStream ss(SER_GETHASH, 0);
+        ss << stakeModifier << int64_t{0} << GetMnCollateralAmount(int(creationHeight)) << masternodeID;
+        if (blockHeight >= static_cast<uint64_t>(params.DF10EunosPayaHeight)) {
+            ss << subNode;
+        }
+        kernel.assign(ss.begin(), ss.end());
+    }
+
+    std::optional<int64_t> CKernelSearch::FindKernel(const int64_t* coinstakeTimes, size_t count) const {
+        std::vector<unsigned char> kernels(count * kernel.size());
+        for (size_t i = 0; i < count; ++i) {
+            auto it = kernels.begin() + i * kernel.size();
+            std::copy(kernel.begin(), kernel.end(), it);
+            WriteLE64(&*it + KERNEL_TIME_OFFSET, static_cast<uint64_t>(coinstakeTimes[i]));
+        }
+
+        std::vector<unsigned char> hashes(count * CSHA256::OUTPUT_SIZE);
+        SHA256DShort(hashes.data(), kernels.data(), kernel.size(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            uint256 hash;
+            std::copy(hashes.begin() + i * CSHA256::OUTPUT_SIZE, hashes.begin() + (i + 1) * CSHA256::OUTPUT_SIZE, hash.begin());
+            const auto hashProofOfStake = UintToArith256(hash);
+
+            // Increase target by coinDayWeight.
+            const auto target = coinDayWeighted ? targetProofOfStake * CalcCoinDayWeight(params, coinstakeTimes[i], subNodeBlockTime)
+                                                : targetProofOfStake;
+            if (hashProofOfStake / collateral <= target) {
+                return coinstakeTimes[i];
+            }
+        }
+
+        return {};
+    }
+
     uint256 ComputeStakeModifier(const uint256& prevStakeModifier, const CKeyID& key) {
         // Calculate hash
         CDataStream ss(SER_GETHASH, 0);
@@ -8,6 +8,9 @@
 #include <amount.h>
 #include <pos.h>
 
+#include <optional>
+#include <vector>
+
 class CWallet;
 class COutPoint;
 class CBlock;
@@ -30,6 +33,25 @@ namespace pos {
     bool CheckKernelHash(const uint256& stakeModifier, uint32_t nBits, int64_t creationHeight, int64_t coinstakeTime, uint64_t blockHeight,
                          const uint256& masternodeID, const Consensus::Params& params, const int64_t subNodeBlockTime, const CheckContextState ctxState);
 
+/// Stake kernel of one masternode and subnode, with everything but the coinstake time serialized once,
+/// checked for many coinstake times per call using multi-buffer SHA256
+    class CKernelSearch {
+    public:
+        CKernelSearch(const uint256& stakeModifier, uint32_t nBits, int64_t creationHeight, uint64_t blockHeight,
+                      const uint256& masternodeID, const Consensus::Params& params, const int64_t subNodeBlockTime, const uint8_t subNode);
+
+        /// First of the coinstake times, in the given order, whose kernel meets the target as in CheckKernelHash
+        std::optional<int64_t> FindKernel(const int64_t* coinstakeTimes, size_t count) const;
+
+    private:
+        const Consensus::Params& params;
+        arith_uint256 targetProofOfStake;
+        uint64_t collateral;
+        int64_t subNodeBlockTime;
+        bool coinDayWeighted;
+        std::vector<unsigned char> kernel;
+    };
+
 /// Stake Modifier (hash modifier of proof-of-stake)
     uint256 ComputeStakeModifier(const uint256& prevStakeModifier, const CKeyID& key);
 }
@@ -12,6 +12,7 @@
 #include <chainparams.h>
 #include <coins.h>
 #include <node/coinstats.h>
+#include <ocean.h>
 #include <consensus/validation.h>
 #include <core_io.h>
 #include <hash.h>
@@ -27,6 +28,7 @@
 #include <primitives/transaction.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
+#include <rpc/jsonstream.h>
 #include <rpc/resultcache.h>
 #include <script/descriptor.h>
 #include <streams.h>
@@ -419,6 +421,58 @@ UniValue blockToJSON(CCustomCSView &view, const CBlock& block, const CBlockIndex
     return result;
 }
 
+std::vector<uint8_t> blockToOceanPayload(CCustomCSView &view, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex)
+{
+    OceanBlockInfo info;
+    info.hash = blockindex->GetBlockHash();
+    info.height = blockindex->nHeight;
+    const CBlockIndex* pnext;
+    info.confirmations = ComputeNextBlockAndDepth(tip, blockindex, pnext);
+    info.medianTime = blockindex->GetMedianTimePast();
+    info.chainwork = ArithToUint256(blockindex->nChainWork);
+
+    const auto minterInfo = MinterInfo::From(block, blockindex, view);
+    if (!minterInfo.Id.empty()) {
+        info.masternode = minterInfo.Id;
+        info.minter = minterInfo.OperatorAddress;
+    }
+    info.mintedBlocks = minterInfo.MintedBlocks;
+    info.stakeModifier = blockindex->stakeModifier;
+
+    if (auto rewardInfo = RewardInfo::TryFrom(block, blockindex, Params().GetConsensus())) {
+        info.hasRewards = true;
+        info.rewards = {rewardInfo->TokenRewards.AnchorReward,
+                        rewardInfo->TokenRewards.CommunityDevFunds,
+                        rewardInfo->TokenRewards.Burnt};
+    }
+
+    info.vouts.reserve(block.vtx.size());
+    for (const auto& tx : block.vtx) {
+        auto& outs = info.vouts.emplace_back();
+        outs.reserve(tx->vout.size());
+        for (const auto& txout : tx->vout) {
+            auto& out = outs.emplace_back();
+            txnouttype type;
+            std::vector<CTxDestination> addresses;
+            int nRequired;
+            if (ExtractDestinations(txout.scriptPubKey, type, addresses, nRequired)) {
+                out.reqSigs = nRequired;
+                for (const auto& addr : addresses) {
+                    out.addresses.push_back(EncodeDestination(addr));
+                }
+            } else {
+                out.reqSigs = -1;
+            }
+            out.type = GetTxnOutputType(type);
+            out.tokenId = tx->nVersion >= CTransaction::TOKENS_MIN_VERSION ? txout.nTokenId.v : 0;
+        }
+    }
+
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << block << info;
+    return {ss.begin(), ss.end()};
+}
+
 static UniValue getblockcount(const JSONRPCRequest& request)
 {
             RPCHelpMan{"getblockcount",
@@ -625,6 +679,38 @@ static UniValue getdifficulty(const JSONRPCRequest& request)
     return GetDifficulty(::ChainActive().Tip());
 }
 
+static UniValue getoceancatchupinfo(const JSONRPCRequest& request)
+{
+            RPCHelpMan{"getoceancatchupinfo",
+                "\nReturns the progress of the ocean indexer catching up to the chain tip.\n",
+                {},
+                RPCResult{
+            "{\n"
+            "  \"active\": true|false,      (boolean) whether the catch-up is running\n"
+            "  \"startheight\": n,          (numeric) the height the catch-up started from\n"
+            "  \"indexedheight\": n,        (numeric) the height of the last block indexed\n"
+            "  \"targetheight\": n,         (numeric) the chain tip height the catch-up is heading for\n"
+            "  \"queued\": n,               (numeric) the number of blocks read ahead of the indexer\n"
+            "  \"blockspersecond\": x.xxx   (numeric) the average indexing rate\n"
+            "}\n"
+                },
+                RPCExamples{
+                    HelpExampleCli("getoceancatchupinfo", "")
+            + HelpExampleRpc("getoceancatchupinfo", "")
+                },
+            }.Check(request);
+
+    const auto progress = GetOceanCatchupProgress();
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("active", progress.active);
+    result.pushKV("startheight", static_cast<uint64_t>(progress.startHeight));
+    result.pushKV("indexedheight", static_cast<uint64_t>(progress.indexedHeight));
+    result.pushKV("targetheight", static_cast<uint64_t>(progress.targetHeight));
+    result.pushKV("queued", static_cast<uint64_t>(progress.queued));
+    result.pushKV("blockspersecond", progress.blocksPerSecond);
+    return result;
+}
+
 static std::string EntryDescriptionString()
 {
     return "    \"vsize\" : n,            (numeric) virtual transaction size as defined in BIP 141. This is different from actual serialized size for witness transactions as witness data is discounted.\n"
@@ -1073,6 +1159,30 @@ static CBlockUndo GetUndoChecked(const CBlockIndex* pblockindex)
     return blockUndo;
 }
 
+// blockToJSON with transaction details, written one transaction at a time
+static void blockToJSONStream(JSONStreamWriter& writer, CCustomCSView &view, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, int version)
+{
+    const auto isEvmEnabledForBlock = version > 2 && IsEVMEnabled(view);
+    const auto header = blockToJSON(view, block, tip, blockindex, false, version);
+    const auto& keys = header.getKeys();
+    const auto& values = header.getValues();
+
+    writer.BeginObject();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] != "tx") {
+            writer.KeyValue(keys[i], values[i]);
+            continue;
+        }
+        writer.Key(keys[i]);
+        writer.BeginArray();
+        for (const auto& tx : block.vtx) {
+            writer.Value(ExtendedTxToUniv(view, *tx, true, RPCSerializationFlags(), version, true, isEvmEnabledForBlock));
+        }
+        writer.End();
+    }
+    writer.End();
+}
+
 static UniValue getblock(const JSONRPCRequest& request)
 {
     RPCHelpMan{"getblock",
@@ -1172,6 +1282,10 @@ static UniValue getblock(const JSONRPCRequest& request)
     }
 
     auto [view, accountView, vaultView] = GetSnapshots();
+    if (request.replyStream && verbosity >= 2) {
+        blockToJSONStream(request.replyStream->Result(), *view, block, tip, pblockindex, verbosity);
+        return NullUniValue;
+    }
     return blockToJSON(*view, block, tip, pblockindex, verbosity >= 2, verbosity);
 }
 
@@ -2544,6 +2658,7 @@ static const CRPCCommand commands[] =
     { "blockchain",         "getblockheader",         &getblockheader,         {"blockhash","verbose"} },
     { "blockchain",         "getchaintips",           &getchaintips,           {} },
     { "blockchain",         "getdifficulty",          &getdifficulty,          {} },
+    { "blockchain",         "getoceancatchupinfo",    &getoceancatchupinfo,    {} },
     { "blockchain",         "getmempoolancestors",    &getmempoolancestors,    {"txid","verbose"} },
     { "blockchain",         "getmempooldescendants",  &getmempooldescendants,  {"txid","verbose"} },
     { "blockchain",         "getmempoolentry",        &getmempoolentry,        {"txid"} },
@@ -39,6 +39,9 @@ UniValue ExtendedTxToUniv(CCustomCSView &view, const CTransaction& tx, bool incl
 /** Block description to JSON */
 UniValue blockToJSON(CCustomCSView &view, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, bool txDetails = false, int verbosity = 0) LOCKS_EXCLUDED(cs_main);
 
+/** Serialized block and the fields only the node can derive, for the Ocean indexer */
+std::vector<uint8_t> blockToOceanPayload(CCustomCSView &view, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex);
+
 /** Mempool information to JSON */
 UniValue MempoolInfoToJSON(const CTxMemPool& pool);
 
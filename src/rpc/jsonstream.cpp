@@ -0,0 +1,198 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/jsonstream.h>
+
+#include <rpc/protocol.h>
+#include <rpc/request.h>
+
+#include <cassert>
+
+JSONStreamWriter::JSONStreamWriter(Sink sink, size_t flushSize)
+    : sink(std::move(sink)),
+      flushSize(flushSize) {}
+
+void JSONStreamWriter::Separator() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (!containers.empty() && containers.back().second++ > 0) {
+        buffer += ',';
+    }
+}
+
+void JSONStreamWriter::MaybeFlush() {
+    if (buffer.size() >= flushSize) {
+        Flush();
+    }
+}
+
+void JSONStreamWriter::Flush() {
+    if (buffer.empty()) {
+        return;
+    }
+    written += buffer.size();
+    if (good) {
+        good = sink(buffer);
+    }
+    buffer.clear();
+}
+
+void JSONStreamWriter::Discard() {
+    buffer.clear();
+    containers.clear();
+    afterKey = false;
+    good = false;
+}
+
+void JSONStreamWriter::BeginObject() {
+    Separator();
+    buffer += '{';
+    containers.emplace_back('}', 0);
+}
+
+void JSONStreamWriter::BeginArray() {
+    Separator();
+    buffer += '[';
+    containers.emplace_back(']', 0);
+}
+
+void JSONStreamWriter::End() {
+    assert(!containers.empty());
+    if (afterKey) {
+        buffer += "null";
+        afterKey = false;
+    }
+    buffer += containers.back().first;
+    containers.pop_back();
+    MaybeFlush();
+}
+
+void JSONStreamWriter::EndAll(size_t depth) {
+    while (containers.size() > depth) {
+        End();
+    }
+}
+
+void JSONStreamWriter::Key(const std::string &key) {
+    assert(!containers.empty() && containers.back().first == '}' && !afterKey);
+    Separator();
+    buffer += UniValue(key).write();
+    buffer += ':';
+    afterKey = true;
+}
+
+void JSONStreamWriter::Value(const UniValue &value) {
+    Separator();
+    buffer += value.write();
+    MaybeFlush();
+}
+
+void JSONStreamWriter::KeyValue(const std::string &key, const UniValue &value) {
+    Key(key);
+    Value(value);
+}
+
+JSONRPCReplyStream::JSONRPCReplyStream(std::function<void()> start, JSONStreamWriter::Sink sink)
+    : start(std::move(start)),
+      sink(std::move(sink)) {}
+
+JSONStreamWriter &JSONRPCReplyStream::Result() {
+    if (!writer) {
+        start();
+        writer = std::make_unique<JSONStreamWriter>(sink);
+        // Same layout as JSONRPCReplyObj
+        writer->BeginObject();
+        writer->Key("result");
+    }
+    return *writer;
+}
+
+void JSONRPCReplyStream::Finish(const UniValue &id) {
+    assert(writer);
+    writer->EndAll(1);
+    writer->KeyValue("error", NullUniValue);
+    writer->KeyValue("id", id);
+    writer->End();
+    writer->Flush();
+    if (writer->Good()) {
+        sink("\n");
+    }
+}
+
+void JSONRPCReplyStream::Abort() {
+    assert(writer);
+    writer->Discard();
+}
+
+size_t JSONRPCReplyStream::Written() const {
+    return writer ? writer->Written() : 0;
+}
+
+RPCResultWriter::RPCResultWriter(const JSONRPCRequest &request, UniValue::VType type)
+    : stream(request.replyStream),
+      value(type) {}
+
+bool RPCResultWriter::Streaming() {
+    if (writer) {
+        if (!writer->Good()) {
+            throw JSONRPCError(RPC_MISC_ERROR, "Client disconnected");
+        }
+        return true;
+    }
+    if (!stream || count < RPC_STREAM_MIN_ITEMS) {
+        return false;
+    }
+    writer = &stream->Result();
+    if (value.isArray()) {
+        writer->BeginArray();
+        for (const auto &item : value.getValues()) {
+            writer->Value(item);
+        }
+    } else {
+        writer->BeginObject();
+        const auto &keys = value.getKeys();
+        const auto &values = value.getValues();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            writer->KeyValue(keys[i], values[i]);
+        }
+    }
+    value.clear();
+    return true;
+}
+
+void RPCResultWriter::push_back(const UniValue &item) {
+    if (Streaming()) {
+        writer->Value(item);
+    } else {
+        value.push_back(item);
+    }
+    ++count;
+}
+
+void RPCResultWriter::pushKV(const std::string &key, const UniValue &item) {
+    if (Streaming()) {
+        writer->KeyValue(key, item);
+    } else {
+        value.pushKV(key, item);
+    }
+    ++count;
+}
+
+void RPCResultWriter::pushKVs(const UniValue &obj) {
+    const auto &keys = obj.getKeys();
+    const auto &values = obj.getValues();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        pushKV(keys[i], values[i]);
+    }
+}
+
+UniValue RPCResultWriter::get() {
+    if (writer) {
+        writer->End();
+        return NullUniValue;
+    }
+    return value;
+}
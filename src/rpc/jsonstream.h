@@ -0,0 +1,114 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DEFI_RPC_JSONSTREAM_H
+#define DEFI_RPC_JSONSTREAM_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <univalue.h>
+
+class JSONRPCRequest;
+
+static const size_t JSON_STREAM_FLUSH_SIZE = 64 * 1024;
+// List results with fewer items are returned as a whole, so they can still be cached
+static const size_t RPC_STREAM_MIN_ITEMS = 1000;
+
+/**
+ * Writes a JSON document piece by piece as it is produced. Output is handed to the sink
+ * in chunks of about flushSize bytes, so only one chunk is held in memory at a time.
+ */
+class JSONStreamWriter {
+public:
+    // Returns false once the output can no longer be delivered
+    using Sink = std::function<bool(const std::string &)>;
+
+    explicit JSONStreamWriter(Sink sink, size_t flushSize = JSON_STREAM_FLUSH_SIZE);
+
+    void BeginObject();
+    void BeginArray();
+    // Closes the innermost object or array
+    void End();
+    // Closes objects and arrays until depth are left open
+    void EndAll(size_t depth = 0);
+    void Key(const std::string &key);
+    // Array element, or the value of the last key
+    void Value(const UniValue &value);
+    void KeyValue(const std::string &key, const UniValue &value);
+    void Flush();
+    // Drops the output not handed to the sink yet, nothing is written afterwards
+    void Discard();
+
+    size_t Depth() const { return containers.size(); }
+    size_t Written() const { return written; }
+    bool Good() const { return good; }
+
+private:
+    void Separator();
+    void MaybeFlush();
+
+    Sink sink;
+    const size_t flushSize;
+    std::string buffer;
+    // Closing character and number of items written so far per open container
+    std::vector<std::pair<char, size_t>> containers;
+    bool afterKey{};
+    bool good{true};
+    size_t written{};
+};
+
+/**
+ * A JSON-RPC reply written while the result is produced. The reply starts on the first
+ * call to Result, before that the handler can still return or throw as usual.
+ */
+class JSONRPCReplyStream {
+public:
+    JSONRPCReplyStream(std::function<void()> start, JSONStreamWriter::Sink sink);
+
+    // Starts the reply if needed and returns the writer to write the result value with
+    JSONStreamWriter &Result();
+    bool Started() const { return writer != nullptr; }
+    void Finish(const UniValue &id);
+    // Drops what was not written yet and leaves the reply incomplete, the error can't be told apart
+    // from a result once part of it was sent, so the transport has to end the reply as failed
+    void Abort();
+    size_t Written() const;
+
+private:
+    std::function<void()> start;
+    JSONStreamWriter::Sink sink;
+    std::unique_ptr<JSONStreamWriter> writer;
+};
+
+/**
+ * Collects the items of a list result into a UniValue. When the request is streamed and
+ * the list grows past RPC_STREAM_MIN_ITEMS, the items are written straight to the reply
+ * from then on. Return get() from the handler either way.
+ */
+class RPCResultWriter {
+public:
+    RPCResultWriter(const JSONRPCRequest &request, UniValue::VType type);
+
+    void push_back(const UniValue &value);
+    void pushKV(const std::string &key, const UniValue &value);
+    void pushKVs(const UniValue &obj);
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // The collected result, or null once it was streamed
+    UniValue get();
+
+private:
+    bool Streaming();
+
+    std::shared_ptr<JSONRPCReplyStream> stream;
+    JSONStreamWriter *writer{};
+    UniValue value;
+    size_t count{};
+};
+
+#endif  // DEFI_RPC_JSONSTREAM_H
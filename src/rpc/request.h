@@ -6,11 +6,14 @@
 #ifndef DEFI_RPC_REQUEST_H
 #define DEFI_RPC_REQUEST_H
 
+#include <memory>
 #include <string>
 #include <univalue.h>
 #include <dfi/coinselect.h>
 #include <util/system.h>
 
+class JSONRPCReplyStream;
+
 UniValue JSONRPCRequestObj(const std::string& strMethod, const UniValue& params, const UniValue& id);
 UniValue JSONRPCReplyObj(const UniValue& result, const UniValue& error, const UniValue& id);
 std::string JSONRPCReply(const UniValue& result, const UniValue& error, const UniValue& id);
@@ -70,6 +73,8 @@ public:
     std::string authUser;
     std::string peerAddr;
     RPCMetadata metadata;
+    // Set for single HTTP requests, lets large results be written while they are produced
+    std::shared_ptr<JSONRPCReplyStream> replyStream;
 
     JSONRPCRequest() : id(NullUniValue), params(NullUniValue), fHelp(false), metadata(RPCMetadata::CreateDefault()) {}
     void parse(const UniValue& valRequest);
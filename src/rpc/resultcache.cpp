@@ -1,62 +1,254 @@
 #include <rpc/resultcache.h>
+#include <rpc/jsonstream.h>
 #include <rpc/util.h>
 #include <logging.h>
+#include <util/time.h>
 #include <validation.h>
 
-void RPCResultCache::Init(RPCCacheMode mode) {
-    std::unique_lock l{aMutex};
-    this->mode = mode;
+#include <algorithm>
+#include <numeric>
+
+using MethodPolicy = RPCResultCache::MethodPolicy;
+using Policy = RPCResultCache::Policy;
+
+// Methods cached in smart mode. Everything else uses the default policy in all mode.
+static const std::map<std::string, MethodPolicy> &GetPolicies() {
+    static const std::map<std::string, MethodPolicy> policies{
+        {"getblockchaininfo",       {Policy::TTL, 1000}},
+        {"getburninfo",             {}},
+        {"getfixedintervalprice",   {}},
+        {"getgov",                  {}},
+        {"getloaninfo",             {}},
+        {"getoracledata",           {}},
+        {"getpoolpair",             {}},
+        {"getprice",                {}},
+        {"gettoken",                {}},
+        {"listcollateraltokens",    {}},
+        {"listfixedintervalprices", {}},
+        {"listgovs",                {}},
+        {"listlatestrawprices",     {}},
+        {"listloantokens",          {}},
+        {"listoracles",             {}},
+        {"listpoolpairs",           {}},
+        {"listprices",              {}},
+        {"listtokens",              {}},
+        {"getaccounthistory",       {Policy::Historical, 0, 1}},
+        {"listburnhistory",         {Policy::Historical, 0, 0, "maxBlockHeight"}},
+    };
+    return policies;
+}
+
+static const MethodPolicy *GetPolicy(const std::string &method) {
+    const auto &policies = GetPolicies();
+    if (auto it = policies.find(method); it != policies.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+static std::optional<int> GetHistoricalHeight(const MethodPolicy &policy, const UniValue &params) {
+    if (policy.policy != Policy::Historical || params.size() <= policy.heightParam) {
+        return {};
+    }
+    const auto &param = params[policy.heightParam];
+    const auto &height = policy.heightKey.empty() ? param : find_value(param, policy.heightKey);
+    if (!height.isNum()) {
+        return {};
+    }
+    const auto value = height.get_int64();
+    if (value < 0 || value > std::numeric_limits<int>::max()) {
+        return {};
+    }
+    return static_cast<int>(value);
+}
+
+// Object keys in sorted order, so that the same named options hit the same entry
+static void WriteNormalized(std::string &out, const UniValue &value) {
+    if (value.isObject()) {
+        const auto &keys = value.getKeys();
+        const auto &values = value.getValues();
+        std::vector<size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+        out += '{';
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (i) out += ',';
+            out += UniValue(keys[order[i]]).write();
+            out += ':';
+            WriteNormalized(out, values[order[i]]);
+        }
+        out += '}';
+    } else if (value.isArray()) {
+        out += '[';
+        for (size_t i = 0; i < value.size(); ++i) {
+            if (i) out += ',';
+            WriteNormalized(out, value[i]);
+        }
+        out += ']';
+    } else {
+        out += value.write();
+    }
 }
 
 std::string GetKey(const JSONRPCRequest &request) {
-    std::stringstream ss;
-    ss << request.strMethod << '/' << request.authUser << '/' << request.params.write();
-    return ss.str();
+    std::string key = request.strMethod + '/' + request.authUser + '/';
+    WriteNormalized(key, request.params);
+    return key;
 }
 
-bool RPCResultCache::InvalidateCaches() {
-    std::unique_lock l{aMutex};
-    auto height = GetLastValidatedHeight();
-    if (cacheHeight != height) {
-        LogPrint(BCLog::RPCCACHE, "RPCCache: clear\n");
-        if (cacheMap.size()) cacheMap.clear();
-        cacheHeight = height;
-        return true;
+// Last miss on this thread: the result Set after it is only stored if the tip is unchanged
+struct CacheMiss {
+    std::string key;
+    uint64_t generation{};
+};
+static thread_local std::optional<CacheMiss> t_lastMiss;
+
+void RPCResultCache::Init(RPCCacheMode mode, size_t maxBytes) {
+    this->mode = mode;
+    maxShardBytes = maxBytes / SHARDS;
+}
+
+RPCResultCache::Shard &RPCResultCache::GetShard(const std::string &key) {
+    return shards[std::hash<std::string>{}(key) % SHARDS];
+}
+
+void RPCResultCache::Erase(Shard &shard, std::list<Entry>::iterator it) {
+    shard.bytes -= it->bytes;
+    shard.index.erase(it->key);
+    shard.lru.erase(it);
+}
+
+bool RPCResultCache::SetTip(int height, const uint256 &hash) {
+    auto changed = false;
+    for (auto &shard : shards) {
+        std::unique_lock l{shard.aMutex};
+        if (shard.tipHeight == height && shard.tipHash == hash) {
+            continue;
+        }
+        changed = true;
+        ++shard.generation;
+        shard.tipHeight = height;
+        shard.tipHash = hash;
+        for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+            auto entry = it++;
+            if (!entry->historical || entry->height > height) {
+                Erase(shard, entry);
+            }
+        }
+    }
+    if (changed) {
+        LogPrint(BCLog::RPCCACHE, "RPCCache: clear: %d/%s\n", height, hash.ToString());
     }
-    return false;
+    return changed;
 }
 
 std::optional<UniValue> RPCResultCache::TryGet(const JSONRPCRequest &request) {
-    auto cacheMode = mode;
+    auto cacheMode = mode.load();
     if (cacheMode == RPCCacheMode::None) return {};
-    if (cacheMode == RPCCacheMode::Smart &&
-        smartModeList.find(request.strMethod) == smartModeList.end()) return {};
+    if (cacheMode == RPCCacheMode::Smart && !GetPolicy(request.strMethod)) return {};
     auto key = GetKey(request);
-    UniValue val;
+    auto &shard = GetShard(key);
+    std::shared_ptr<const UniValue> value;
+    int height{};
     {
-        std::unique_lock l{aMutex};
-        if (auto res = cacheMap.find(key); res != cacheMap.end()) {
-            if (LogAcceptCategory(BCLog::RPCCACHE)) {
-                LogPrint(BCLog::RPCCACHE, "RPCCache: hit: key: %d/%s, val: %s\n", cacheHeight, key, res->second.write());
+        std::unique_lock l{shard.aMutex};
+        auto &counters = shard.methods[request.strMethod];
+        if (auto res = shard.index.find(key); res != shard.index.end()) {
+            auto entry = res->second;
+            if (entry->expiry && entry->expiry <= GetTimeMillis()) {
+                ++shard.expired;
+                Erase(shard, entry);
+            } else {
+                shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+                value = entry->value;
             }
-            return res->second;
         }
+        height = shard.tipHeight;
+        if (value) {
+            ++counters.hits;
+        } else {
+            ++counters.misses;
+            t_lastMiss = CacheMiss{std::move(key), shard.generation};
+        }
+    }
+    if (!value) {
+        return {};
     }
-    return {};
+    if (LogAcceptCategory(BCLog::RPCCACHE)) {
+        LogPrint(BCLog::RPCCACHE, "RPCCache: hit: key: %d/%s, val: %s\n", height, key, value->write());
+    }
+    return *value;
 }
 
 const UniValue& RPCResultCache::Set(const JSONRPCRequest &request, const UniValue &value) {
+    auto cacheMode = mode.load();
+    if (cacheMode == RPCCacheMode::None) return value;
+    // Streamed results are not held anywhere
+    if (request.replyStream && request.replyStream->Started()) return value;
+    const auto policy = GetPolicy(request.strMethod);
+    if (cacheMode == RPCCacheMode::Smart && !policy) return value;
+
     auto key = GetKey(request);
+    auto miss = std::move(t_lastMiss);
+    t_lastMiss.reset();
+    if (!miss || miss->key != key) return value;
+
+    Entry entry;
+    entry.bytes = value.write().size() + key.size() + sizeof(Entry);
+    const auto maxBytes = maxShardBytes.load();
+    if (entry.bytes > maxBytes) return value;
+    entry.key = std::move(key);
+    entry.value = std::make_shared<const UniValue>(value);
+    const auto historicalHeight = policy ? GetHistoricalHeight(*policy, request.params) : std::nullopt;
+    if (policy && policy->policy == Policy::TTL) {
+        entry.expiry = GetTimeMillis() + policy->ttlMillis;
+    }
+
+    auto &shard = GetShard(entry.key);
     {
-        std::unique_lock l{aMutex};
+        std::unique_lock l{shard.aMutex};
+        if (shard.generation != miss->generation) return value;
+        if (historicalHeight && *historicalHeight <= shard.tipHeight) {
+            entry.historical = true;
+            entry.height = *historicalHeight;
+        } else {
+            entry.height = shard.tipHeight;
+        }
         if (LogAcceptCategory(BCLog::RPCCACHE)) {
-            LogPrint(BCLog::RPCCACHE, "RPCCache: set: key: %d/%s, val: %s\n", cacheHeight, key, value.write());
+            LogPrint(BCLog::RPCCACHE, "RPCCache: set: key: %d/%s, val: %s\n", shard.tipHeight, entry.key, value.write());
+        }
+        if (auto res = shard.index.find(entry.key); res != shard.index.end()) {
+            Erase(shard, res->second);
+        }
+        shard.bytes += entry.bytes;
+        shard.lru.push_front(std::move(entry));
+        shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+        while (shard.bytes > maxBytes) {
+            Erase(shard, std::prev(shard.lru.end()));
+            ++shard.evictions;
         }
-        cacheMap[key] = value;
     }
     return value;
 }
 
+RPCResultCache::Stats RPCResultCache::GetStats() {
+    Stats stats;
+    stats.maxBytes = maxShardBytes.load() * SHARDS;
+    for (auto &shard : shards) {
+        std::unique_lock l{shard.aMutex};
+        stats.entries += shard.index.size();
+        stats.bytes += shard.bytes;
+        stats.evictions += shard.evictions;
+        stats.expired += shard.expired;
+        for (const auto &[method, counters] : shard.methods) {
+            auto &total = stats.methods[method];
+            total.hits += counters.hits;
+            total.misses += counters.misses;
+        }
+    }
+    return stats;
+}
+
 // Note: We initialize all the globals in the init phase. So, it's safe. Otherwise,
 // static init is undefined behavior when multiple threads init them at the same time.
 RPCResultCache& GetRPCResultCache() {
@@ -71,50 +263,8 @@ int GetLastValidatedHeight() {
     return res;
 }
 
-void SetLastValidatedHeight(int height) {
+void SetLastValidatedHeight(int height, const uint256 &hash) {
     LogPrint(BCLog::RPCCACHE, "RPCCache: set height: %d\n", height);
     g_lastValidatedHeight.store(height, std::memory_order_release);
-    GetRPCResultCache().InvalidateCaches();
-}
-
-void MemoizedResultCache::Init(RPCResultCache::RPCCacheMode mode) {
-    std::unique_lock l{aMutex};
-    this->mode = mode;
-}
-
-CMemoizedResultValue MemoizedResultCache::GetOrDefault(const JSONRPCRequest &request) {
-    if (mode == RPCResultCache::RPCCacheMode::None) return {};
-    auto key = GetKey(request);
-    {
-        std::unique_lock l{aMutex};
-        if (auto res = cacheMap.find(key); res != cacheMap.end()) {
-            auto val = res->second;
-            if (!::ChainActive().Contains(LookupBlockIndex(val.hash)))
-                return {};
-
-            if (LogAcceptCategory(BCLog::RPCCACHE)) {
-                LogPrint(BCLog::RPCCACHE, "RPCCache: hit: key: %d/%s\n", val.height, key);
-            }
-            return val;
-        }
-    }
-    return {};
-}
-
-void MemoizedResultCache::Set(const JSONRPCRequest &request, const CMemoizedResultValue &value) {
-    auto key = GetKey(request);
-    {
-        std::unique_lock l{aMutex};
-        if (LogAcceptCategory(BCLog::RPCCACHE)) {
-            LogPrint(BCLog::RPCCACHE, "RPCCache: set: key: %d/%s\n", value.height, key);
-        }
-        cacheMap[key] = value;
-    }
-}
-
-// Note: We initialize all the globals in the init phase. So, it's safe. Otherwise,
-// static init is undefined behavior when multiple threads init them at the same time.
-MemoizedResultCache& GetMemoizedResultCache() {
-    static MemoizedResultCache g_memoizedResultCache;
-    return g_memoizedResultCache;
+    GetRPCResultCache().SetTip(height, hash);
 }
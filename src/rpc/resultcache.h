@@ -2,25 +2,28 @@
 #define DEFI_RPC_RESULTCACHE_H
 
 #include <atomic>
-#include <dfi/balances.h>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
 #include <rpc/request.h>
 #include <string>
 #include <set>
+#include <sync.h>
 #include <uint256.h>
 #include <univalue.h>
+#include <unordered_map>
 
-struct CGetBurnInfoResult {
-    CAmount burntDFI{};
-    CAmount burntFee{};
-    CAmount auctionFee{};
-    CBalances burntTokens;
-    CBalances dexfeeburn;
-    CBalances paybackFee;
-};
+static const int64_t DEFAULT_RPC_CACHE_SIZE = 128;  // MiB
 
+/**
+ * Caches RPC results per (method, auth user, normalized params) at the tip block.
+ *
+ * Entries live in shards picked by key hash, each with its own lock, LRU order and share
+ * of the -rpccachesize budget, sized by the serialized result. Entries of an earlier tip
+ * are dropped when the tip changes unless the method's policy keeps them. Smart mode
+ * only caches methods with a policy.
+ */
 class RPCResultCache {
 public:
     enum RPCCacheMode {
@@ -29,42 +32,83 @@ public:
         All
     };
 
-    void Init(RPCCacheMode mode);
+    enum class Policy {
+        // Valid until the tip changes
+        UntilNextBlock,
+        // Valid until the tip changes, at most ttlMillis
+        TTL,
+        // Valid across blocks when the request names a height at or below the tip,
+        // until that height is disconnected. Otherwise as UntilNextBlock.
+        Historical,
+    };
+
+    struct MethodPolicy {
+        Policy policy{Policy::UntilNextBlock};
+        int64_t ttlMillis{};
+        // Historical: positional param holding the height, or the options object holding heightKey
+        size_t heightParam{};
+        std::string heightKey{};
+    };
+
+    struct Counters {
+        uint64_t hits{};
+        uint64_t misses{};
+    };
+
+    struct Stats {
+        uint64_t entries{};
+        uint64_t bytes{};
+        uint64_t maxBytes{};
+        uint64_t evictions{};
+        uint64_t expired{};
+        std::map<std::string, Counters> methods;
+    };
+
+    static constexpr size_t SHARDS = 16;
+
+    void Init(RPCCacheMode mode, size_t maxBytes = DEFAULT_RPC_CACHE_SIZE << 20);
     std::optional<UniValue> TryGet(const JSONRPCRequest &request);
     const UniValue& Set(const JSONRPCRequest &request, const UniValue &value);
-    bool InvalidateCaches();
+    // Drops the entries no longer valid at the new tip, returns whether the tip changed
+    bool SetTip(int height, const uint256 &hash);
+    Stats GetStats();
 
 private:
-    AtomicMutex aMutex;
-    std::set<std::string> smartModeList{};
-    RPCCacheMode mode{RPCCacheMode::None};
-    std::map<std::string, UniValue> cacheMap{};
-    int cacheHeight{0};
-
-};
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const UniValue> value;
+        size_t bytes{};
+        // Height the entry stays valid from for Historical, otherwise the tip it was set at
+        int height{};
+        bool historical{};
+        int64_t expiry{};  // ms, 0 for none
+    };
 
-RPCResultCache& GetRPCResultCache();
+    struct Shard {
+        AtomicMutex aMutex;
+        std::list<Entry> lru;  // most recently used first
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        size_t bytes{};
+        int tipHeight{};
+        uint256 tipHash;
+        // Bumped on every tip change, a result is only stored if its miss saw the same one
+        uint64_t generation{};
+        uint64_t evictions{};
+        uint64_t expired{};
+        std::map<std::string, Counters> methods;
+    };
 
-int GetLastValidatedHeight();
-void SetLastValidatedHeight(int height);
+    Shard &GetShard(const std::string &key);
+    void Erase(Shard &shard, std::list<Entry>::iterator it);
 
-struct CMemoizedResultValue {
-    int height;
-    uint256 hash;
-    std::variant<CGetBurnInfoResult> data;
+    std::atomic<RPCCacheMode> mode{RPCCacheMode::None};
+    std::atomic<size_t> maxShardBytes{(DEFAULT_RPC_CACHE_SIZE << 20) / SHARDS};
+    Shard shards[SHARDS];
 };
 
-class MemoizedResultCache {
-public:
-    void Init(RPCResultCache::RPCCacheMode mode);
-    CMemoizedResultValue GetOrDefault(const JSONRPCRequest &request);
-    void Set(const JSONRPCRequest &request, const CMemoizedResultValue &value);
-private:
-    AtomicMutex aMutex;
-    std::map<std::string, CMemoizedResultValue> cacheMap{};
-    RPCResultCache::RPCCacheMode mode{RPCResultCache::RPCCacheMode::None};
-};
+RPCResultCache& GetRPCResultCache();
 
-MemoizedResultCache& GetMemoizedResultCache();
+int GetLastValidatedHeight();
+void SetLastValidatedHeight(int height, const uint256 &hash);
 
 #endif //DEFI_RPC_RESULTCACHE_H
@@ -5,7 +5,9 @@
 
 #include <rpc/server.h>
 
+#include <dfi/threadpool.h>
 #include <fs.h>
+#include <httpserver.h>
 #include <key_io.h>
 #include <rpc/util.h>
 #include <shutdown.h>
@@ -17,7 +19,10 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <condition_variable>
 #include <memory> // for unique_ptr
+#include <mutex>
+#include <set>
 #include <unordered_map>
 
 static CCriticalSection cs_rpcWarmup;
@@ -280,9 +285,24 @@ bool CRPCTable::removeCommand(const std::string& name, const CRPCCommand* pcmd)
     return false;
 }
 
+/** Runs the read-only calls of JSON-RPC batches */
+static std::mutex g_rpcBatchMutex;
+static std::condition_variable g_rpcBatchCv;
+static std::unique_ptr<TaskPool> g_rpcBatchPool;
+static int g_rpcBatchesRunning{0};
+/** Batch calls queued on or running in the pool, bounded by -rpcworkqueue */
+static std::atomic<int> g_rpcBatchCalls{0};
+static int g_rpcBatchMaxCalls{0};
+
 void StartRPC()
 {
     LogPrint(BCLog::RPC, "Starting RPC\n");
+    const auto batchThreads = gArgs.GetArg("-rpcbatchthreads", DEFAULT_RPC_BATCH_THREADS);
+    if (batchThreads > 0) {
+        std::lock_guard<std::mutex> lock(g_rpcBatchMutex);
+        g_rpcBatchPool = std::make_unique<TaskPool>(static_cast<size_t>(batchThreads));
+        g_rpcBatchMaxCalls = std::max<int>(gArgs.GetArg("-rpcworkqueue", DEFAULT_HTTP_WORKQUEUE), 1);
+    }
     g_rpc_running = true;
     g_rpcSignals.Started();
 }
@@ -297,6 +317,16 @@ void InterruptRPC()
 void StopRPC()
 {
     LogPrint(BCLog::RPC, "Stopping RPC\n");
+    std::unique_ptr<TaskPool> batchPool;
+    {
+        // Batches still running keep the pool until they are done, later ones run sequentially
+        std::unique_lock<std::mutex> lock(g_rpcBatchMutex);
+        g_rpcBatchCv.wait(lock, [] { return g_rpcBatchesRunning == 0; });
+        batchPool = std::move(g_rpcBatchPool);
+    }
+    if (batchPool) {
+        batchPool->Shutdown();
+    }
     deadlineTimers.clear();
     DeleteAuthCookie();
     g_rpcSignals.Stopped();
@@ -363,11 +393,81 @@ static UniValue JSONRPCExecOne(JSONRPCRequest jreq, const UniValue& req)
     return rpc_result;
 }
 
+// Calls without side effects, which can run in any order within a batch. They read
+// through their own snapshot or lock what they need, like calls on separate connections.
+static bool IsParallelBatchCall(const UniValue& req)
+{
+    static const std::set<std::string> methods{
+        "estimatecollateral", "estimateloan", "estimatevault",
+        "getaccount", "getaccounthistory", "getbestblockhash", "getblock", "getblockchaininfo",
+        "getblockcount", "getblockhash", "getblockheader", "getburninfo", "getcollateraltoken",
+        "getfixedintervalprice", "getgov", "getinterest", "getloaninfo", "getloanscheme",
+        "getloantoken", "getmasternode", "getmasternodeblocks", "getoracledata", "getpoolpair",
+        "getprice", "getrawtransaction", "gettoken", "gettokenbalances", "gettxout", "getvault",
+        "listaccounthistory", "listaccounts", "listauctions", "listburnhistory",
+        "listcollateraltokens", "listcommunitybalances", "listfixedintervalprices", "listgovs",
+        "listlatestrawprices", "listloanschemes", "listloantokens", "listmasternodes",
+        "listoracles", "listpoolpairs", "listpoolshares", "listprices", "listtokens", "listvaults",
+    };
+    if (!req.isObject()) {
+        return false;
+    }
+    const auto& method = find_value(req.get_obj(), "method");
+    return method.isStr() && methods.count(method.get_str());
+}
+
+std::vector<UniValue> JSONRPCExecBatchCalls(const UniValue& vReq, const std::function<UniValue(const UniValue&)>& execOne)
+{
+    std::vector<UniValue> results(vReq.size());
+    TaskPool* pool{};
+    {
+        std::lock_guard<std::mutex> lock(g_rpcBatchMutex);
+        if (g_rpcBatchPool) {
+            pool = g_rpcBatchPool.get();
+            ++g_rpcBatchesRunning;
+        }
+    }
+
+    TaskGroup group;
+    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++) {
+        if (!pool || !IsParallelBatchCall(vReq[reqIdx])) {
+            // Anything that may change state sees the effects of the calls before it
+            group.WaitForCompletion();
+            results[reqIdx] = execOne(vReq[reqIdx]);
+            continue;
+        }
+        if (g_rpcBatchCalls.fetch_add(1) >= g_rpcBatchMaxCalls) {
+            // The pool is busy, run it here rather than queue without bound
+            g_rpcBatchCalls.fetch_sub(1);
+            results[reqIdx] = execOne(vReq[reqIdx]);
+            continue;
+        }
+        group.AddTask();
+        boost::asio::post(pool->pool, [&, reqIdx] {
+            results[reqIdx] = execOne(vReq[reqIdx]);
+            g_rpcBatchCalls.fetch_sub(1);
+            group.RemoveTask();
+        });
+    }
+    group.WaitForCompletion();
+
+    if (pool) {
+        {
+            std::lock_guard<std::mutex> lock(g_rpcBatchMutex);
+            --g_rpcBatchesRunning;
+        }
+        g_rpcBatchCv.notify_all();
+    }
+    return results;
+}
+
 std::string JSONRPCExecBatch(const JSONRPCRequest& jreq, const UniValue& vReq)
 {
+    auto results = JSONRPCExecBatchCalls(vReq, [&](const UniValue& req) { return JSONRPCExecOne(jreq, req); });
+
     UniValue ret(UniValue::VARR);
-    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
-        ret.push_back(JSONRPCExecOne(jreq, vReq[reqIdx]));
+    for (auto& result : results)
+        ret.push_back(std::move(result));
 
     return ret.write() + "\n";
 }
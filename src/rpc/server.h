@@ -19,6 +19,7 @@
 #include <univalue.h>
 
 static const unsigned int DEFAULT_RPC_SERIALIZE_VERSION = 1;
+static const int DEFAULT_RPC_BATCH_THREADS = 4;
 
 class CRPCCommand;
 
@@ -167,7 +168,14 @@ extern CRPCTable tableRPC;
 void StartRPC();
 void InterruptRPC();
 void StopRPC();
+/**
+ * Executes the calls of a JSON-RPC batch, replies in request order. Consecutive read-only
+ * calls run concurrently on -rpcbatchthreads threads, any other call runs on its own
+ * after the calls before it.
+ */
 std::string JSONRPCExecBatch(const JSONRPCRequest& jreq, const UniValue& vReq);
+/** Runs the calls of a batch with execOne as JSONRPCExecBatch does, results are in request order */
+std::vector<UniValue> JSONRPCExecBatchCalls(const UniValue& vReq, const std::function<UniValue(const UniValue&)>& execOne);
 
 // Retrieves any serialization flags requested in command line argument
 int RPCSerializationFlags();
@@ -1,8 +1,12 @@
 #include <rpc/stats.h>
+#include <crypto/common.h>
+#include <rpc/resultcache.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
 
+#include <cmath>
 #include <fstream>
+#include <limits>
 
 bool CRPCStats::isActive() { return active.load(); }
 void CRPCStats::setActive(bool isActive) { active.store(isActive); }
@@ -26,7 +30,7 @@ void CRPCStats::save() {
     fs::path statsPath = GetDataDir() / DEFAULT_STATSFILE;
     std::ofstream file(statsPath);
 
-    file << toJSON().write() << '\n';
+    file << toJSON(true).write() << '\n';
     file.close();
 }
 
@@ -51,10 +55,180 @@ void CRPCStats::load() {
     file.close();
 }
 
-UniValue RPCStats::toJSON() {
+static const size_t STAT_HISTOGRAM_SUB_BUCKETS = 16;
+
+size_t StatHistogram::BucketIndex(int64_t value) {
+    if (value < static_cast<int64_t>(STAT_HISTOGRAM_SUB_BUCKETS)) {
+        return std::max<int64_t>(value, 0);
+    }
+    // Buckets of [2^e, 2^(e+1)) are 2^(e-4) wide
+    const auto exponent = CountBits(value) - 1;
+    return (exponent - 3) * STAT_HISTOGRAM_SUB_BUCKETS + ((value >> (exponent - 4)) & (STAT_HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+uint64_t StatHistogram::BucketLowest(size_t index) {
+    if (index < STAT_HISTOGRAM_SUB_BUCKETS) {
+        return index;
+    }
+    const auto exponent = index / STAT_HISTOGRAM_SUB_BUCKETS + 3;
+    return static_cast<uint64_t>(STAT_HISTOGRAM_SUB_BUCKETS + index % STAT_HISTOGRAM_SUB_BUCKETS) << (exponent - 4);
+}
+
+void StatHistogram::Add(int64_t value) {
+    const auto index = BucketIndex(value);
+    if (index >= buckets.size()) {
+        buckets.resize(index + 1);
+    }
+    ++buckets[index];
+    ++count;
+    max = std::max(max, value);
+}
+
+void StatHistogram::Merge(const StatHistogram& other) {
+    if (other.buckets.size() > buckets.size()) {
+        buckets.resize(other.buckets.size());
+    }
+    for (size_t i = 0; i < other.buckets.size(); ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    max = std::max(max, other.max);
+}
+
+int64_t StatHistogram::Percentile(double fraction) const {
+    if (!count) {
+        return 0;
+    }
+    const auto rank = std::max<uint64_t>(1, std::ceil(fraction * count));
+    uint64_t seen{0};
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min<uint64_t>(max, BucketLowest(i + 1) - 1);
+        }
+    }
+    return max;
+}
+
+UniValue StatHistogram::toJSON() const {
+    UniValue bucketsArr(UniValue::VARR);
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        if (buckets[i]) {
+            UniValue bucket(UniValue::VARR);
+            bucket.push_back(static_cast<uint64_t>(i));
+            bucket.push_back(buckets[i]);
+            bucketsArr.push_back(bucket);
+        }
+    }
+    UniValue histogram(UniValue::VOBJ);
+    histogram.pushKV("max", max);
+    histogram.pushKV("buckets", bucketsArr);
+    return histogram;
+}
+
+StatHistogram StatHistogram::fromJSON(const UniValue& json) {
+    StatHistogram histogram;
+    if (!json.isObject()) {
+        return histogram;
+    }
+    histogram.max = json["max"].get_int64();
+    for (const auto &bucket : json["buckets"].getValues()) {
+        const auto index = bucket[0].get_int64();
+        const auto count = bucket[1].get_int64();
+        if (index < 0 || count < 0 || static_cast<size_t>(index) > BucketIndex(std::numeric_limits<int64_t>::max())) {
+            continue;
+        }
+        if (static_cast<size_t>(index) >= histogram.buckets.size()) {
+            histogram.buckets.resize(index + 1);
+        }
+        histogram.buckets[index] += count;
+        histogram.count += count;
+    }
+    return histogram;
+}
+
+void RPCStatHistograms::Add(int64_t latency, int64_t payload, int64_t queueTime, int64_t lockWait) {
+    this->latency.Add(latency);
+    this->payload.Add(payload);
+    this->queueTime.Add(queueTime);
+    this->lockWait.Add(lockWait);
+    execution.Add(std::max<int64_t>(latency - lockWait, 0));
+}
+
+void RPCStatHistograms::Merge(const RPCStatHistograms& other) {
+    latency.Merge(other.latency);
+    payload.Merge(other.payload);
+    queueTime.Merge(other.queueTime);
+    lockWait.Merge(other.lockWait);
+    execution.Merge(other.execution);
+}
+
+static UniValue PercentilesToJSON(const StatHistogram& histogram, double scale) {
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("p50", histogram.Percentile(0.5) / scale);
+    obj.pushKV("p90", histogram.Percentile(0.9) / scale);
+    obj.pushKV("p99", histogram.Percentile(0.99) / scale);
+    obj.pushKV("p999", histogram.Percentile(0.999) / scale);
+    return obj;
+}
+
+UniValue RPCStatHistograms::percentilesJSON() const {
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("latency", PercentilesToJSON(latency, 1000));
+    obj.pushKV("payload", PercentilesToJSON(payload, 1));
+    obj.pushKV("queueTime", PercentilesToJSON(queueTime, 1000));
+    obj.pushKV("lockWait", PercentilesToJSON(lockWait, 1000));
+    obj.pushKV("execution", PercentilesToJSON(execution, 1000));
+    return obj;
+}
+
+UniValue RPCStatHistograms::toJSON() const {
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("latency", latency.toJSON());
+    obj.pushKV("payload", payload.toJSON());
+    obj.pushKV("queueTime", queueTime.toJSON());
+    obj.pushKV("lockWait", lockWait.toJSON());
+    obj.pushKV("execution", execution.toJSON());
+    return obj;
+}
+
+RPCStatHistograms RPCStatHistograms::fromJSON(const UniValue& json) {
+    RPCStatHistograms histograms;
+    histograms.latency = StatHistogram::fromJSON(json["latency"]);
+    histograms.payload = StatHistogram::fromJSON(json["payload"]);
+    histograms.queueTime = StatHistogram::fromJSON(json["queueTime"]);
+    histograms.lockWait = StatHistogram::fromJSON(json["lockWait"]);
+    histograms.execution = StatHistogram::fromJSON(json["execution"]);
+    return histograms;
+}
+
+void RPCStats::addHistograms(int64_t latency, int64_t payload, int64_t queueTime, int64_t lockWait, int64_t now) {
+    histograms.Add(latency, payload, queueTime, lockWait);
+
+    const auto slotStart = now - now % RPC_STATS_WINDOW_SLOT_SECONDS;
+    auto &slot = window[(now / RPC_STATS_WINDOW_SLOT_SECONDS) % RPC_STATS_WINDOW_SLOTS];
+    if (slot.start != slotStart) {
+        slot = {slotStart, {}};
+    }
+    slot.histograms.Add(latency, payload, queueTime, lockWait);
+}
+
+RPCStatHistograms RPCStats::windowHistograms(int64_t now) const {
+    RPCStatHistograms merged;
+    for (const auto &slot : window) {
+        if (slot.start > now - RPC_STATS_WINDOW_SLOTS * RPC_STATS_WINDOW_SLOT_SECONDS) {
+            merged.Merge(slot.histograms);
+        }
+    }
+    return merged;
+}
+
+UniValue RPCStats::toJSON(bool persist) {
     UniValue stats(UniValue::VOBJ),
              latencyObj(UniValue::VOBJ),
              payloadObj(UniValue::VOBJ),
+             queueTimeObj(UniValue::VOBJ),
+             windowObj(UniValue::VOBJ),
              historyArr(UniValue::VARR);
 
     latencyObj.pushKV("min", latency.min);
@@ -65,6 +239,15 @@ UniValue RPCStats::toJSON() {
     payloadObj.pushKV("avg", payload.avg);
     payloadObj.pushKV("max", payload.max);
 
+    queueTimeObj.pushKV("min", queueTime.min);
+    queueTimeObj.pushKV("avg", queueTime.avg);
+    queueTimeObj.pushKV("max", queueTime.max);
+
+    const auto windowStats = windowHistograms(GetSystemTimeInSeconds());
+    windowObj.pushKV("seconds", RPC_STATS_WINDOW_SLOTS * RPC_STATS_WINDOW_SLOT_SECONDS);
+    windowObj.pushKV("count", windowStats.latency.Count());
+    windowObj.pushKVs(windowStats.percentilesJSON());
+
     for (auto const &entry : history) {
         UniValue historyObj(UniValue::VOBJ);
         historyObj.pushKV("timestamp", entry.timestamp);
@@ -78,7 +261,24 @@ UniValue RPCStats::toJSON() {
     stats.pushKV("lastUsedTime", lastUsedTime);
     stats.pushKV("latency", latencyObj);
     stats.pushKV("payload", payloadObj);
+    stats.pushKV("queueTime", queueTimeObj);
+    stats.pushKV("percentiles", histograms.percentilesJSON());
+    stats.pushKV("window", windowObj);
     stats.pushKV("history", historyArr);
+
+    if (persist) {
+        UniValue windowArr(UniValue::VARR);
+        for (const auto &slot : window) {
+            if (slot.histograms.latency.Count()) {
+                UniValue slotObj(UniValue::VOBJ);
+                slotObj.pushKV("start", slot.start);
+                slotObj.pushKV("histograms", slot.histograms.toJSON());
+                windowArr.push_back(slotObj);
+            }
+        }
+        stats.pushKV("histograms", histograms.toJSON());
+        stats.pushKV("windowHistograms", windowArr);
+    }
     return stats;
 }
 
@@ -106,6 +306,15 @@ RPCStats RPCStats::fromJSON(UniValue json) {
         };
     }
 
+    if (!json["queueTime"].isNull()) {
+        auto queueTimeObj  = json["queueTime"].get_obj();
+        stats.queueTime = {
+            queueTimeObj["min"].get_int64(),
+            queueTimeObj["avg"].get_int64(),
+            queueTimeObj["max"].get_int64()
+        };
+    }
+
     if (!json["history"].isNull()) {
         auto historyArr = json["history"].get_array();
         for (const auto &entry : historyArr.getValues()) {
@@ -118,40 +327,63 @@ RPCStats RPCStats::fromJSON(UniValue json) {
             stats.history.push_back(historyEntry);
         }
     }
+
+    if (!json["histograms"].isNull()) {
+        stats.histograms = RPCStatHistograms::fromJSON(json["histograms"]);
+    }
+
+    if (!json["windowHistograms"].isNull()) {
+        for (const auto &slotObj : json["windowHistograms"].getValues()) {
+            const auto start = slotObj["start"].get_int64();
+            stats.window[(start / RPC_STATS_WINDOW_SLOT_SECONDS) % RPC_STATS_WINDOW_SLOTS] = {
+                start,
+                RPCStatHistograms::fromJSON(slotObj["histograms"])
+            };
+        }
+    }
     return stats;
 }
 
-void CRPCStats::add(const std::string& name, const int64_t latency, const int64_t payload)
+void CRPCStats::add(const std::string& name, const int64_t latency, const int64_t payload, const int64_t queueTime, const int64_t lockWait)
 {
-    auto stats = CRPCStats::get(name);
-    if (stats) {
-        stats->count++;
-        stats->lastUsedTime = GetSystemTimeInSeconds();
-        stats->latency = {
-            std::min(latency, stats->latency.min),
-            stats->latency.avg + (latency - stats->latency.avg) / stats->count,
-            std::max(latency, stats->latency.max)
+    const auto latencyMillis = latency / 1000;
+    const auto queueTimeMillis = queueTime / 1000;
+
+    std::unique_lock lock(lock_stats);
+    auto it = map.find(name);
+    if (it != map.end()) {
+        auto &stats = it->second;
+        stats.count++;
+        stats.lastUsedTime = GetSystemTimeInSeconds();
+        stats.latency = {
+            std::min(latencyMillis, stats.latency.min),
+            stats.latency.avg + (latencyMillis - stats.latency.avg) / stats.count,
+            std::max(latencyMillis, stats.latency.max)
+        };
+        stats.payload = {
+            std::min(payload, stats.payload.min),
+            stats.payload.avg + (payload - stats.payload.avg) / stats.count,
+            std::max(payload, stats.payload.max)
         };
-        stats->payload = {
-            std::min(payload, stats->payload.min),
-            stats->payload.avg + (payload - stats->payload.avg) / stats->count,
-            std::max(payload, stats->payload.max)
+        stats.queueTime = {
+            std::min(queueTimeMillis, stats.queueTime.min),
+            stats.queueTime.avg + (queueTimeMillis - stats.queueTime.avg) / stats.count,
+            std::max(queueTimeMillis, stats.queueTime.max)
         };
     } else {
-        stats = { name, latency, payload };
+        it = map.emplace(name, RPCStats{ name, latencyMillis, payload, queueTimeMillis }).first;
     }
-    stats->history.push_back({ stats->lastUsedTime, latency, payload });
-
-    std::unique_lock lock(lock_stats);
-    map[name] = *stats;
+    auto &stats = it->second;
+    stats.history.push_back({ stats.lastUsedTime, latencyMillis, payload });
+    stats.addHistograms(latency, payload, queueTime, lockWait, stats.lastUsedTime);
 }
 
-UniValue CRPCStats::toJSON() {
+UniValue CRPCStats::toJSON(bool persist) {
     auto map = CRPCStats::getMap();
 
     UniValue ret(UniValue::VARR);
     for (auto &[_, stats] : map) {
-        ret.push_back(stats.toJSON());
+        ret.push_back(stats.toJSON(persist));
     }
     return ret;
 }
@@ -168,6 +400,10 @@ static UniValue getrpcstats(const JSONRPCRequest& request)
             "  \"name\":               (string) The RPC command name.\n"
             "  \"latency\":            (json object) Min, max and average latency.\n"
             "  \"payload\":            (json object) Min, max and average payload size in bytes.\n"
+            "  \"queueTime\":          (json object) Min, max and average time waited in the HTTP work queue in milliseconds.\n"
+            "  \"percentiles\":        (json object) p50, p90, p99 and p999 of latency, payload, queueTime, lockWait and execution.\n"
+            "                        Times in milliseconds, lockWait is spent waiting for cs_main, other locks and snapshots.\n"
+            "  \"window\":             (json object) The same percentiles and count of calls within the last seconds.\n"
             "  \"count\":              (numeric) The number of times this command as been used.\n"
             "  \"lastUsedTime\":       (numeric) Last used time as timestamp.\n"
             "  \"history\":            (json array) History of last 5 RPC calls.\n"
@@ -209,6 +445,10 @@ static UniValue listrpcstats(const JSONRPCRequest& request)
             "  \"name\":               (string) The RPC command name.\n"
             "  \"latency\":            (json object) Min, max and average latency.\n"
             "  \"payload\":            (json object) Min, max and average payload size in bytes.\n"
+            "  \"queueTime\":          (json object) Min, max and average time waited in the HTTP work queue in milliseconds.\n"
+            "  \"percentiles\":        (json object) p50, p90, p99 and p999 of latency, payload, queueTime, lockWait and execution.\n"
+            "                        Times in milliseconds, lockWait is spent waiting for cs_main, other locks and snapshots.\n"
+            "  \"window\":             (json object) The same percentiles and count of calls within the last seconds.\n"
             "  \"count\":              (numeric) The number of times this command as been used.\n"
             "  \"lastUsedTime\":       (numeric) Last used time as timestamp.\n"
             "  \"history\":            (json array) History of last 5 RPC calls.\n"
@@ -235,12 +475,60 @@ static UniValue listrpcstats(const JSONRPCRequest& request)
     return statsRPC.toJSON();
 }
 
+static UniValue getrpccacheinfo(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"getrpccacheinfo",
+        "\nGet RPC result cache usage and hit counts per command.\n",
+        {},
+        RPCResult{
+            " {\n"
+            "  \"entries\":            (numeric) The number of cached results.\n"
+            "  \"bytes\":              (numeric) Estimated size of cached results in bytes.\n"
+            "  \"maxbytes\":           (numeric) The -rpccachesize budget in bytes.\n"
+            "  \"evictions\":          (numeric) Results dropped to stay within the budget.\n"
+            "  \"expired\":            (numeric) Results dropped when their time to live ran out.\n"
+            "  \"commands\":           (json object) Per command hits and misses.\n"
+            "  {\n"
+            "       \"command\": {\n"
+            "           \"hits\":   (numeric)\n"
+            "           \"misses\": (numeric)\n"
+            "       }\n"
+            "  }\n"
+            "}"
+        },
+        RPCExamples{
+            HelpExampleCli("getrpccacheinfo", "") +
+            HelpExampleRpc("getrpccacheinfo", "")
+        },
+    }.Check(request);
+
+    const auto stats = GetRPCResultCache().GetStats();
+
+    UniValue commands(UniValue::VOBJ);
+    for (const auto &[method, counters] : stats.methods) {
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("hits", counters.hits);
+        obj.pushKV("misses", counters.misses);
+        commands.pushKV(method, obj);
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("entries", stats.entries);
+    ret.pushKV("bytes", stats.bytes);
+    ret.pushKV("maxbytes", stats.maxBytes);
+    ret.pushKV("evictions", stats.evictions);
+    ret.pushKV("expired", stats.expired);
+    ret.pushKV("commands", commands);
+    return ret;
+}
+
 // clang-format off
 static const CRPCCommand commands[] =
 { //  category              name                      actor (function)         argNames
   //  --------------------- ------------------------  -----------------------  ----------
     { "stats",              "getrpcstats",            &getrpcstats,            {"command"} },
     { "stats",              "listrpcstats",           &listrpcstats,           {} },
+    { "stats",              "getrpccacheinfo",        &getrpccacheinfo,        {} },
 };
 // clang-format on
 
@@ -1,16 +1,20 @@
 #ifndef DEFI_RPC_STATS_H
 #define DEFI_RPC_STATS_H
 
+#include <array>
 #include <map>
 #include <stdint.h>
 #include <univalue.h>
 #include <util/time.h>
 #include <util/system.h>
 #include <optional>
+#include <vector>
 #include <boost/circular_buffer.hpp>
 
 const char * const DEFAULT_STATSFILE = "stats.log";
 static const uint8_t RPC_STATS_HISTORY_SIZE = 5;
+static const uint8_t RPC_STATS_WINDOW_SLOTS = 5;
+static const int64_t RPC_STATS_WINDOW_SLOT_SECONDS = 60;
 const bool DEFAULT_RPC_STATS = true;
 
 struct MinMaxStatEntry {
@@ -23,6 +27,53 @@ struct MinMaxStatEntry {
     MinMaxStatEntry(int64_t min, int64_t avg, int64_t max) : min(min), avg(avg), max(max) {};
 };
 
+/**
+ * Log-linear histogram of non-negative values in the manner of HdrHistogram: each power
+ * of two is split into 16 buckets, so percentiles are within 6.25% of the recorded values.
+ */
+class StatHistogram {
+    std::vector<uint64_t> buckets;  // grown up to the highest bucket recorded
+    uint64_t count{0};
+    int64_t max{0};
+
+    static size_t BucketIndex(int64_t value);
+    static uint64_t BucketLowest(size_t index);
+
+public:
+    void Add(int64_t value);
+    void Merge(const StatHistogram& other);
+    uint64_t Count() const { return count; }
+    // Highest value of the bucket holding the given fraction of values, at most the maximum
+    int64_t Percentile(double fraction) const;
+
+    // Non-empty buckets as [index, count] pairs
+    UniValue toJSON() const;
+    static StatHistogram fromJSON(const UniValue& json);
+};
+
+/** Histograms of latency, payload and the phases of an RPC call */
+struct RPCStatHistograms {
+    StatHistogram latency;    // microseconds
+    StatHistogram payload;    // bytes
+    StatHistogram queueTime;  // microseconds waited in the HTTP work queue
+    StatHistogram lockWait;   // microseconds waited for cs_main, other locks and snapshots
+    StatHistogram execution;  // microseconds of latency without lock wait
+
+    void Add(int64_t latency, int64_t payload, int64_t queueTime, int64_t lockWait);
+    void Merge(const RPCStatHistograms& other);
+
+    // p50, p90, p99 and p999 of each, times in milliseconds
+    UniValue percentilesJSON() const;
+    UniValue toJSON() const;
+    static RPCStatHistograms fromJSON(const UniValue& json);
+};
+
+/** Histograms of the calls that started within a slot of the rolling window */
+struct StatWindowSlot {
+    int64_t start{0};
+    RPCStatHistograms histograms;
+};
+
 struct StatHistoryEntry {
     int64_t timestamp;
     int64_t latency;
@@ -34,18 +85,27 @@ struct RPCStats {
     int64_t lastUsedTime;
     MinMaxStatEntry latency;
     MinMaxStatEntry payload;
+    MinMaxStatEntry queueTime{0};  // time spent in the HTTP work queue
     int64_t count;
     boost::circular_buffer<StatHistoryEntry> history;
+    RPCStatHistograms histograms;
+    std::array<StatWindowSlot, RPC_STATS_WINDOW_SLOTS> window;
 
     RPCStats() : history(RPC_STATS_HISTORY_SIZE) {}
 
-    RPCStats(const std::string& name, int64_t latency, int64_t payload) : 
-        name(name), latency(latency), payload(payload), history(RPC_STATS_HISTORY_SIZE) {
+    RPCStats(const std::string& name, int64_t latency, int64_t payload, int64_t queueTime) :
+        name(name), latency(latency), payload(payload), queueTime(queueTime), history(RPC_STATS_HISTORY_SIZE) {
             lastUsedTime = GetSystemTimeInSeconds();
             count = 1;
     };
 
-    UniValue toJSON();
+    // Latency, queue time and lock wait in microseconds
+    void addHistograms(int64_t latency, int64_t payload, int64_t queueTime, int64_t lockWait, int64_t now);
+    // Histograms of the slots within the rolling window ending at now
+    RPCStatHistograms windowHistograms(int64_t now) const;
+
+    // With persist, the histogram buckets are included to be read back by fromJSON
+    UniValue toJSON(bool persist = false);
     static RPCStats fromJSON(UniValue json);
 };
 
@@ -62,10 +122,11 @@ private:
 public:
     bool isActive();
     void setActive(bool isActive);
-    void add(const std::string& name, const int64_t latency, const int64_t payload);
+    // Latency, queue time and lock wait in microseconds
+    void add(const std::string& name, const int64_t latency, const int64_t payload, const int64_t queueTime = 0, const int64_t lockWait = 0);
     std::optional<RPCStats> get(const std::string& name);
     std::map<std::string, RPCStats> getMap();
-    UniValue toJSON();
+    UniValue toJSON(bool persist = false);
     void save();
     void load();
 };
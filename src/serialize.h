@@ -24,6 +24,8 @@
 #include <prevector.h>
 #include <span.h>
 
+#include <boost/container/flat_map.hpp>
+
 #include <variant>
 
 static const unsigned int MAX_DESER_SIZE = 0x08000000;    // 128M (for submit 64M block via rpc!), old value 32M (0x02000000)
@@ -600,6 +602,12 @@ template<typename Stream, typename K, typename T> void Unserialize(Stream& is, s
 template<typename Stream, typename K, typename T, typename Pred, typename A> void Serialize(Stream& os, const std::map<K, T, Pred, A>& m);
 template<typename Stream, typename K, typename T, typename Pred, typename A> void Unserialize(Stream& is, std::map<K, T, Pred, A>& m);
 
+/**
+ * flat_map, same format as map
+ */
+template<typename Stream, typename K, typename T, typename Pred, typename A> void Serialize(Stream& os, const boost::container::flat_map<K, T, Pred, A>& m);
+template<typename Stream, typename K, typename T, typename Pred, typename A> void Unserialize(Stream& is, boost::container::flat_map<K, T, Pred, A>& m);
+
 /**
  * set
  */
@@ -865,6 +873,50 @@ void Unserialize(Stream& is, std::map<K, T, Pred, A>& m)
 
 
 
+/**
+ * flat_map
+ */
+template<typename Stream, typename K, typename T, typename Pred, typename A>
+void Serialize(Stream& os, const boost::container::flat_map<K, T, Pred, A>& m)
+{
+    WriteCompactSize(os, m.size());
+    for (const auto& entry : m)
+        Serialize(os, entry);
+}
+
+/**
+ * Adopts entries in stream order, sorting them only when they are not already
+ * in canonical order. Keeps the first of duplicate keys, like map.
+ */
+template<typename K, typename T, typename Pred, typename A>
+void AdoptFlatMapSequence(boost::container::flat_map<K, T, Pred, A>& m, typename boost::container::flat_map<K, T, Pred, A>::sequence_type&& seq)
+{
+    const auto comp = m.key_comp();
+    const auto notLess = [&](const auto& a, const auto& b) { return !comp(a.first, b.first); };
+    if (std::adjacent_find(seq.begin(), seq.end(), notLess) != seq.end()) {
+        std::stable_sort(seq.begin(), seq.end(), [&](const auto& a, const auto& b) { return comp(a.first, b.first); });
+        seq.erase(std::unique(seq.begin(), seq.end(), notLess), seq.end());
+    }
+    m.adopt_sequence(boost::container::ordered_unique_range, std::move(seq));
+}
+
+template<typename Stream, typename K, typename T, typename Pred, typename A>
+void Unserialize(Stream& is, boost::container::flat_map<K, T, Pred, A>& m)
+{
+    m.clear();
+    auto seq = m.extract_sequence();
+    unsigned int nSize = ReadCompactSize(is);
+    for (unsigned int i = 0; i < nSize; i++)
+    {
+        std::pair<K, T> item;
+        Unserialize(is, item);
+        seq.push_back(std::move(item));
+    }
+    AdoptFlatMapSequence(m, std::move(seq));
+}
+
+
+
 /**
  * set
  */
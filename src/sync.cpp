@@ -215,3 +215,33 @@ void DeleteLock(void* cs)
 bool g_debug_lockorder_abort = true;
 
 #endif /* DEBUG_LOCKORDER */
+
+static thread_local LockWaitScope* g_lock_wait_scope{nullptr};
+
+LockWaitScope::LockWaitScope() : outer(g_lock_wait_scope)
+{
+    g_lock_wait_scope = this;
+}
+
+LockWaitScope::~LockWaitScope()
+{
+    g_lock_wait_scope = outer;
+    if (outer)
+        outer->micros += micros;
+}
+
+bool LockWaitScope::Active()
+{
+    return g_lock_wait_scope != nullptr;
+}
+
+void LockWaitScope::Add(int64_t micros)
+{
+    if (g_lock_wait_scope)
+        g_lock_wait_scope->micros += micros;
+}
+
+int64_t LockWaitScope::Waited()
+{
+    return g_lock_wait_scope ? g_lock_wait_scope->micros : 0;
+}
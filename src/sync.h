@@ -106,6 +106,48 @@ using CCriticalSection = RecursiveMutex;
 /** Wrapped mutex: supports waiting but not recursive locking */
 using Mutex = AnnotatedMixin<std::mutex>;
 
+/**
+ * Adds up the time the current thread blocks in contended LOCKs while in scope, which
+ * RPC stats report as lock wait. A nested scope also adds its time to the outer one.
+ */
+class LockWaitScope
+{
+public:
+    LockWaitScope();
+    ~LockWaitScope();
+
+    LockWaitScope(const LockWaitScope&) = delete;
+    LockWaitScope& operator=(const LockWaitScope&) = delete;
+
+    int64_t Micros() const { return micros; }
+
+    /** Whether the current thread is in a scope */
+    static bool Active();
+    /** Adds to the innermost scope of the current thread, if any */
+    static void Add(int64_t micros);
+    /** Time added to the innermost scope of the current thread so far */
+    static int64_t Waited();
+
+private:
+    int64_t micros{0};
+    LockWaitScope* outer;
+};
+
+/** Locks a std::unique_lock style lock, timing the wait if it's contended */
+template <typename Lock>
+void LockTrackingWait(Lock& lock)
+{
+    if (lock.try_lock())
+        return;
+    if (!LockWaitScope::Active()) {
+        lock.lock();
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    LockWaitScope::Add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
 #ifdef DEBUG_LOCKCONTENTION
 
 #define AssertLockHeld(cs) AssertLockHeldInternal(#cs, __FILE__, __LINE__, &cs)
@@ -123,7 +165,7 @@ private:
         EnterCritical(pszName, pszFile, nLine, (void*)(Base::mutex()));
         if (!Base::try_lock()) {
             PrintLockContention(pszName, pszFile, nLine);
-            Base::lock();
+            LockTrackingWait(static_cast<Base&>(*this));
         }
     }
 
@@ -198,7 +240,15 @@ using DebugLock = UniqueLock<typename std::remove_reference<typename std::remove
 template<typename T>
 using unique_lock_type = typename std::decay<T>::type::UniqueLock;
 
-#define LOCK(cs) unique_lock_type<decltype(cs)> criticalblock1(cs)
+template <typename MutexArg>
+unique_lock_type<MutexArg> LockTracked(MutexArg& cs)
+{
+    unique_lock_type<MutexArg> lock(cs, std::defer_lock);
+    LockTrackingWait(lock);
+    return lock;
+}
+
+#define LOCK(cs) unique_lock_type<decltype(cs)> criticalblock1(LockTracked(cs))
 #define LOCK2(cs1, cs2)                                                   \
     unique_lock_type<decltype(cs1)> criticalblock1(cs1, std::defer_lock); \
     unique_lock_type<decltype(cs2)> criticalblock2(cs2, std::defer_lock); \
@@ -0,0 +1,157 @@
+#include <test/setup_common.h>
+
+#include <dfi/accountshistory.h>
+#include <dfi/historywriter.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(accountshistory_tests, TestingSetup)
+
+using HistoryKeys = std::vector<std::pair<uint32_t, uint32_t>>;
+
+static void WriteHistory(CAccountsHistoryView &view,
+                         const CScript &owner,
+                         uint32_t height,
+                         uint32_t txn,
+                         CustomTxType type,
+                         TAmounts diff) {
+    view.WriteAccountHistory({owner, height, txn}, {uint256{}, static_cast<unsigned char>(type), std::move(diff)});
+}
+
+BOOST_AUTO_TEST_CASE(secondary_indexes)
+{
+    CAccountHistoryStorage view(GetDataDir() / "history_indexes", 1 << 20, true, true);
+    view.SetSecondaryIndexes(true);
+    BOOST_CHECK(view.HasSecondaryIndexes());
+
+    const CScript alice = CScript() << OP_TRUE;
+    const CScript bob = CScript() << OP_FALSE;
+    WriteHistory(view, alice, 10, 1, CustomTxType::PoolSwap, {{DCT_ID{0}, -COIN}, {DCT_ID{1}, COIN}});
+    WriteHistory(view, bob, 10, 2, CustomTxType::AccountToAccount, {{DCT_ID{1}, -COIN}});
+    WriteHistory(view, alice, 11, 0, CustomTxType::AccountToAccount, {{DCT_ID{0}, COIN}});
+    WriteHistory(view, bob, 12, 3, CustomTxType::AddPoolLiquidity, {{DCT_ID{1}, -COIN}});
+    view.Flush();
+
+    HistoryKeys keys;
+    auto collect = [&](const AccountHistoryKey &key, AccountHistoryValue) {
+        keys.emplace_back(key.blockHeight, key.txn);
+        return true;
+    };
+
+    view.ForEachAccountHistoryByToken(collect, DCT_ID{1});
+    BOOST_CHECK(keys == HistoryKeys({{12, 3}, {10, 2}, {10, 1}}));
+
+    keys.clear();
+    view.ForEachAccountHistoryByToken(collect, DCT_ID{1}, bob, 11);
+    BOOST_CHECK(keys == HistoryKeys({{10, 2}}));
+
+    // types are merged back into height order
+    keys.clear();
+    view.ForEachAccountHistoryByType(collect,
+                                     {static_cast<unsigned char>(CustomTxType::PoolSwap),
+                                      static_cast<unsigned char>(CustomTxType::AccountToAccount)});
+    BOOST_CHECK(keys == HistoryKeys({{11, 0}, {10, 2}, {10, 1}}));
+
+    view.EraseAccountHistoryHeight(10);
+    view.Flush();
+    keys.clear();
+    view.ForEachAccountHistoryByToken(collect, DCT_ID{1});
+    BOOST_CHECK(keys == HistoryKeys({{12, 3}}));
+
+    view.SetSecondaryIndexes(false);
+    BOOST_CHECK(!view.HasSecondaryIndexes());
+    keys.clear();
+    view.ForEachAccountHistoryByToken(collect, DCT_ID{0});
+    BOOST_CHECK(keys.empty());
+}
+
+BOOST_AUTO_TEST_CASE(overwritten_record_indexes)
+{
+    CAccountHistoryStorage view(GetDataDir() / "history_overwritten", 1 << 20, true, true);
+    view.SetSecondaryIndexes(true);
+
+    const CScript alice = CScript() << OP_TRUE;
+    const auto swap = static_cast<unsigned char>(CustomTxType::PoolSwap);
+    const auto transfer = static_cast<unsigned char>(CustomTxType::AccountToAccount);
+    HistoryKeys keys;
+    auto collect = [&](const AccountHistoryKey &key, AccountHistoryValue) {
+        keys.emplace_back(key.blockHeight, key.txn);
+        return true;
+    };
+    auto byToken = [&](uint32_t tokenId) {
+        keys.clear();
+        view.ForEachAccountHistoryByToken(collect, DCT_ID{tokenId});
+        return keys;
+    };
+    auto byType = [&](unsigned char category) {
+        keys.clear();
+        view.ForEachAccountHistoryByType(collect, {category});
+        return keys;
+    };
+
+    // overwritten in the same block with other tokens and type, the rows of the first value go
+    WriteHistory(view, alice, 10, 1, CustomTxType::PoolSwap, {{DCT_ID{0}, -COIN}, {DCT_ID{1}, COIN}});
+    WriteHistory(view, alice, 10, 1, CustomTxType::AccountToAccount, {{DCT_ID{1}, COIN}, {DCT_ID{2}, COIN}});
+    view.Flush();
+    BOOST_CHECK(byToken(0).empty());
+    BOOST_CHECK(byToken(1) == HistoryKeys({{10, 1}}));
+    BOOST_CHECK(byToken(2) == HistoryKeys({{10, 1}}));
+    BOOST_CHECK(byType(swap).empty());
+    BOOST_CHECK(byType(transfer) == HistoryKeys({{10, 1}}));
+
+    // as are the rows of a record already flushed
+    WriteHistory(view, alice, 10, 1, CustomTxType::PoolSwap, {{DCT_ID{0}, -COIN}});
+    view.Flush();
+    BOOST_CHECK(byToken(0) == HistoryKeys({{10, 1}}));
+    BOOST_CHECK(byToken(1).empty());
+    BOOST_CHECK(byToken(2).empty());
+    BOOST_CHECK(byType(swap) == HistoryKeys({{10, 1}}));
+    BOOST_CHECK(byType(transfer).empty());
+}
+
+static std::map<unsigned char, uint64_t> HistoryCounts(CAccountsHistoryView &view, const CScript &owner = {}) {
+    std::map<unsigned char, uint64_t> counts;
+    view.ForEachAccountHistoryCount(
+        [&](unsigned char category, uint64_t count) {
+            counts.emplace(category, count);
+            return true;
+        },
+        owner);
+    return counts;
+}
+
+BOOST_AUTO_TEST_CASE(history_counts)
+{
+    CAccountHistoryStorage view(GetDataDir() / "history_counts", 1 << 20, true, true);
+
+    const CScript alice = CScript() << OP_TRUE;
+    const CScript bob = CScript() << OP_FALSE;
+    const auto swap = static_cast<unsigned char>(CustomTxType::PoolSwap);
+    const auto transfer = static_cast<unsigned char>(CustomTxType::AccountToAccount);
+    WriteHistory(view, alice, 10, 1, CustomTxType::PoolSwap, {{DCT_ID{0}, -COIN}});
+    view.Flush();
+
+    // existing records are counted when enabled
+    view.SetSecondaryIndexes(true);
+    WriteHistory(view, alice, 11, 1, CustomTxType::PoolSwap, {{DCT_ID{0}, -COIN}});
+    WriteHistory(view, bob, 11, 2, CustomTxType::PoolSwap, {{DCT_ID{0}, COIN}});
+    // overwritten in the same block
+    WriteHistory(view, bob, 11, 2, CustomTxType::AccountToAccount, {{DCT_ID{0}, COIN}});
+    view.Flush();
+
+    using Counts = std::map<unsigned char, uint64_t>;
+    BOOST_CHECK(HistoryCounts(view, alice) == Counts({{swap, 2}}));
+    BOOST_CHECK(HistoryCounts(view, bob) == Counts({{transfer, 1}}));
+    BOOST_CHECK(HistoryCounts(view) == Counts({{swap, 2}, {transfer, 1}}));
+
+    view.EraseAccountHistoryHeight(11);
+    view.Flush();
+    BOOST_CHECK(HistoryCounts(view, alice) == Counts({{swap, 1}}));
+    BOOST_CHECK(HistoryCounts(view, bob).empty());
+    BOOST_CHECK(HistoryCounts(view) == Counts({{swap, 1}}));
+
+    view.SetSecondaryIndexes(false);
+    BOOST_CHECK(HistoryCounts(view).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
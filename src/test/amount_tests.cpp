@@ -3,7 +3,10 @@
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
 #include <amount.h>
+#include <clientversion.h>
+#include <dfi/balances.h>
 #include <policy/feerate.h>
+#include <streams.h>
 #include <test/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -154,4 +157,72 @@ BOOST_AUTO_TEST_CASE(CAmount_Float_Test)
     BOOST_CHECK_EQUAL(CAmount(amount1 + float(amount2)), amount1 + amount2 - 1);
 }
 
+// TAmounts and CBalances keep the wire format of the std::map they replace
+BOOST_AUTO_TEST_CASE(TAmounts_Serialization_Test)
+{
+    const TAmounts amounts{{DCT_ID{300}, 3}, {DCT_ID{0}, 1}, {DCT_ID{2}, 2}};
+    BOOST_CHECK(amounts.begin()->first == DCT_ID{0});
+    BOOST_CHECK(amounts.rbegin()->first == DCT_ID{300});
+
+    const std::map<DCT_ID, CAmount> mapAmounts(amounts.begin(), amounts.end());
+    CDataStream ss(SER_DISK, CLIENT_VERSION), mapSs(SER_DISK, CLIENT_VERSION);
+    ss << amounts;
+    mapSs << mapAmounts;
+    BOOST_CHECK(ss.str() == mapSs.str());
+
+    TAmounts read;
+    ss >> read;
+    BOOST_CHECK(read == amounts);
+    mapSs.clear();
+
+    CBalances balances{amounts};
+    const std::map<uint32_t, CAmount> mapBalances{{0, 1}, {2, 2}, {300, 3}};
+    ss << balances;
+    mapSs << mapBalances;
+    BOOST_CHECK(ss.str() == mapSs.str());
+
+    CBalances readBalances;
+    ss >> readBalances;
+    BOOST_CHECK(readBalances == balances);
+
+    // Out of order entries are sorted and the first of duplicate ids is kept, as the map did
+    mapSs.clear();
+    WriteCompactSize(mapSs, 3);
+    mapSs << uint32_t{2} << CAmount{2} << uint32_t{0} << CAmount{1} << uint32_t{2} << CAmount{5};
+    mapSs >> readBalances;
+    BOOST_CHECK(readBalances.balances == (TAmounts{{DCT_ID{0}, 1}, {DCT_ID{2}, 2}}));
+
+    // Zero amounts are not canonical
+    WriteCompactSize(mapSs, 1);
+    mapSs << uint32_t{1} << CAmount{0};
+    BOOST_CHECK_THROW(mapSs >> readBalances, std::ios_base::failure);
+}
+
+BOOST_AUTO_TEST_CASE(TAmounts_Unserialize_Reversed_Test)
+{
+    // Reversed ids are sorted once instead of inserted at the front one by one
+    const uint32_t count = 10000;
+    CDataStream ss(SER_DISK, CLIENT_VERSION), balancesSs(SER_DISK, CLIENT_VERSION);
+    WriteCompactSize(ss, count + 1);
+    WriteCompactSize(balancesSs, count + 1);
+    for (uint32_t id = count; id > 0; --id) {
+        ss << DCT_ID{id} << CAmount{id};
+        balancesSs << id << CAmount{id};
+    }
+    // Duplicate of the first entry read, which is dropped
+    ss << DCT_ID{count} << CAmount{1};
+    balancesSs << count << CAmount{1};
+
+    TAmounts read;
+    ss >> read;
+    BOOST_CHECK_EQUAL(read.size(), count);
+    BOOST_CHECK(std::is_sorted(read.begin(), read.end()));
+    BOOST_CHECK_EQUAL(read.begin()->first.v, 1);
+    BOOST_CHECK_EQUAL(read.at(DCT_ID{count}), count);
+
+    CBalances readBalances;
+    balancesSs >> readBalances;
+    BOOST_CHECK(readBalances.balances == read);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -415,6 +415,39 @@ BOOST_AUTO_TEST_CASE(Test_AnchorFinalMsgCount)
 }
 
 
+BOOST_AUTO_TEST_CASE(Test_AnchorSignerCache)
+{
+    // Enough signatures to spread recovery over the task pool when it runs
+    const auto hash = uint256S(std::string(64, '7'));
+    std::vector<CKey> keys;
+    std::vector<std::pair<uint256, CAnchorSignerCache::Signature>> sigs;
+    for (int i{0}; i < 40; ++i) {
+        CKey key;
+        key.MakeNewKey(true);
+        CAnchorSignerCache::Signature sig;
+        BOOST_REQUIRE(key.SignCompact(hash, sig));
+        keys.push_back(key);
+        sigs.emplace_back(hash, sig);
+    }
+    // Signature that recovers nothing
+    sigs.emplace_back(hash, CAnchorSignerCache::Signature(65, 0));
+
+    CAnchorSignerCache cache;
+    for (int pass{0}; pass < 2; ++pass) {
+        const auto signers = cache.Recover(sigs);
+        BOOST_REQUIRE_EQUAL(signers.size(), sigs.size());
+        for (size_t i{0}; i < keys.size(); ++i) {
+            BOOST_CHECK(signers[i] && *signers[i] == keys[i].GetPubKey());
+        }
+        BOOST_CHECK(!signers.back());
+    }
+
+    // The second pass only hits the cache
+    const auto stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(stats.recovered, sigs.size());
+    BOOST_CHECK_EQUAL(stats.cacheHits, sigs.size());
+}
+
 BOOST_AUTO_TEST_CASE(Test_AnchorMsgCount)
 {
     // Team and private keys
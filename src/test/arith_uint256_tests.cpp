@@ -10,6 +10,7 @@
 #include <cmath>
 #include <uint256.h>
 #include <arith_uint256.h>
+#include <arith_int128.h>
 #include <string>
 #include <test/setup_common.h>
 
@@ -576,4 +577,33 @@ BOOST_AUTO_TEST_CASE( sqrt )
     BOOST_CHECK((arith_uint256(std::numeric_limits<uint64_t>::max()) +1).sqrt()  == arith_uint256(4294967296));
 }
 
+BOOST_AUTO_TEST_CASE( native128 )
+{
+    const int64_t values[] = {0, 1, 3, 999, 100000000, 10000000000000000, -1, -100000000,
+                              std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()};
+    for (const auto a : values) {
+        for (const auto b : values) {
+            BOOST_CHECK(Mul128(a, b) == base_uint<128>(a) * b);
+            BOOST_CHECK(MulAdd128(a, b, a) == base_uint<128>(arith_uint256(a) * b + a));
+            for (const auto c : values) {
+                if (c == 0) {
+                    BOOST_CHECK_THROW(MulDivLow64(a, b, c), uint_error);
+                    BOOST_CHECK_THROW(MulMulDiv128(a, b, a, c), uint_error);
+                    continue;
+                }
+                BOOST_CHECK_EQUAL(MulDivLow64(a, b, c), (arith_uint256(a) * arith_uint256(b) / arith_uint256(c)).GetLow64());
+                BOOST_CHECK_EQUAL(MulDivLow64(a, R1L, c), (a * R1L / c).GetLow64());
+                BOOST_CHECK_EQUAL(MulDivLow64(a, R1L >> 192, c), (a * (R1L >> 192) / c).GetLow64());
+                BOOST_CHECK(MulDiv128(a, b, c) == base_uint<128>(arith_uint256(a) * b / c));
+                BOOST_CHECK(MulMulDiv128(a, b, a, c) == base_uint<128>(arith_uint256(a) * b * a / c));
+
+                const base_uint<128> value = arith_uint256(a) * b;
+                const int64_t quotient = (value / base_uint<128>(c)).GetLow64();
+                BOOST_CHECK_EQUAL(DivLow64(value, c), uint64_t(quotient));
+                BOOST_CHECK_EQUAL(DivCeilLow64(value, c), uint64_t(quotient) + (value != base_uint<128>(quotient) * c));
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
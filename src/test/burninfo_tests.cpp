@@ -0,0 +1,86 @@
+#include <test/setup_common.h>
+
+#include <dfi/accountshistory.h>
+#include <dfi/customtx.h>
+#include <dfi/masternodes.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(burninfo_tests, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(burn_history_buckets)
+{
+    CBurnInfo info;
+    info.AddHistory(uint8_t(CustomTxType::None), {{DCT_ID{0}, 5 * COIN}});
+    info.AddHistory(uint8_t(CustomTxType::CreateMasternode), {{DCT_ID{0}, COIN}});
+    info.AddHistory(uint8_t(CustomTxType::AuctionBid), {{DCT_ID{0}, 2 * COIN}});
+    info.AddHistory(uint8_t(CustomTxType::PaybackLoan), {{DCT_ID{1}, 3 * COIN}});
+    info.AddHistory(uint8_t(CustomTxType::PoolSwap), {{DCT_ID{2}, 4 * COIN}});
+    info.AddHistory(uint8_t(CustomTxType::BurnToken), {{DCT_ID{3}, 6 * COIN}});
+    info.AddHistory(uint8_t(CustomTxType::AccountToAccount), {{DCT_ID{3}, 7 * COIN}, {DCT_ID{4}, -COIN}});
+
+    BOOST_CHECK_EQUAL(info.burntDFI, 5 * COIN);
+    BOOST_CHECK_EQUAL(info.burntFee, COIN);
+    BOOST_CHECK_EQUAL(info.auctionFee, 2 * COIN);
+    BOOST_CHECK_EQUAL(info.paybackFee.balances[DCT_ID{1}], 3 * COIN);
+    BOOST_CHECK_EQUAL(info.dexfeeburn.balances[DCT_ID{2}], 4 * COIN);
+    BOOST_CHECK_EQUAL(info.burntTokens.balances[DCT_ID{3}], 13 * COIN);
+    BOOST_CHECK_EQUAL(info.burntTokens.balances.count(DCT_ID{4}), 0);
+}
+
+BOOST_AUTO_TEST_CASE(block_burns_connect_disconnect)
+{
+    CCustomCSView mnview(*pcustomcsview.get());
+
+    CBurnInfo first, second;
+    first.AddHistory(uint8_t(CustomTxType::None), {{DCT_ID{0}, COIN}});
+    first.AddHistory(uint8_t(CustomTxType::PoolSwap), {{DCT_ID{1}, COIN}});
+    second.AddHistory(uint8_t(CustomTxType::PoolSwap), {{DCT_ID{1}, 2 * COIN}});
+
+    mnview.AddBlockBurnInfo(10, first);
+    mnview.AddBlockBurnInfo(11, CBurnInfo{});
+    mnview.AddBlockBurnInfo(12, second);
+    BOOST_CHECK(!mnview.GetBlockBurnInfo(11));
+
+    auto totals = mnview.GetBurnInfo();
+    BOOST_CHECK_EQUAL(totals.burntDFI, COIN);
+    BOOST_CHECK_EQUAL(totals.dexfeeburn.balances[DCT_ID{1}], 3 * COIN);
+
+    mnview.EraseBlockBurnInfo(12);
+    mnview.EraseBlockBurnInfo(11);
+    totals = mnview.GetBurnInfo();
+    BOOST_CHECK_EQUAL(totals.burntDFI, COIN);
+    BOOST_CHECK_EQUAL(totals.dexfeeburn.balances[DCT_ID{1}], COIN);
+
+    mnview.EraseBlockBurnInfo(10);
+    BOOST_CHECK(mnview.GetBurnInfo().IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(burn_history_blocks)
+{
+    CBurnHistoryStorage burnView(GetDataDir() / "burn_history_blocks", 1 << 20, true, true);
+    const CScript burnAddress = CScript() << OP_RETURN;
+    const CScript other = CScript() << OP_TRUE;
+    burnView.WriteAccountHistory({burnAddress, 10, 0}, {{}, uint8_t(CustomTxType::None), {{DCT_ID{0}, COIN}}});
+    burnView.WriteAccountHistory({other, 10, 1}, {{}, uint8_t(CustomTxType::PoolSwap), {{DCT_ID{1}, COIN}}});
+    burnView.WriteAccountHistory({burnAddress, 12, 0}, {{}, uint8_t(CustomTxType::PoolSwap), {{DCT_ID{1}, 2 * COIN}}});
+    burnView.Flush();
+
+    // Blocks are visited once each with all the burns of their owners, as rebuilt on upgrade
+    CCustomCSView mnview(*pcustomcsview.get());
+    std::vector<uint32_t> heights;
+    burnView.ForEachBlockBurnInfo([&](uint32_t height, const CBurnInfo &burns) {
+        heights.push_back(height);
+        const auto expected = burnView.GetBlockBurnInfo(height);
+        BOOST_CHECK_EQUAL(burns.burntDFI, expected.burntDFI);
+        BOOST_CHECK(burns.dexfeeburn.balances == expected.dexfeeburn.balances);
+        mnview.AddBlockBurnInfo(height, burns);
+    });
+    BOOST_CHECK(heights == std::vector<uint32_t>({12, 10}));
+
+    const auto totals = mnview.GetBurnInfo();
+    BOOST_CHECK_EQUAL(totals.burntDFI, COIN);
+    BOOST_CHECK_EQUAL(totals.dexfeeburn.balances.at(DCT_ID{1}), 3 * COIN);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
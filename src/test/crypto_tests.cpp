@@ -749,4 +749,22 @@ BOOST_AUTO_TEST_CASE(sha256d64)
     }
 }
 
+BOOST_AUTO_TEST_CASE(sha256dshort)
+{
+    for (size_t length : {0, 32, 55, 56, 64, 80, 81, 119}) {
+        for (int i = 0; i <= 17; ++i) {
+            unsigned char in[119 * 17];
+            unsigned char out1[32 * 17], out2[32 * 17];
+            for (size_t j = 0; j < length * i; ++j) {
+                in[j] = InsecureRandBits(8);
+            }
+            for (int j = 0; j < i; ++j) {
+                CHash256().Write(in + length * j, length).Finalize(out1 + 32 * j);
+            }
+            SHA256DShort(out2, in, length, i);
+            BOOST_CHECK(memcmp(out1, out2, 32 * i) == 0);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <dfi/accountshistory.h>
+#include <dfi/masternodes.h>
+#include <dfi/threadpool.h>
+#include <dfi/validation.h>
+#include <script/standard.h>
+#include <test/setup_common.h>
+#include <validation.h>
+
+#include <cstring>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+struct Settlement {
+    Res res = Res::Ok();
+    size_t workers{};
+    std::vector<std::string> balances;
+    std::vector<std::string> history;
+};
+
+Settlement Settle(CCustomCSView &base, const std::vector<CAccountChange> &changes, bool stopOnFailure, bool parallel)
+{
+    // Without a pool the changes are applied in order
+    std::unique_ptr<TaskPool> pool;
+    if (parallel) {
+        pool = std::make_unique<TaskPool>(4);
+    }
+    std::swap(pool, DfTxTaskPool);
+
+    CAccountHistoryStorage historyView(GetDataDir() / (parallel ? "parallel" : "sequential"), 1 << 20, true, true);
+    CCustomCSView view(base, &historyView, nullptr, nullptr);
+    const CBlockIndex *tip = WITH_LOCK(cs_main, return ::ChainActive().Tip());
+
+    Settlement settlement;
+    settlement.res = ApplyAccountChanges(
+        tip, view, changes, uint8_t(CustomTxType::FutureSwapExecution), stopOnFailure, settlement.workers);
+    std::swap(pool, DfTxTaskPool);
+
+    view.ForEachBalance([&](const CScript &owner, const CTokenAmount &balance) {
+        settlement.balances.push_back(owner.GetHex() + " " + balance.ToString());
+        return true;
+    });
+    view.GetHistoryWriters().FlushDB();
+    historyView.ForEachAccountHistory([&](const AccountHistoryKey &key, AccountHistoryValue value) {
+        settlement.history.push_back(strprintf("%s %d %d %d %s",
+                                               key.owner.GetHex(),
+                                               key.blockHeight,
+                                               key.txn,
+                                               value.category,
+                                               CBalances{value.diff}.ToString()));
+        return true;
+    });
+    return settlement;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(futures_tests, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(parallel_settlement)
+{
+    constexpr uint32_t owners = 3000;
+    const auto &burnAddress = Params().GetConsensus().burnAddress;
+
+    CCustomCSView base(*pcustomcsview);
+    std::vector<CScript> scripts;
+    for (uint32_t i = 0; i < owners; ++i) {
+        uint160 hash;
+        std::memcpy(hash.begin(), &i, sizeof(i));
+        scripts.push_back(GetScriptForDestination(WitnessV0KeyHash(hash)));
+        BOOST_REQUIRE(base.AddBalance(scripts.back(), {DCT_ID{0}, COIN}));
+    }
+    BOOST_REQUIRE(base.AddBalance(burnAddress, {DCT_ID{0}, COIN}));
+
+    // Each owner pays and is paid out, burn address items stay on the block view
+    std::vector<CAccountChange> changes;
+    uint32_t txn{};
+    for (uint32_t i = 0; i < owners; ++i) {
+        changes.push_back({scripts[i], {DCT_ID{0}, COIN / 2}, txn++, true});
+        changes.push_back({scripts[i], {DCT_ID{1}, i + 1}, txn++, false});
+        if (i % 1000 == 0) {
+            changes.push_back({burnAddress, {DCT_ID{2}, i + 1}, txn++, false});
+        }
+    }
+
+    const auto sequential = Settle(base, changes, false, false);
+    const auto parallel = Settle(base, changes, false, true);
+    BOOST_CHECK(sequential.res && parallel.res);
+    BOOST_CHECK_EQUAL(sequential.workers, 1);
+    BOOST_CHECK_GT(parallel.workers, 1);
+    BOOST_CHECK_EQUAL(sequential.history.size(), changes.size());
+    BOOST_CHECK(parallel.balances == sequential.balances);
+    BOOST_CHECK(parallel.history == sequential.history);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_settlement_first_failure)
+{
+    constexpr uint32_t owners = 3000;
+    const auto &burnAddress = Params().GetConsensus().burnAddress;
+
+    CCustomCSView base(*pcustomcsview);
+    std::vector<CAccountChange> changes;
+    for (uint32_t i = 0; i < owners; ++i) {
+        uint160 hash;
+        std::memcpy(hash.begin(), &i, sizeof(i));
+        const auto owner = GetScriptForDestination(WitnessV0KeyHash(hash));
+        BOOST_REQUIRE(base.AddBalance(owner, {DCT_ID{0}, COIN}));
+        // A few owners pay more than they hold, each failing with its own amount
+        const CAmount amount = i % 700 == 699 ? COIN + i : COIN;
+        changes.push_back({owner, {DCT_ID{0}, amount}, i, true});
+    }
+
+    // The first failure in order is returned however the owners are split
+    const auto sequential = Settle(base, changes, true, false);
+    BOOST_CHECK(!sequential.res);
+    for (int run = 0; run < 5; ++run) {
+        const auto parallel = Settle(base, changes, true, true);
+        BOOST_CHECK_GT(parallel.workers, 1);
+        BOOST_CHECK(!parallel.res);
+        BOOST_CHECK_EQUAL(parallel.res.msg, sequential.res.msg);
+    }
+
+    // Including a burn address item before the failures of the workers
+    changes[100] = {burnAddress, {DCT_ID{0}, COIN}, 100, true};
+    const auto burnSequential = Settle(base, changes, true, false);
+    const auto burnParallel = Settle(base, changes, true, true);
+    BOOST_CHECK(!burnSequential.res);
+    BOOST_CHECK(burnSequential.res.msg != sequential.res.msg);
+    BOOST_CHECK_EQUAL(burnParallel.res.msg, burnSequential.res.msg);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_int128.h>
+#include <arith_uint256.h>
+#include <streams.h>
+#include <version.h>
+
+#include <test/fuzz/fuzz.h>
+
+#include <cassert>
+
+/** Evaluates both sides and requires identical values or identical division by zero failures */
+template <typename Fast, typename Reference>
+static void AssertEquivalent(Fast fast, Reference reference)
+{
+    bool fastThrew = false, referenceThrew = false;
+    decltype(fast()) fastResult{};
+    decltype(fast()) referenceResult{};
+    try {
+        fastResult = fast();
+    } catch (const uint_error&) {
+        fastThrew = true;
+    }
+    try {
+        referenceResult = reference();
+    } catch (const uint_error&) {
+        referenceThrew = true;
+    }
+    assert(fastThrew == referenceThrew);
+    assert(fastThrew || fastResult == referenceResult);
+}
+
+void test_one_input(std::vector<uint8_t> buffer)
+{
+    CDataStream ds(buffer, SER_NETWORK, INIT_PROTO_VERSION);
+    int64_t a, b, c, d;
+    arith_uint256 wide;
+    try {
+        ds >> a >> b >> c >> d >> wide;
+    } catch (const std::ios_base::failure&) {
+        return;
+    }
+
+    // amount.h, liquidity, reserves and swap
+    AssertEquivalent([&] { return MulDivLow64(a, b, c); },
+                     [&] { return (arith_uint256(a) * arith_uint256(b) / arith_uint256(c)).GetLow64(); });
+
+    // static pool rewards, exercising both the native path and the fallback
+    for (const arith_uint256 perShare : {wide, arith_uint256(wide >> 128), arith_uint256(wide >> 160)}) {
+        AssertEquivalent([&] { return MulDivLow64(a, perShare, c); },
+                         [&] { return (a * perShare / c).GetLow64(); });
+    }
+
+    // reward per share and swap price
+    AssertEquivalent([&] { return MulDiv128(a, b, c); },
+                     [&] { return base_uint<128>(arith_uint256(a) * b / c); });
+
+    // maximum swap price
+    AssertEquivalent([&] { return MulAdd128(a, b, c); },
+                     [&] { return base_uint<128>(arith_uint256(a) * b + c); });
+
+    // interest per block, the reference truncates to 128 bits like InterestPerBlockCalculationV2
+    AssertEquivalent([&] { return MulMulDiv128(a, b, c, d); },
+                     [&] { return base_uint<128>(arith_uint256(a) * b * c / d); });
+    AssertEquivalent([&] { return MulMulDiv128(a, b >> 32, c >> 32, d); },
+                     [&] { return base_uint<128>(arith_uint256(a) * (b >> 32) * (c >> 32) / d); });
+
+    // ToHigherPrecision, FloorInterest and CeilInterest
+    AssertEquivalent([&] { return Mul128(a, b); },
+                     [&] { return base_uint<128>(a) * b; });
+
+    const base_uint<128> value = wide;
+    AssertEquivalent([&] { return DivLow64(value, c); },
+                     [&] { return (value / base_uint<128>(c)).GetLow64(); });
+    AssertEquivalent(
+        [&] { return DivCeilLow64(value, c); },
+        [&] {
+            int64_t amount = (value / base_uint<128>(c)).GetLow64();
+            return uint64_t(amount) + uint64_t(value != base_uint<128>(amount) * c);
+        });
+}
@@ -0,0 +1,155 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <httprpc.h>
+#include <httpserver.h>
+#include <httpworkqueue.h>
+#include <test/setup_common.h>
+#include <util/system.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+struct TestWorkItem {
+    TestWorkItem(HTTPWorkClass _workClass, std::string _client, std::function<void()> _func)
+        : workClass(_workClass), client(std::move(_client)), func(std::move(_func)) {}
+    void operator()() { func(); }
+
+    const HTTPWorkClass workClass;
+    const std::string client;
+    int64_t enqueueTime{};
+    std::function<void()> func;
+};
+
+bool Enqueue(WorkQueue<TestWorkItem>& queue, HTTPWorkClass workClass, std::function<void()> func, const std::string& client = "")
+{
+    auto item = std::make_unique<TestWorkItem>(workClass, client, std::move(func));
+    if (!queue.Enqueue(item.get()))
+        return false;
+    item.release();
+    return true;
+}
+
+// Runs items of the class on two workers at once and returns how many of them ran at the same time
+size_t MaxRunningAtOnce(HTTPWorkClass workClass, size_t maxHeavy, size_t maxPerClient, const std::string& client)
+{
+    WorkQueue<TestWorkItem> queue({8, 8, 8}, maxHeavy, maxPerClient);
+    std::atomic<size_t> running{0}, maxRunning{0}, done{0};
+    for (int i = 0; i < 4; ++i) {
+        BOOST_REQUIRE(Enqueue(queue, workClass, [&] {
+            maxRunning = std::max<size_t>(maxRunning, ++running);
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            --running;
+            ++done;
+        }, client));
+    }
+    std::thread first([&] { queue.Run(false); });
+    std::thread second([&] { queue.Run(false); });
+    while (done < 4)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    queue.Interrupt();
+    first.join();
+    second.join();
+    return maxRunning;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(httprpc_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(jsonrpc_work_class)
+{
+    BOOST_CHECK(JSONRPCWorkClass(R"({"method":"ping"})") == HTTPWorkClass::CHEAP);
+    BOOST_CHECK(JSONRPCWorkClass(R"({"method":"getblock","params":["00"]})") == HTTPWorkClass::NORMAL);
+    BOOST_CHECK(JSONRPCWorkClass(R"({"method":"listaccounthistory"})") == HTTPWorkClass::HEAVY);
+
+    // An escaped key could read "method", so the call is not trusted to be cheap
+    BOOST_CHECK(JSONRPCWorkClass(R"({"meth\u006fd":"listaccounthistory","method":"ping"})") == HTTPWorkClass::HEAVY);
+    BOOST_CHECK(JSONRPCWorkClass(R"({"method":"getblockcount","params":["listaccounthistory"]})") == HTTPWorkClass::CHEAP);
+
+    // A batch takes the class of its heaviest call
+    BOOST_CHECK(JSONRPCWorkClass(R"([{"method":"ping"},{"method":"getblockcount"}])") == HTTPWorkClass::CHEAP);
+    BOOST_CHECK(JSONRPCWorkClass(R"([{"method":"ping"},{"method":"listaccounthistory"}])") == HTTPWorkClass::HEAVY);
+
+    // A method in a nested value or a string is not the method of the call
+    BOOST_CHECK(JSONRPCWorkClass(R"({"params":{"method":"listaccounthistory"},"id":"\"method\":","method":"ping"})") == HTTPWorkClass::CHEAP);
+    BOOST_CHECK(JSONRPCWorkClass(R"({"id":[1,{"a":"}]"}],"method":"ping"})") == HTTPWorkClass::CHEAP);
+    BOOST_CHECK(JSONRPCWorkClass(R"({"method":"ping","method":"listaccounthistory"})") == HTTPWorkClass::CHEAP);
+    BOOST_CHECK(JSONRPCWorkClass(R"({"method":"p\u0069ng"})") == HTTPWorkClass::HEAVY);
+
+    // Anything the worker will reject without running a call
+    BOOST_CHECK(JSONRPCWorkClass("[]") == HTTPWorkClass::NORMAL);
+    BOOST_CHECK(JSONRPCWorkClass("{}") == HTTPWorkClass::NORMAL);
+    BOOST_CHECK(JSONRPCWorkClass(R"({"method":1})") == HTTPWorkClass::NORMAL);
+    BOOST_CHECK(JSONRPCWorkClass(R"([{"method":"ping"},1])") == HTTPWorkClass::NORMAL);
+
+    // Bodies the scan can't read, or that are too large to scan on the event thread, are not trusted to be cheap
+    BOOST_CHECK(JSONRPCWorkClass("{\"method\":") == HTTPWorkClass::HEAVY);
+    BOOST_CHECK(JSONRPCWorkClass("ping") == HTTPWorkClass::HEAVY);
+    const std::string large = R"({"method":"ping","params":[")" + std::string(1 << 20, 'a') + R"("]})";
+    BOOST_CHECK(JSONRPCWorkClass(large) == HTTPWorkClass::HEAVY);
+}
+
+BOOST_AUTO_TEST_CASE(work_queue_depth)
+{
+    // Normal calls keep the whole -rpcworkqueue depth, the other classes have their own
+    BOOST_CHECK_EQUAL(HTTPWorkQueueDepth(HTTPWorkClass::NORMAL), DEFAULT_HTTP_WORKQUEUE);
+    BOOST_CHECK_EQUAL(HTTPWorkQueueDepth(HTTPWorkClass::CHEAP), DEFAULT_HTTP_CHEAP_WORKQUEUE);
+    BOOST_CHECK_EQUAL(HTTPWorkQueueDepth(HTTPWorkClass::HEAVY), DEFAULT_HTTP_HEAVY_WORKQUEUE);
+    gArgs.ForceSetArg("-rpcworkqueue", "32");
+    gArgs.ForceSetArg("-rpcheavyworkqueue", "0");
+    BOOST_CHECK_EQUAL(HTTPWorkQueueDepth(HTTPWorkClass::NORMAL), 32);
+    BOOST_CHECK_EQUAL(HTTPWorkQueueDepth(HTTPWorkClass::HEAVY), 1);
+    gArgs.ForceSetArg("-rpcworkqueue", std::to_string(DEFAULT_HTTP_WORKQUEUE));
+    gArgs.ForceSetArg("-rpcheavyworkqueue", std::to_string(DEFAULT_HTTP_HEAVY_WORKQUEUE));
+
+    // A full queue only rejects calls of its own class
+    WorkQueue<TestWorkItem> queue({1, 2, 1}, 1, 0);
+    BOOST_CHECK(Enqueue(queue, HTTPWorkClass::NORMAL, [] {}));
+    BOOST_CHECK(Enqueue(queue, HTTPWorkClass::NORMAL, [] {}));
+    BOOST_CHECK(!Enqueue(queue, HTTPWorkClass::NORMAL, [] {}));
+    BOOST_CHECK(Enqueue(queue, HTTPWorkClass::CHEAP, [] {}));
+    BOOST_CHECK(!Enqueue(queue, HTTPWorkClass::CHEAP, [] {}));
+    BOOST_CHECK(Enqueue(queue, HTTPWorkClass::HEAVY, [] {}));
+    BOOST_CHECK(!Enqueue(queue, HTTPWorkClass::HEAVY, [] {}));
+}
+
+BOOST_AUTO_TEST_CASE(work_queue_order)
+{
+    // Cheap calls are taken first, heavy ones last
+    WorkQueue<TestWorkItem> queue({4, 4, 4}, 1, 0);
+    std::vector<HTTPWorkClass> ran;
+    BOOST_REQUIRE(Enqueue(queue, HTTPWorkClass::HEAVY, [&] {
+        ran.push_back(HTTPWorkClass::HEAVY);
+        queue.Interrupt();
+    }));
+    BOOST_REQUIRE(Enqueue(queue, HTTPWorkClass::NORMAL, [&] { ran.push_back(HTTPWorkClass::NORMAL); }));
+    BOOST_REQUIRE(Enqueue(queue, HTTPWorkClass::CHEAP, [&] { ran.push_back(HTTPWorkClass::CHEAP); }));
+    queue.Run(false);
+    BOOST_CHECK(ran == std::vector<HTTPWorkClass>({HTTPWorkClass::CHEAP, HTTPWorkClass::NORMAL, HTTPWorkClass::HEAVY}));
+
+    // Workers reserved for cheap calls take nothing else
+    WorkQueue<TestWorkItem> cheapQueue({4, 4, 4}, 1, 0);
+    ran.clear();
+    BOOST_REQUIRE(Enqueue(cheapQueue, HTTPWorkClass::NORMAL, [&] { ran.push_back(HTTPWorkClass::NORMAL); }));
+    BOOST_REQUIRE(Enqueue(cheapQueue, HTTPWorkClass::CHEAP, [&] {
+        ran.push_back(HTTPWorkClass::CHEAP);
+        cheapQueue.Interrupt();
+    }));
+    cheapQueue.Run(true);
+    BOOST_CHECK(ran == std::vector<HTTPWorkClass>({HTTPWorkClass::CHEAP}));
+}
+
+BOOST_AUTO_TEST_CASE(work_queue_limits)
+{
+    // Heavy calls and the calls of a single client are limited in how many run at once
+    BOOST_CHECK_EQUAL(MaxRunningAtOnce(HTTPWorkClass::HEAVY, 1, 0, "a"), 1);
+    BOOST_CHECK_EQUAL(MaxRunningAtOnce(HTTPWorkClass::NORMAL, 1, 1, "a"), 1);
+    BOOST_CHECK_EQUAL(MaxRunningAtOnce(HTTPWorkClass::NORMAL, 1, 0, "a"), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,5 @@
 #include <chainparams.h>
+#include <dfi/govvariables/attributes.h>
 #include <dfi/loan.h>
 #include <dfi/masternodes.h>
 #include <dfi/mn_checks.h>
@@ -529,4 +530,75 @@ BOOST_AUTO_TEST_CASE(auction_batch_creator)
     }
 }
 
+BOOST_AUTO_TEST_CASE(live_economy_balances)
+{
+    CCustomCSView mnview(*pcustomcsview);
+
+    const DCT_ID dusd{1};
+    const CDataStructureV0 loansKey{AttributeTypes::Live, ParamIDs::Economy, EconomyKeys::Loans};
+    const CDataStructureV0 currentKey{AttributeTypes::Live, ParamIDs::Economy, EconomyKeys::DFIP2203Current};
+    BOOST_CHECK(IsLiveBalanceKey(loansKey));
+    BOOST_CHECK(!IsLiveBalanceKey(currentKey));
+
+    // Tracked as a row and merged back into ATTRIBUTES
+    TrackDUSDAdd(mnview, {dusd, 10 * COIN});
+    TrackDUSDSub(mnview, {dusd, 3 * COIN});
+    BOOST_CHECK_EQUAL(mnview.GetLiveBalances(loansKey)->balances[dusd], 7 * COIN);
+    auto attributes = mnview.GetAttributes();
+    BOOST_CHECK_EQUAL(attributes->GetValue(loansKey, CBalances{}).balances[dusd], 7 * COIN);
+
+    // Set through ATTRIBUTES, as a token split does, next to a key kept in the blob
+    CBalances loans, current;
+    loans.Add({dusd, 5 * COIN});
+    current.Add({dusd, COIN});
+    attributes->SetValue(loansKey, std::move(loans));
+    attributes->SetValue(currentKey, std::move(current));
+    BOOST_REQUIRE(mnview.SetVariable(*attributes));
+    BOOST_CHECK_EQUAL(mnview.GetLiveBalances(loansKey)->balances[dusd], 5 * COIN);
+    BOOST_CHECK(!mnview.GetLiveBalances(currentKey));
+    attributes = mnview.GetAttributes();
+    BOOST_CHECK_EQUAL(attributes->GetValue(loansKey, CBalances{}).balances[dusd], 5 * COIN);
+    BOOST_CHECK_EQUAL(attributes->GetValue(currentKey, CBalances{}).balances[dusd], COIN);
+
+    attributes->EraseKey(loansKey);
+    BOOST_REQUIRE(mnview.SetVariable(*attributes));
+    BOOST_CHECK(!mnview.GetLiveBalances(loansKey));
+    BOOST_CHECK(!mnview.GetAttributes()->CheckKey(loansKey));
+    BOOST_CHECK(mnview.GetAttributes()->CheckKey(currentKey));
+}
+
+BOOST_AUTO_TEST_CASE(live_economy_balances_build)
+{
+    CCustomCSView mnview(*pcustomcsview);
+
+    const DCT_ID dusd{1};
+    const CDataStructureV0 loansKey{AttributeTypes::Live, ParamIDs::Economy, EconomyKeys::Loans};
+    const CDataStructureV0 currentKey{AttributeTypes::Live, ParamIDs::Economy, EconomyKeys::DFIP2203Current};
+
+    // Blob as written before the counters were kept as rows
+    CBalances loans, current;
+    loans.Add({dusd, 5 * COIN});
+    current.Add({dusd, COIN});
+    ATTRIBUTES blob;
+    blob.SetValue(loansKey, std::move(loans));
+    blob.SetValue(currentKey, std::move(current));
+    BOOST_REQUIRE(mnview.WriteBy<CGovView::ByName>(blob.GetName(), blob));
+    BOOST_CHECK(!mnview.GetLiveBalances(loansKey));
+
+    mnview.BuildLiveBalances();
+    BOOST_CHECK_EQUAL(mnview.GetLiveBalances(loansKey)->balances[dusd], 5 * COIN);
+    BOOST_CHECK(!mnview.GetLiveBalances(currentKey));
+
+    ATTRIBUTES stored;
+    BOOST_REQUIRE(mnview.ReadBy<CGovView::ByName>(stored.GetName(), stored));
+    BOOST_CHECK(!stored.CheckKey(loansKey));
+    BOOST_CHECK(stored.CheckKey(currentKey));
+
+    // Tracking carries on from the moved value
+    TrackDUSDAdd(mnview, {dusd, COIN});
+    const auto attributes = mnview.GetAttributes();
+    BOOST_CHECK_EQUAL(attributes->GetValue(loansKey, CBalances{}).balances[dusd], 6 * COIN);
+    BOOST_CHECK_EQUAL(attributes->GetValue(currentKey, CBalances{}).balances[dusd], COIN);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,11 +1,56 @@
 #include <test/setup_common.h>
 
+#include <chainparams.h>
 #include <dfi/masternodes.h>
 
 #include <boost/test/unit_test.hpp>
 
 BOOST_FIXTURE_TEST_SUITE(mn_blocktime_tests, TestingSetup)
 
+// Merkle root of the view with every row under the given prefixes dropped
+static uint256 MerkleRootWithout(CCustomCSView &parent, CCustomCSView &mnview, const std::set<uint8_t> &prefixes) {
+    CCustomCSView expected(parent);
+    bool found{};
+    for (const auto &[key, value] : mnview.GetStorage().GetRaw()) {
+        if (!key.empty() && prefixes.count(key[0])) {
+            found = true;
+            continue;
+        }
+        value ? expected.GetStorage().Write(key, *value) : expected.GetStorage().Erase(key);
+    }
+    BOOST_CHECK(found);
+    return expected.MerkleRoot();
+}
+
+BOOST_AUTO_TEST_CASE(last_time_merkle_root)
+{
+    // Masternode created at a height where the view merkle root is part of the block merkle root
+    const auto height = Params().GetConsensus().DF8EunosHeight;
+    const std::set<uint8_t> lastTimePrefixes{CMasternodesView::LastStakerTime::prefix(),
+                                             CMasternodesView::LastSubNodeTime::prefix()};
+
+    CMasternode mn;
+    std::vector<unsigned char> vec(20, '1');
+    CKeyID minter(uint160{vec});
+    mn.operatorType = 1;
+    mn.ownerType = 1;
+    mn.operatorAuthAddress = minter;
+    mn.ownerAuthAddress = minter;
+    const auto mnId = uint256S(std::string(64, '1'));
+
+    CCustomCSView base(*pcustomcsview.get());
+    CCustomCSView mnview(base);
+    BOOST_REQUIRE(mnview.CreateMasternode(mnId, mn, 0));
+    mnview.SetMasternodeLastBlockTime(minter, height, 1000);
+    BOOST_CHECK(mnview.MerkleRoot() == MerkleRootWithout(base, mnview, lastTimePrefixes));
+    mnview.Flush();
+
+    CCustomCSView staked(base);
+    staked.SetMasternodeLastBlockTime(minter, height + 1, 2000);
+    staked.SetSubNodesBlockTime(minter, height + 1, 1, 2000);
+    BOOST_CHECK(staked.MerkleRoot() == MerkleRootWithout(base, staked, lastTimePrefixes));
+}
+
 BOOST_AUTO_TEST_CASE(retrieve_last_time)
 {
     // Create masternode
@@ -115,4 +160,95 @@ BOOST_AUTO_TEST_CASE(retrieve_last_time_multi)
     BOOST_CHECK_EQUAL(time2001[3], 2000);
 }
 
+BOOST_AUTO_TEST_CASE(latest_time_follows_connect_and_disconnect)
+{
+    // Create masternode
+    CMasternode mn;
+    std::vector<unsigned char> vec(20, '2');
+    uint160 bytes{vec};
+    CKeyID minter(bytes);
+    mn.operatorType = 1;
+    mn.ownerType = 1;
+    mn.operatorAuthAddress = minter;
+    mn.ownerAuthAddress = minter;
+    uint256 mnId = uint256S("2222222222222222222222222222222222222222222222222222222222222222");
+
+    CCustomCSView mnview(*pcustomcsview.get());
+    mnview.CreateMasternode(mnId, mn, 0);
+    const auto tip = std::numeric_limits<uint32_t>::max();
+
+    // Nothing staked yet
+    BOOST_CHECK(!mnview.GetMasternodeLastBlockTime(minter, tip));
+    BOOST_CHECK_EQUAL(mnview.GetSubNodesBlockTime(minter, tip)[1], 0);
+
+    mnview.SetMasternodeLastBlockTime(minter, 100, 1000);
+    mnview.SetMasternodeLastBlockTime(minter, 200, 2000);
+    mnview.SetSubNodesBlockTime(minter, 100, 1, 1000);
+    mnview.SetSubNodesBlockTime(minter, 200, 1, 2000);
+    BOOST_CHECK_EQUAL(*mnview.GetMasternodeLastBlockTime(minter, tip), 2000);
+    BOOST_CHECK_EQUAL(mnview.GetSubNodesBlockTime(minter, tip)[1], 2000);
+
+    // Disconnecting a block the masternode did not stake leaves its latest time alone
+    mnview.EraseMasternodeLastBlockTime(mnId, 150);
+    mnview.EraseSubNodesLastBlockTime(mnId, 150);
+    BOOST_CHECK_EQUAL(*mnview.GetMasternodeLastBlockTime(minter, tip), 2000);
+    BOOST_CHECK_EQUAL(mnview.GetSubNodesBlockTime(minter, tip)[1], 2000);
+
+    // Disconnecting its blocks steps back to the previous one, then to none
+    mnview.EraseMasternodeLastBlockTime(mnId, 200);
+    mnview.EraseSubNodesLastBlockTime(mnId, 200);
+    BOOST_CHECK_EQUAL(*mnview.GetMasternodeLastBlockTime(minter, tip), 1000);
+    BOOST_CHECK_EQUAL(mnview.GetSubNodesBlockTime(minter, tip)[1], 1000);
+
+    mnview.EraseMasternodeLastBlockTime(mnId, 100);
+    mnview.EraseSubNodesLastBlockTime(mnId, 100);
+    BOOST_CHECK(!mnview.GetMasternodeLastBlockTime(minter, tip));
+    BOOST_CHECK_EQUAL(mnview.GetSubNodesBlockTime(minter, tip)[1], 0);
+}
+
+BOOST_AUTO_TEST_CASE(build_last_times)
+{
+    CMasternode mn;
+    std::vector<unsigned char> vec(20, '3');
+    CKeyID minter(uint160{vec});
+    mn.operatorType = 1;
+    mn.ownerType = 1;
+    mn.operatorAuthAddress = minter;
+    mn.ownerAuthAddress = minter;
+    const auto mnId = uint256S(std::string(64, '3'));
+    const auto tip = std::numeric_limits<uint32_t>::max();
+
+    CCustomCSView mnview(*pcustomcsview.get());
+    BOOST_REQUIRE(mnview.CreateMasternode(mnId, mn, 0));
+    mnview.SetMasternodeLastBlockTime(minter, 100, 1000);
+    mnview.SetMasternodeLastBlockTime(minter, 200, 2000);
+    mnview.SetSubNodesBlockTime(minter, 100, 0, 1000);
+    mnview.SetSubNodesBlockTime(minter, 100, 1, 1000);
+    mnview.SetSubNodesBlockTime(minter, 200, 1, 2000);
+
+    // History as written before the latest entries were kept
+    CCustomCSView built(*pcustomcsview.get());
+    for (const auto &[key, value] : mnview.GetStorage().GetRaw()) {
+        if (!key.empty() && (key[0] == CMasternodesView::LastStakerTime::prefix() ||
+                             key[0] == CMasternodesView::LastSubNodeTime::prefix())) {
+            continue;
+        }
+        value ? built.GetStorage().Write(key, *value) : built.GetStorage().Erase(key);
+    }
+    BOOST_CHECK(!built.GetMasternodeLastBlockTime(minter, tip));
+
+    built.BuildLastBlockTimes();
+    BOOST_CHECK_EQUAL(*built.GetMasternodeLastBlockTime(minter, tip), 2000);
+    BOOST_CHECK_EQUAL(*built.GetMasternodeLastBlockTime(minter, 200), 1000);
+    const auto times = built.GetSubNodesBlockTime(minter, tip);
+    BOOST_CHECK(times == mnview.GetSubNodesBlockTime(minter, tip));
+    BOOST_CHECK_EQUAL(times[0], 1000);
+    BOOST_CHECK_EQUAL(times[1], 2000);
+    BOOST_CHECK_EQUAL(times[2], 0);
+
+    // Disconnect steps back from the built entry
+    built.EraseMasternodeLastBlockTime(mnId, 200);
+    BOOST_CHECK_EQUAL(*built.GetMasternodeLastBlockTime(minter, tip), 1000);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
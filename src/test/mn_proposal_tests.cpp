@@ -0,0 +1,196 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/setup_common.h>
+
+#include <chainparams.h>
+#include <dfi/masternodes.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(mn_proposal_tests, TestingSetup)
+
+static uint256 CreateTestMasternode(CCustomCSView &mnview, const char id) {
+    CMasternode mn;
+    std::vector<unsigned char> vec(20, id);
+    CKeyID key(uint160{vec});
+    mn.operatorType = 1;
+    mn.ownerType = 1;
+    mn.operatorAuthAddress = key;
+    mn.ownerAuthAddress = key;
+    const auto mnId = uint256S(std::string(64, id));
+    BOOST_REQUIRE(mnview.CreateMasternode(mnId, mn, 0));
+    return mnId;
+}
+
+static std::set<uint256> MintingMasternodes(CCustomCSView &mnview) {
+    std::set<uint256> result;
+    mnview.ForEachMintingMasternode([&](const uint256 &mnId) {
+        result.insert(mnId);
+        return true;
+    });
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(minting_masternodes)
+{
+    CCustomCSView mnview(*pcustomcsview.get());
+    const auto mn1 = CreateTestMasternode(mnview, '1');
+    const auto mn2 = CreateTestMasternode(mnview, '2');
+    BOOST_CHECK(MintingMasternodes(mnview).empty());
+
+    mnview.IncrementMintedBy(mn1);
+    mnview.IncrementMintedBy(mn1);
+    mnview.IncrementMintedBy(mn2);
+    BOOST_CHECK(MintingMasternodes(mnview) == std::set<uint256>({mn1, mn2}));
+
+    std::set<uint256> active, inactive;
+    mnview.GetMintingMasternodes(1, active, inactive);
+    BOOST_CHECK(active == std::set<uint256>({mn1, mn2}));
+    BOOST_CHECK(inactive.empty());
+
+    // Still minted one block
+    mnview.DecrementMintedBy(mn1);
+    BOOST_CHECK(MintingMasternodes(mnview) == std::set<uint256>({mn1, mn2}));
+
+    mnview.DecrementMintedBy(mn1);
+    BOOST_CHECK(MintingMasternodes(mnview) == std::set<uint256>({mn2}));
+
+    auto node = mnview.GetMasternode(mn2);
+    BOOST_REQUIRE(mnview.ResignMasternode(*node, mn2, uint256S(std::string(64, 'a')), 1));
+    BOOST_CHECK(MintingMasternodes(mnview).empty());
+}
+
+// Merkle root of the view with every row under the given prefix dropped
+static uint256 MerkleRootWithout(CCustomCSView &parent, CCustomCSView &mnview, const uint8_t prefix) {
+    CCustomCSView expected(parent);
+    bool found{};
+    for (const auto &[key, value] : mnview.GetStorage().GetRaw()) {
+        if (!key.empty() && key[0] == prefix) {
+            found = true;
+            continue;
+        }
+        value ? expected.GetStorage().Write(key, *value) : expected.GetStorage().Erase(key);
+    }
+    BOOST_CHECK(found);
+    return expected.MerkleRoot();
+}
+
+BOOST_AUTO_TEST_CASE(minting_merkle_root)
+{
+    const auto height = Params().GetConsensus().DF8EunosHeight;
+    CCustomCSView base(*pcustomcsview.get());
+    const auto mnId = CreateTestMasternode(base, '1');
+
+    CCustomCSView minted(base);
+    minted.IncrementMintedBy(mnId);
+    BOOST_CHECK(minted.MerkleRoot() == MerkleRootWithout(base, minted, CMasternodesView::Minting::prefix()));
+    minted.Flush();
+
+    CCustomCSView resigned(base);
+    auto node = resigned.GetMasternode(mnId);
+    BOOST_REQUIRE(resigned.ResignMasternode(*node, mnId, uint256S(std::string(64, 'a')), height));
+    BOOST_CHECK(resigned.MerkleRoot() == MerkleRootWithout(base, resigned, CMasternodesView::Minting::prefix()));
+}
+
+BOOST_AUTO_TEST_CASE(proposal_vote_tally)
+{
+    CCustomCSView mnview(*pcustomcsview.get());
+    const auto mn1 = CreateTestMasternode(mnview, '1');
+    const auto mn2 = CreateTestMasternode(mnview, '2');
+    const auto mn3 = CreateTestMasternode(mnview, '3');
+
+    CCreateProposalMessage msg;
+    msg.type = CProposalType::VoteOfConfidence;
+    msg.nCycles = 1;
+    const auto propId = uint256S(std::string(64, 'b'));
+    BOOST_REQUIRE(mnview.CreateProposal(propId, 1, msg, COIN));
+    const auto cycle = mnview.GetProposal(propId)->cycle;
+
+    BOOST_REQUIRE(mnview.AddProposalVote(propId, mn1, CProposalVoteType::VoteYes));
+    BOOST_REQUIRE(mnview.AddProposalVote(propId, mn2, CProposalVoteType::VoteNo));
+    BOOST_REQUIRE(mnview.AddProposalVote(propId, mn3, CProposalVoteType::VoteNeutral));
+
+    auto tally = mnview.GetProposalVoteTally(propId, cycle);
+    BOOST_CHECK_EQUAL(tally.yes, 1);
+    BOOST_CHECK_EQUAL(tally.no, 1);
+    BOOST_CHECK_EQUAL(tally.neutral, 1);
+    BOOST_CHECK_EQUAL(tally.invalid, 0);
+
+    // Revote replaces the previous vote
+    BOOST_REQUIRE(mnview.AddProposalVote(propId, mn2, CProposalVoteType::VoteYes));
+    tally = mnview.GetProposalVoteTally(propId, cycle);
+    BOOST_CHECK_EQUAL(tally.yes, 2);
+    BOOST_CHECK_EQUAL(tally.no, 0);
+    BOOST_CHECK_EQUAL(tally.Valid(), 3);
+
+    // Resigned masternode votes become invalid
+    mnview.InvalidateProposalVotes(mn2);
+    tally = mnview.GetProposalVoteTally(propId, cycle);
+    BOOST_CHECK_EQUAL(tally.yes, 1);
+    BOOST_CHECK_EQUAL(tally.invalid, 1);
+
+    // Inactive masternode votes are excluded at read time only
+    tally = mnview.GetProposalVoteTally(propId, cycle, {mn3});
+    BOOST_CHECK_EQUAL(tally.neutral, 0);
+    BOOST_CHECK_EQUAL(tally.Valid(), 1);
+    BOOST_CHECK_EQUAL(tally.invalid, 2);
+    BOOST_CHECK_EQUAL(mnview.GetProposalVoteTally(propId, cycle).neutral, 1);
+}
+
+// Copy of the view as written before the tables under the given prefixes were kept
+static void CopyWithout(CCustomCSView &mnview, CCustomCSView &copy, const std::set<uint8_t> &prefixes) {
+    for (const auto &[key, value] : mnview.GetStorage().GetRaw()) {
+        if (!key.empty() && prefixes.count(key[0])) {
+            continue;
+        }
+        value ? copy.GetStorage().Write(key, *value) : copy.GetStorage().Erase(key);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(build_minting_and_tallies)
+{
+    CCustomCSView mnview(*pcustomcsview.get());
+    const auto mn1 = CreateTestMasternode(mnview, '1');
+    const auto mn2 = CreateTestMasternode(mnview, '2');
+    const auto mn3 = CreateTestMasternode(mnview, '3');
+    CreateTestMasternode(mnview, '4');
+    mnview.IncrementMintedBy(mn1);
+    mnview.IncrementMintedBy(mn2);
+    mnview.IncrementMintedBy(mn3);
+
+    CCreateProposalMessage msg;
+    msg.type = CProposalType::VoteOfConfidence;
+    msg.nCycles = 1;
+    const auto propId = uint256S(std::string(64, 'b'));
+    BOOST_REQUIRE(mnview.CreateProposal(propId, 1, msg, COIN));
+    const auto cycle = mnview.GetProposal(propId)->cycle;
+    BOOST_REQUIRE(mnview.AddProposalVote(propId, mn1, CProposalVoteType::VoteYes));
+    BOOST_REQUIRE(mnview.AddProposalVote(propId, mn2, CProposalVoteType::VoteNo));
+    BOOST_REQUIRE(mnview.AddProposalVote(propId, mn2, CProposalVoteType::VoteNeutral));
+    BOOST_REQUIRE(mnview.AddProposalVote(propId, mn3, CProposalVoteType::VoteYes));
+
+    auto node = mnview.GetMasternode(mn3);
+    BOOST_REQUIRE(mnview.ResignMasternode(*node, mn3, uint256S(std::string(64, 'a')), 1));
+    mnview.InvalidateProposalVotes(mn3);
+
+    CCustomCSView built(*pcustomcsview.get());
+    CopyWithout(mnview, built, {CMasternodesView::Minting::prefix(), CProposalView::ByVoteTally::prefix()});
+    BOOST_CHECK(MintingMasternodes(built).empty());
+
+    built.BuildMintingIndex();
+    built.BuildProposalVoteTallies([&](const uint256 &mnId) { return built.GetMasternode(mnId)->resignHeight != -1; });
+    BOOST_CHECK(MintingMasternodes(built) == MintingMasternodes(mnview));
+    BOOST_CHECK(MintingMasternodes(built) == std::set<uint256>({mn1, mn2}));
+
+    const auto expected = mnview.GetProposalVoteTally(propId, cycle);
+    const auto tally = built.GetProposalVoteTally(propId, cycle);
+    BOOST_CHECK_EQUAL(tally.yes, expected.yes);
+    BOOST_CHECK_EQUAL(tally.no, expected.no);
+    BOOST_CHECK_EQUAL(tally.neutral, expected.neutral);
+    BOOST_CHECK_EQUAL(tally.invalid, expected.invalid);
+    BOOST_CHECK_EQUAL(tally.invalid, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
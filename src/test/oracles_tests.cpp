@@ -9,6 +9,7 @@
 #include <dfi/oracles.h>
 #include <rpc/rawtransaction_util.h>
 #include <dfi/masternodes.h>
+#include <dfi/mn_checks.h>
 
 #include <string>
 
@@ -129,4 +130,97 @@ BOOST_FIXTURE_TEST_SUITE(oracles_tests, OraclesTestingSetup)
         BOOST_ASSERT_MSG(dataRes.ok, dataRes.msg.c_str());
     }
 
+    BOOST_AUTO_TEST_CASE(oracle_pair_price_index_test) {
+
+        COracleId oracleId1{rawVector1};
+        COracleId oracleId2{rawVector2};
+        std::vector<unsigned char> tmp{'a', 'b', 'c'};
+        CScript oracleAddress1{tmp.begin(), tmp.end()};
+        std::set<CTokenCurrencyPair> availableTokens = {
+                {"DFI", "USD"},
+                {"TOK", "USD"},
+        };
+        COracle oracle1, oracle2;
+        static_cast<CAppointOracleMessage&>(oracle1) = CAppointOracleMessage{oracleAddress1, 15, availableTokens};
+        static_cast<CAppointOracleMessage&>(oracle2) = CAppointOracleMessage{oracleAddress1, 5, availableTokens};
+
+        CCustomCSView mnview(*pcustomcsview);
+        BOOST_REQUIRE(mnview.AppointOracle(oracleId1, oracle1));
+        BOOST_REQUIRE(mnview.AppointOracle(oracleId2, oracle2));
+
+        const int64_t time = 1700000000;
+        BOOST_REQUIRE(mnview.SetOracleData(oracleId1, time, {{"DFI", {{"USD", 10 * COIN}}}, {"TOK", {{"USD", COIN}}}}));
+        BOOST_REQUIRE(mnview.SetOracleData(oracleId2, time, {{"DFI", {{"USD", 20 * COIN}}}}));
+
+        auto countPrices = [&](const CTokenCurrencyPair &pair) {
+            int count{};
+            mnview.ForEachOraclePairPrice([&](const COraclePairPriceKey &key, CLazySerialize<COraclePairPrice>) {
+                count += key.priceFeedId == pair;
+                return true;
+            });
+            return count;
+        };
+        BOOST_CHECK_EQUAL(countPrices({"DFI", "USD"}), 2);
+        BOOST_CHECK_EQUAL(countPrices({"TOK", "USD"}), 1);
+
+        auto price = GetAggregatePrice(mnview, "DFI", "USD", time);
+        BOOST_REQUIRE(price);
+        BOOST_CHECK_EQUAL(*price, 25 * COIN / 2);
+        BOOST_CHECK(!GetAggregatePrice(mnview, "DFI", "USD", time + 3600));
+
+        auto prices = GetAggregatePrices(mnview, time);
+        BOOST_CHECK_EQUAL(prices.size(), 2u);
+        BOOST_CHECK_EQUAL(*prices.at({"DFI", "USD"}), 25 * COIN / 2);
+        // a single live oracle is not enough outside regtest
+        BOOST_CHECK(!prices.at({"TOK", "USD"}));
+
+        // new weightage is applied to existing prices, dropped pairs leave the index
+        COracle update1, update2;
+        static_cast<CAppointOracleMessage&>(update1) = CAppointOracleMessage{oracleAddress1, 15, {{"DFI", "USD"}}};
+        static_cast<CAppointOracleMessage&>(update2) = CAppointOracleMessage{oracleAddress1, 15, {{"DFI", "USD"}}};
+        BOOST_REQUIRE(mnview.UpdateOracle(oracleId1, std::move(update1)));
+        BOOST_REQUIRE(mnview.UpdateOracle(oracleId2, std::move(update2)));
+        BOOST_CHECK_EQUAL(countPrices({"TOK", "USD"}), 0);
+        price = GetAggregatePrice(mnview, "DFI", "USD", time);
+        BOOST_REQUIRE(price);
+        BOOST_CHECK_EQUAL(*price, 15 * COIN);
+
+        BOOST_REQUIRE(mnview.RemoveOracle(oracleId1));
+        BOOST_CHECK_EQUAL(countPrices({"DFI", "USD"}), 1);
+        BOOST_CHECK(!GetAggregatePrice(mnview, "DFI", "USD", time));
+    }
+
+    BOOST_AUTO_TEST_CASE(oracle_pair_price_index_build_test) {
+
+        COracleId oracleId1{rawVector1};
+        COracleId oracleId2{rawVector2};
+        std::vector<unsigned char> tmp{'a', 'b', 'c'};
+        CScript oracleAddress1{tmp.begin(), tmp.end()};
+        COracle oracle1, oracle2;
+        static_cast<CAppointOracleMessage&>(oracle1) = CAppointOracleMessage{oracleAddress1, 15, {{"DFI", "USD"}}};
+        static_cast<CAppointOracleMessage&>(oracle2) = CAppointOracleMessage{oracleAddress1, 5, {{"DFI", "USD"}}};
+
+        CCustomCSView mnview(*pcustomcsview);
+        BOOST_REQUIRE(mnview.AppointOracle(oracleId1, oracle1));
+        BOOST_REQUIRE(mnview.AppointOracle(oracleId2, oracle2));
+        const int64_t time = 1700000000;
+        BOOST_REQUIRE(mnview.SetOracleData(oracleId1, time, {{"DFI", {{"USD", 10 * COIN}}}}));
+        BOOST_REQUIRE(mnview.SetOracleData(oracleId2, time, {{"DFI", {{"USD", 20 * COIN}}}}));
+
+        // oracles as written before the index was kept
+        CCustomCSView built(*pcustomcsview);
+        for (const auto &[key, value] : mnview.GetStorage().GetRaw()) {
+            if (!key.empty() && key[0] == COracleView::ByPairPrice::prefix()) {
+                continue;
+            }
+            value ? built.GetStorage().Write(key, *value) : built.GetStorage().Erase(key);
+        }
+        BOOST_CHECK(!GetAggregatePrice(built, "DFI", "USD", time));
+
+        built.BuildPairPriceIndex();
+        auto price = GetAggregatePrice(built, "DFI", "USD", time);
+        BOOST_REQUIRE(price);
+        BOOST_CHECK_EQUAL(*price, *GetAggregatePrice(mnview, "DFI", "USD", time));
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -70,6 +70,42 @@ BOOST_AUTO_TEST_CASE(calc_kernel)
 //    BOOST_CHECK(pos::ComputeStakeModifier(prevStakeModifier, keyID) == targetStakeModifier);
 }
 
+BOOST_AUTO_TEST_CASE(kernel_search)
+{
+    const auto& params = Params().GetConsensus();
+    uint256 stakeModifier = uint256S("1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef");
+    uint256 mnID = uint256S("fedcba0987654321fedcba0987654321fedcba0987654321fedcba0987654321");
+    std::vector<int64_t> coinstakeTimes(100);
+    for (size_t i = 0; i < coinstakeTimes.size(); ++i) {
+        coinstakeTimes[i] = 10000000 + i;
+    }
+
+    // Before and after the subnode joined the kernel, with targets the first few kernels miss
+    const std::vector<std::pair<uint64_t, uint32_t>> heightTargets{
+        {0, 0x1c7fffff},
+        {static_cast<uint64_t>(params.DF10EunosPayaHeight), 0x1b0fffff},
+    };
+    for (const auto& [blockHeight, nBits] : heightTargets) {
+        for (uint8_t subNode : {0, 1}) {
+            CheckContextState ctxState{subNode};
+            std::optional<int64_t> expected;
+            for (const auto time : coinstakeTimes) {
+                if (pos::CheckKernelHash(stakeModifier, nBits, 1, time, blockHeight, mnID, params, 0, ctxState)) {
+                    expected = time;
+                    break;
+                }
+            }
+            BOOST_REQUIRE(expected && *expected != coinstakeTimes.front());
+
+            const pos::CKernelSearch kernel(stakeModifier, nBits, 1, blockHeight, mnID, params, 0, subNode);
+            BOOST_CHECK(kernel.FindKernel(coinstakeTimes.data(), coinstakeTimes.size()) == expected);
+
+            const pos::CKernelSearch unattainable(stakeModifier, 0x00ffffff, 1, blockHeight, mnID, params, 0, subNode);
+            BOOST_CHECK(!unattainable.FindKernel(coinstakeTimes.data(), coinstakeTimes.size()));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(check_stake_modifier)
 {
     uint256 masternodeID = testMasternodeKeys.begin()->first;
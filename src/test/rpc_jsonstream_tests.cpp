@@ -0,0 +1,101 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/jsonstream.h>
+#include <rpc/protocol.h>
+#include <rpc/request.h>
+#include <test/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(rpc_jsonstream_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(jsonstream_writer)
+{
+    std::string out;
+    size_t chunks = 0;
+    JSONStreamWriter writer([&](const std::string &chunk) {
+        out += chunk;
+        ++chunks;
+        return true;
+    }, 16);
+
+    UniValue expected(UniValue::VOBJ);
+    UniValue items(UniValue::VARR);
+    writer.BeginObject();
+    writer.KeyValue("name", "list \"quoted\"");
+    writer.Key("items");
+    writer.BeginArray();
+    for (int i = 0; i < 10; ++i) {
+        UniValue item(UniValue::VOBJ);
+        item.pushKV("n", i);
+        items.push_back(item);
+        writer.Value(item);
+    }
+    writer.BeginArray();
+    writer.End();
+    items.push_back(UniValue(UniValue::VARR));
+    writer.End();
+    writer.KeyValue("empty", UniValue(UniValue::VOBJ));
+    writer.End();
+    writer.Flush();
+    expected.pushKV("name", "list \"quoted\"");
+    expected.pushKV("items", items);
+    expected.pushKV("empty", UniValue(UniValue::VOBJ));
+
+    BOOST_CHECK_EQUAL(out, expected.write());
+    BOOST_CHECK_GT(chunks, 1U);
+    BOOST_CHECK_EQUAL(writer.Written(), out.size());
+}
+
+BOOST_AUTO_TEST_CASE(jsonstream_reply)
+{
+    std::string out;
+    bool started = false;
+    JSONRPCRequest request;
+    request.replyStream = std::make_shared<JSONRPCReplyStream>([&] { started = true; }, [&](const std::string &chunk) {
+        out += chunk;
+        return true;
+    });
+
+    // Small lists are returned as a whole
+    {
+        RPCResultWriter ret(request, UniValue::VARR);
+        ret.push_back(1);
+        BOOST_CHECK_EQUAL(ret.get().write(), "[1]");
+        BOOST_CHECK(!started);
+    }
+
+    UniValue expected(UniValue::VARR);
+    RPCResultWriter ret(request, UniValue::VARR);
+    for (size_t i = 0; i < RPC_STREAM_MIN_ITEMS + 10; ++i) {
+        expected.push_back(uint64_t(i));
+        ret.push_back(uint64_t(i));
+    }
+    BOOST_CHECK(started);
+    BOOST_CHECK(ret.get().isNull());
+    request.replyStream->Finish(UniValue(7));
+    BOOST_CHECK_EQUAL(out, JSONRPCReply(expected, NullUniValue, UniValue(7)));
+
+    // An error leaves the partial result incomplete, so it is not taken for the whole one
+    out.clear();
+    request.replyStream = std::make_shared<JSONRPCReplyStream>([] {}, [&](const std::string &chunk) {
+        out += chunk;
+        return true;
+    });
+    auto &writer = request.replyStream->Result();
+    writer.BeginObject();
+    writer.Key("tx");
+    writer.BeginArray();
+    writer.Value(1);
+    writer.Flush();
+    writer.Value(2);
+    request.replyStream->Abort();
+    BOOST_CHECK_EQUAL(out, "{\"result\":{\"tx\":[1");
+    BOOST_CHECK(!writer.Good());
+    UniValue reply;
+    BOOST_CHECK(!reply.read(out));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
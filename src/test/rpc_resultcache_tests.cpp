@@ -0,0 +1,102 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/resultcache.h>
+#include <test/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+static JSONRPCRequest MakeRequest(const std::string &method, const std::string &params)
+{
+    JSONRPCRequest request;
+    request.strMethod = method;
+    request.params.read(params);
+    return request;
+}
+
+// Set only stores after a miss for the same request, as the RPCs do
+static void Cache(RPCResultCache &cache, const JSONRPCRequest &request, const UniValue &value)
+{
+    BOOST_CHECK(!cache.TryGet(request));
+    cache.Set(request, value);
+}
+
+BOOST_FIXTURE_TEST_SUITE(rpc_resultcache_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(resultcache_tip_change)
+{
+    RPCResultCache cache;
+    cache.Init(RPCResultCache::RPCCacheMode::All);
+    cache.SetTip(10, uint256S("0a"));
+
+    const auto request = MakeRequest("listpoolpairs", R"([{"start":1,"limit":2}, true])");
+    Cache(cache, request, UniValue("pools"));
+
+    // Object keys do not need to be in the same order
+    auto res = cache.TryGet(MakeRequest("listpoolpairs", R"([{"limit":2,"start":1}, true])"));
+    BOOST_REQUIRE(res);
+    BOOST_CHECK_EQUAL(res->get_str(), "pools");
+
+    BOOST_CHECK(!cache.SetTip(10, uint256S("0a")));
+    BOOST_CHECK(cache.TryGet(request));
+    BOOST_CHECK(cache.SetTip(11, uint256S("0b")));
+    BOOST_CHECK(!cache.TryGet(request));
+
+    // A result computed while the tip changed is not stored
+    cache.SetTip(12, uint256S("0c"));
+    cache.Set(request, UniValue("stale"));
+    BOOST_CHECK(!cache.TryGet(request));
+
+    const auto stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(stats.methods.at("listpoolpairs").hits, 2U);
+    BOOST_CHECK_EQUAL(stats.methods.at("listpoolpairs").misses, 3U);
+}
+
+BOOST_AUTO_TEST_CASE(resultcache_historical)
+{
+    RPCResultCache cache;
+    cache.Init(RPCResultCache::RPCCacheMode::Smart);
+    cache.SetTip(100, uint256S("01"));
+
+    const auto past = MakeRequest("listburnhistory", R"([{"maxBlockHeight":90,"depth":10}])");
+    const auto future = MakeRequest("listburnhistory", R"([{"maxBlockHeight":110}])");
+    Cache(cache, past, UniValue("past"));
+    Cache(cache, future, UniValue("future"));
+
+    // Smart mode skips methods without a policy
+    const auto other = MakeRequest("listmasternodes", "[]");
+    Cache(cache, other, UniValue("masternodes"));
+    BOOST_CHECK(!cache.TryGet(other));
+
+    cache.SetTip(101, uint256S("02"));
+    BOOST_CHECK(cache.TryGet(past));
+    BOOST_CHECK(!cache.TryGet(future));
+
+    // Disconnecting the height a result covers drops it
+    cache.SetTip(89, uint256S("03"));
+    BOOST_CHECK(!cache.TryGet(past));
+}
+
+BOOST_AUTO_TEST_CASE(resultcache_budget)
+{
+    RPCResultCache cache;
+    cache.Init(RPCResultCache::RPCCacheMode::All, RPCResultCache::SHARDS * 4096);
+    cache.SetTip(1, uint256S("01"));
+
+    const std::string big(1000, 'x');
+    for (int i = 0; i < 1000; ++i) {
+        Cache(cache, MakeRequest("gettoken", strprintf("[%d]", i)), UniValue(big));
+    }
+    const auto stats = cache.GetStats();
+    BOOST_CHECK_LE(stats.bytes, stats.maxBytes);
+    BOOST_CHECK_GT(stats.evictions, 0U);
+    BOOST_CHECK_EQUAL(stats.entries + stats.evictions, 1000U);
+
+    // Larger than a shard's share is never stored
+    const auto huge = MakeRequest("gettoken", R"(["huge"])");
+    Cache(cache, huge, UniValue(std::string(8192, 'x')));
+    BOOST_CHECK(!cache.TryGet(huge));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
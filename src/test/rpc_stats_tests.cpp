@@ -0,0 +1,97 @@
+// Copyright (c) DeFi Blockchain Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/stats.h>
+#include <test/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(rpc_stats_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(histogram_percentiles)
+{
+    StatHistogram histogram;
+    BOOST_CHECK_EQUAL(histogram.Percentile(0.5), 0);
+
+    for (int64_t i = 1; i <= 1000; ++i) {
+        histogram.Add(i);
+    }
+    BOOST_CHECK_EQUAL(histogram.Count(), 1000);
+
+    // Within the 6.25% bucket width of the exact value
+    for (const auto &[fraction, exact] : {std::pair{0.5, 500}, std::pair{0.9, 900}, std::pair{0.99, 990}, std::pair{0.999, 999}}) {
+        const auto value = histogram.Percentile(fraction);
+        BOOST_CHECK_GE(value, exact);
+        BOOST_CHECK_LE(value, exact * 1.0625);
+    }
+    BOOST_CHECK_EQUAL(histogram.Percentile(1), 1000);
+
+    // Small values are exact
+    StatHistogram small;
+    small.Add(3);
+    small.Add(7);
+    BOOST_CHECK_EQUAL(small.Percentile(0.5), 3);
+    BOOST_CHECK_EQUAL(small.Percentile(0.99), 7);
+
+    // Tail latency shows up in p99 but not in p50
+    StatHistogram tail;
+    for (int i = 0; i < 980; ++i) {
+        tail.Add(100);
+    }
+    for (int i = 0; i < 20; ++i) {
+        tail.Add(100000);
+    }
+    BOOST_CHECK_LE(tail.Percentile(0.5), 106);
+    BOOST_CHECK_GE(tail.Percentile(0.99), 100000);
+
+    tail.Merge(histogram);
+    BOOST_CHECK_EQUAL(tail.Count(), 2000);
+    BOOST_CHECK_EQUAL(tail.Percentile(1), 100000);
+
+    const auto large = std::numeric_limits<int64_t>::max();
+    histogram.Add(large);
+    BOOST_CHECK_EQUAL(histogram.Percentile(1), large);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_json_roundtrip)
+{
+    StatHistogram histogram;
+    for (int64_t i = 0; i < 5000; i += 7) {
+        histogram.Add(i * i);
+    }
+    const auto restored = StatHistogram::fromJSON(histogram.toJSON());
+    BOOST_CHECK_EQUAL(restored.Count(), histogram.Count());
+    for (const auto fraction : {0.1, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+        BOOST_CHECK_EQUAL(restored.Percentile(fraction), histogram.Percentile(fraction));
+    }
+
+    // Stats files written before histograms load with empty ones
+    BOOST_CHECK_EQUAL(StatHistogram::fromJSON(NullUniValue).Count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(stats_window)
+{
+    RPCStats stats{"getblockcount", 1, 10, 0};
+    const int64_t now = 1000000;
+
+    // Execution is latency without lock wait
+    stats.addHistograms(5000, 10, 100, 4000, now - 1000);
+    stats.addHistograms(2000, 10, 100, 0, now - 10);
+    stats.addHistograms(3000, 10, 100, 1000, now);
+
+    BOOST_CHECK_EQUAL(stats.histograms.latency.Count(), 3);
+    BOOST_CHECK_EQUAL(stats.histograms.execution.Percentile(1), 2000);
+
+    const auto window = stats.windowHistograms(now);
+    BOOST_CHECK_EQUAL(window.latency.Count(), 2);
+    BOOST_CHECK_EQUAL(window.latency.Percentile(1), 3000);
+    BOOST_CHECK_EQUAL(stats.windowHistograms(now + RPC_STATS_WINDOW_SLOTS * RPC_STATS_WINDOW_SLOT_SECONDS).latency.Count(), 0);
+
+    const auto restored = RPCStats::fromJSON(stats.toJSON(true));
+    BOOST_CHECK_EQUAL(restored.histograms.latency.Count(), 3);
+    BOOST_CHECK_EQUAL(restored.windowHistograms(now).latency.Count(), 2);
+    BOOST_CHECK(stats.toJSON()["histograms"].isNull());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
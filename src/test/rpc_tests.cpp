@@ -7,6 +7,7 @@
 #include <rpc/util.h>
 
 #include <core_io.h>
+#include <httpserver.h>
 #include <init.h>
 #include <interfaces/chain.h>
 #include <test/setup_common.h>
@@ -15,6 +16,11 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
 #include <univalue.h>
 
 #include <rpc/blockchain.h>
@@ -452,4 +458,120 @@ BOOST_AUTO_TEST_CASE(rpc_getblockstats_calculate_percentiles_by_weight)
     }
 }
 
+// Batch call request, numbered by its id
+static UniValue BatchCall(const std::string& method, int id)
+{
+    UniValue req(UniValue::VOBJ);
+    req.pushKV("method", method);
+    req.pushKV("id", id);
+    return req;
+}
+
+// Batch pool as started by the node, with room for maxCalls calls queued or running
+struct BatchPoolSetup {
+    BatchPoolSetup(int threads, int maxCalls)
+    {
+        gArgs.ForceSetArg("-rpcbatchthreads", std::to_string(threads));
+        gArgs.ForceSetArg("-rpcworkqueue", std::to_string(maxCalls));
+        StartRPC();
+    }
+    ~BatchPoolSetup()
+    {
+        InterruptRPC();
+        StopRPC();
+        gArgs.ForceSetArg("-rpcbatchthreads", std::to_string(DEFAULT_RPC_BATCH_THREADS));
+        gArgs.ForceSetArg("-rpcworkqueue", std::to_string(DEFAULT_HTTP_WORKQUEUE));
+    }
+};
+
+BOOST_AUTO_TEST_CASE(rpc_batch_order)
+{
+    BatchPoolSetup setup(4, 16);
+    UniValue batch(UniValue::VARR);
+    for (int i = 0; i < 8; ++i) {
+        batch.push_back(BatchCall("getblockcount", i));
+    }
+
+    const auto results = JSONRPCExecBatchCalls(batch, [](const UniValue& req) {
+        const auto id = find_value(req, "id").get_int();
+        // Later calls finish first
+        std::this_thread::sleep_for(std::chrono::milliseconds{10 * (8 - id)});
+        return UniValue(id);
+    });
+    BOOST_REQUIRE_EQUAL(results.size(), 8U);
+    for (int i = 0; i < 8; ++i) {
+        BOOST_CHECK_EQUAL(results[i].get_int(), i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rpc_batch_waits_for_unlisted_call)
+{
+    BatchPoolSetup setup(4, 16);
+    UniValue batch(UniValue::VARR);
+    batch.push_back(BatchCall("getblockcount", 0));
+    batch.push_back(BatchCall("getblockcount", 1));
+    batch.push_back(BatchCall("getblockcount", 2));
+    batch.push_back(BatchCall("sendtoaddress", 3));
+    batch.push_back(BatchCall("getblockcount", 4));
+
+    std::atomic<int> finished{0};
+    std::atomic<bool> sent{false};
+    int finishedBeforeSend{-1};
+    bool sentBeforeLast{};
+    const auto results = JSONRPCExecBatchCalls(batch, [&](const UniValue& req) {
+        const auto id = find_value(req, "id").get_int();
+        if (id == 3) {
+            finishedBeforeSend = finished;
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            sent = true;
+        } else if (id == 4) {
+            sentBeforeLast = sent;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            ++finished;
+        }
+        return UniValue(id);
+    });
+
+    // The unlisted call runs after every call before it, the calls after it do not start before it ends
+    BOOST_CHECK_EQUAL(finishedBeforeSend, 3);
+    BOOST_CHECK(sentBeforeLast);
+    BOOST_REQUIRE_EQUAL(results.size(), 5U);
+    for (int i = 0; i < 5; ++i) {
+        BOOST_CHECK_EQUAL(results[i].get_int(), i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rpc_batch_full_pool_runs_inline)
+{
+    // Room for a single call, the second one cannot be queued while the first runs
+    BatchPoolSetup setup(2, 1);
+    UniValue batch(UniValue::VARR);
+    batch.push_back(BatchCall("getblockcount", 0));
+    batch.push_back(BatchCall("getblockcount", 1));
+
+    const auto caller = std::this_thread::get_id();
+    std::vector<std::thread::id> threads(2);
+    std::promise<void> secondRan;
+    auto secondFuture = secondRan.get_future();
+    bool secondRanDuringFirst{};
+    const auto results = JSONRPCExecBatchCalls(batch, [&](const UniValue& req) {
+        const auto id = find_value(req, "id").get_int();
+        threads[id] = std::this_thread::get_id();
+        if (id == 0) {
+            secondRanDuringFirst = secondFuture.wait_for(std::chrono::seconds{10}) == std::future_status::ready;
+        } else {
+            secondRan.set_value();
+        }
+        return UniValue(id);
+    });
+
+    BOOST_CHECK(threads[0] != caller);
+    BOOST_CHECK(threads[1] == caller);
+    BOOST_CHECK(secondRanDuringFirst);
+    BOOST_REQUIRE_EQUAL(results.size(), 2U);
+    BOOST_CHECK_EQUAL(results[0].get_int(), 0);
+    BOOST_CHECK_EQUAL(results[1].get_int(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
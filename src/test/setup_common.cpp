@@ -136,9 +136,11 @@ TestingSetup::TestingSetup(const std::string& chainName) : BasicTestingSetup(cha
     {
         LOCK(cs_main);
 
+        g_tokenTable.Reset();
         pcustomcsDB.reset();
         pcustomcsDB = std::make_unique<CStorageLevelDB>(GetDataDir() / "enhancedcs", nMinDbCache << 20, true, true);
         pcustomcsview = std::make_unique<CCustomCSView>(*pcustomcsDB.get());
+        g_tokenTable.Load(*pcustomcsDB);
         paccountHistoryDB = std::make_unique<CAccountHistoryStorage>(GetDataDir() / "history", nMinDbCache << 20, true, true);
         pvaultHistoryDB = std::make_unique<CVaultHistoryStorage>(GetDataDir() / "vault", nMinDbCache << 20, true, true);
 
@@ -184,6 +186,7 @@ TestingSetup::~TestingSetup()
     panchorAwaitingConfirms.reset();
     panchorauths.reset();
     pcustomcsview.reset();
+    g_tokenTable.Reset();
     pcustomcsDB.reset();
 
     pblocktree.reset();
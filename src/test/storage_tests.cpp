@@ -245,6 +245,62 @@ BOOST_AUTO_TEST_CASE(tokens)
     BOOST_REQUIRE(GetTokensCount() == 3);
 }
 
+BOOST_AUTO_TEST_CASE(token_table)
+{
+    BlockContext dummyContext{std::numeric_limits<uint32_t>::max(), {}, Params().GetConsensus()};
+
+    CTokenImplementation dusd;
+    dusd.symbol = "DUSD";
+    dusd.creationTx = uint256S("0x3333");
+    dusd.flags |= (uint8_t)CToken::TokenFlags::DAT;
+
+    CCustomCSView mnview(*pcustomcsview);
+    const auto res = mnview.CreateToken(dusd, dummyContext);
+    BOOST_REQUIRE(res.ok);
+    const auto id = *res.val;
+    auto undo = CUndo::Construct(pcustomcsview->GetStorage(), mnview.GetStorage().GetRaw());
+
+    // Not committed yet, the view reads its own rows
+    BOOST_CHECK(!g_tokenTable.GetDUSDTokenId());
+    BOOST_CHECK(mnview.GetDUSDTokenId() == id);
+    BOOST_CHECK(!pcustomcsview->GetDUSDTokenId());
+
+    mnview.Flush();
+    BOOST_CHECK(pcustomcsview->GetDUSDTokenId() == id);
+    BOOST_CHECK(!g_tokenTable.GetToken(id));
+
+    BOOST_REQUIRE(pcustomcsview->Flush() && pcustomcsDB->Flush());
+    BOOST_CHECK(g_tokenTable.GetDUSDTokenId() == id);
+    BOOST_CHECK(g_tokenTable.GetTokenId("DUSD") == id);
+    BOOST_REQUIRE(g_tokenTable.GetToken(id));
+    BOOST_CHECK(g_tokenTable.GetToken(id)->creationTx == dusd.creationTx);
+    {
+        const auto pair = CCustomCSView(*pcustomcsview).GetToken("DUSD");
+        BOOST_REQUIRE(pair && pair->second);
+        BOOST_CHECK(pair->first == id);
+        BOOST_CHECK(pair->second->symbol == "DUSD");
+    }
+
+    // Disconnect
+    pcustomcsview->SetUndo(UndoKey{1, uint256S("0x1")}, undo);
+    pcustomcsview->OnUndoTx(uint256S("0x1"), 1);
+    BOOST_CHECK(g_tokenTable.GetDUSDTokenId() == id);
+    BOOST_CHECK(!pcustomcsview->GetDUSDTokenId());
+    BOOST_CHECK(!pcustomcsview->GetToken(id));
+
+    BOOST_REQUIRE(pcustomcsview->Flush() && pcustomcsDB->Flush());
+    BOOST_CHECK(!g_tokenTable.GetDUSDTokenId());
+    BOOST_CHECK(!g_tokenTable.GetTokenId("DUSD"));
+    BOOST_CHECK(!g_tokenTable.GetToken(id));
+
+    // Rebuilt from storage as on startup
+    g_tokenTable.Load(*pcustomcsDB);
+    BOOST_REQUIRE(g_tokenTable.GetToken(DCT_ID{0}));
+    BOOST_CHECK(g_tokenTable.GetToken(DCT_ID{0})->symbol == "DFI");
+    BOOST_CHECK(g_tokenTable.GetTokenId("DFI") == DCT_ID{0});
+    BOOST_CHECK(!g_tokenTable.GetToken(id));
+}
+
 struct TestForward {
     uint32_t n;
 
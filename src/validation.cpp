@@ -30,6 +30,7 @@
 #include <hash.h>
 #include <index/txindex.h>
 #include <net_processing.h>
+#include <ocean.h>
 #include <policy/fees.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
@@ -81,6 +82,10 @@ UniValue blockToJSON(CCustomCSView &view,
                      const CBlockIndex *blockindex,
                      bool txDetails,
                      int version);
+std::vector<uint8_t> blockToOceanPayload(CCustomCSView &view,
+                                         const CBlock &block,
+                                         const CBlockIndex *tip,
+                                         const CBlockIndex *blockindex);
 
 bool CBlockIndexWorkComparator::operator()(const CBlockIndex *pa, const CBlockIndex *pb) const {
     // First sort by most total work, ...
@@ -2171,6 +2176,7 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock &block,
         LogPrint(BCLog::BENCH, "    - Interest rate reverting took: %dms\n", GetTimeMillis() - time);
     }
 
+    mnview.EraseBlockBurnInfo(pindex->nHeight);
     mnview.GetHistoryWriters().EraseHistory(pindex->nHeight, eraseBurnEntries);
 
     // move best block pointer to prevout block
@@ -3585,6 +3591,8 @@ bool CChainState::FlushStateToDisk(const CChainParams &chainparams,
                                                       pcustomcsview->SizeEstimate() > memoryCacheSizeMax);
             // Flush best chain related state. This can only be done if the blocks / block index write was also done.
             if (fMemoryCacheLarge && !CoinsTip().GetBestBlock().IsNull()) {
+                // History of the flushed blocks must be on disk before the chainstate is
+                WaitForHistoryWriterQueue();
                 // Flush view first to estimate size on disk later
                 if (!pcustomcsview->Flush()) {
                     return AbortNode(state, "Failed to write db batch");
@@ -3775,8 +3783,10 @@ bool CChainState::DisconnectTip(CValidationState &state,
 
         if (gArgs.GetBoolArg("-oceanarchive", DEFAULT_OCEAN_INDEXER_ENABLED) ||
             gArgs.GetBoolArg("-expr-oceanarchive", DEFAULT_OCEAN_INDEXER_ENABLED)) {
-            const UniValue b = blockToJSON(mnview, block, pindexDelete, pindexDelete, true, 2);
-            XResultStatusLogged(ocean_invalidate_block(result, b.write()));
+            auto payload = blockToOceanPayload(mnview, block, pindexDelete, pindexDelete);
+            if (OceanCatchupDisconnect(pindexDelete->nHeight, payload)) {
+                XResultStatusLogged(ocean_invalidate_block(result, rust::Slice<const uint8_t>{payload.data(), payload.size()}));
+            }
         }
 
         bool flushed = view.Flush() && mnview.Flush();
@@ -3818,8 +3828,6 @@ bool CChainState::DisconnectTip(CValidationState &state,
 
     UpdateTip(pindexDelete->pprev, chainparams);
 
-    SetLastValidatedHeight(pindexDelete->pprev->nHeight);
-
     // DisconnectTip might be called before psnapshotManager has been initialised
     // as part of start-up so check psnapshotManager before using it.
     if (psnapshotManager) {
@@ -3830,6 +3838,9 @@ bool CChainState::DisconnectTip(CValidationState &state,
                                             BlockchainNearTip(pindexDelete->pprev->GetBlockTime()));
     }
 
+    // After the snapshots, so that results cached for the new tip are read from them
+    SetLastValidatedHeight(pindexDelete->pprev->nHeight, pindexDelete->pprev->GetBlockHash());
+
     // Let wallets know transactions went from 1-confirmed to
     // 0-confirmed or conflicted:
     GetMainSignals().BlockDisconnected(pblock);
@@ -3968,9 +3979,15 @@ bool CChainState::ConnectTip(CValidationState &state,
                  nTimeConnectTotal * MICRO,
                  nTimeConnectTotal * MILLI / nBlocksTotal);
 
+        mnview.GetHistoryWriters().FlushDB();
+
+        // Burn history of the block is now committed, add it to the burn totals
+        if (const auto burnView = mnview.GetHistoryWriters().GetBurnView()) {
+            mnview.AddBlockBurnInfo(pindexNew->nHeight, burnView->GetBlockBurnInfo(pindexNew->nHeight));
+        }
+
         bool flushed = view.Flush() && mnview.Flush();
         assert(flushed);
-        mnview.GetHistoryWriters().FlushDB();
 
         // Delete all other confirms from memory
         if (rewardedAnchors) {
@@ -4024,8 +4041,6 @@ bool CChainState::ConnectTip(CValidationState &state,
         }
     }
 
-    SetLastValidatedHeight(pindexNew->nHeight);
-
     // ConnectTip might be called before psnapshotManager has been initialised
     // as part of start-up so check psnapshotManager before using it.
     if (psnapshotManager) {
@@ -4036,6 +4051,8 @@ bool CChainState::ConnectTip(CValidationState &state,
                                             BlockchainNearTip(pindexNew->GetBlockTime()));
     }
 
+    SetLastValidatedHeight(pindexNew->nHeight, pindexNew->GetBlockHash());
+
     int64_t nTime6 = GetTimeMicros();
     nTimePostConnect += nTime6 - nTime5;
     nTimeTotal += nTime6 - nTime1;